@@ -3,6 +3,7 @@
 
 
 #include "darray_raw_priv_common.h"
+#include "darray_raw_typed_sort.h"
 
 
 /*
@@ -19,16 +20,39 @@
     * copy/clone/move/zeros/set_all.
     * insert first/last/pos with/without entries for unsorted arrays and insert for sorted arrays.
     * delete first/last/pos/all with/without entry for arrays.
-    * find lower/upper bound for sorted arrays.
+    * unique (with optional counts) for arrays, SIMD version for 4- and 8-byte keys.
+    * find lower/upper bound for sorted arrays (branchless with prefetch, type-specialized versions).
+    * hinted (finger) lower/upper bound, find first/last and sorted insert with exponential search from hint.
+    * batched lower/upper bound and find first for many keys (interleaved searches, merge for sorted keys).
+    * interpolation search (lower/upper bound, find first/last) for numeric keys with bisection fallback.
+    * frozen Eytzinger layout of sorted arrays with branchless, prefetching lower/upper bound.
+    * static B-tree (S+ tree) index for sorted arrays of integer keys with SIMD node search, persistable.
+    * learned index (piecewise linear model with bounded error) for sorted arrays of numeric keys.
     * find min/max for arrays.
     * find first/last for sorted/unsorted arrays.
+    * find first/last for unsorted arrays by bytewise equal 1-, 2-, 4- or 8-byte key (SSE2/AVX2/AVX-512 scan).
+    * approximate membership filter (blocked Bloom) for unsorted arrays, updated by insert/delete wrappers.
     * sort/shuffle/reverse arrays.
+    * type-specialized sort for fixed-width integers, float and double (and generator for user types).
+    * sorting networks (SSE4.1/AVX2/AVX-512) for small arrays of 4- and 8-byte keys.
+    * radix sort for integer and floating point keys (whole array member or key inside record).
+    * parallel sort on many threads.
+    * stable sort (TimSort) with optional scratch buffer.
+    * indirect sort (argsort) and in-place permutation of arrays.
+    * sort of key array together with payload arrays (structure-of-arrays).
+    * nth element, partial sort and top k selection.
+    * k-way merge of sorted arrays (loser tree, galloping, unique and parallel variants).
+    * set intersection/union/difference/symmetric difference of sorted arrays (galloping, count only, SIMD for integer keys).
+    * sort by normalized key prefixes for expensive comparators.
+    * external-memory sort of files bigger than memory.
     * check is arrays are equals.
     * check if array is sorted/reverse sorted. 
+    * batch comparator variants of find min, unsorted find first, equal and is sorted.
 */
 
 
 #include <stddef.h>
+#include <stdint.h>
 #include <stdbool.h>
 #include <sys/types.h>
 
@@ -200,6 +224,23 @@ int darray_raw_unsorted_insert_pos(void* restrict array_p, size_t size_of, size_
 int darray_raw_sorted_insert(void* restrict array_p, size_t size_of, size_t length, const void* restrict data_p, const compare_fp cmp_fp);
 
 
+/*
+ * Function insert @data_p into @array_p for sorted array like darray_raw_sorted_insert, but position is searched
+ * by exponential search from @hint, so position at distance d from @hint needs O(log d) comparisons.
+ * For near-sorted streams use @length - 1 (append) or position returned by previous insert as @hint.
+ *
+ * @param[in] array_p - pointer to array.
+ * @param[in] size_of - size of each array member.
+ * @param[in] length  - number of elements in array (last one is free slot for @data_p).
+ * @param[in] data_p  - constant data which fill array.
+ * @param[in] cmp_fp  - comparator function pointer.
+ * @param[in] hint    - expected position of @data_p.
+ *
+ * @return: position of inserted member on success, -1 value on failure.
+ */
+ssize_t darray_raw_sorted_insert_hint(void* restrict array_p, size_t size_of, size_t length, const void* restrict data_p, const compare_fp cmp_fp, size_t hint);
+
+
 /*
  * Function delete first item from @array_p and zeros item from (@length - 1).
  *
@@ -302,8 +343,52 @@ int darray_raw_delete_pos_with_entry(void* array_p, size_t size_of, size_t lengt
 int darray_raw_delete_all_with_entries(void* array_p, size_t size_of, size_t length, const destructor_fp destroy_fp);
 
 
+/*
+ * Function remove consecutive duplicates from @array_p (all duplicates when array is sorted) in a single forward pass.
+ * Kept elements are moved to the beginning of array, slots after new length are zeroed.
+ *
+ * @param[in] array_p - pointer to array.
+ * @param[in] size_of - size of each array member.
+ * @param[in] length  - number of elements in array.
+ * @param[in] cmp_fp  - comparator function pointer.
+ *
+ * @return: new length on success, -1 value on failure.
+ */
+ssize_t darray_raw_unique(void* array_p, size_t size_of, size_t length, const compare_fp cmp_fp);
+
+
+/*
+ * Function remove consecutive duplicates from @array_p like darray_raw_unique and count them (run-length encoding).
+ *
+ * @param[in]  array_p  - pointer to array.
+ * @param[in]  size_of  - size of each array member.
+ * @param[in]  length   - number of elements in array.
+ * @param[in]  cmp_fp   - comparator function pointer.
+ * @param[out] counts_p - number of occurrences of each kept element (space for @length counts), can be NULL.
+ *
+ * @return: new length on success, -1 value on failure.
+ */
+ssize_t darray_raw_unique_counts(void* array_p, size_t size_of, size_t length, const compare_fp cmp_fp, size_t* counts_p);
+
+
+/*
+ * Function remove consecutive duplicates from @array_p of 4- or 8-byte keys which are equal only when bitwise equal
+ * (integers; for floating point -0.0 and +0.0 are different). Neighbors are compared by SIMD and kept elements are
+ * compacted by compress-store (AVX-512) or table-driven permutation (AVX2), instruction set is chosen at run time.
+ * Slots after new length are zeroed.
+ *
+ * @param[in] array_p - pointer to array.
+ * @param[in] size_of - size of each array member (4 or 8).
+ * @param[in] length  - number of elements in array.
+ *
+ * @return: new length on success, -1 value on failure.
+ */
+ssize_t darray_raw_unique_bitwise(void* array_p, size_t size_of, size_t length);
+
+
 /*
  * Function get lower bound of @data_p from @array_p.
+ * Search does not divide and does not branch on comparator result, members of next level are prefetched.
  * 
  * @param[in] array_p - pointer to array.
  * @param[in] size_of - size of each array member.
@@ -318,6 +403,7 @@ ssize_t darray_raw_lower_bound(const void* restrict array_p, size_t size_of, siz
 
 /*
  * Function get upper bound of @data_p from @array_p.
+ * Search does not divide and does not branch on comparator result, members of next level are prefetched.
  * 
  * @param[in] array_p - pointer to array.
  * @param[in] size_of - size of each array member.
@@ -330,6 +416,378 @@ ssize_t darray_raw_lower_bound(const void* restrict array_p, size_t size_of, siz
 ssize_t darray_raw_upper_bound(const void* restrict array_p, size_t size_of, size_t length, const void* restrict data_p, const compare_fp cmp_fp);
 
 
+/*
+ * Function get lower bound of @data_p from @array_p like darray_raw_lower_bound, starting from index @hint.
+ * Range of bound is found by exponential (galloping) search outward from @hint, so bound at distance d
+ * from @hint needs O(log d) comparisons (for cursor-driven scans and streaming joins use previous result as @hint).
+ *
+ * @param[in] array_p - pointer to array.
+ * @param[in] size_of - size of each array member.
+ * @param[in] length  - number of elements in array.
+ * @param[in] data_p  - searched value.
+ * @param[in] cmp_fp  - comparator function pointer.
+ * @param[in] hint    - expected bound index (values greater than @length are treated as @length).
+ *
+ * @return: lower bound index on success, -1 value on failure.
+ */
+ssize_t darray_raw_lower_bound_hint(const void* restrict array_p, size_t size_of, size_t length, const void* restrict data_p, const compare_fp cmp_fp, size_t hint);
+
+
+/*
+ * Function get upper bound of @data_p from @array_p like darray_raw_upper_bound, starting from index @hint.
+ * Range of bound is found by exponential (galloping) search outward from @hint, so bound at distance d
+ * from @hint needs O(log d) comparisons.
+ *
+ * @param[in] array_p - pointer to array.
+ * @param[in] size_of - size of each array member.
+ * @param[in] length  - number of elements in array.
+ * @param[in] data_p  - searched value.
+ * @param[in] cmp_fp  - comparator function pointer.
+ * @param[in] hint    - expected bound index (values greater than @length are treated as @length).
+ *
+ * @return: upper bound index on success, -1 value on failure.
+ */
+ssize_t darray_raw_upper_bound_hint(const void* restrict array_p, size_t size_of, size_t length, const void* restrict data_p, const compare_fp cmp_fp, size_t hint);
+
+
+/*
+ * Type-specialized lower and upper bound functions generated by DARRAY_RAW_DEFINE_LOWER_BOUND and DARRAY_RAW_DEFINE_UPPER_BOUND.
+ * They use the same algorithm as darray_raw_lower_bound and darray_raw_upper_bound, but key is passed by value
+ * and comparison is inlined (operator <). For float and double arrays with NaN values result is unspecified.
+ *
+ * @param[in] array_p - pointer to sorted array.
+ * @param[in] length  - number of elements in array.
+ * @param[in] key     - searched value.
+ *
+ * @return: bound index on success, -1 value on failure.
+ */
+DARRAY_RAW_DECLARE_BOUND(darray_raw_lower_bound_i8, int8_t);
+DARRAY_RAW_DECLARE_BOUND(darray_raw_lower_bound_u8, uint8_t);
+DARRAY_RAW_DECLARE_BOUND(darray_raw_lower_bound_i16, int16_t);
+DARRAY_RAW_DECLARE_BOUND(darray_raw_lower_bound_u16, uint16_t);
+DARRAY_RAW_DECLARE_BOUND(darray_raw_lower_bound_i32, int32_t);
+DARRAY_RAW_DECLARE_BOUND(darray_raw_lower_bound_u32, uint32_t);
+DARRAY_RAW_DECLARE_BOUND(darray_raw_lower_bound_i64, int64_t);
+DARRAY_RAW_DECLARE_BOUND(darray_raw_lower_bound_u64, uint64_t);
+DARRAY_RAW_DECLARE_BOUND(darray_raw_lower_bound_float, float);
+DARRAY_RAW_DECLARE_BOUND(darray_raw_lower_bound_double, double);
+DARRAY_RAW_DECLARE_BOUND(darray_raw_upper_bound_i8, int8_t);
+DARRAY_RAW_DECLARE_BOUND(darray_raw_upper_bound_u8, uint8_t);
+DARRAY_RAW_DECLARE_BOUND(darray_raw_upper_bound_i16, int16_t);
+DARRAY_RAW_DECLARE_BOUND(darray_raw_upper_bound_u16, uint16_t);
+DARRAY_RAW_DECLARE_BOUND(darray_raw_upper_bound_i32, int32_t);
+DARRAY_RAW_DECLARE_BOUND(darray_raw_upper_bound_u32, uint32_t);
+DARRAY_RAW_DECLARE_BOUND(darray_raw_upper_bound_i64, int64_t);
+DARRAY_RAW_DECLARE_BOUND(darray_raw_upper_bound_u64, uint64_t);
+DARRAY_RAW_DECLARE_BOUND(darray_raw_upper_bound_float, float);
+DARRAY_RAW_DECLARE_BOUND(darray_raw_upper_bound_double, double);
+
+
+/*
+ * Function get lower bound (like darray_raw_lower_bound) of each of @nkeys keys from @array_p.
+ * Keys have the same type as array members. Sorted batch of keys is merged with array (each key is searched by exponential
+ * search from result of previous key). Otherwise groups of 16 binary searches advance in lockstep and each search
+ * prefetches its next probe, so cache misses of independent searches overlap.
+ *
+ * @param[in]  array_p   - pointer to sorted array.
+ * @param[in]  size_of   - size of each array member.
+ * @param[in]  length    - number of elements in array.
+ * @param[in]  keys_p    - pointer to keys.
+ * @param[in]  nkeys     - number of keys.
+ * @param[in]  cmp_fp    - comparator function pointer.
+ * @param[out] out_idx_p - lower bound index of each key.
+ *
+ * @return: 0 on success, -1 value on failure.
+ */
+int darray_raw_lower_bound_batch(const void* array_p, size_t size_of, size_t length, const void* keys_p, size_t nkeys, const compare_fp cmp_fp, ssize_t* out_idx_p);
+
+
+/*
+ * Function get upper bound (like darray_raw_upper_bound) of each of @nkeys keys from @array_p.
+ * Keys have the same type as array members. Sorted batch of keys is merged with array (each key is searched by exponential
+ * search from result of previous key). Otherwise groups of 16 binary searches advance in lockstep and each search
+ * prefetches its next probe, so cache misses of independent searches overlap.
+ *
+ * @param[in]  array_p   - pointer to sorted array.
+ * @param[in]  size_of   - size of each array member.
+ * @param[in]  length    - number of elements in array.
+ * @param[in]  keys_p    - pointer to keys.
+ * @param[in]  nkeys     - number of keys.
+ * @param[in]  cmp_fp    - comparator function pointer.
+ * @param[out] out_idx_p - upper bound index of each key.
+ *
+ * @return: 0 on success, -1 value on failure.
+ */
+int darray_raw_upper_bound_batch(const void* array_p, size_t size_of, size_t length, const void* keys_p, size_t nkeys, const compare_fp cmp_fp, ssize_t* out_idx_p);
+
+
+/*
+ * Function find first occurrence (like darray_raw_sorted_find_first) of each of @nkeys keys in @array_p.
+ * Keys have the same type as array members. Sorted batch of keys is merged with array (each key is searched by exponential
+ * search from result of previous key). Otherwise groups of 16 binary searches advance in lockstep and each search
+ * prefetches its next probe, so cache misses of independent searches overlap.
+ *
+ * @param[in]  array_p   - pointer to sorted array.
+ * @param[in]  size_of   - size of each array member.
+ * @param[in]  length    - number of elements in array.
+ * @param[in]  keys_p    - pointer to keys.
+ * @param[in]  nkeys     - number of keys.
+ * @param[in]  cmp_fp    - comparator function pointer.
+ * @param[out] out_idx_p - index of first occurrence or -1 when key is not found of each key.
+ *
+ * @return: 0 on success, -1 value on failure.
+ */
+int darray_raw_sorted_find_first_batch(const void* array_p, size_t size_of, size_t length, const void* keys_p, size_t nkeys, const compare_fp cmp_fp, ssize_t* out_idx_p);
+
+
+/*
+ * Function get lower bound of @data_p from @array_p like darray_raw_lower_bound using interpolation search.
+ * Position is estimated by interpolation of numbers of members (@num_fp), so uniformly distributed keys are found
+ * in few probes. After 2 * log2(log2(n)) + 2 probes search continues by bisection, so worst case is O(log n).
+ *
+ * @param[in] array_p - pointer to sorted array.
+ * @param[in] size_of - size of each array member.
+ * @param[in] length  - number of elements in array.
+ * @param[in] data_p  - searched value.
+ * @param[in] cmp_fp  - comparator function pointer.
+ * @param[in] num_fp  - function which map member to number, not decreasing in order of @cmp_fp.
+ *
+ * @return: lower bound index on success, -1 value on failure.
+ */
+ssize_t darray_raw_interpolation_lower_bound(const void* restrict array_p, size_t size_of, size_t length, const void* restrict data_p, const compare_fp cmp_fp, const number_fp num_fp);
+
+
+/*
+ * Function get upper bound of @data_p from @array_p like darray_raw_upper_bound using interpolation search.
+ * Position is estimated by interpolation of numbers of members (@num_fp), so uniformly distributed keys are found
+ * in few probes. After 2 * log2(log2(n)) + 2 probes search continues by bisection, so worst case is O(log n).
+ *
+ * @param[in] array_p - pointer to sorted array.
+ * @param[in] size_of - size of each array member.
+ * @param[in] length  - number of elements in array.
+ * @param[in] data_p  - searched value.
+ * @param[in] cmp_fp  - comparator function pointer.
+ * @param[in] num_fp  - function which map member to number, not decreasing in order of @cmp_fp.
+ *
+ * @return: upper bound index on success, -1 value on failure.
+ */
+ssize_t darray_raw_interpolation_upper_bound(const void* restrict array_p, size_t size_of, size_t length, const void* restrict data_p, const compare_fp cmp_fp, const number_fp num_fp);
+
+
+/*
+ * Function find first occurrence of @key_p in sorted @array_p like darray_raw_sorted_find_first using interpolation search.
+ * Position is estimated by interpolation of numbers of members (@num_fp), so uniformly distributed keys are found
+ * in few probes. After 2 * log2(log2(n)) + 2 probes search continues by bisection, so worst case is O(log n).
+ * Value under found index will be copy into @out_p if not NULL.
+ *
+ * @param[in]  array_p - pointer to sorted array.
+ * @param[in]  size_of - size of each array member.
+ * @param[in]  length  - number of elements in array.
+ * @param[in]  key_p   - searched value.
+ * @param[in]  cmp_fp  - comparator function pointer.
+ * @param[in]  num_fp  - function which map member to number, not decreasing in order of @cmp_fp.
+ * @param[out] out_p   - copy found value if not NULL.
+ *
+ * @return: index of first occurrence on success, -1 value on failure.
+ */
+ssize_t darray_raw_interpolation_find_first(const void* restrict array_p, size_t size_of, size_t length, const void* restrict key_p, const compare_fp cmp_fp, const number_fp num_fp, void* out_p);
+
+
+/*
+ * Function find last occurrence of @key_p in sorted @array_p like darray_raw_sorted_find_last using interpolation search.
+ * Position is estimated by interpolation of numbers of members (@num_fp), so uniformly distributed keys are found
+ * in few probes. After 2 * log2(log2(n)) + 2 probes search continues by bisection, so worst case is O(log n).
+ * Value under found index will be copy into @out_p if not NULL.
+ *
+ * @param[in]  array_p - pointer to sorted array.
+ * @param[in]  size_of - size of each array member.
+ * @param[in]  length  - number of elements in array.
+ * @param[in]  key_p   - searched value.
+ * @param[in]  cmp_fp  - comparator function pointer.
+ * @param[in]  num_fp  - function which map member to number, not decreasing in order of @cmp_fp.
+ * @param[out] out_p   - copy found value if not NULL.
+ *
+ * @return: index of last occurrence on success, -1 value on failure.
+ */
+ssize_t darray_raw_interpolation_find_last(const void* restrict array_p, size_t size_of, size_t length, const void* restrict key_p, const compare_fp cmp_fp, const number_fp num_fp, void* out_p);
+
+
+/*
+ * Function create frozen copy of sorted @array_p in Eytzinger (BFS) layout for read-mostly lookups on big arrays.
+ * Element of rank r is stored at node k of implicit binary tree (children of k are 2k and 2k + 1, root is 1),
+ * layout has @length + 1 slots (slot 0 is unused) and it is aligned to cache line. Destroy it by darray_raw_destroy.
+ * Layout is not updated by changes of @array_p, it has to be created again.
+ *
+ * @param[in] array_p - pointer to sorted array.
+ * @param[in] size_of - size of each array member.
+ * @param[in] length  - number of elements in array.
+ *
+ * @return: allocated layout on success, NULL on failure.
+ */
+void* darray_raw_eytzinger_create(const void* array_p, size_t size_of, size_t length);
+
+
+/*
+ * Function get lower bound of @data_p from Eytzinger layout created by darray_raw_eytzinger_create.
+ * Search does not branch on comparator result and prefetches nodes four levels ahead.
+ *
+ * @param[in] eytzinger_p - pointer to layout.
+ * @param[in] size_of     - size of each array member.
+ * @param[in] length      - number of elements in sorted array used to create layout.
+ * @param[in] data_p      - searched value.
+ * @param[in] cmp_fp      - comparator function pointer.
+ *
+ * @return: lower bound index in sorted array (like darray_raw_lower_bound) on success, -1 value on failure.
+ */
+ssize_t darray_raw_eytzinger_lower_bound(const void* restrict eytzinger_p, size_t size_of, size_t length, const void* restrict data_p, const compare_fp cmp_fp);
+
+
+/*
+ * Function get upper bound of @data_p from Eytzinger layout created by darray_raw_eytzinger_create.
+ * Search does not branch on comparator result and prefetches nodes four levels ahead.
+ *
+ * @param[in] eytzinger_p - pointer to layout.
+ * @param[in] size_of     - size of each array member.
+ * @param[in] length      - number of elements in sorted array used to create layout.
+ * @param[in] data_p      - searched value.
+ * @param[in] cmp_fp      - comparator function pointer.
+ *
+ * @return: upper bound index in sorted array (like darray_raw_upper_bound) on success, -1 value on failure.
+ */
+ssize_t darray_raw_eytzinger_upper_bound(const void* restrict eytzinger_p, size_t size_of, size_t length, const void* restrict data_p, const compare_fp cmp_fp);
+
+
+/*
+ * Function map index in sorted array to index in Eytzinger layout, so element can be read from layout
+ * when sorted array is not kept.
+ *
+ * @param[in] length - number of elements in sorted array used to create layout.
+ * @param[in] rank   - index in sorted array.
+ *
+ * @return: index in layout on success, -1 value on failure.
+ */
+ssize_t darray_raw_eytzinger_node(size_t length, size_t rank);
+
+
+/*
+ * Function build static B-tree (S+ tree) index for sorted @array_p of 4- or 8-byte integer keys which is built once
+ * and queried many times. Leaves of tree are cache-line blocks of array itself (16 4-byte or 8 8-byte keys),
+ * index stores only internal nodes (one cache line of separators each), so it takes about 1 / 16 (1 / 8) of array memory.
+ * Index is not updated by changes of @array_p, it has to be created again. Destroy it by darray_raw_destroy.
+ *
+ * @param[in] array_p  - pointer to sorted array.
+ * @param[in] size_of  - size of each array member (4 or 8).
+ * @param[in] length   - number of elements in array.
+ * @param[in] key_type - type of key (DARRAY_RAW_KEY_UNSIGNED or DARRAY_RAW_KEY_SIGNED).
+ *
+ * @return: allocated index on success, NULL on failure.
+ */
+void* darray_raw_stree_create(const void* array_p, size_t size_of, size_t length, darray_raw_key_type_e key_type);
+
+
+/*
+ * Function get size of index in bytes (index is position-independent, so it can be written and read as is).
+ *
+ * @param[in] stree_p - index created by darray_raw_stree_create or darray_raw_stree_load.
+ *
+ * @return: size of index on success, 0 on failure.
+ */
+size_t darray_raw_stree_size(const void* stree_p);
+
+
+/*
+ * Function get lower bound of @key_p in sorted array using its index, result is the same as from darray_raw_lower_bound.
+ * Each node is searched by SIMD compare and movemask (AVX-512 or AVX2 chosen at run time, scalar otherwise).
+ *
+ * @param[in] stree_p - index created for @array_p.
+ * @param[in] array_p - pointer to sorted array.
+ * @param[in] key_p   - searched key.
+ *
+ * @return: lower bound index on success, -1 value on failure.
+ */
+ssize_t darray_raw_stree_lower_bound(const void* restrict stree_p, const void* restrict array_p, const void* restrict key_p);
+
+
+/*
+ * Function save index to file, so it can be stored alongside array and loaded without rebuilding.
+ * File format uses byte order of machine.
+ *
+ * @param[in] stree_p - index.
+ * @param[in] path    - path of file.
+ *
+ * @return: 0 on success, -1 value on failure.
+ */
+int darray_raw_stree_save(const void* stree_p, const char* path);
+
+
+/*
+ * Function load index saved by darray_raw_stree_save. Header and size of file are validated.
+ * Destroy index by darray_raw_destroy.
+ *
+ * @param[in] path - path of file.
+ *
+ * @return: allocated index on success, NULL on failure.
+ */
+void* darray_raw_stree_load(const char* path);
+
+
+/*
+ * Function build learned index (piecewise linear model) for sorted @array_p of numeric keys in one pass over array.
+ * Model predicts rank of key within @epsilon members, so lookup searches only small window of array.
+ * Smooth keys (timestamps, monotone IDs) need few segments, so model is much smaller than B-tree.
+ * Model is not updated by changes of @array_p, it has to be created again. Destroy it by darray_raw_destroy.
+ *
+ * @param[in] array_p - pointer to sorted array.
+ * @param[in] size_of - size of each array member.
+ * @param[in] length  - number of elements in array.
+ * @param[in] num_fp  - number function pointer, maps member to number which does not decrease with order of array.
+ * @param[in] epsilon - maximal error of prediction in members (bigger value gives smaller model and wider window).
+ *
+ * @return: allocated model on success, NULL on failure.
+ */
+void* darray_raw_learned_create(const void* array_p, size_t size_of, size_t length, const number_fp num_fp, size_t epsilon);
+
+
+/*
+ * Function get size of learned index in bytes.
+ *
+ * @param[in] learned_p - model created by darray_raw_learned_create.
+ *
+ * @return: size of model on success, 0 on failure.
+ */
+size_t darray_raw_learned_size(const void* learned_p);
+
+
+/*
+ * Function get lower bound of @data_p in sorted array using its learned index, result is the same as from darray_raw_lower_bound.
+ * Window around predicted rank is searched, it is extended by exponential search when bound is outside of it.
+ *
+ * @param[in] learned_p - model created for @array_p.
+ * @param[in] array_p   - pointer to sorted array.
+ * @param[in] data_p    - searched value.
+ * @param[in] cmp_fp    - comparator function pointer.
+ * @param[in] num_fp    - number function pointer used to create model.
+ *
+ * @return: lower bound index on success, -1 value on failure.
+ */
+ssize_t darray_raw_learned_lower_bound(const void* restrict learned_p, const void* restrict array_p, const void* restrict data_p, const compare_fp cmp_fp, const number_fp num_fp);
+
+
+/*
+ * Function get upper bound of @data_p in sorted array using its learned index, result is the same as from darray_raw_upper_bound.
+ * Window around predicted rank is searched, it is extended by exponential search when bound is outside of it.
+ *
+ * @param[in] learned_p - model created for @array_p.
+ * @param[in] array_p   - pointer to sorted array.
+ * @param[in] data_p    - searched value.
+ * @param[in] cmp_fp    - comparator function pointer.
+ * @param[in] num_fp    - number function pointer used to create model.
+ *
+ * @return: upper bound index on success, -1 value on failure.
+ */
+ssize_t darray_raw_learned_upper_bound(const void* restrict learned_p, const void* restrict array_p, const void* restrict data_p, const compare_fp cmp_fp, const number_fp num_fp);
+
+
 /*
  * Function find minimum value from @array_p.
  * Value under found index will be copy into @out_p if not NULL.
@@ -368,7 +826,7 @@ ssize_t darray_raw_find_max(const void* array_p, size_t size_of, size_t length,
  * @param[in]  size_of - size of each array member.
  * @param[in]  length  - number of elements in array.
  * @param[in]  key_p   - search first key from array.
- * @param[in]  cmp_fp  - comparator function pointer.
+ * @param[in]  cmp_fp  - comparator function pointer, called as cmp_fp(array member, @key_p).
  * @param[out] out_p   - copy found value if not NULL.
  * 
  * @return: index of first occurrence on success, -1 value on failure.
@@ -384,7 +842,7 @@ ssize_t darray_raw_unsorted_find_first(const void* restrict array_p, size_t size
  * @param[in]  size_of - size of each array member.
  * @param[in]  length  - number of elements in array.
  * @param[in]  key_p   - search last key from array.
- * @param[in]  cmp_fp  - comparator function pointer.
+ * @param[in]  cmp_fp  - comparator function pointer, called as cmp_fp(array member, @key_p).
  * @param[out] out_p   - copy found value if not NULL.
  * 
  * @return: index of last occurrence on success, -1 value on failure.
@@ -393,57 +851,660 @@ ssize_t darray_raw_unsorted_find_last(const void* restrict array_p, size_t size_
 
 
 /*
- * Function find first occurrence of @key_p in sorted @array_p. 
+ * Function find first occurrence of member with key equal to @key_p in unsorted @array_p without comparator.
+ * Equality is bytewise equality of @key_size bytes at @key_offset of each member, so many members are compared
+ * by one SIMD instruction (SSE2, AVX2 or AVX-512 chosen at run time) when member size is power of two up to vector size.
  * Value under found index will be copy into @out_p if not NULL.
- * 
- * @param[in]  array_p - pointer to array.
- * @param[in]  size_of - size of each array member.
- * @param[in]  length  - number of elements in array.
- * @param[in]  key_p   - search first key from array.
- * @param[in]  cmp_fp  - comparator function pointer.
- * @param[out] out_p   - copy found value if not NULL.
- * 
+ *
+ * @param[in]  array_p    - pointer to array.
+ * @param[in]  size_of    - size of each array member.
+ * @param[in]  length     - number of elements in array.
+ * @param[in]  key_offset - offset of key in bytes inside array member (e.g. offsetof, 0 for whole member).
+ * @param[in]  key_size   - size of key in bytes (1, 2, 4 or 8).
+ * @param[in]  key_p      - key bytes.
+ * @param[out] out_p      - copy found value if not NULL.
+ *
  * @return: index of first occurrence on success, -1 value on failure.
  */
-ssize_t darray_raw_sorted_find_first(const void* restrict array_p, size_t size_of, size_t length, const void* restrict key_p, const compare_fp cmp_fp, void* out_p);
+ssize_t darray_raw_unsorted_find_first_bitwise(const void* restrict array_p, size_t size_of, size_t length, size_t key_offset, size_t key_size, const void* restrict key_p, void* out_p);
 
 
 /*
- * Function last occurrence of @key_p in sorted @array_p. 
+ * Function find last occurrence of member with key equal to @key_p in unsorted @array_p without comparator.
+ * Equality is bytewise equality of @key_size bytes at @key_offset of each member, array is scanned backward
+ * by SIMD instructions (SSE2, AVX2 or AVX-512 chosen at run time) when member size is power of two up to vector size.
  * Value under found index will be copy into @out_p if not NULL.
- * 
- * @param[in]  array_p - pointer to array.
- * @param[in]  size_of - size of each array member.
- * @param[in]  length  - number of elements in array.
- * @param[in]  key_p   - search last key from array.
- * @param[in]  cmp_fp  - comparator function pointer.
- * @param[out] out_p   - copy found value if not NULL.
- * 
+ *
+ * @param[in]  array_p    - pointer to array.
+ * @param[in]  size_of    - size of each array member.
+ * @param[in]  length     - number of elements in array.
+ * @param[in]  key_offset - offset of key in bytes inside array member (e.g. offsetof, 0 for whole member).
+ * @param[in]  key_size   - size of key in bytes (1, 2, 4 or 8).
+ * @param[in]  key_p      - key bytes.
+ * @param[out] out_p      - copy found value if not NULL.
+ *
  * @return: index of last occurrence on success, -1 value on failure.
  */
-ssize_t darray_raw_sorted_find_last(const void* restrict array_p, size_t size_of, size_t length, const void* restrict key_p, const compare_fp cmp_fp, void* out_p);
+ssize_t darray_raw_unsorted_find_last_bitwise(const void* restrict array_p, size_t size_of, size_t length, size_t key_offset, size_t key_size, const void* restrict key_p, void* out_p);
 
 
 /*
- * Function sort @array_p. 
- * Insertion-sort will be used for arrays with length smaller than 17 elements. For bigger arrays dual-pivot quick-sort will be used.
- * 
- * @param[in]  array_p - pointer to array.
- * @param[in]  size_of - size of each array member.
- * @param[in]  length  - number of elements in array.
- * @param[in]  cmp_fp  - comparator function pointer.
- * 
- * @return: this is void function.
+ * Function create approximate membership filter (blocked Bloom filter) for keys of unsorted @array_p, so lookups
+ * of missing keys are answered without scan. Key is hashed by @hash_fp, or when it is NULL bytes of key at @key_offset
+ * of each member are hashed. Filter has no false negatives, false positive rate is about @fpr up to @capacity keys.
+ * Keep filter updated by darray_raw_filter_unsorted_insert_pos / darray_raw_filter_delete_pos or rebuild it
+ * by darray_raw_filter_rebuild after other changes of array. Destroy it by darray_raw_filter_destroy.
+ *
+ * @param[in] array_p    - pointer to array (can be NULL when @length is 0).
+ * @param[in] size_of    - size of each array member.
+ * @param[in] length     - number of elements in array.
+ * @param[in] capacity   - expected number of keys (at least @length is used).
+ * @param[in] fpr        - false positive rate in range (0, 1), e.g. 0.01.
+ * @param[in] hash_fp    - hash function pointer or NULL.
+ * @param[in] key_offset - offset of key in bytes inside array member (used when @hash_fp is NULL).
+ * @param[in] key_size   - size of key in bytes (used when @hash_fp is NULL).
+ *
+ * @return: allocated filter on success, NULL on failure.
  */
-void darray_raw_sort(void* array_p, size_t size_of, size_t length, const compare_fp cmp_fp);
+void* darray_raw_filter_create(const void* array_p, size_t size_of, size_t length, size_t capacity, double fpr, const hasher_fp hash_fp, size_t key_offset, size_t key_size);
 
 
 /*
- * Function shuffle @array_p.
+ * Function destroy filter created by darray_raw_filter_create.
  *
- * @param[in] array_p - pointer to array.
- * @param[in] size_of - size of each array member.
- * @param[in] length  - number of elements in array.
+ * @param[in] filter_p - pointer to filter.
+ *
+ * @return: this is void function.
+ */
+void darray_raw_filter_destroy(void* filter_p);
+
+
+/*
+ * Function get memory used by filter in bytes.
+ *
+ * @param[in] filter_p - pointer to filter.
+ *
+ * @return: size of filter on success, 0 on failure.
+ */
+size_t darray_raw_filter_size(const void* filter_p);
+
+
+/*
+ * Function build filter again from all members of @array_p (after changes of array without filter wrappers).
+ *
+ * @param[in] filter_p - pointer to filter.
+ * @param[in] array_p  - pointer to array (can be NULL when @length is 0).
+ * @param[in] length   - number of elements in array.
+ *
+ * @return: 0 on success, -1 value on failure.
+ */
+int darray_raw_filter_rebuild(void* filter_p, const void* array_p, size_t length);
+
+
+/*
+ * Function check if key of @key_p may be in array of filter.
+ *
+ * @param[in] filter_p - pointer to filter.
+ * @param[in] key_p    - searched value (member with key).
+ *
+ * @return: 1 when key may be in array, 0 when it is not in array, -1 value on failure.
+ */
+int darray_raw_filter_contains(const void* restrict filter_p, const void* restrict key_p);
+
+
+/*
+ * Function find first occurrence of @key_p in unsorted @array_p like darray_raw_unsorted_find_first,
+ * but filter is checked first, so missing key is answered in constant time.
+ * Value under found index will be copy into @out_p if not NULL.
+ *
+ * @param[in]  filter_p - filter of @array_p.
+ * @param[in]  array_p  - pointer to array.
+ * @param[in]  length   - number of elements in array.
+ * @param[in]  key_p    - search first key from array.
+ * @param[in]  cmp_fp   - comparator function pointer.
+ * @param[out] out_p    - copy found value if not NULL.
+ *
+ * @return: index of first occurrence on success, -1 value on failure.
+ */
+ssize_t darray_raw_filter_find_first(const void* restrict filter_p, const void* restrict array_p, size_t length, const void* restrict key_p, const compare_fp cmp_fp, void* out_p);
+
+
+/*
+ * Function find last occurrence of @key_p in unsorted @array_p like darray_raw_unsorted_find_last,
+ * but filter is checked first, so missing key is answered in constant time.
+ * Value under found index will be copy into @out_p if not NULL.
+ *
+ * @param[in]  filter_p - filter of @array_p.
+ * @param[in]  array_p  - pointer to array.
+ * @param[in]  length   - number of elements in array.
+ * @param[in]  key_p    - search last key from array.
+ * @param[in]  cmp_fp   - comparator function pointer.
+ * @param[out] out_p    - copy found value if not NULL.
+ *
+ * @return: index of last occurrence on success, -1 value on failure.
+ */
+ssize_t darray_raw_filter_find_last(const void* restrict filter_p, const void* restrict array_p, size_t length, const void* restrict key_p, const compare_fp cmp_fp, void* out_p);
+
+
+/*
+ * Function insert @data_p at @pos of unsorted @array_p like darray_raw_unsorted_insert_pos and add its key to filter.
+ * Filter is rebuilt with doubled capacity when it holds more keys than its capacity.
+ *
+ * @param[in] filter_p - filter of @array_p.
+ * @param[in] array_p  - pointer to array.
+ * @param[in] length   - number of elements in array.
+ * @param[in] pos      - array index to insert data.
+ * @param[in] data_p   - constant data which fill array.
+ *
+ * @return: 0 on success, non-zero value on failure.
+ */
+int darray_raw_filter_unsorted_insert_pos(void* restrict filter_p, void* restrict array_p, size_t length, size_t pos, const void* restrict data_p);
+
+
+/*
+ * Function delete item at @pos of @array_p like darray_raw_delete_pos. Bloom filter can not remove key,
+ * so filter is rebuilt from array when more than half of its keys are deleted.
+ *
+ * @param[in] filter_p - filter of @array_p.
+ * @param[in] array_p  - pointer to array.
+ * @param[in] length   - number of elements in array.
+ * @param[in] pos      - array index to delete.
+ *
+ * @return: 0 on success, non-zero value on failure.
+ */
+int darray_raw_filter_delete_pos(void* restrict filter_p, void* restrict array_p, size_t length, size_t pos);
+
+
+/*
+ * Function find first occurrence of @key_p in sorted @array_p. 
+ * Value under found index will be copy into @out_p if not NULL.
+ * 
+ * @param[in]  array_p - pointer to array.
+ * @param[in]  size_of - size of each array member.
+ * @param[in]  length  - number of elements in array.
+ * @param[in]  key_p   - search first key from array.
+ * @param[in]  cmp_fp  - comparator function pointer, called as cmp_fp(array member, @key_p).
+ * @param[out] out_p   - copy found value if not NULL.
+ * 
+ * @return: index of first occurrence on success, -1 value on failure.
+ */
+ssize_t darray_raw_sorted_find_first(const void* restrict array_p, size_t size_of, size_t length, const void* restrict key_p, const compare_fp cmp_fp, void* out_p);
+
+
+/*
+ * Function last occurrence of @key_p in sorted @array_p. 
+ * Value under found index will be copy into @out_p if not NULL.
+ * 
+ * @param[in]  array_p - pointer to array.
+ * @param[in]  size_of - size of each array member.
+ * @param[in]  length  - number of elements in array.
+ * @param[in]  key_p   - search last key from array.
+ * @param[in]  cmp_fp  - comparator function pointer, called as cmp_fp(array member, @key_p).
+ * @param[out] out_p   - copy found value if not NULL.
+ * 
+ * @return: index of last occurrence on success, -1 value on failure.
+ */
+ssize_t darray_raw_sorted_find_last(const void* restrict array_p, size_t size_of, size_t length, const void* restrict key_p, const compare_fp cmp_fp, void* out_p);
+
+
+/*
+ * Function find first occurrence of @key_p in sorted @array_p like darray_raw_sorted_find_first,
+ * but search starts from index @hint (exponential search, O(log d) comparisons for occurrence at distance d).
+ * Value under found index will be copy into @out_p if not NULL.
+ *
+ * @param[in]  array_p - pointer to array.
+ * @param[in]  size_of - size of each array member.
+ * @param[in]  length  - number of elements in array.
+ * @param[in]  key_p   - search first key from array.
+ * @param[in]  cmp_fp  - comparator function pointer.
+ * @param[in]  hint    - expected index of first occurrence.
+ * @param[out] out_p   - copy found value if not NULL.
+ *
+ * @return: index of first occurrence on success, -1 value on failure.
+ */
+ssize_t darray_raw_sorted_find_first_hint(const void* restrict array_p, size_t size_of, size_t length, const void* restrict key_p, const compare_fp cmp_fp, size_t hint, void* out_p);
+
+
+/*
+ * Function find last occurrence of @key_p in sorted @array_p like darray_raw_sorted_find_last,
+ * but search starts from index @hint (exponential search, O(log d) comparisons for occurrence at distance d).
+ * Value under found index will be copy into @out_p if not NULL.
+ *
+ * @param[in]  array_p - pointer to array.
+ * @param[in]  size_of - size of each array member.
+ * @param[in]  length  - number of elements in array.
+ * @param[in]  key_p   - search last key from array.
+ * @param[in]  cmp_fp  - comparator function pointer.
+ * @param[in]  hint    - expected index of last occurrence.
+ * @param[out] out_p   - copy found value if not NULL.
+ *
+ * @return: index of last occurrence on success, -1 value on failure.
+ */
+ssize_t darray_raw_sorted_find_last_hint(const void* restrict array_p, size_t size_of, size_t length, const void* restrict key_p, const compare_fp cmp_fp, size_t hint, void* out_p);
+
+
+/*
+ * Function sort @array_p. 
+ * Insertion-sort will be used for arrays with length smaller than 17 elements. For bigger arrays dual-pivot quick-sort will be used.
+ * Quick-sort falls back to heap-sort after 2 * log2(@length) levels, so worst case is O(n log n).
+ * Unbalanced partitions break input patterns and already partitioned ranges are finished by insertion-sort.
+ * Ranges waiting for sorting are kept in explicit stack, so stack usage is O(log n) regardless of input.
+ * Natural run at the beginning of array is detected first (descending run is reversed): sorted and reverse sorted arrays
+ * cost n - 1 comparisons and sorted array with k unsorted elements appended costs O(n + k log k), when k <= n / 4.
+ * 
+ * @param[in]  array_p - pointer to array.
+ * @param[in]  size_of - size of each array member.
+ * @param[in]  length  - number of elements in array.
+ * @param[in]  cmp_fp  - comparator function pointer.
+ * 
+ * @return: this is void function.
+ */
+void darray_raw_sort(void* array_p, size_t size_of, size_t length, const compare_fp cmp_fp);
+
+
+/*
+ * Type-specialized sort functions generated by DARRAY_RAW_DEFINE_SORT.
+ * They use the same algorithm as darray_raw_sort, but comparison is inlined (operator <) instead of called by pointer.
+ * For float and double arrays with NaN values result order is unspecified.
+ * 
+ * @param[in]  array_p - pointer to array.
+ * @param[in]  length  - number of elements in array.
+ * 
+ * @return: this is void function.
+ */
+DARRAY_RAW_DECLARE_SORT(darray_raw_sort_i8, int8_t);
+DARRAY_RAW_DECLARE_SORT(darray_raw_sort_u8, uint8_t);
+DARRAY_RAW_DECLARE_SORT(darray_raw_sort_i16, int16_t);
+DARRAY_RAW_DECLARE_SORT(darray_raw_sort_u16, uint16_t);
+DARRAY_RAW_DECLARE_SORT(darray_raw_sort_i32, int32_t);
+DARRAY_RAW_DECLARE_SORT(darray_raw_sort_u32, uint32_t);
+DARRAY_RAW_DECLARE_SORT(darray_raw_sort_i64, int64_t);
+DARRAY_RAW_DECLARE_SORT(darray_raw_sort_u64, uint64_t);
+DARRAY_RAW_DECLARE_SORT(darray_raw_sort_float, float);
+DARRAY_RAW_DECLARE_SORT(darray_raw_sort_double, double);
+
+
+/* maximal length of array sorted by sorting network in darray_raw_sort_small family */
+#define DARRAY_RAW_SORT_SMALL_MAX 64
+
+
+/*
+ * Type-specialized sort functions for small arrays of 4- and 8-byte keys.
+ * Arrays up to DARRAY_RAW_SORT_SMALL_MAX elements are sorted by branchless bitonic sorting network vectorized with
+ * SSE4.1, AVX2 or AVX-512 (chosen at program load time). Longer arrays are sorted by darray_raw_sort_<type>.
+ * Type-specialized sorts of these types use sorting network for partitions shorter than DARRAY_RAW_SORT_SMALL_MAX.
+ *
+ * @param[in]  array_p - pointer to array.
+ * @param[in]  length  - number of elements in array.
+ *
+ * @return: this is void function.
+ */
+DARRAY_RAW_DECLARE_SORT(darray_raw_sort_small_i32, int32_t);
+DARRAY_RAW_DECLARE_SORT(darray_raw_sort_small_u32, uint32_t);
+DARRAY_RAW_DECLARE_SORT(darray_raw_sort_small_i64, int64_t);
+DARRAY_RAW_DECLARE_SORT(darray_raw_sort_small_u64, uint64_t);
+DARRAY_RAW_DECLARE_SORT(darray_raw_sort_small_float, float);
+DARRAY_RAW_DECLARE_SORT(darray_raw_sort_small_double, double);
+
+
+/*
+ * Function sort small @array_p of numeric keys by sorting network (see darray_raw_sort_small_<type>).
+ * Whole array member is a key (@size_of has to be 4 or 8). Useful for sorting millions of tiny arrays.
+ *
+ * @param[in]  array_p  - pointer to array.
+ * @param[in]  size_of  - size of each array member.
+ * @param[in]  length   - number of elements in array.
+ * @param[in]  key_type - type of key: unsigned, signed or floating point.
+ *
+ * @return: 0 on success, non-zero value on failure.
+ */
+int darray_raw_sort_small(void* array_p, size_t size_of, size_t length, darray_raw_key_type_e key_type);
+
+
+/*
+ * Function sort @array_p with LSD radix-sort. Whole array member is a key (@size_of has to be 1, 2, 4 or 8).
+ * Sort is stable and makes at most @size_of passes over array. Passes where all keys have the same digit are skipped.
+ * Floating point keys are ordered by IEEE total order (-NaN < -inf < ... < -0.0 < +0.0 < ... < +inf < +NaN).
+ * If @scratch_p is NULL, buffer will be allocated for the time of the call.
+ * 
+ * @param[in]  array_p   - pointer to array.
+ * @param[in]  size_of   - size of each array member.
+ * @param[in]  length    - number of elements in array.
+ * @param[in]  key_type  - type of key: unsigned, signed or floating point.
+ * @param[in]  scratch_p - buffer with at least @size_of * @length bytes or NULL.
+ * 
+ * @return: 0 on success, non-zero value on failure.
+ */
+int darray_raw_radix_sort(void* array_p, size_t size_of, size_t length, darray_raw_key_type_e key_type, void* scratch_p);
+
+
+/*
+ * Function sort @array_p with LSD radix-sort by key placed at @key_offset of each array member.
+ * Sort is stable, so it can be used for multi-pass sorts of records.
+ * If @scratch_p is NULL, buffer will be allocated for the time of the call.
+ * 
+ * @param[in]  array_p    - pointer to array.
+ * @param[in]  size_of    - size of each array member.
+ * @param[in]  length     - number of elements in array.
+ * @param[in]  key_offset - offset of key in bytes inside array member (e.g. offsetof).
+ * @param[in]  key_size   - size of key in bytes (1, 2, 4 or 8).
+ * @param[in]  key_type   - type of key: unsigned, signed or floating point.
+ * @param[in]  scratch_p  - buffer with at least @size_of * @length bytes or NULL.
+ * 
+ * @return: 0 on success, non-zero value on failure.
+ */
+int darray_raw_radix_sort_by_key(void* array_p, size_t size_of, size_t length, size_t key_offset, size_t key_size, darray_raw_key_type_e key_type, void* scratch_p);
+
+
+/*
+ * Function sort @array_p using @nthreads threads.
+ * Parallel in-place samplesort (IPS4o style) is used: elements are classified into buckets by sampled splitters,
+ * moved in place block by block and buckets are sorted in parallel. Additional memory does not depend on @length.
+ * For small arrays darray_raw_sort is used. Comparator has to be thread-safe.
+ * 
+ * @param[in]  array_p  - pointer to array.
+ * @param[in]  size_of  - size of each array member.
+ * @param[in]  length   - number of elements in array.
+ * @param[in]  cmp_fp   - comparator function pointer.
+ * @param[in]  nthreads - number of threads, 0 means number of online processors.
+ * 
+ * @return: 0 on success, non-zero value on failure.
+ */
+int darray_raw_parallel_sort(void* array_p, size_t size_of, size_t length, const compare_fp cmp_fp, size_t nthreads);
+
+
+/*
+ * Function sort @array_p with stable sort (equal elements keep their order), so it can be used for multi-pass sorts of records.
+ * Adaptive merge sort (TimSort) is used: natural runs are detected and merged with galloping, so partially sorted arrays are cheap.
+ * Merges use @scratch_p buffer. When smaller run does not fit in it (or @scratch_p is NULL), runs are merged in place by rotations,
+ * which is slower, but does not allocate memory. Buffer for @length / 2 elements is enough to never merge in place.
+ * 
+ * @param[in]  array_p        - pointer to array.
+ * @param[in]  size_of        - size of each array member.
+ * @param[in]  length         - number of elements in array.
+ * @param[in]  cmp_fp         - comparator function pointer.
+ * @param[in]  scratch_p      - buffer for @scratch_length elements or NULL.
+ * @param[in]  scratch_length - number of elements which fit in @scratch_p.
+ * 
+ * @return: 0 on success, non-zero value on failure.
+ */
+int darray_raw_stable_sort(void* array_p, size_t size_of, size_t length, const compare_fp cmp_fp, void* scratch_p, size_t scratch_length);
+
+
+/*
+ * Function sort indexes of @array_p instead of its members (argsort). Array is not modified.
+ * After call @idx_p[i] is index of i-th smallest element. Sort is stable, so equal elements keep their order.
+ * Useful for big records, because only indexes are moved. Temporary buffer for @length indexes is allocated.
+ *
+ * @param[in]  array_p  - pointer to array.
+ * @param[in]  size_of  - size of each array member.
+ * @param[in]  length   - number of elements in array.
+ * @param[in]  cmp_fp   - comparator function pointer.
+ * @param[out] idx_p    - array for @length indexes.
+ * @param[in]  idx_size - size of each index: sizeof(uint32_t) or sizeof(size_t).
+ *
+ * @return: 0 on success, non-zero value on failure.
+ */
+int darray_raw_argsort(const void* array_p, size_t size_of, size_t length, const compare_fp cmp_fp, void* idx_p, size_t idx_size);
+
+
+/*
+ * Function reorder @array_p in place, so after call i-th member is member which was at index @idx_p[i] (e.g. result of argsort).
+ * Members are moved along cycles of permutation, so each of them is copied once. Bitmap of visited members is allocated.
+ * Array is not modified if @idx_p is not a permutation of [0, @length).
+ *
+ * @param[in]  array_p  - pointer to array.
+ * @param[in]  size_of  - size of each array member.
+ * @param[in]  length   - number of elements in array.
+ * @param[in]  idx_p    - array of @length indexes.
+ * @param[in]  idx_size - size of each index: sizeof(uint32_t) or sizeof(size_t).
+ *
+ * @return: 0 on success, non-zero value on failure.
+ */
+int darray_raw_apply_permutation(void* array_p, size_t size_of, size_t length, const void* idx_p, size_t idx_size);
+
+
+/*
+ * Function sort @keys_p and reorder every payload column in the same way (structure-of-arrays co-sort).
+ * Keys are argsorted once and columns are gathered one after another by sorted indexes with prefetch into temporary column.
+ * Sort is stable. If temporary column cannot be allocated, permutation is applied in place.
+ *
+ * @param[in] keys_p          - pointer to array of keys.
+ * @param[in] key_size        - size of each key.
+ * @param[in] length          - number of elements in each column.
+ * @param[in] cmp_fp          - comparator function pointer for keys.
+ * @param[in] payloads_p      - array of @npayloads payload columns, each with @length elements.
+ * @param[in] payload_sizes_p - size of element of each payload column.
+ * @param[in] npayloads       - number of payload columns (can be 0).
+ *
+ * @return: 0 on success, non-zero value on failure.
+ */
+int darray_raw_sort_by_key(void* keys_p, size_t key_size, size_t length, const compare_fp cmp_fp, void* const* payloads_p, const size_t* payload_sizes_p, size_t npayloads);
+
+
+/*
+ * Function reorder @array_p, so element at @nth is the same as it would be after sorting (nth element / selection).
+ * Elements before @nth are not greater and elements after @nth are not less than it.
+ * Introselect is used: dual-pivot partition step of darray_raw_sort, switched to median of medians
+ * when partitions do not shrink fast enough, so time is O(n) in worst case.
+ *
+ * @param[in] array_p - pointer to array.
+ * @param[in] size_of - size of each array member.
+ * @param[in] length  - number of elements in array.
+ * @param[in] nth     - index of element to select.
+ * @param[in] cmp_fp  - comparator function pointer.
+ *
+ * @return: 0 on success, non-zero value on failure.
+ */
+int darray_raw_nth_element(void* array_p, size_t size_of, size_t length, size_t nth, const compare_fp cmp_fp);
+
+
+/*
+ * Function reorder @array_p, so first @middle elements are the smallest elements in sorted order.
+ * Order of remaining elements is unspecified. Time is O(n + k log k), where k is @middle.
+ *
+ * @param[in] array_p - pointer to array.
+ * @param[in] size_of - size of each array member.
+ * @param[in] length  - number of elements in array.
+ * @param[in] middle  - number of smallest elements to sort (at least 1).
+ * @param[in] cmp_fp  - comparator function pointer.
+ *
+ * @return: 0 on success, non-zero value on failure.
+ */
+int darray_raw_partial_sort(void* array_p, size_t size_of, size_t length, size_t middle, const compare_fp cmp_fp);
+
+
+/*
+ * Function copy @k greatest elements of @array_p into @out_p in descending order. Array is not modified.
+ * Bounded min-heap is built in @out_p, so time is O(n log k) and most of elements cost one comparison.
+ *
+ * @param[in]  array_p - pointer to array.
+ * @param[in]  size_of - size of each array member.
+ * @param[in]  length  - number of elements in array.
+ * @param[in]  k       - number of elements to copy (in range [1, @length]).
+ * @param[in]  cmp_fp  - comparator function pointer.
+ * @param[out] out_p   - array for @k elements.
+ *
+ * @return: 0 on success, non-zero value on failure.
+ */
+int darray_raw_top_k(const void* restrict array_p, size_t size_of, size_t length, size_t k, const compare_fp cmp_fp, void* restrict out_p);
+
+
+/*
+ * Function merge @k sorted arrays into @dst_p with loser tree (log2(k) comparisons per element).
+ * When only two arrays are not empty, they are merged directly with galloping, so very unequal arrays are merged quickly.
+ * Merge is stable: equal elements are written in order of arrays. If @unique, element equal to previous written one is dropped.
+ * @dst_p must not overlap any of input arrays.
+ *
+ * @param[out] dst_p     - output array with space for sum of @lengths_p elements.
+ * @param[in]  srcs_p    - sorted input arrays (array can be NULL if its length is 0).
+ * @param[in]  lengths_p - number of elements in each input array.
+ * @param[in]  k         - number of input arrays.
+ * @param[in]  size_of   - size of each array member.
+ * @param[in]  cmp_fp    - comparator function pointer.
+ * @param[in]  unique    - drop duplicates.
+ *
+ * @return: number of elements written to @dst_p on success, -1 value on failure.
+ */
+ssize_t darray_raw_merge_k(void* restrict dst_p, const void* const* srcs_p, const size_t* lengths_p, size_t k, size_t size_of, const compare_fp cmp_fp, bool unique);
+
+
+/*
+ * Function merge @k sorted arrays into @dst_p like darray_raw_merge_k (without dropping duplicates) using @nthreads threads.
+ * Output is split into equal slices, and inputs are co-ranked (split by binary search) at slice borders,
+ * so each thread merges own parts of inputs into own slice of @dst_p. Comparator has to be thread-safe.
+ *
+ * @param[out] dst_p     - output array with space for sum of @lengths_p elements.
+ * @param[in]  srcs_p    - sorted input arrays (array can be NULL if its length is 0).
+ * @param[in]  lengths_p - number of elements in each input array.
+ * @param[in]  k         - number of input arrays.
+ * @param[in]  size_of   - size of each array member.
+ * @param[in]  cmp_fp    - comparator function pointer.
+ * @param[in]  nthreads  - number of threads, 0 means number of online processors.
+ *
+ * @return: number of elements written to @dst_p on success, -1 value on failure.
+ */
+ssize_t darray_raw_parallel_merge_k(void* restrict dst_p, const void* const* srcs_p, const size_t* lengths_p, size_t k, size_t size_of, const compare_fp cmp_fp, size_t nthreads);
+
+
+/*
+ * Function write elements which are in both sorted arrays to @out_p (elements are taken from @first_p).
+ * Duplicates are handled like in multisets: element is written min(count in first, count in second) times.
+ * Arrays are merged, but after few elements in a row from one array, its run is skipped by exponential search,
+ * so intersection of very short and very long array costs O(short * log(long / short)) comparisons.
+ * Only elements of result are written, so @out_p can be sized by number returned for @out_p == NULL
+ * (min(@first_length, @second_length) elements is always enough).
+ *
+ * @param[in]  first_p       - pointer to first sorted array.
+ * @param[in]  first_length  - number of elements in first array.
+ * @param[in]  second_p      - pointer to second sorted array.
+ * @param[in]  second_length - number of elements in second array.
+ * @param[in]  size_of       - size of each array member.
+ * @param[in]  cmp_fp        - comparator function pointer.
+ * @param[out] out_p         - output array (must not overlap inputs) or NULL to only count elements of result.
+ *
+ * @return: number of elements of result on success, -1 value on failure.
+ */
+ssize_t darray_raw_set_intersect(const void* first_p, size_t first_length, const void* second_p, size_t second_length, size_t size_of, const compare_fp cmp_fp, void* out_p);
+
+
+/*
+ * Function write elements which are in any of sorted arrays to @out_p, result is sorted.
+ * Duplicates are handled like in multisets: element is written max(count in first, count in second) times.
+ * Runs of one array between elements of other array are found by galloping and copied as blocks.
+ * Space for @first_length + @second_length elements in @out_p is enough.
+ *
+ * @param[in]  first_p       - pointer to first sorted array.
+ * @param[in]  first_length  - number of elements in first array.
+ * @param[in]  second_p      - pointer to second sorted array.
+ * @param[in]  second_length - number of elements in second array.
+ * @param[in]  size_of       - size of each array member.
+ * @param[in]  cmp_fp        - comparator function pointer.
+ * @param[out] out_p         - output array (must not overlap inputs) or NULL to only count elements of result.
+ *
+ * @return: number of elements of result on success, -1 value on failure.
+ */
+ssize_t darray_raw_set_union(const void* first_p, size_t first_length, const void* second_p, size_t second_length, size_t size_of, const compare_fp cmp_fp, void* out_p);
+
+
+/*
+ * Function write elements of sorted @first_p which are not in sorted @second_p to @out_p.
+ * Duplicates are handled like in multisets: element is written max(0, count in first - count in second) times.
+ * Runs are found by galloping like in darray_raw_set_intersect. Space for @first_length elements in @out_p is enough.
+ *
+ * @param[in]  first_p       - pointer to first sorted array.
+ * @param[in]  first_length  - number of elements in first array.
+ * @param[in]  second_p      - pointer to second sorted array.
+ * @param[in]  second_length - number of elements in second array.
+ * @param[in]  size_of       - size of each array member.
+ * @param[in]  cmp_fp        - comparator function pointer.
+ * @param[out] out_p         - output array (must not overlap inputs) or NULL to only count elements of result.
+ *
+ * @return: number of elements of result on success, -1 value on failure.
+ */
+ssize_t darray_raw_set_difference(const void* first_p, size_t first_length, const void* second_p, size_t second_length, size_t size_of, const compare_fp cmp_fp, void* out_p);
+
+
+/*
+ * Function write elements which are in exactly one of sorted arrays to @out_p, result is sorted.
+ * Duplicates are handled like in multisets: element is written |count in first - count in second| times.
+ * Runs are found by galloping like in darray_raw_set_intersect. Space for @first_length + @second_length elements is enough.
+ *
+ * @param[in]  first_p       - pointer to first sorted array.
+ * @param[in]  first_length  - number of elements in first array.
+ * @param[in]  second_p      - pointer to second sorted array.
+ * @param[in]  second_length - number of elements in second array.
+ * @param[in]  size_of       - size of each array member.
+ * @param[in]  cmp_fp        - comparator function pointer.
+ * @param[out] out_p         - output array (must not overlap inputs) or NULL to only count elements of result.
+ *
+ * @return: number of elements of result on success, -1 value on failure.
+ */
+ssize_t darray_raw_set_symmetric_difference(const void* first_p, size_t first_length, const void* second_p, size_t second_length, size_t size_of, const compare_fp cmp_fp, void* out_p);
+
+
+/*
+ * Function write elements which are in both strictly increasing (no duplicates) arrays of 4- or 8-byte integer keys
+ * to @out_p. Arrays are walked in blocks (16 or 8 keys) and every key of first block is compared with all keys of
+ * second block by vector instructions (SSE4.1/AVX2/AVX-512 chosen at load time), block with smaller last key is advanced.
+ * When one array is more than 32 times longer, keys of shorter array are found in longer by exponential search.
+ * Space for min(@first_length, @second_length) elements in @out_p is enough.
+ *
+ * @param[in]  first_p       - pointer to first strictly increasing array.
+ * @param[in]  first_length  - number of elements in first array.
+ * @param[in]  second_p      - pointer to second strictly increasing array.
+ * @param[in]  second_length - number of elements in second array.
+ * @param[in]  size_of       - size of each array member (4 or 8).
+ * @param[in]  key_type      - type of key (DARRAY_RAW_KEY_UNSIGNED or DARRAY_RAW_KEY_SIGNED).
+ * @param[out] out_p         - output array (must not overlap inputs) or NULL to only count elements of result.
+ *
+ * @return: number of elements of result on success, -1 value on failure.
+ */
+ssize_t darray_raw_set_intersect_keys(const void* first_p, size_t first_length, const void* second_p, size_t second_length, size_t size_of, darray_raw_key_type_e key_type, void* out_p);
+
+
+/*
+ * Function sort @array_p using normalized key prefixes, for comparators which are expensive (e.g. chase many fields).
+ * @norm_fp writes order-preserving binary prefix of element (@prefix_size bytes compared like memcmp, e.g. big-endian key).
+ * (prefix, index) pairs are sorted with inlined integer comparison and array is permuted once,
+ * @cmp_fp is called only to order elements with equal prefixes. Sort is not stable.
+ *
+ * @param[in] array_p     - pointer to array.
+ * @param[in] size_of     - size of each array member.
+ * @param[in] length      - number of elements in array.
+ * @param[in] prefix_size - size of prefix in bytes (8 or 16).
+ * @param[in] norm_fp     - function which write prefix of element: void norm_fp(const void* elem_p, void* prefix_p).
+ * @param[in] cmp_fp      - comparator function pointer, consistent with prefix order.
+ *
+ * @return: 0 on success, non-zero value on failure.
+ */
+int darray_raw_prefix_sort(void* array_p, size_t size_of, size_t length, size_t prefix_size, const normalize_fp norm_fp, const compare_fp cmp_fp);
+
+
+/*
+ * Function sort file @in_path of records with size @size_of into file @out_path using at most @memory_budget bytes of memory.
+ * Chunks of input are sorted by darray_raw_sort and spilled as runs into unlinked temporary file, then runs are merged
+ * with large sequential reads and writes. Disk I/O runs on separate thread with two blocks per stream, so it overlaps sorting and merging.
+ * @in_path and @out_path can be the same file.
+ *
+ * @param[in] in_path       - path to input file (size has to be multiple of @size_of).
+ * @param[in] out_path      - path to output file, created or truncated.
+ * @param[in] size_of       - size of each record.
+ * @param[in] cmp_fp        - comparator function pointer.
+ * @param[in] memory_budget - memory in bytes used for chunks and I/O blocks (at least 6 * @size_of).
+ * @param[in] tmp_dir       - directory for temporary files, NULL means /tmp.
+ *
+ * @return: 0 on success, non-zero value on failure.
+ */
+int darray_raw_external_sort(const char* in_path, const char* out_path, size_t size_of, const compare_fp cmp_fp, size_t memory_budget, const char* tmp_dir);
+
+
+/*
+ * Function shuffle @array_p.
+ *
+ * @param[in] array_p - pointer to array.
+ * @param[in] size_of - size of each array member.
+ * @param[in] length  - number of elements in array.
  *
  * @return: this is void function.
  */
@@ -502,4 +1563,64 @@ bool darray_raw_is_sorted(const void* array_p, size_t size_of, size_t length, co
 bool darray_raw_is_reverse_sorted(const void* array_p, size_t size_of, size_t length, const compare_fp cmp_fp);
 
 
+/*
+ * Function find minimum value from @array_p like darray_raw_find_min, but with batch comparator.
+ * Comparator is called for blocks of elements, which amortize indirect call and let comparator use SIMD.
+ * Minima are kept per lane of block and reduced pairwise at the end, so comparator is called about length / 128 times
+ * for any input order.
+ * Value under found index will be copy into @out_p if not NULL.
+ *
+ * @param[in]  array_p - pointer to array.
+ * @param[in]  size_of - size of each array member.
+ * @param[in]  length  - number of elements in array.
+ * @param[in]  cmp_fp  - batch comparator function pointer.
+ * @param[out] out_p   - copy found value if not NULL.
+ *
+ * @return: minimum value index on success, -1 value on failure.
+ */
+ssize_t darray_raw_find_min_batch(const void* array_p, size_t size_of, size_t length, const compare_batch_fp cmp_fp, void* out_p);
+
+
+/*
+ * Function find first occurrence of @key_p in unsorted @array_p like darray_raw_unsorted_find_first, but with batch comparator.
+ * Value under found index will be copy into @out_p if not NULL.
+ *
+ * @param[in]  array_p - pointer to array.
+ * @param[in]  size_of - size of each array member.
+ * @param[in]  length  - number of elements in array.
+ * @param[in]  key_p   - search first key from array.
+ * @param[in]  cmp_fp  - batch comparator function pointer (array elements are first, key is second with stride 0).
+ * @param[out] out_p   - copy found value if not NULL.
+ *
+ * @return: index of first occurrence on success, -1 value on failure.
+ */
+ssize_t darray_raw_unsorted_find_first_batch(const void* restrict array_p, size_t size_of, size_t length, const void* restrict key_p, const compare_batch_fp cmp_fp, void* out_p);
+
+
+/*
+ * Function check if @first_array_p and @second_array_p are equals like darray_raw_equal, but with batch comparator.
+ *
+ * @param[in] first_array_p  - pointer to first array to compare.
+ * @param[in] second_array_p - pointer to second array to compare.
+ * @param[in] size_of        - size of each array member.
+ * @param[in] length         - number of elements in array.
+ * @param[in] cmp_fp         - batch comparator function pointer.
+ *
+ * @return: true if @first_array_p and @second_array_p are equals, false if not.
+ */
+bool darray_raw_equal_batch(const void* first_array_p, const void* second_array_p, size_t size_of, size_t length, const compare_batch_fp cmp_fp);
+
+
+/*
+ * Function check if @array_p is sorted like darray_raw_is_sorted, but with batch comparator.
+ *
+ * @param[in] array_p - pointer to array.
+ * @param[in] size_of - size of each array member.
+ * @param[in] length  - number of elements in array.
+ * @param[in] cmp_fp  - batch comparator function pointer.
+ *
+ * @return: true if @array_p is sorted, false if @array_p is not sorted.
+ */
+bool darray_raw_is_sorted_batch(const void* array_p, size_t size_of, size_t length, const compare_batch_fp cmp_fp);
+
 #endif /* DARRAY_RAW_H */
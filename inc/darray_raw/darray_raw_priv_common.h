@@ -24,10 +24,38 @@
 typedef int (*compare_fp)(const void*, const void*);
 
 
+/*
+ * typedef for batch comparator function: out_p[i] = sign of compare(first_p + i * first_stride, second_p + i * second_stride)
+ * for i in [0, n). Stride 0 compares every element with the same value.
+ */
+typedef void (*compare_batch_fp)(const void* first_p, size_t first_stride, const void* second_p, size_t second_stride, size_t n, int8_t* out_p);
+
+
 /* typedef for destructor function */
 typedef void (*destructor_fp)(void*);
 
 
+/* typedef for function which write order-preserving binary prefix of key (compared like memcmp) */
+typedef void (*normalize_fp)(const void*, void*);
+
+
+/* typedef for function which map key to number, not decreasing in comparator order (used by interpolation search) */
+typedef double (*number_fp)(const void*);
+
+
+/* typedef for function which hash key to 64-bit value, equal keys have equal hashes (used by membership filter) */
+typedef uint64_t (*hasher_fp)(const void*);
+
+
+/* enum for type of key used by radix-sort family */
+typedef enum darray_raw_key_type_e
+{
+    DARRAY_RAW_KEY_UNSIGNED,
+    DARRAY_RAW_KEY_SIGNED,
+    DARRAY_RAW_KEY_FLOAT,
+} darray_raw_key_type_e;
+
+
 /* functionlike macro for getting length of arrays allocated on stack */
 #define array_size(array) (sizeof(array) / sizeof((array)[0]))
 
@@ -92,4 +120,22 @@ typedef void (*destructor_fp)(void*);
 void* darray_raw_create_and_init(size_t size_of, size_t length, const void* array_p);
 
 
+/*
+ * Internal functions which sort @array_p by sorting network without checking arguments.
+ * They are leaves of type-specialized sorts, where partitions may be empty.
+ * Declarations have been moved to private header to hide them from user.
+ *
+ * @param[in] array_p - pointer to array.
+ * @param[in] length  - number of elements in array, in range [0, DARRAY_RAW_SORT_SMALL_MAX].
+ *
+ * @return nothing.
+ */
+void __darray_raw_network_i32(int32_t* array_p, size_t length);
+void __darray_raw_network_u32(uint32_t* array_p, size_t length);
+void __darray_raw_network_float(float* array_p, size_t length);
+void __darray_raw_network_i64(int64_t* array_p, size_t length);
+void __darray_raw_network_u64(uint64_t* array_p, size_t length);
+void __darray_raw_network_double(double* array_p, size_t length);
+
+
 #endif /* DARRAY_RAW_PRIV_COMMON_H */
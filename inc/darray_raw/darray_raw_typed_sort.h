@@ -0,0 +1,401 @@
+#ifndef DARRAY_RAW_TYPED_SORT_H
+#define DARRAY_RAW_TYPED_SORT_H
+
+
+/*
+    This is the header with type-specialized sort generators for DArrayRaw library.
+
+
+    Author: Kamil Kielbasa
+    Email: kamilkielbasa64@gmail.com
+    License: GPL3
+
+
+    Generated functions implement the same algorithm as darray_raw_sort (dual-pivot quick-sort with
+    insertion-sort for small partitions and heap-sort when recursion goes too deep), but element type
+    is known at compile time and comparison is plain expression instead of comparator function pointer.
+    Thanks to that compiler can inline comparison, keep keys in registers and vectorize moves.
+
+    Usage:
+    * in header:      DARRAY_RAW_DECLARE_SORT(my_sort, MyType);
+    * in source file: DARRAY_RAW_DEFINE_SORT(my_sort, MyType, a.key < b.key)
+
+    DARRAY_RAW_DEFINE_SORT_WITH_LEAF additionally replaces insertion-sort of small partitions with own function.
+
+    DARRAY_RAW_DEFINE_LOWER_BOUND and DARRAY_RAW_DEFINE_UPPER_BOUND generate binary search with the same algorithm
+    as darray_raw_lower_bound (no branch on comparison, prefetch of next level), but key is passed by value.
+
+    @less_expr is an expression which uses two constant values of @type named a and b.
+    It has to return true when a is strictly less than b. If expression contains commas, wrap it in parentheses.
+*/
+
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+
+/*
+ * Functionlike macro which declare type-specialized sort function.
+ *
+ * @param[in] name - name of generated function.
+ * @param[in] type - type of each array member.
+ *
+ * @return nothing.
+ */
+#define DARRAY_RAW_DECLARE_SORT(name, type) \
+    void name(type* array_p, size_t length)
+
+
+/*
+ * Functionlike macro which define type-specialized sort function: void name(type* array_p, size_t length).
+ * Function has to be declared earlier by DARRAY_RAW_DECLARE_SORT.
+ *
+ * @param[in] name      - name of generated function.
+ * @param[in] type      - type of each array member.
+ * @param[in] less_expr - expression on values a and b, true if a is less than b.
+ *
+ * @return nothing.
+ */
+#define DARRAY_RAW_DEFINE_SORT(name, type, less_expr) \
+    DARRAY_RAW_DEFINE_SORT_WITH_LEAF(name, type, less_expr, 17, name##_priv_insertion_sort)
+
+
+/*
+ * Functionlike macro which define type-specialized sort function like DARRAY_RAW_DEFINE_SORT,
+ * but partitions shorter than @leaf_size are sorted by @leaf_fn instead of insertion-sort (e.g. by sorting network).
+ *
+ * @param[in] name      - name of generated function.
+ * @param[in] type      - type of each array member.
+ * @param[in] less_expr - expression on values a and b, true if a is less than b.
+ * @param[in] leaf_size - partitions shorter than this are sorted by @leaf_fn (at least 17).
+ * @param[in] leaf_fn   - function void leaf_fn(type* array_p, size_t length) which sort small partitions
+ *                        (called with length in range [2, @leaf_size - 1]).
+ *
+ * @return nothing.
+ */
+#define DARRAY_RAW_DEFINE_SORT_WITH_LEAF(name, type, less_expr, leaf_size, leaf_fn) \
+    static inline bool name##_priv_less(const type a, const type b) \
+    { \
+        return (less_expr); \
+    } \
+    \
+    static inline void name##_priv_insertion_sort(type* const array_p, const size_t length) \
+    { \
+        for (size_t i = 1; i < length; ++i) \
+        { \
+            const type tmp = array_p[i]; \
+            size_t j = i; \
+            \
+            for (; j > 0 && name##_priv_less(tmp, array_p[j - 1]); --j) \
+            { \
+                array_p[j] = array_p[j - 1]; \
+            } \
+            \
+            array_p[j] = tmp; \
+        } \
+    } \
+    \
+    static inline void name##_priv_cswap(type* const restrict first_p, type* const restrict second_p) \
+    { \
+        if (name##_priv_less(*second_p, *first_p)) \
+        { \
+            const type tmp = *first_p; \
+            *first_p = *second_p; \
+            *second_p = tmp; \
+        } \
+    } \
+    \
+    static void name##_priv_sift_down(type* const array_p, const size_t length, size_t root) \
+    { \
+        const type tmp = array_p[root]; \
+        \
+        for (size_t child = 2 * root + 1; child < length; child = 2 * root + 1) \
+        { \
+            if (child + 1 < length && name##_priv_less(array_p[child], array_p[child + 1])) \
+            { \
+                child++; \
+            } \
+            \
+            if (!name##_priv_less(tmp, array_p[child])) \
+            { \
+                break; \
+            } \
+            \
+            array_p[root] = array_p[child]; \
+            root = child; \
+        } \
+        \
+        array_p[root] = tmp; \
+    } \
+    \
+    static void name##_priv_heap_sort(type* const array_p, const size_t length) \
+    { \
+        for (size_t i = length / 2; i > 0; --i) \
+        { \
+            name##_priv_sift_down(array_p, length, i - 1); \
+        } \
+        \
+        for (size_t end = length - 1; end > 0; --end) \
+        { \
+            const type tmp = array_p[0]; \
+            array_p[0] = array_p[end]; \
+            array_p[end] = tmp; \
+            name##_priv_sift_down(array_p, end, 0); \
+        } \
+    } \
+    \
+    static void name##_priv_sort(type* const array_p, const size_t length, const size_t depth_limit) \
+    { \
+        const size_t dist_size = 13; \
+        const size_t tiny_size = (leaf_size); \
+        \
+        if (length >= tiny_size && depth_limit == 0) \
+        { \
+            name##_priv_heap_sort(array_p, length); \
+            return; \
+        } \
+        \
+        if (length < tiny_size) \
+        { \
+            /* empty and one element partitions are sorted already */ \
+            if (length > 1) \
+            { \
+                leaf_fn(array_p, length); \
+            } \
+            \
+            return; \
+        } \
+        \
+        const size_t right_idx = length - 1; \
+        const size_t sixth = length / 6; \
+        const size_t m1 = sixth; \
+        const size_t m2 = m1 + sixth; \
+        const size_t m3 = m2 + sixth; \
+        const size_t m4 = m3 + sixth; \
+        const size_t m5 = m4 + sixth; \
+        \
+        name##_priv_cswap(&array_p[m1], &array_p[m2]); \
+        name##_priv_cswap(&array_p[m4], &array_p[m5]); \
+        name##_priv_cswap(&array_p[m1], &array_p[m3]); \
+        name##_priv_cswap(&array_p[m2], &array_p[m3]); \
+        name##_priv_cswap(&array_p[m1], &array_p[m4]); \
+        name##_priv_cswap(&array_p[m3], &array_p[m4]); \
+        name##_priv_cswap(&array_p[m2], &array_p[m5]); \
+        name##_priv_cswap(&array_p[m2], &array_p[m3]); \
+        name##_priv_cswap(&array_p[m4], &array_p[m5]); \
+        \
+        const type first_pivot = array_p[m2]; \
+        const type second_pivot = array_p[m4]; \
+        const bool diff_pivots = name##_priv_less(first_pivot, second_pivot); \
+        \
+        array_p[m2] = array_p[0]; \
+        array_p[m4] = array_p[right_idx]; \
+        \
+        size_t less_idx = 1; \
+        size_t great_idx = right_idx - 1; \
+        \
+        for (size_t k = less_idx; k <= great_idx; k++) \
+        { \
+            type tmp = array_p[k]; \
+            \
+            if (name##_priv_less(tmp, first_pivot)) \
+            { \
+                array_p[k] = array_p[less_idx]; \
+                array_p[less_idx] = tmp; \
+                less_idx++; \
+            } \
+            else if (name##_priv_less(second_pivot, tmp)) \
+            { \
+                while (name##_priv_less(second_pivot, array_p[great_idx]) && k < great_idx) \
+                { \
+                    great_idx--; \
+                } \
+                \
+                array_p[k] = array_p[great_idx]; \
+                array_p[great_idx] = tmp; \
+                tmp = array_p[k]; \
+                great_idx--; \
+                \
+                if (name##_priv_less(tmp, first_pivot)) \
+                { \
+                    array_p[k] = array_p[less_idx]; \
+                    array_p[less_idx] = tmp; \
+                    less_idx++; \
+                } \
+            } \
+        } \
+        \
+        array_p[0] = array_p[less_idx - 1]; \
+        array_p[less_idx - 1] = first_pivot; \
+        \
+        array_p[right_idx] = array_p[great_idx + 1]; \
+        array_p[great_idx + 1] = second_pivot; \
+        \
+        name##_priv_sort(&array_p[0], less_idx - 1, depth_limit - 1); \
+        name##_priv_sort(&array_p[great_idx + 2], right_idx - great_idx - 1, depth_limit - 1); \
+        \
+        if (!diff_pivots || less_idx > great_idx) \
+        { \
+            return; \
+        } \
+        \
+        if (great_idx - less_idx > length - dist_size) \
+        { \
+            for (size_t k = less_idx; k <= great_idx; k++) \
+            { \
+                type tmp = array_p[k]; \
+                \
+                if (!name##_priv_less(first_pivot, tmp)) \
+                { \
+                    array_p[k] = array_p[less_idx]; \
+                    array_p[less_idx] = tmp; \
+                    less_idx++; \
+                } \
+                else if (!name##_priv_less(tmp, second_pivot)) \
+                { \
+                    array_p[k] = array_p[great_idx]; \
+                    array_p[great_idx] = tmp; \
+                    tmp = array_p[k]; \
+                    great_idx--; \
+                    \
+                    if (!name##_priv_less(first_pivot, tmp)) \
+                    { \
+                        array_p[k] = array_p[less_idx]; \
+                        array_p[less_idx] = tmp; \
+                        less_idx++; \
+                    } \
+                } \
+            } \
+        } \
+        \
+        if (less_idx <= great_idx) \
+        { \
+            name##_priv_sort(&array_p[less_idx], great_idx - less_idx + 1, depth_limit - 1); \
+        } \
+    } \
+    \
+    void name(type* const array_p, const size_t length) \
+    { \
+        if (array_p == NULL) \
+        { \
+            perror("DArrayRaw: argument array_p is NULL\n"); \
+            return; \
+        } \
+        \
+        if (length == 0) \
+        { \
+            perror("DArrayRaw: argument length has to small value\n"); \
+            return; \
+        } \
+        \
+        /* depth limit 2 * log2(length) guarantees O(n log n) time and O(log n) stack frames */ \
+        size_t depth_limit = 0; \
+        \
+        for (size_t n = length; n > 1; n >>= 1) \
+        { \
+            depth_limit += 2; \
+        } \
+        \
+        name##_priv_sort(array_p, length, depth_limit); \
+    }
+
+
+
+/*
+ * Functionlike macro which declare type-specialized lower or upper bound function.
+ *
+ * @param[in] name - name of generated function.
+ * @param[in] type - type of each array member.
+ *
+ * @return nothing.
+ */
+#define DARRAY_RAW_DECLARE_BOUND(name, type) \
+    ssize_t name(const type* array_p, size_t length, type key)
+
+
+/*
+ * Functionlike macro which define type-specialized bound function: ssize_t name(const type* array_p, size_t length, type key).
+ * Range is kept as base pointer and length, so base is moved by multiplication with comparison result instead of branch,
+ * and both candidates of next level are prefetched.
+ *
+ * @param[in] name      - name of generated function.
+ * @param[in] type      - type of each array member.
+ * @param[in] less_expr - expression on values a and b, true if a is less than b.
+ * @param[in] upper     - true for upper bound, false for lower bound.
+ *
+ * @return nothing.
+ */
+#define DARRAY_RAW_DEFINE_BOUND(name, type, less_expr, upper) \
+    static inline bool name##_priv_less(const type a, const type b) \
+    { \
+        return (less_expr); \
+    } \
+    \
+    /* 1 when search goes right: lower bound when member < key, upper bound when !(key < member) */ \
+    static inline size_t name##_priv_go_right(const type member, const type key) \
+    { \
+        return (upper) ? !name##_priv_less(key, member) : name##_priv_less(member, key); \
+    } \
+    \
+    ssize_t name(const type* const array_p, const size_t length, const type key) \
+    { \
+        if (array_p == NULL) \
+        { \
+            perror("DArrayRaw: argument array_p is NULL\n"); \
+            return -1; \
+        } \
+        \
+        if (length == 0) \
+        { \
+            perror("DArrayRaw: argument length has to small value\n"); \
+            return -1; \
+        } \
+        \
+        const type* base_p = array_p; \
+        size_t len = length; \
+        \
+        while (len > 1) \
+        { \
+            const size_t half = len / 2; \
+            const size_t next_half = (len - half) / 2; \
+            \
+            __builtin_prefetch(&base_p[next_half], 0, 3); \
+            __builtin_prefetch(&base_p[half + next_half], 0, 3); \
+            \
+            base_p += name##_priv_go_right(base_p[half - 1], key) * half; \
+            len -= half; \
+        } \
+        \
+        return (ssize_t)((size_t)(base_p - array_p) + name##_priv_go_right(*base_p, key)); \
+    }
+
+
+/*
+ * Functionlike macro which define type-specialized lower bound function: ssize_t name(const type* array_p, size_t length, type key).
+ * Function has to be declared earlier by DARRAY_RAW_DECLARE_BOUND.
+ *
+ * @param[in] name      - name of generated function.
+ * @param[in] type      - type of each array member.
+ * @param[in] less_expr - expression on values a and b, true if a is less than b.
+ *
+ * @return nothing.
+ */
+#define DARRAY_RAW_DEFINE_LOWER_BOUND(name, type, less_expr) \
+    DARRAY_RAW_DEFINE_BOUND(name, type, less_expr, false)
+
+
+/*
+ * Functionlike macro which define type-specialized upper bound function: ssize_t name(const type* array_p, size_t length, type key).
+ * Function has to be declared earlier by DARRAY_RAW_DECLARE_BOUND.
+ *
+ * @param[in] name      - name of generated function.
+ * @param[in] type      - type of each array member.
+ * @param[in] less_expr - expression on values a and b, true if a is less than b.
+ *
+ * @return nothing.
+ */
+#define DARRAY_RAW_DEFINE_UPPER_BOUND(name, type, less_expr) \
+    DARRAY_RAW_DEFINE_BOUND(name, type, less_expr, true)
+
+#endif /* DARRAY_RAW_TYPED_SORT_H */
@@ -4,6 +4,15 @@
 #include <string.h>
 
 
+/* range of array waiting for sorting in explicit stack of darray_raw_sort */
+typedef struct DArrayRawSortRangeS
+{
+    size_t left_idx;
+    size_t length;
+    size_t depth_limit;
+} DArrayRawSortRangeS;
+
+
 /*
  * Internal function which insert @data_p at @pos of @array_p.
  * 
@@ -45,6 +54,405 @@ static inline int __darray_raw_delete_pos(void* array_p, size_t size_of, size_t
 static inline int __darray_raw_delete_pos_with_entry(void* array_p, size_t size_of, size_t length, size_t pos, const destructor_fp destroy_fp);
 
 
+/*
+ * Internal function which convert key under @key_p into unsigned value with the same order.
+ * Signed integers have flipped sign bit. IEEE floats have flipped sign bit when positive and all bits when negative.
+ * 
+ * @param[in] key_p    - pointer to key.
+ * @param[in] key_size - size of key in bytes (1, 2, 4 or 8).
+ * @param[in] key_type - type of key.
+ * 
+ * @return: unsigned value with the same order as key.
+ */
+static inline uint64_t __darray_raw_radix_key(const void* key_p, size_t key_size, darray_raw_key_type_e key_type);
+
+
+/*
+ * Internal function which sort @array_p by key stored at @key_offset of each array member.
+ * LSD radix-sort with 8-bit digits is used. Passes where all keys have the same digit are skipped.
+ * 
+ * @param[in] array_p    - pointer to array.
+ * @param[in] size_of    - size of each array member.
+ * @param[in] length     - number of elements in array.
+ * @param[in] key_offset - offset of key in bytes inside array member.
+ * @param[in] key_size   - size of key in bytes (1, 2, 4 or 8).
+ * @param[in] key_type   - type of key.
+ * @param[in] scratch_p  - buffer with at least @size_of * @length bytes or NULL.
+ * 
+ * @return: 0 on success, non-zero value on failure.
+ */
+static inline int __darray_raw_radix_sort(void* array_p, size_t size_of, size_t length, size_t key_offset, size_t key_size, darray_raw_key_type_e key_type, void* scratch_p);
+
+
+/*
+ * Internal function which sort @array_p by insertion-sort.
+ * 
+ * @param[in] array_p - pointer to array.
+ * @param[in] size_of - size of each array member.
+ * @param[in] length  - number of elements in array.
+ * @param[in] cmp_fp  - comparator function pointer.
+ * 
+ * @return: this is void function.
+ */
+static inline void __darray_raw_insertion_sort(uint8_t* array_p, size_t size_of, size_t length, compare_fp cmp_fp);
+
+
+/*
+ * Internal function which try to sort @array_p by insertion-sort, but give up after few moves of elements.
+ * 
+ * @param[in] array_p - pointer to array.
+ * @param[in] size_of - size of each array member.
+ * @param[in] length  - number of elements in array.
+ * @param[in] cmp_fp  - comparator function pointer.
+ * 
+ * @return: true if @array_p is sorted, false if limit of moves was exceeded.
+ */
+static inline bool __darray_raw_partial_insertion_sort(uint8_t* array_p, size_t size_of, size_t length, compare_fp cmp_fp);
+
+
+/*
+ * Internal function which move element @root down the binary max-heap @array_p until heap property is restored.
+ * 
+ * @param[in] array_p - pointer to array.
+ * @param[in] size_of - size of each array member.
+ * @param[in] length  - number of elements in heap.
+ * @param[in] root    - index of element to move down.
+ * @param[in] cmp_fp  - comparator function pointer.
+ * 
+ * @return: this is void function.
+ */
+static inline void __darray_raw_heap_sift_down(uint8_t* array_p, size_t size_of, size_t length, size_t root, compare_fp cmp_fp);
+
+
+/*
+ * Internal function which sort @array_p by heap-sort. Used when quick-sort goes too deep.
+ * 
+ * @param[in] array_p - pointer to array.
+ * @param[in] size_of - size of each array member.
+ * @param[in] length  - number of elements in array.
+ * @param[in] cmp_fp  - comparator function pointer.
+ * 
+ * @return: this is void function.
+ */
+static inline void __darray_raw_heap_sort(uint8_t* array_p, size_t size_of, size_t length, compare_fp cmp_fp);
+
+
+/*
+ * Internal function which partition @array_p (at least 17 elements) by two pivots chosen from five evenly spaced elements.
+ * After call elements [0, @less_idx - 1) are less than first pivot, element @less_idx - 1 is first pivot,
+ * elements [@less_idx, @great_idx] are between pivots, element @great_idx + 1 is second pivot
+ * and elements (@great_idx + 1, @length) are greater than second pivot.
+ * If pivots are equal, middle part contains only elements equal to pivots and does not need sorting.
+ * 
+ * @param[in]  array_p       - pointer to array.
+ * @param[in]  size_of       - size of each array member.
+ * @param[in]  length        - number of elements in array.
+ * @param[in]  cmp_fp        - comparator function pointer.
+ * @param[out] less_idx_p    - first index of middle part.
+ * @param[out] great_idx_p   - last index of middle part (@less_idx - 1 if middle part is empty).
+ * @param[out] diff_pivots_p - true if pivots are different.
+ * 
+ * @return: true if no element had to be moved (array was already partitioned), false otherwise.
+ */
+static inline bool __darray_raw_dual_pivot_partition(uint8_t* array_p, size_t size_of, size_t length, compare_fp cmp_fp, 
+                                                     size_t* less_idx_p, size_t* great_idx_p, bool* diff_pivots_p);
+
+
+/*
+ * Internal function which merge sorted @array_p [0, @prefix_length) with sorted tail [@prefix_length, @length).
+ * Tail is copied into @buffer_p and merged from the back. Position of each tail element is found by exponential search,
+ * so merge costs O(k log(n / k)) comparisons and every prefix element is moved at most once.
+ * 
+ * @param[in] array_p       - pointer to array.
+ * @param[in] size_of       - size of each array member.
+ * @param[in] length        - number of elements in array.
+ * @param[in] prefix_length - number of elements in sorted prefix.
+ * @param[in] cmp_fp        - comparator function pointer.
+ * @param[in] buffer_p      - buffer for (@length - @prefix_length) elements.
+ * 
+ * @return: this is void function.
+ */
+static inline void __darray_raw_merge_tail(uint8_t* array_p, size_t size_of, size_t length, size_t prefix_length, compare_fp cmp_fp, uint8_t* buffer_p);
+
+
+/*
+ * Internal function which try to sort @array_p by natural run found at the beginning of array.
+ * Descending run is reversed. If the run covers whole array nothing else is done (n - 1 comparisons).
+ * If the rest of array is short, it is sorted separately and merged with the run.
+ * 
+ * @param[in] array_p - pointer to array.
+ * @param[in] size_of - size of each array member.
+ * @param[in] length  - number of elements in array.
+ * @param[in] cmp_fp  - comparator function pointer.
+ * 
+ * @return: true if @array_p is sorted, false if it still has to be sorted.
+ */
+static inline bool __darray_raw_sort_adaptive(uint8_t* array_p, size_t size_of, size_t length, compare_fp cmp_fp);
+
+
+/*
+ * Internal function which move element @root down the binary min-heap @array_p until heap property is restored.
+ * 
+ * @param[in] array_p - pointer to array.
+ * @param[in] size_of - size of each array member.
+ * @param[in] length  - number of elements in heap.
+ * @param[in] root    - index of element to move down.
+ * @param[in] cmp_fp  - comparator function pointer.
+ * 
+ * @return: this is void function.
+ */
+static inline void __darray_raw_min_heap_sift_down(uint8_t* array_p, size_t size_of, size_t length, size_t root, compare_fp cmp_fp);
+
+
+/*
+ * Internal function which partition @array_p (at least 17 elements) around median of medians of groups of five.
+ * After call elements [0, @lt) are less than pivot, elements [@lt, @gt) are equal to pivot and elements [@gt, @length) are greater.
+ * Pivot is guaranteed to have at least 30% of elements on both sides, so selection with this partition is linear.
+ * 
+ * @param[in]  array_p - pointer to array.
+ * @param[in]  size_of - size of each array member.
+ * @param[in]  length  - number of elements in array.
+ * @param[in]  cmp_fp  - comparator function pointer.
+ * @param[out] lt_p    - first index of elements equal to pivot.
+ * @param[out] gt_p    - first index of elements greater than pivot.
+ * 
+ * @return: this is void function.
+ */
+static void __darray_raw_median_of_medians_partition(uint8_t* array_p, size_t size_of, size_t length, compare_fp cmp_fp, size_t* lt_p, size_t* gt_p);
+
+
+/*
+ * Internal function which move @nth smallest element of @array_p to index @nth (introselect).
+ * Dual-pivot partition is used while range shrinks at least twice every two steps, then median of medians partition.
+ * 
+ * @param[in] array_p     - pointer to array.
+ * @param[in] size_of     - size of each array member.
+ * @param[in] length      - number of elements in array.
+ * @param[in] nth         - index of element to select.
+ * @param[in] cmp_fp      - comparator function pointer.
+ * @param[in] linear_only - true if only median of medians partition has to be used.
+ * 
+ * @return: this is void function.
+ */
+static void __darray_raw_select(uint8_t* array_p, size_t size_of, size_t length, size_t nth, compare_fp cmp_fp, bool linear_only);
+
+
+/*
+ * Internal function which check if bound of @data_p is after @member_p (for lower bound @data_p > @member_p,
+ * for upper bound @data_p >= @member_p).
+ *
+ * @param[in] member_p     - pointer to array member.
+ * @param[in] data_p       - searched value.
+ * @param[in] cmp_fp       - comparator function pointer.
+ * @param[in] upper        - search upper bound instead of lower bound.
+ * @param[in] member_first - call comparator as cmp_fp(@member_p, @data_p) instead of cmp_fp(@data_p, @member_p).
+ *
+ * @return: 1 if bound is after @member_p, 0 otherwise.
+ */
+static inline size_t __darray_raw_bound_after(const void* member_p, const void* data_p, compare_fp cmp_fp, bool upper, bool member_first);
+
+
+/*
+ * Internal function which get lower bound (@upper is false) or upper bound (@upper is true) of @data_p from @array_p.
+ * Search keeps base index and length of remaining range, so there are no divisions by @size_of, and base is moved
+ * by multiplication with comparison result instead of branch. Both candidates of next level are prefetched.
+ *
+ * @param[in] barray_p     - pointer to array.
+ * @param[in] size_of      - size of each array member.
+ * @param[in] length       - number of elements in array (at least 1).
+ * @param[in] data_p       - searched value.
+ * @param[in] cmp_fp       - comparator function pointer.
+ * @param[in] upper        - search upper bound instead of lower bound.
+ * @param[in] member_first - call comparator as cmp_fp(array member, data_p) instead of cmp_fp(data_p, array member).
+ *
+ * @return: bound index.
+ */
+static inline size_t __darray_raw_bound(const uint8_t* restrict barray_p, size_t size_of, size_t length, const void* restrict data_p, compare_fp cmp_fp,
+                                        bool upper, bool member_first);
+
+
+/*
+ * Internal function which call __darray_raw_bound with constant @size_of for 4- and 8-byte array members,
+ * so offsets are computed by shifts.
+ *
+ * @param[in] barray_p     - pointer to array.
+ * @param[in] size_of      - size of each array member.
+ * @param[in] length       - number of elements in array (at least 1).
+ * @param[in] data_p       - searched value.
+ * @param[in] cmp_fp       - comparator function pointer.
+ * @param[in] upper        - search upper bound instead of lower bound.
+ * @param[in] member_first - call comparator as cmp_fp(array member, data_p) instead of cmp_fp(data_p, array member).
+ *
+ * @return: bound index.
+ */
+static size_t __darray_raw_bound_dispatch(const uint8_t* restrict barray_p, size_t size_of, size_t length, const void* restrict data_p, compare_fp cmp_fp,
+                                          bool upper, bool member_first);
+
+
+/*
+ * Internal function which get lower bound (@upper is false) or upper bound (@upper is true) of @data_p from @array_p
+ * starting at index @hint. Range of bound is found by exponential (galloping) search outward from @hint, then it is
+ * searched by __darray_raw_bound_dispatch, so bound at distance d from @hint needs O(log d) comparisons.
+ *
+ * @param[in] barray_p     - pointer to array.
+ * @param[in] size_of      - size of each array member.
+ * @param[in] length       - number of elements in array (at least 1).
+ * @param[in] data_p       - searched value.
+ * @param[in] cmp_fp       - comparator function pointer.
+ * @param[in] upper        - search upper bound instead of lower bound.
+ * @param[in] member_first - call comparator as cmp_fp(array member, data_p) instead of cmp_fp(data_p, array member).
+ * @param[in] hint         - expected bound index (values greater than @length are treated as @length).
+ *
+ * @return: bound index.
+ */
+static size_t __darray_raw_bound_hint(const uint8_t* restrict barray_p, size_t size_of, size_t length, const void* restrict data_p, compare_fp cmp_fp,
+                                      bool upper, bool member_first, size_t hint);
+
+
+/*
+ * Internal function which check arguments of hinted searches.
+ *
+ * @param[in] array_p - pointer to array.
+ * @param[in] size_of - size of each array member.
+ * @param[in] length  - number of elements in array.
+ * @param[in] data_p  - searched value.
+ * @param[in] cmp_fp  - comparator function pointer.
+ *
+ * @return: 0 on success, -1 on failure.
+ */
+static int __darray_raw_hint_check(const void* array_p, size_t size_of, size_t length, const void* data_p, compare_fp cmp_fp);
+
+
+static inline size_t __darray_raw_bound_after(const void* const member_p, const void* const data_p, const compare_fp cmp_fp, const bool upper,
+                                            const bool member_first)
+{
+    if (member_first)
+    {
+        return (size_t)(upper ? cmp_fp(member_p, data_p) <= 0 : cmp_fp(member_p, data_p) < 0);
+    }
+
+    return (size_t)(upper ? cmp_fp(data_p, member_p) >= 0 : cmp_fp(data_p, member_p) > 0);
+}
+
+
+static inline size_t __darray_raw_bound(const uint8_t* const restrict barray_p, const size_t size_of, const size_t length, const void* const restrict data_p,
+                                        const compare_fp cmp_fp, const bool upper, const bool member_first)
+{
+    /* for lower bound go right when data > member, for upper bound when data >= member */
+    register size_t base = 0;
+    register size_t len = length;
+
+    while (len > 1)
+    {
+        register const size_t half = len / 2;
+        register const size_t next_half = (len - half) / 2;
+
+        __builtin_prefetch(&barray_p[(base + next_half) * size_of], 0, 3);
+        __builtin_prefetch(&barray_p[(base + half + next_half) * size_of], 0, 3);
+
+        base += __darray_raw_bound_after(&barray_p[(base + half - 1) * size_of], data_p, cmp_fp, upper, member_first) * half;
+        len -= half;
+    }
+
+    return base + __darray_raw_bound_after(&barray_p[base * size_of], data_p, cmp_fp, upper, member_first);
+}
+
+
+static size_t __darray_raw_bound_dispatch(const uint8_t* const restrict barray_p, const size_t size_of, const size_t length, const void* const restrict data_p,
+                                          const compare_fp cmp_fp, const bool upper, const bool member_first)
+{
+    switch (size_of)
+    {
+        case sizeof(uint32_t): return __darray_raw_bound(barray_p, sizeof(uint32_t), length, data_p, cmp_fp, upper, member_first);
+        case sizeof(uint64_t): return __darray_raw_bound(barray_p, sizeof(uint64_t), length, data_p, cmp_fp, upper, member_first);
+        default: return __darray_raw_bound(barray_p, size_of, length, data_p, cmp_fp, upper, member_first);
+    }
+}
+
+
+static size_t __darray_raw_bound_hint(const uint8_t* const restrict barray_p, const size_t size_of, const size_t length, const void* const restrict data_p,
+                                      const compare_fp cmp_fp, const bool upper, const bool member_first, const size_t hint)
+{
+    /* for lower bound go right when data > member, for upper bound when data >= member */
+    register const size_t start = hint < length ? hint : length;
+
+    /* bound is in [@low, @high] */
+    register size_t low = start;
+    register size_t high = start;
+    register size_t step = 1;
+
+    if (start < length && __darray_raw_bound_after(&barray_p[start * size_of], data_p, cmp_fp, upper, member_first) != 0)
+    {
+        /* gallop right: members at start + 1, start + 2, start + 4 ... */
+        low = start + 1;
+
+        while (length - start > step && __darray_raw_bound_after(&barray_p[(start + step) * size_of], data_p, cmp_fp, upper, member_first) != 0)
+        {
+            low = start + step + 1;
+            step *= 2;
+        }
+
+        high = length - start > step ? start + step : length;
+    }
+    else if (start > 0 && __darray_raw_bound_after(&barray_p[(start - 1) * size_of], data_p, cmp_fp, upper, member_first) == 0)
+    {
+        /* gallop left: members at start - 2, start - 3, start - 5 ... */
+        high = start - 1;
+
+        while (start > step + 1 && __darray_raw_bound_after(&barray_p[(start - step - 1) * size_of], data_p, cmp_fp, upper, member_first) == 0)
+        {
+            high = start - step - 1;
+            step *= 2;
+        }
+
+        low = start > step + 1 ? start - step : 0;
+    }
+
+    if (low == high)
+    {
+        return low;
+    }
+
+    return low + __darray_raw_bound_dispatch(&barray_p[low * size_of], size_of, high - low, data_p, cmp_fp, upper, member_first);
+}
+
+
+static int __darray_raw_hint_check(const void* const array_p, const size_t size_of, const size_t length, const void* const data_p, const compare_fp cmp_fp)
+{
+    if (array_p == NULL)
+    {
+        perror("DArrayRaw: argument array_p is NULL\n");
+        return -1;
+    }
+
+    if (size_of == 0)
+    {
+        perror("DArrayRaw: argument size_of has to small value\n");
+        return -1;
+    }
+
+    if (length == 0)
+    {
+        perror("DArrayRaw: argument length has to small value\n");
+        return -1;
+    }
+
+    if (data_p == NULL)
+    {
+        perror("DArrayRaw: argument data_p is NULL\n");
+        return -1;
+    }
+
+    if (cmp_fp == NULL)
+    {
+        perror("DArrayRaw: argument cmp_fp is NULL\n");
+        return -1;
+    }
+
+    return 0;
+}
+
+
 static inline int __darray_raw_insert_pos(void* const restrict array_p, const size_t size_of, const size_t length, const size_t pos, const void* const restrict data_p)
 {
     if (array_p == NULL)
@@ -205,72 +613,810 @@ static inline int __darray_raw_delete_pos_with_entry(void* array_p, size_t size_
 }
 
 
-void* darray_raw_create(size_t size_of, size_t length)
+static inline uint64_t __darray_raw_radix_key(const void* const key_p, const size_t key_size, const darray_raw_key_type_e key_type)
 {
-    if (size_of == 0)
-    {
-        perror("DArrayRaw: argument size_of has to small value\n");
-        return NULL;
-    }
+    register uint64_t key = 0;
 
-    if (length == 0)
+    switch (key_size)
     {
-        perror("DArrayRaw: argument length has to small value\n");
-        return NULL;
+        case sizeof(uint8_t):  { uint8_t k;  memcpy(&k, key_p, sizeof(k)); key = k; break; }
+        case sizeof(uint16_t): { uint16_t k; memcpy(&k, key_p, sizeof(k)); key = k; break; }
+        case sizeof(uint32_t): { uint32_t k; memcpy(&k, key_p, sizeof(k)); key = k; break; }
+        case sizeof(uint64_t): { uint64_t k; memcpy(&k, key_p, sizeof(k)); key = k; break; }
+        default: break;
     }
 
-    void* array_p = calloc(length, size_of);
+    register const uint64_t sign_bit = (uint64_t)1 << (key_size * 8 - 1);
+    register const uint64_t all_bits = sign_bit | (sign_bit - 1);
 
-    if (array_p == NULL)
+    if (key_type == DARRAY_RAW_KEY_FLOAT)
     {
-        perror("DArrayRaw: calloc error\n");
-        return NULL;
+        return key ^ ((key & sign_bit) ? all_bits : sign_bit);
     }
 
-    return array_p;
+    return key ^ ((key_type == DARRAY_RAW_KEY_SIGNED) ? sign_bit : 0);
 }
 
 
-/* needed to be able to cover function by macro */
-#undef darray_raw_create_and_init
-
-void* darray_raw_create_and_init(const size_t size_of, const size_t length, const void* const array_p)
+static inline int __darray_raw_radix_sort(void* const array_p, const size_t size_of, const size_t length, const size_t key_offset, 
+                                          const size_t key_size, const darray_raw_key_type_e key_type, void* const scratch_p)
 {
-    void* new_array_p = darray_raw_create(size_of, length);
-
-    if (new_array_p == NULL)
+    if (array_p == NULL)
     {
-        perror("DArrayRaw: calloc error\n");
-        return NULL;
+        perror("DArrayRaw: argument array_p is NULL\n");
+        return -1;
     }
 
-    register const int ret = darray_raw_copy(new_array_p, array_p, size_of, length);
+    if (size_of == 0)
+    {
+        perror("DArrayRaw: argument size_of has to small value\n");
+        return -1;
+    }
 
-    if (ret == -1)
+    if (length == 0)
     {
-        perror("DArrayRaw: darray_raw_copy error\n");
-        darray_raw_destroy(new_array_p);
-        return NULL;
+        perror("DArrayRaw: argument length has to small value\n");
+        return -1;
     }
 
-    return new_array_p;
-}
+    if (key_size != sizeof(uint8_t) && key_size != sizeof(uint16_t) && key_size != sizeof(uint32_t) && key_size != sizeof(uint64_t))
+    {
+        perror("DArrayRaw: argument key_size has to be 1, 2, 4 or 8\n");
+        return -1;
+    }
 
+    if (key_offset > size_of || key_size > size_of - key_offset)
+    {
+        perror("DArrayRaw: argument key_offset is out of array member\n");
+        return -1;
+    }
 
-void darray_raw_destroy(void* array_p)
-{
-    if (array_p == NULL)
+    if (key_type == DARRAY_RAW_KEY_FLOAT && key_size != sizeof(float) && key_size != sizeof(double))
     {
-        perror("DArrayRaw: argument array_p is NULL\n");
-        return;
+        perror("DArrayRaw: argument key_size has to be 4 or 8 for floating point keys\n");
+        return -1;
     }
 
-    free(array_p);
-}
+    register const size_t tiny_size = 32;
+    register const size_t digit_bits = 8;
+    register const size_t digit_count = (size_t)1 << digit_bits;
 
+    register uint8_t* const barray_p = array_p;
 
-void darray_raw_destroy_with_entires(void* array_p, const size_t size_of, const size_t length, const destructor_fp destroy_fp)
-{
+    if (length < tiny_size)
+    {
+        for (size_t i = 1; i < length; ++i)
+        {
+            uint8_t tmp[size_of];
+            assign(&tmp[0], &barray_p[i * size_of], size_of);
+
+            register const uint64_t tmp_key = __darray_raw_radix_key(&tmp[key_offset], key_size, key_type);
+            register size_t j = i;
+
+            for (; j > 0 && __darray_raw_radix_key(&barray_p[(j - 1) * size_of + key_offset], key_size, key_type) > tmp_key; --j)
+            {
+                assign(&barray_p[j * size_of], &barray_p[(j - 1) * size_of], size_of);
+            }
+
+            assign(&barray_p[j * size_of], &tmp[0], size_of);
+        }
+
+        return 0;
+    }
+
+    size_t histogram[sizeof(uint64_t)][digit_count];
+    memset(&histogram[0][0], 0, sizeof(histogram));
+
+    for (size_t offset = key_offset; offset < size_of * length; offset += size_of)
+    {
+        register const uint64_t key = __darray_raw_radix_key(&barray_p[offset], key_size, key_type);
+
+        for (size_t digit = 0; digit < key_size; ++digit)
+        {
+            histogram[digit][(key >> (digit * digit_bits)) & (digit_count - 1)]++;
+        }
+    }
+
+    register const uint64_t first_key = __darray_raw_radix_key(&barray_p[key_offset], key_size, key_type);
+
+    register uint8_t* src_p = barray_p;
+    register uint8_t* dst_p = scratch_p;
+    register uint8_t* allocated_p = NULL;
+
+    for (size_t digit = 0; digit < key_size; ++digit)
+    {
+        register const size_t shift = digit * digit_bits;
+
+        /* all keys have the same digit, so this pass would not change order */
+        if (histogram[digit][(first_key >> shift) & (digit_count - 1)] == length)
+        {
+            continue;
+        }
+
+        if (dst_p == NULL)
+        {
+            allocated_p = malloc(size_of * length);
+
+            if (allocated_p == NULL)
+            {
+                perror("DArrayRaw: malloc error\n");
+                return -1;
+            }
+
+            dst_p = allocated_p;
+        }
+
+        size_t bucket_idx[digit_count];
+        register size_t sum = 0;
+
+        for (size_t i = 0; i < digit_count; ++i)
+        {
+            bucket_idx[i] = sum;
+            sum += histogram[digit][i];
+        }
+
+        for (size_t offset = 0; offset < size_of * length; offset += size_of)
+        {
+            register const uint64_t key = __darray_raw_radix_key(&src_p[offset + key_offset], key_size, key_type);
+            register const size_t bucket = (size_t)((key >> shift) & (digit_count - 1));
+
+            assign(&dst_p[bucket_idx[bucket] * size_of], &src_p[offset], size_of);
+            bucket_idx[bucket]++;
+        }
+
+        register uint8_t* const tmp_p = src_p;
+        src_p = dst_p;
+        dst_p = tmp_p;
+    }
+
+    if (src_p != barray_p)
+    {
+        memcpy(barray_p, src_p, size_of * length);
+    }
+
+    free(allocated_p);
+
+    return 0;
+}
+
+
+static inline void __darray_raw_insertion_sort(uint8_t* const array_p, const size_t size_of, const size_t length, const compare_fp cmp_fp)
+{
+    uint8_t tmp[size_of];
+
+    for (size_t i = 1; i < length; ++i)
+    {
+        if (cmp_fp(&array_p[i * size_of], &array_p[(i - 1) * size_of]) >= 0)
+        {
+            continue;
+        }
+
+        assign(&tmp[0], &array_p[i * size_of], size_of);
+
+        register size_t j = i;
+
+        for (; j > 0 && cmp_fp(&tmp[0], &array_p[(j - 1) * size_of]) < 0; --j)
+        {
+            assign(&array_p[j * size_of], &array_p[(j - 1) * size_of], size_of);
+        }
+
+        assign(&array_p[j * size_of], &tmp[0], size_of);
+    }
+}
+
+
+static inline bool __darray_raw_partial_insertion_sort(uint8_t* const array_p, const size_t size_of, const size_t length, const compare_fp cmp_fp)
+{
+    register const size_t moves_limit = 8;
+    register size_t moves = 0;
+
+    uint8_t tmp[size_of];
+
+    for (size_t i = 1; i < length; ++i)
+    {
+        if (cmp_fp(&array_p[i * size_of], &array_p[(i - 1) * size_of]) >= 0)
+        {
+            continue;
+        }
+
+        assign(&tmp[0], &array_p[i * size_of], size_of);
+
+        register size_t j = i;
+
+        for (; j > 0 && cmp_fp(&tmp[0], &array_p[(j - 1) * size_of]) < 0; --j)
+        {
+            assign(&array_p[j * size_of], &array_p[(j - 1) * size_of], size_of);
+        }
+
+        assign(&array_p[j * size_of], &tmp[0], size_of);
+
+        moves += i - j;
+
+        if (moves > moves_limit)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+static inline void __darray_raw_heap_sift_down(uint8_t* const array_p, const size_t size_of, const size_t length, size_t root, const compare_fp cmp_fp)
+{
+    uint8_t tmp[size_of];
+    assign(&tmp[0], &array_p[root * size_of], size_of);
+
+    for (size_t child = 2 * root + 1; child < length; child = 2 * root + 1)
+    {
+        if (child + 1 < length && cmp_fp(&array_p[child * size_of], &array_p[(child + 1) * size_of]) < 0)
+        {
+            child++;
+        }
+
+        if (cmp_fp(&tmp[0], &array_p[child * size_of]) >= 0)
+        {
+            break;
+        }
+
+        assign(&array_p[root * size_of], &array_p[child * size_of], size_of);
+        root = child;
+    }
+
+    assign(&array_p[root * size_of], &tmp[0], size_of);
+}
+
+
+static inline void __darray_raw_heap_sort(uint8_t* const array_p, const size_t size_of, const size_t length, const compare_fp cmp_fp)
+{
+    for (size_t i = length / 2; i > 0; --i)
+    {
+        __darray_raw_heap_sift_down(array_p, size_of, length, i - 1, cmp_fp);
+    }
+
+    for (size_t end = length - 1; end > 0; --end)
+    {
+        swap(&array_p[0], &array_p[end * size_of], size_of);
+        __darray_raw_heap_sift_down(array_p, size_of, end, 0, cmp_fp);
+    }
+}
+
+
+static inline bool __darray_raw_dual_pivot_partition(uint8_t* const barray_p, const size_t size_of, const size_t length, const compare_fp cmp_fp, 
+                                                     size_t* const less_idx_p, size_t* const great_idx_p, bool* const diff_pivots_p)
+{
+    register const size_t dist_size = 13;
+
+    register const size_t left_idx = 0;
+    register const size_t right_idx = length - 1;
+
+    register const size_t sixth = length / 6;
+    register const size_t m1 = left_idx + sixth;
+    register const size_t m2 = m1 + sixth;
+    register const size_t m3 = m2 + sixth;
+    register const size_t m4 = m3 + sixth;
+    register const size_t m5 = m4 + sixth;
+
+    if (cmp_fp(&barray_p[m1 * size_of], &barray_p[m2 * size_of]) > 0)
+    {
+        swap(&barray_p[m1 * size_of], &barray_p[m2 * size_of], size_of);
+    }
+
+    if (cmp_fp(&barray_p[m4 * size_of], &barray_p[m5 * size_of]) > 0)
+    {
+        swap(&barray_p[m4 * size_of], &barray_p[m5 * size_of], size_of);
+    }
+
+    if (cmp_fp(&barray_p[m1 * size_of], &barray_p[m3 * size_of]) > 0)
+    {
+        swap(&barray_p[m1 * size_of], &barray_p[m3 * size_of], size_of);
+    }
+
+    if (cmp_fp(&barray_p[m2 * size_of], &barray_p[m3 * size_of]) > 0)
+    {
+        swap(&barray_p[m2 * size_of], &barray_p[m3 * size_of], size_of);
+    }
+
+    if (cmp_fp(&barray_p[m1 * size_of], &barray_p[m4 * size_of]) > 0)
+    {
+        swap(&barray_p[m1 * size_of], &barray_p[m4 * size_of], size_of);
+    }
+
+    if (cmp_fp(&barray_p[m3 * size_of], &barray_p[m4 * size_of]) > 0)
+    {
+        swap(&barray_p[m3 * size_of], &barray_p[m4 * size_of], size_of);
+    }
+
+    if (cmp_fp(&barray_p[m2 * size_of], &barray_p[m5 * size_of]) > 0)
+    {
+        swap(&barray_p[m2 * size_of], &barray_p[m5 * size_of], size_of);
+    }
+
+    if (cmp_fp(&barray_p[m2 * size_of], &barray_p[m3 * size_of]) > 0)
+    {
+        swap(&barray_p[m2 * size_of], &barray_p[m3 * size_of], size_of);
+    }
+
+    if (cmp_fp(&barray_p[m4 * size_of], &barray_p[m5 * size_of]) > 0)
+    {
+        swap(&barray_p[m4 * size_of], &barray_p[m5 * size_of], size_of);
+    }
+
+    uint8_t first_pivot[size_of];
+    assign(&first_pivot[0], &barray_p[m2 * size_of], size_of);
+
+    uint8_t second_pivot[size_of];
+    assign(&second_pivot[0], &barray_p[m4 * size_of], size_of);
+
+    uint8_t tmp[size_of];
+
+    register const bool diff_pivots = cmp_fp(&first_pivot[0], &second_pivot[0]) != 0;
+    register bool moved = false;
+
+    assign(&barray_p[m2 * size_of], &barray_p[left_idx * size_of], size_of);
+    assign(&barray_p[m4 * size_of], &barray_p[right_idx * size_of], size_of);
+
+    register size_t less_idx = left_idx + 1;
+    register size_t great_idx = right_idx - 1;
+
+    for (size_t k = less_idx; k <= great_idx; k++)
+    {
+        assign(&tmp[0], &barray_p[k * size_of], size_of);
+
+        register const int cmp_first = cmp_fp(&tmp[0], &first_pivot[0]);
+
+        if (cmp_first < 0)
+        {
+            if (k != less_idx)
+            {
+                assign(&barray_p[k * size_of], &barray_p[less_idx * size_of], size_of);
+                assign(&barray_p[less_idx * size_of], &tmp[0], size_of);
+                moved = true;
+            }
+
+            less_idx++;
+        }
+        else if (diff_pivots ? cmp_fp(&tmp[0], &second_pivot[0]) > 0 : cmp_first > 0)
+        {
+            while (cmp_fp(&barray_p[great_idx * size_of], &second_pivot[0]) > 0 && k < great_idx)
+            {
+                great_idx--;
+            }
+
+            if (k != great_idx)
+            {
+                assign(&barray_p[k * size_of], &barray_p[great_idx * size_of], size_of);
+                assign(&barray_p[great_idx * size_of], &tmp[0], size_of);
+                assign(&tmp[0], &barray_p[k * size_of], size_of);
+                moved = true;
+            }
+
+            great_idx--;
+
+            if (cmp_fp(&tmp[0], &first_pivot[0]) < 0)
+            {
+                assign(&barray_p[k * size_of], &barray_p[less_idx * size_of], size_of);
+                assign(&barray_p[less_idx * size_of], &tmp[0], size_of);
+                less_idx++;
+                moved = true;
+            }
+        }
+    }
+
+    assign(&barray_p[left_idx * size_of], &barray_p[(less_idx - 1) * size_of], size_of);
+    assign(&barray_p[(less_idx - 1) * size_of], &first_pivot[0], size_of);
+
+    assign(&barray_p[right_idx * size_of], &barray_p[(great_idx + 1) * size_of], size_of);
+    assign(&barray_p[(great_idx + 1) * size_of], &second_pivot[0], size_of);
+
+    /* middle part is very big, so elements equal to pivots are moved to its borders and excluded from sorting */
+    if (diff_pivots && less_idx <= great_idx && great_idx - less_idx > length - dist_size)
+    {
+        for (size_t k = less_idx; k <= great_idx; k++)
+        {
+            assign(&tmp[0], &barray_p[k * size_of], size_of);
+
+            if (cmp_fp(&tmp[0], &first_pivot[0]) == 0)
+            {
+                assign(&barray_p[k * size_of], &barray_p[less_idx * size_of], size_of);
+                assign(&barray_p[less_idx * size_of], &tmp[0], size_of);
+                less_idx++;
+            }
+            else if (cmp_fp(&tmp[0], &second_pivot[0]) == 0)
+            {
+                assign(&barray_p[k * size_of], &barray_p[great_idx * size_of], size_of);
+                assign(&barray_p[great_idx * size_of], &tmp[0], size_of);
+                assign(&tmp[0], &barray_p[k * size_of], size_of);
+                great_idx--;
+
+                if (cmp_fp(&tmp[0], &first_pivot[0]) == 0)
+                {
+                    assign(&barray_p[k * size_of], &barray_p[less_idx * size_of], size_of);
+                    assign(&barray_p[less_idx * size_of], &tmp[0], size_of);
+                    less_idx++;
+                }
+            }
+        }
+    }
+
+    *less_idx_p = less_idx;
+    *great_idx_p = great_idx;
+    *diff_pivots_p = diff_pivots;
+
+    return !moved;
+}
+
+
+static inline void __darray_raw_merge_tail(uint8_t* const array_p, const size_t size_of, const size_t length, const size_t prefix_length, 
+                                           const compare_fp cmp_fp, uint8_t* const buffer_p)
+{
+    register const size_t tail_length = length - prefix_length;
+
+    memcpy(buffer_p, &array_p[prefix_length * size_of], tail_length * size_of);
+
+    register size_t end = length;
+    register size_t prefix_end = prefix_length;
+
+    for (size_t t = tail_length; t > 0 && prefix_end > 0; --t)
+    {
+        register const uint8_t* const elem_p = &buffer_p[(t - 1) * size_of];
+
+        /* exponential search from the end of prefix, elements [high, prefix_end) are greater than @elem_p */
+        register size_t high = prefix_end;
+        register size_t low = 0;
+        register size_t step = 1;
+
+        while (high > 0)
+        {
+            register const size_t probe = high > step ? high - step : 0;
+
+            if (cmp_fp(&array_p[probe * size_of], elem_p) <= 0)
+            {
+                low = probe + 1;
+                break;
+            }
+
+            high = probe;
+            step *= 2;
+        }
+
+        /* first element greater than @elem_p is in range [low, high] */
+        while (low < high)
+        {
+            register const size_t middle = low + (high - low) / 2;
+
+            if (cmp_fp(&array_p[middle * size_of], elem_p) > 0)
+            {
+                high = middle;
+            }
+            else
+            {
+                low = middle + 1;
+            }
+        }
+
+        register const size_t greater = prefix_end - low;
+
+        if (greater > 0)
+        {
+            memmove(&array_p[(end - greater) * size_of], &array_p[low * size_of], greater * size_of);
+        }
+
+        end -= greater;
+        prefix_end = low;
+
+        end--;
+        assign(&array_p[end * size_of], elem_p, size_of);
+
+        if (prefix_end == 0)
+        {
+            memcpy(array_p, buffer_p, (t - 1) * size_of);
+            return;
+        }
+    }
+}
+
+
+static inline bool __darray_raw_sort_adaptive(uint8_t* const array_p, const size_t size_of, const size_t length, const compare_fp cmp_fp)
+{
+    if (length < 2)
+    {
+        return true;
+    }
+
+    register const bool descending = cmp_fp(&array_p[size_of], &array_p[0]) < 0;
+    register size_t run_length = 2;
+
+    if (descending)
+    {
+        while (run_length < length && cmp_fp(&array_p[run_length * size_of], &array_p[(run_length - 1) * size_of]) <= 0)
+        {
+            run_length++;
+        }
+
+        darray_raw_reverse(array_p, size_of, run_length);
+    }
+    else
+    {
+        while (run_length < length && cmp_fp(&array_p[run_length * size_of], &array_p[(run_length - 1) * size_of]) >= 0)
+        {
+            run_length++;
+        }
+    }
+
+    if (run_length == length)
+    {
+        return true;
+    }
+
+    register const size_t tail_length = length - run_length;
+
+    /* long unsorted tail is cheaper to sort together with the run */
+    if (tail_length > length / 4)
+    {
+        return false;
+    }
+
+    /* short tails are buffered on stack */
+    uint8_t stack_buffer[1024];
+    uint8_t* buffer_p = &stack_buffer[0];
+
+    if (tail_length * size_of > sizeof(stack_buffer))
+    {
+        buffer_p = malloc(tail_length * size_of);
+
+        if (buffer_p == NULL)
+        {
+            return false;
+        }
+    }
+
+    darray_raw_sort(&array_p[run_length * size_of], size_of, tail_length, cmp_fp);
+    __darray_raw_merge_tail(array_p, size_of, length, run_length, cmp_fp, buffer_p);
+
+    if (buffer_p != &stack_buffer[0])
+    {
+        free(buffer_p);
+    }
+
+    return true;
+}
+
+
+static inline void __darray_raw_min_heap_sift_down(uint8_t* const array_p, const size_t size_of, const size_t length, size_t root, const compare_fp cmp_fp)
+{
+    uint8_t tmp[size_of];
+    assign(&tmp[0], &array_p[root * size_of], size_of);
+
+    for (size_t child = 2 * root + 1; child < length; child = 2 * root + 1)
+    {
+        if (child + 1 < length && cmp_fp(&array_p[child * size_of], &array_p[(child + 1) * size_of]) > 0)
+        {
+            child++;
+        }
+
+        if (cmp_fp(&tmp[0], &array_p[child * size_of]) <= 0)
+        {
+            break;
+        }
+
+        assign(&array_p[root * size_of], &array_p[child * size_of], size_of);
+        root = child;
+    }
+
+    assign(&array_p[root * size_of], &tmp[0], size_of);
+}
+
+
+static void __darray_raw_median_of_medians_partition(uint8_t* const array_p, const size_t size_of, const size_t length, const compare_fp cmp_fp, 
+                                                     size_t* const lt_p, size_t* const gt_p)
+{
+    register const size_t group_size = 5;
+    register const size_t ngroups = length / group_size;
+
+    /* medians of groups are moved to the beginning of array */
+    for (size_t group = 0; group < ngroups; ++group)
+    {
+        uint8_t* const group_p = &array_p[group * group_size * size_of];
+
+        __darray_raw_insertion_sort(group_p, size_of, group_size, cmp_fp);
+
+        swap(&array_p[group * size_of], &group_p[(group_size / 2) * size_of], size_of);
+    }
+
+    __darray_raw_select(array_p, size_of, ngroups, ngroups / 2, cmp_fp, true);
+
+    uint8_t pivot[size_of];
+    assign(&pivot[0], &array_p[(ngroups / 2) * size_of], size_of);
+
+    register size_t lt = 0;
+    register size_t gt = length;
+
+    for (size_t i = 0; i < gt; )
+    {
+        register const int cmp = cmp_fp(&array_p[i * size_of], &pivot[0]);
+
+        if (cmp < 0)
+        {
+            if (i != lt)
+            {
+                swap(&array_p[i * size_of], &array_p[lt * size_of], size_of);
+            }
+
+            lt++;
+            i++;
+        }
+        else if (cmp > 0)
+        {
+            gt--;
+            swap(&array_p[i * size_of], &array_p[gt * size_of], size_of);
+        }
+        else
+        {
+            i++;
+        }
+    }
+
+    *lt_p = lt;
+    *gt_p = gt;
+}
+
+
+static void __darray_raw_select(uint8_t* const array_p, const size_t size_of, const size_t length, const size_t nth, const compare_fp cmp_fp, const bool linear_only)
+{
+    register const size_t tiny_size = 17;
+
+    register size_t left = 0;
+    register size_t right = length;
+
+    register bool use_median_of_medians = linear_only;
+    register size_t checkpoint_length = length;
+    register size_t partitions = 0;
+
+    while (right - left >= tiny_size)
+    {
+        uint8_t* const range_p = &array_p[left * size_of];
+        register const size_t range_length = right - left;
+        register const size_t k = nth - left;
+
+        if (use_median_of_medians)
+        {
+            size_t lt;
+            size_t gt;
+
+            __darray_raw_median_of_medians_partition(range_p, size_of, range_length, cmp_fp, &lt, &gt);
+
+            if (k < lt)
+            {
+                right = left + lt;
+            }
+            else if (k >= gt)
+            {
+                left += gt;
+            }
+            else
+            {
+                return;
+            }
+
+            continue;
+        }
+
+        size_t less_idx;
+        size_t great_idx;
+        bool diff_pivots;
+
+        (void)__darray_raw_dual_pivot_partition(range_p, size_of, range_length, cmp_fp, &less_idx, &great_idx, &diff_pivots);
+
+        /* element at @less_idx - 1 and @great_idx + 1 are already at their final positions */
+        if (k + 1 < less_idx)
+        {
+            right = left + less_idx - 1;
+        }
+        else if (k + 1 == less_idx || k == great_idx + 1)
+        {
+            return;
+        }
+        else if (k <= great_idx)
+        {
+            if (!diff_pivots)
+            {
+                return;
+            }
+
+            right = left + great_idx + 1;
+            left += less_idx;
+        }
+        else
+        {
+            left += great_idx + 2;
+        }
+
+        /* range has to be at least halved every two partitions, otherwise linear time is not guaranteed */
+        if (++partitions % 2 == 0)
+        {
+            if (right - left > checkpoint_length / 2)
+            {
+                use_median_of_medians = true;
+            }
+
+            checkpoint_length = right - left;
+        }
+    }
+
+    if (right - left > 1)
+    {
+        __darray_raw_insertion_sort(&array_p[left * size_of], size_of, right - left, cmp_fp);
+    }
+}
+
+
+void* darray_raw_create(size_t size_of, size_t length)
+{
+    if (size_of == 0)
+    {
+        perror("DArrayRaw: argument size_of has to small value\n");
+        return NULL;
+    }
+
+    if (length == 0)
+    {
+        perror("DArrayRaw: argument length has to small value\n");
+        return NULL;
+    }
+
+    void* array_p = calloc(length, size_of);
+
+    if (array_p == NULL)
+    {
+        perror("DArrayRaw: calloc error\n");
+        return NULL;
+    }
+
+    return array_p;
+}
+
+
+/* needed to be able to cover function by macro */
+#undef darray_raw_create_and_init
+
+void* darray_raw_create_and_init(const size_t size_of, const size_t length, const void* const array_p)
+{
+    void* new_array_p = darray_raw_create(size_of, length);
+
+    if (new_array_p == NULL)
+    {
+        perror("DArrayRaw: calloc error\n");
+        return NULL;
+    }
+
+    register const int ret = darray_raw_copy(new_array_p, array_p, size_of, length);
+
+    if (ret == -1)
+    {
+        perror("DArrayRaw: darray_raw_copy error\n");
+        darray_raw_destroy(new_array_p);
+        return NULL;
+    }
+
+    return new_array_p;
+}
+
+
+void darray_raw_destroy(void* array_p)
+{
+    if (array_p == NULL)
+    {
+        perror("DArrayRaw: argument array_p is NULL\n");
+        return;
+    }
+
+    free(array_p);
+}
+
+
+void darray_raw_destroy_with_entires(void* array_p, const size_t size_of, const size_t length, const destructor_fp destroy_fp)
+{
     if (array_p == NULL)
     {
         perror("DArrayRaw: argument array_p is NULL\n");
@@ -506,6 +1652,26 @@ int darray_raw_sorted_insert(void* const restrict array_p, const size_t size_of,
 }
 
 
+ssize_t darray_raw_sorted_insert_hint(void* const restrict array_p, const size_t size_of, const size_t length, const void* const restrict data_p,
+                                      const compare_fp cmp_fp, const size_t hint)
+{
+    if (__darray_raw_hint_check(array_p, size_of, length, data_p, cmp_fp) != 0)
+    {
+        return -1;
+    }
+
+    /* last member is free slot for new one */
+    register const size_t pos = length == 1 ? 0 : __darray_raw_bound_hint(array_p, size_of, length - 1, data_p, cmp_fp, true, false, hint);
+
+    if (__darray_raw_insert_pos(array_p, size_of, length, pos, data_p) != 0)
+    {
+        return -1;
+    }
+
+    return (ssize_t)pos;
+}
+
+
 int darray_raw_delete_first(void* const array_p, const size_t size_of, const size_t length)
 {
     return __darray_raw_delete_pos(array_p, size_of, length, 0);
@@ -635,26 +1801,7 @@ ssize_t darray_raw_lower_bound(const void* const restrict array_p, const size_t
         return -1;
     }
 
-    register const uint8_t* const restrict barray_p = array_p;
-
-    register size_t offset_left = 0;
-    register size_t offset_right = length * size_of;
-
-    while (offset_left < offset_right)
-    {
-        register const size_t offset_middle = (((offset_left / size_of) + (offset_right / size_of)) / 2) * size_of;
-
-        if (cmp_fp(data_p, &barray_p[offset_middle]) <= 0)
-        {
-            offset_right = offset_middle;
-        }
-        else
-        {
-            offset_left = offset_middle + size_of;
-        }
-    }
-
-    return (ssize_t)(offset_left / size_of);
+    return (ssize_t)__darray_raw_bound_dispatch(array_p, size_of, length, data_p, cmp_fp, false, false);
 }
 
 
@@ -690,26 +1837,31 @@ ssize_t darray_raw_upper_bound(const void* const restrict array_p, const size_t
         return -1;
     }
 
-    register const uint8_t* const restrict barray_p = array_p;
+    return (ssize_t)__darray_raw_bound_dispatch(array_p, size_of, length, data_p, cmp_fp, true, false);
+}
 
-    register size_t offset_left = 0;
-    register size_t offset_right = length * size_of;
 
-    while (offset_left < offset_right)
+ssize_t darray_raw_lower_bound_hint(const void* const restrict array_p, const size_t size_of, const size_t length, const void* const restrict data_p,
+                                    const compare_fp cmp_fp, const size_t hint)
+{
+    if (__darray_raw_hint_check(array_p, size_of, length, data_p, cmp_fp) != 0)
     {
-        register const size_t offset_middle = (((offset_left / size_of) + (offset_right / size_of)) / 2) * size_of;
+        return -1;
+    }
 
-        if (cmp_fp(data_p, &barray_p[offset_middle]) >= 0)
-        {
-            offset_left = offset_middle + size_of;
-        }
-        else
-        {
-            offset_right = offset_middle;
-        }
+    return (ssize_t)__darray_raw_bound_hint(array_p, size_of, length, data_p, cmp_fp, false, false, hint);
+}
+
+
+ssize_t darray_raw_upper_bound_hint(const void* const restrict array_p, const size_t size_of, const size_t length, const void* const restrict data_p,
+                                    const compare_fp cmp_fp, const size_t hint)
+{
+    if (__darray_raw_hint_check(array_p, size_of, length, data_p, cmp_fp) != 0)
+    {
+        return -1;
     }
 
-    return (ssize_t)(offset_left / size_of);
+    return (ssize_t)__darray_raw_bound_hint(array_p, size_of, length, data_p, cmp_fp, true, false, hint);
 }
 
 
@@ -956,33 +2108,20 @@ ssize_t darray_raw_sorted_find_first(const void* const restrict array_p, const s
         return -1;
     }
 
-    register size_t left_offset = 0;
-    register size_t right_offset = (length - 1) * size_of;
-
     register const uint8_t* const restrict barray_p = array_p;
 
-    while (left_offset < right_offset)
-    {
-        register const size_t middle_offset = (((left_offset / size_of) + (right_offset / size_of)) / 2) * size_of;
-
-        if (cmp_fp(&barray_p[middle_offset], key_p) < 0)
-        {
-            left_offset = middle_offset + size_of;
-        }
-        else
-        {
-            right_offset = middle_offset;
-        }
-    }
+    /* first occurrence is lower bound, when key is greater than all members it is last member */
+    register const size_t bound = __darray_raw_bound_dispatch(barray_p, size_of, length, key_p, cmp_fp, false, true);
+    register const size_t idx = bound < length ? bound : length - 1;
 
-    if (cmp_fp(&barray_p[left_offset], key_p) == 0)
+    if (cmp_fp(&barray_p[idx * size_of], key_p) == 0)
     {
         if (out_p != NULL)
         {
-            assign(out_p, &barray_p[left_offset], size_of);
+            assign(out_p, &barray_p[idx * size_of], size_of);
         }
 
-        return (ssize_t)(left_offset / size_of);
+        return (ssize_t)idx;
     }
 
     return -1;
@@ -1016,39 +2155,78 @@ ssize_t darray_raw_sorted_find_last(const void* const restrict array_p, const si
         return -1;
     }
 
-    if (cmp_fp == NULL)
+    if (cmp_fp == NULL)
+    {
+        perror("DArrayRaw: argument cmp_fp is NULL\n");
+        return -1;
+    }
+
+    register const uint8_t* const restrict barray_p = array_p;
+
+    /* last occurrence is just before upper bound, when key is less than all members it is first member */
+    register const size_t bound = __darray_raw_bound_dispatch(barray_p, size_of, length, key_p, cmp_fp, true, true);
+    register const size_t idx = bound > 0 ? bound - 1 : 0;
+
+    if (cmp_fp(&barray_p[idx * size_of], key_p) == 0)
+    {
+        if (out_p != NULL)
+        {
+            assign(out_p, &barray_p[idx * size_of], size_of);
+        }
+
+        return (ssize_t)idx;
+    }
+
+    return -1;
+}
+
+
+ssize_t darray_raw_sorted_find_first_hint(const void* const restrict array_p, const size_t size_of, const size_t length,
+                                          const void* const restrict key_p, const compare_fp cmp_fp, const size_t hint, void* const out_p)
+{
+    if (__darray_raw_hint_check(array_p, size_of, length, key_p, cmp_fp) != 0)
+    {
+        return -1;
+    }
+
+    register const uint8_t* const restrict barray_p = array_p;
+    register const size_t bound = __darray_raw_bound_hint(barray_p, size_of, length, key_p, cmp_fp, false, true, hint);
+
+    if (bound < length && cmp_fp(&barray_p[bound * size_of], key_p) == 0)
+    {
+        if (out_p != NULL)
+        {
+            assign(out_p, &barray_p[bound * size_of], size_of);
+        }
+
+        return (ssize_t)bound;
+    }
+
+    return -1;
+}
+
+
+ssize_t darray_raw_sorted_find_last_hint(const void* const restrict array_p, const size_t size_of, const size_t length,
+                                         const void* const restrict key_p, const compare_fp cmp_fp, const size_t hint, void* const out_p)
+{
+    if (__darray_raw_hint_check(array_p, size_of, length, key_p, cmp_fp) != 0)
     {
-        perror("DArrayRaw: argument cmp_fp is NULL\n");
         return -1;
     }
 
-    register size_t left_offset = 0;
-    register size_t right_offset = (length - 1) * size_of;
-
     register const uint8_t* const restrict barray_p = array_p;
 
-    while (left_offset < right_offset)
-    {
-        register const size_t middle_offset = (((left_offset / size_of) + (right_offset / size_of) + 1) / 2) * size_of;
-
-        if (cmp_fp(&barray_p[middle_offset], key_p) > 0)
-        {
-            right_offset = middle_offset - size_of;
-        }
-        else
-        {
-            left_offset = middle_offset;
-        }
-    }
+    /* hint is index of last occurrence, bound is just after it */
+    register const size_t bound = __darray_raw_bound_hint(barray_p, size_of, length, key_p, cmp_fp, true, true, hint < length ? hint + 1 : length);
 
-    if (cmp_fp(&barray_p[left_offset], key_p) == 0)
+    if (bound > 0 && cmp_fp(&barray_p[(bound - 1) * size_of], key_p) == 0)
     {
         if (out_p != NULL)
         {
-            assign(out_p, &barray_p[left_offset], size_of);
+            assign(out_p, &barray_p[(bound - 1) * size_of], size_of);
         }
 
-        return (ssize_t)(left_offset / size_of);
+        return (ssize_t)(bound - 1);
     }
 
     return -1;
@@ -1081,212 +2259,329 @@ void darray_raw_sort(void* const array_p, const size_t size_of, const size_t len
         return;
     }
 
-    register const size_t dist_size = 13;
     register const size_t tiny_size = 17;
 
     uint8_t* const barray_p = array_p;
-    register const size_t left_idx = 0;
-    register const size_t right_idx = length - 1;
 
-    if (length < tiny_size)
+    /* sorted, reverse sorted and sorted with short unsorted tail arrays are finished by natural run */
+    if (__darray_raw_sort_adaptive(barray_p, size_of, length, cmp_fp))
+    {
+        return;
+    }
+
+    /* depth limit is 2 * log2(length), each level pushes at most two ranges, so stack never overflows */
+    register size_t depth_limit = 0;
+
+    for (size_t n = length; n > 1; n >>= 1)
+    {
+        depth_limit += 2;
+    }
+
+    DArrayRawSortRangeS stack[2 * 2 * sizeof(size_t) * 8];
+    register size_t stack_size = 0;
+
+    DArrayRawSortRangeS range = { .left_idx = 0, .length = length, .depth_limit = depth_limit };
+
+    for (;;)
     {
-        for (size_t i = left_idx + 1; i <= right_idx; ++i)
+        uint8_t* const range_p = &barray_p[range.left_idx * size_of];
+
+        if (range.length < tiny_size)
+        {
+            __darray_raw_insertion_sort(range_p, size_of, range.length, cmp_fp);
+        }
+        else if (range.depth_limit == 0)
+        {
+            __darray_raw_heap_sort(range_p, size_of, range.length, cmp_fp);
+        }
+        else
         {
-            for (size_t j = i; j > left_idx && cmp_fp(&barray_p[j * size_of], &barray_p[(j - 1) * size_of]) < 0; j--)
+            size_t less_idx;
+            size_t great_idx;
+            bool diff_pivots;
+
+            register const bool partitioned = __darray_raw_dual_pivot_partition(range_p, size_of, range.length, cmp_fp, &less_idx, &great_idx, &diff_pivots);
+
+            DArrayRawSortRangeS parts[3] = {
+                { .left_idx = range.left_idx, .length = less_idx - 1, .depth_limit = range.depth_limit - 1 },
+                { .left_idx = range.left_idx + less_idx, .length = diff_pivots ? great_idx + 1 - less_idx : 0, .depth_limit = range.depth_limit - 1 },
+                { .left_idx = range.left_idx + great_idx + 2, .length = range.length - great_idx - 2, .depth_limit = range.depth_limit - 1 },
+            };
+
+            register size_t largest = 0;
+
+            for (size_t i = 1; i < array_size(parts); ++i)
+            {
+                if (parts[i].length > parts[largest].length)
+                {
+                    largest = i;
+                }
+            }
+
+            /* badly unbalanced partition, swap elements under pivot candidates to break patterns in input */
+            if (parts[largest].length > range.length - range.length / 8)
+            {
+                for (size_t i = 0; i < array_size(parts); ++i)
+                {
+                    register const size_t part_length = parts[i].length;
+
+                    if (part_length < tiny_size)
+                    {
+                        continue;
+                    }
+
+                    uint8_t* const part_p = &barray_p[parts[i].left_idx * size_of];
+
+                    for (size_t candidate = 1; candidate <= 5; ++candidate)
+                    {
+                        register const size_t idx = candidate * (part_length / 6);
+                        register const size_t other_idx = (idx + part_length / 12 + candidate) % part_length;
+
+                        swap(&part_p[idx * size_of], &part_p[other_idx * size_of], size_of);
+                    }
+                }
+            }
+            else if (partitioned)
+            {
+                /* nothing was moved, so parts are probably sorted already */
+                for (size_t i = 0; i < array_size(parts); ++i)
+                {
+                    if (parts[i].length > 1 && __darray_raw_partial_insertion_sort(&barray_p[parts[i].left_idx * size_of], size_of, parts[i].length, cmp_fp))
+                    {
+                        parts[i].length = 0;
+                    }
+                }
+            }
+
+            /* largest part is sorted in this loop, smaller ones wait in stack */
+            largest = 0;
+
+            for (size_t i = 1; i < array_size(parts); ++i)
+            {
+                if (parts[i].length > parts[largest].length)
+                {
+                    largest = i;
+                }
+            }
+
+            for (size_t i = 0; i < array_size(parts); ++i)
+            {
+                if (i != largest && parts[i].length > 1)
+                {
+                    stack[stack_size++] = parts[i];
+                }
+            }
+
+            if (parts[largest].length > 1)
             {
-                swap(&barray_p[j * size_of], &barray_p[(j - 1) * size_of], size_of);
+                range = parts[largest];
+                continue;
             }
         }
 
-        return;
+        if (stack_size == 0)
+        {
+            break;
+        }
+
+        range = stack[--stack_size];
     }
+}
 
-    register const size_t sixth = length / 6;
-    register const size_t m1 = left_idx + sixth;
-    register const size_t m2 = m1 + sixth;
-    register const size_t m3 = m2 + sixth;
-    register const size_t m4 = m3 + sixth;
-    register const size_t m5 = m4 + sixth;
 
-    if (cmp_fp(&barray_p[m1 * size_of], &barray_p[m2 * size_of]) > 0)
+int darray_raw_nth_element(void* const array_p, const size_t size_of, const size_t length, const size_t nth, const compare_fp cmp_fp)
+{
+    if (array_p == NULL)
     {
-        swap(&barray_p[m1 * size_of], &barray_p[m2 * size_of], size_of);
+        perror("DArrayRaw: argument array_p is NULL\n");
+        return -1;
     }
 
-    if (cmp_fp(&barray_p[m4 * size_of], &barray_p[m5 * size_of]) > 0)
+    if (size_of == 0)
     {
-        swap(&barray_p[m4 * size_of], &barray_p[m5 * size_of], size_of);
+        perror("DArrayRaw: argument size_of has to small value\n");
+        return -1;
     }
 
-    if (cmp_fp(&barray_p[m1 * size_of], &barray_p[m3 * size_of]) > 0)
+    if (length == 0)
     {
-        swap(&barray_p[m1 * size_of], &barray_p[m3 * size_of], size_of);
+        perror("DArrayRaw: argument length has to small value\n");
+        return -1;
     }
 
-    if (cmp_fp(&barray_p[m2 * size_of], &barray_p[m3 * size_of]) > 0)
+    if (nth >= length)
     {
-        swap(&barray_p[m2 * size_of], &barray_p[m3 * size_of], size_of);
+        perror("DArrayRaw: argument nth is greater than length value\n");
+        return -1;
     }
 
-    if (cmp_fp(&barray_p[m1 * size_of], &barray_p[m4 * size_of]) > 0)
+    if (cmp_fp == NULL)
     {
-        swap(&barray_p[m1 * size_of], &barray_p[m4 * size_of], size_of);
+        perror("DArrayRaw: argument cmp_fp is NULL\n");
+        return -1;
     }
 
-    if (cmp_fp(&barray_p[m3 * size_of], &barray_p[m4 * size_of]) > 0)
+    __darray_raw_select(array_p, size_of, length, nth, cmp_fp, false);
+
+    return 0;
+}
+
+
+int darray_raw_partial_sort(void* const array_p, const size_t size_of, const size_t length, const size_t middle, const compare_fp cmp_fp)
+{
+    if (middle == 0)
     {
-        swap(&barray_p[m3 * size_of], &barray_p[m4 * size_of], size_of);
+        perror("DArrayRaw: argument middle has to small value\n");
+        return -1;
     }
 
-    if (cmp_fp(&barray_p[m2 * size_of], &barray_p[m5 * size_of]) > 0)
+    if (middle > length)
     {
-        swap(&barray_p[m2 * size_of], &barray_p[m5 * size_of], size_of);
+        perror("DArrayRaw: argument middle has to big value\n");
+        return -1;
     }
 
-    if (cmp_fp(&barray_p[m2 * size_of], &barray_p[m3 * size_of]) > 0)
+    if (darray_raw_nth_element(array_p, size_of, length, middle - 1, cmp_fp) != 0)
     {
-        swap(&barray_p[m2 * size_of], &barray_p[m3 * size_of], size_of);
+        perror("DArrayRaw: darray_raw_nth_element error\n");
+        return -1;
     }
 
-    if (cmp_fp(&barray_p[m4 * size_of], &barray_p[m5 * size_of]) > 0)
+    /* element at @middle - 1 is in place, all before are not greater */
+    if (middle > 2)
     {
-        swap(&barray_p[m4 * size_of], &barray_p[m5 * size_of], size_of);
+        darray_raw_sort(array_p, size_of, middle - 1, cmp_fp);
     }
 
-    uint8_t first_pivot[size_of];
-    assign(&first_pivot[0], &barray_p[m2 * size_of], size_of);
-
-    uint8_t second_pivot[size_of];
-    assign(&second_pivot[0], &barray_p[m4 * size_of], size_of);
-
-    register const bool diff_pivots = cmp_fp(&first_pivot[0], &second_pivot[0]) != 0;
+    return 0;
+}
 
-    assign(&barray_p[m2 * size_of], &barray_p[left_idx * size_of], size_of);
-    assign(&barray_p[m4 * size_of], &barray_p[right_idx * size_of], size_of);
 
-    register size_t less_idx = left_idx + 1;
-    register size_t great_idx = right_idx - 1;
+int darray_raw_top_k(const void* const restrict array_p, const size_t size_of, const size_t length, const size_t k, 
+                     const compare_fp cmp_fp, void* const restrict out_p)
+{
+    if (array_p == NULL)
+    {
+        perror("DArrayRaw: argument array_p is NULL\n");
+        return -1;
+    }
 
-    if (diff_pivots)
+    if (size_of == 0)
     {
-        for (size_t k = less_idx; k <= great_idx; k++)
-        {
-            uint8_t tmp[size_of];
-            assign(&tmp[0], &barray_p[k * size_of], size_of);
+        perror("DArrayRaw: argument size_of has to small value\n");
+        return -1;
+    }
 
-            if (cmp_fp(&tmp[0], &first_pivot[0]) < 0)
-            {
-                assign(&barray_p[k * size_of], &barray_p[less_idx * size_of], size_of);
-                assign(&barray_p[less_idx * size_of], &tmp[0], size_of);
-                less_idx++;
-            }
-            else if (cmp_fp(&tmp[0], &second_pivot[0]) > 0)
-            {
-                while (cmp_fp(&barray_p[great_idx * size_of], &second_pivot[0]) > 0 && k < great_idx)
-                {
-                    great_idx--;
-                }
+    if (length == 0)
+    {
+        perror("DArrayRaw: argument length has to small value\n");
+        return -1;
+    }
 
-                assign(&barray_p[k * size_of], &barray_p[great_idx * size_of], size_of);
-                assign(&barray_p[great_idx * size_of], &tmp[0], size_of);
-                assign(&tmp[0], &barray_p[k * size_of], size_of);
-                great_idx--;
+    if (k == 0 || k > length)
+    {
+        perror("DArrayRaw: argument k is out of range\n");
+        return -1;
+    }
 
-                if (cmp_fp(&tmp[0], &first_pivot[0]) < 0)
-                {
-                    assign(&barray_p[k * size_of], &barray_p[less_idx * size_of], size_of);
-                    assign(&barray_p[less_idx * size_of], &tmp[0], size_of);
-                    less_idx++;
-                }
-            }
-        }
+    if (cmp_fp == NULL)
+    {
+        perror("DArrayRaw: argument cmp_fp is NULL\n");
+        return -1;
     }
-    else
+
+    if (out_p == NULL)
     {
-        for (size_t k = less_idx; k <= great_idx; k++)
-        {
-            uint8_t tmp[size_of];
-            assign(&tmp[0], &barray_p[k * size_of], size_of);
+        perror("DArrayRaw: argument out_p is NULL\n");
+        return -1;
+    }
 
-            if (cmp_fp(&tmp[0], &first_pivot[0]) == 0)
-            {
-                continue;
-            }
+    register const uint8_t* const restrict barray_p = array_p;
+    register uint8_t* const restrict heap_p = out_p;
 
-            if (cmp_fp(&tmp[0], &first_pivot[0]) < 0)
-            {
-                assign(&barray_p[k * size_of], &barray_p[less_idx * size_of], size_of);
-                assign(&barray_p[less_idx * size_of], &tmp[0], size_of);
-                less_idx++;
-            }
-            else
-            {
-                while (cmp_fp(&barray_p[great_idx * size_of], &second_pivot[0]) > 0 && k < great_idx)
-                {
-                    great_idx--;
-                }
+    /* min-heap keeps k greatest elements seen so far, its root is the smallest of them */
+    assign(heap_p, barray_p, size_of * k);
 
-                assign(&barray_p[k * size_of], &barray_p[great_idx * size_of], size_of);
-                assign(&barray_p[great_idx * size_of], &tmp[0], size_of);
-                assign(&tmp[0], &barray_p[k * size_of], size_of);
-                great_idx--;
+    for (size_t i = k / 2; i > 0; --i)
+    {
+        __darray_raw_min_heap_sift_down(heap_p, size_of, k, i - 1, cmp_fp);
+    }
 
-                if (cmp_fp(&tmp[0], &first_pivot[0]) < 0)
-                {
-                    assign(&barray_p[k * size_of], &barray_p[less_idx * size_of], size_of);
-                    assign(&barray_p[less_idx * size_of], &tmp[0], size_of);
-                    less_idx++;
-                }
-            }
+    for (size_t offset = k * size_of; offset < length * size_of; offset += size_of)
+    {
+        if (cmp_fp(&barray_p[offset], &heap_p[0]) > 0)
+        {
+            assign(&heap_p[0], &barray_p[offset], size_of);
+            __darray_raw_min_heap_sift_down(heap_p, size_of, k, 0, cmp_fp);
         }
     }
 
-    assign(&barray_p[left_idx * size_of], &barray_p[(less_idx - 1) * size_of], size_of);
-    assign(&barray_p[(less_idx - 1) * size_of], &first_pivot[0], size_of);
-
-    assign(&barray_p[right_idx * size_of], &barray_p[(great_idx + 1) * size_of], size_of);
-    assign(&barray_p[(great_idx + 1) * size_of], &second_pivot[0], size_of);
-
-    darray_raw_sort(&barray_p[left_idx * size_of], size_of, less_idx - left_idx - 2 + 1, cmp_fp);
-    darray_raw_sort(&barray_p[(great_idx + 2) * size_of], size_of, right_idx - great_idx - 2 + 1, cmp_fp);
-
-    if (great_idx - less_idx > length - dist_size && diff_pivots)
+    /* heap-sort on min-heap leaves elements in descending order */
+    for (size_t end = k - 1; end > 0; --end)
     {
-        for (size_t k = less_idx; k <= great_idx; k++)
-        {
-            uint8_t tmp[size_of];
-            assign(&tmp[0], &barray_p[k * size_of], size_of);
+        swap(&heap_p[0], &heap_p[end * size_of], size_of);
+        __darray_raw_min_heap_sift_down(heap_p, size_of, end, 0, cmp_fp);
+    }
 
-            if (cmp_fp(&tmp[0], &first_pivot[0]) == 0)
-            {
-                assign(&barray_p[k * size_of], &barray_p[less_idx * size_of], size_of);
-                assign(&barray_p[less_idx * size_of], &tmp[0], size_of);
-                less_idx++;
-            }
-            else if (cmp_fp(&tmp[0], &second_pivot[0]) == 0)
-            {
-                assign(&barray_p[k * size_of], &barray_p[great_idx * size_of], size_of);
-                assign(&barray_p[great_idx * size_of], &tmp[0], size_of);
-                assign(&tmp[0], &barray_p[k * size_of], size_of);
-                great_idx--;
+    return 0;
+}
 
-                if (cmp_fp(&tmp[0], &first_pivot[0]) == 0)
-                {
-                    assign(&barray_p[k * size_of], &barray_p[less_idx * size_of], size_of);
-                    assign(&barray_p[less_idx * size_of], &tmp[0], size_of);
-                    less_idx++;
-                }
-            }
-        }
-    }
 
-    if (diff_pivots)
+DARRAY_RAW_DEFINE_SORT(darray_raw_sort_i8, int8_t, a < b)
+DARRAY_RAW_DEFINE_SORT(darray_raw_sort_u8, uint8_t, a < b)
+DARRAY_RAW_DEFINE_SORT(darray_raw_sort_i16, int16_t, a < b)
+DARRAY_RAW_DEFINE_SORT(darray_raw_sort_u16, uint16_t, a < b)
+DARRAY_RAW_DEFINE_SORT_WITH_LEAF(darray_raw_sort_i32, int32_t, a < b, DARRAY_RAW_SORT_SMALL_MAX, __darray_raw_network_i32)
+DARRAY_RAW_DEFINE_SORT_WITH_LEAF(darray_raw_sort_u32, uint32_t, a < b, DARRAY_RAW_SORT_SMALL_MAX, __darray_raw_network_u32)
+DARRAY_RAW_DEFINE_SORT_WITH_LEAF(darray_raw_sort_i64, int64_t, a < b, DARRAY_RAW_SORT_SMALL_MAX, __darray_raw_network_i64)
+DARRAY_RAW_DEFINE_SORT_WITH_LEAF(darray_raw_sort_u64, uint64_t, a < b, DARRAY_RAW_SORT_SMALL_MAX, __darray_raw_network_u64)
+DARRAY_RAW_DEFINE_SORT_WITH_LEAF(darray_raw_sort_float, float, a < b, DARRAY_RAW_SORT_SMALL_MAX, __darray_raw_network_float)
+DARRAY_RAW_DEFINE_SORT_WITH_LEAF(darray_raw_sort_double, double, a < b, DARRAY_RAW_SORT_SMALL_MAX, __darray_raw_network_double)
+
+
+DARRAY_RAW_DEFINE_LOWER_BOUND(darray_raw_lower_bound_i8, int8_t, a < b)
+DARRAY_RAW_DEFINE_LOWER_BOUND(darray_raw_lower_bound_u8, uint8_t, a < b)
+DARRAY_RAW_DEFINE_LOWER_BOUND(darray_raw_lower_bound_i16, int16_t, a < b)
+DARRAY_RAW_DEFINE_LOWER_BOUND(darray_raw_lower_bound_u16, uint16_t, a < b)
+DARRAY_RAW_DEFINE_LOWER_BOUND(darray_raw_lower_bound_i32, int32_t, a < b)
+DARRAY_RAW_DEFINE_LOWER_BOUND(darray_raw_lower_bound_u32, uint32_t, a < b)
+DARRAY_RAW_DEFINE_LOWER_BOUND(darray_raw_lower_bound_i64, int64_t, a < b)
+DARRAY_RAW_DEFINE_LOWER_BOUND(darray_raw_lower_bound_u64, uint64_t, a < b)
+DARRAY_RAW_DEFINE_LOWER_BOUND(darray_raw_lower_bound_float, float, a < b)
+DARRAY_RAW_DEFINE_LOWER_BOUND(darray_raw_lower_bound_double, double, a < b)
+
+
+DARRAY_RAW_DEFINE_UPPER_BOUND(darray_raw_upper_bound_i8, int8_t, a < b)
+DARRAY_RAW_DEFINE_UPPER_BOUND(darray_raw_upper_bound_u8, uint8_t, a < b)
+DARRAY_RAW_DEFINE_UPPER_BOUND(darray_raw_upper_bound_i16, int16_t, a < b)
+DARRAY_RAW_DEFINE_UPPER_BOUND(darray_raw_upper_bound_u16, uint16_t, a < b)
+DARRAY_RAW_DEFINE_UPPER_BOUND(darray_raw_upper_bound_i32, int32_t, a < b)
+DARRAY_RAW_DEFINE_UPPER_BOUND(darray_raw_upper_bound_u32, uint32_t, a < b)
+DARRAY_RAW_DEFINE_UPPER_BOUND(darray_raw_upper_bound_i64, int64_t, a < b)
+DARRAY_RAW_DEFINE_UPPER_BOUND(darray_raw_upper_bound_u64, uint64_t, a < b)
+DARRAY_RAW_DEFINE_UPPER_BOUND(darray_raw_upper_bound_float, float, a < b)
+DARRAY_RAW_DEFINE_UPPER_BOUND(darray_raw_upper_bound_double, double, a < b)
+
+
+int darray_raw_radix_sort(void* const array_p, const size_t size_of, const size_t length, const darray_raw_key_type_e key_type, void* const scratch_p)
+{
+    /* constant key size lets compiler specialize key extraction and moves for primitive arrays */
+    switch (size_of)
     {
-        darray_raw_sort(&barray_p[less_idx * size_of], size_of, great_idx - less_idx + 1, cmp_fp);
+        case sizeof(uint32_t): return __darray_raw_radix_sort(array_p, sizeof(uint32_t), length, 0, sizeof(uint32_t), key_type, scratch_p);
+        case sizeof(uint64_t): return __darray_raw_radix_sort(array_p, sizeof(uint64_t), length, 0, sizeof(uint64_t), key_type, scratch_p);
+        default: return __darray_raw_radix_sort(array_p, size_of, length, 0, size_of, key_type, scratch_p);
     }
 }
 
 
+int darray_raw_radix_sort_by_key(void* const array_p, const size_t size_of, const size_t length, const size_t key_offset, 
+                                 const size_t key_size, const darray_raw_key_type_e key_type, void* const scratch_p)
+{
+    return __darray_raw_radix_sort(array_p, size_of, length, key_offset, key_size, key_type, scratch_p);
+}
+
+
 void darray_raw_shuffle(void* const array_p, const size_t size_of, const size_t length)
 {
     if (array_p == NULL)
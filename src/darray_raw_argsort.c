@@ -0,0 +1,515 @@
+#include <darray_raw/darray_raw.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/*
+    Indirect sort (argsort) and in-place permutation.
+
+    1. Argsort     - array of indexes is sorted instead of records, so records are only read by comparator.
+                     Short blocks of indexes are sorted by insertion-sort and merged bottom-up between
+                     index array and temporary index buffer. Merge sort keeps equal elements in original order.
+    2. Permutation - records are moved along cycles of permutation, so every record is written once
+                     (plus one copy into temporary record per cycle). Visited positions are marked in bitmap.
+    3. Co-sort     - keys are argsorted once and every column (keys and payloads) is gathered by the same indexes
+                     into temporary column, which is copied back. Gather reads sources in index order with prefetch
+                     a few records ahead, writes are sequential. Columns are gathered one after another, not
+                     interleaved per block of indexes: random reads from one column at a time keep TLB and cache
+                     working set small, while indexes are streamed sequentially for each column at low cost.
+                     Without memory for temporary column, permutation is applied in place.
+
+    Indexes are stored as uint32_t or size_t. 32-bit indexes halve memory traffic of argsort.
+*/
+
+
+/* number of indexes sorted by insertion-sort before merging */
+#define DARRAY_RAW_ARGSORT_BLOCK        ((size_t)16)
+
+/* number of bits in one word of visited bitmap */
+#define DARRAY_RAW_PERM_WORD_BITS       (sizeof(uint64_t) * 8)
+
+/* number of records between gathered record and prefetched one */
+#define DARRAY_RAW_GATHER_PREFETCH      ((size_t)16)
+
+
+/*
+ * Internal function which read index @pos from @idx_p.
+ *
+ * @param[in] idx_p    - pointer to array of indexes.
+ * @param[in] idx_size - size of each index (sizeof(uint32_t) or sizeof(size_t)).
+ * @param[in] pos      - position of index.
+ *
+ * @return: index stored at @pos.
+ */
+static inline size_t __darray_raw_idx_get(const void* idx_p, size_t idx_size, size_t pos);
+
+
+/*
+ * Internal function which write @idx at @pos of @idx_p.
+ *
+ * @param[in] idx_p    - pointer to array of indexes.
+ * @param[in] idx_size - size of each index (sizeof(uint32_t) or sizeof(size_t)).
+ * @param[in] pos      - position of index.
+ * @param[in] idx      - index to write.
+ *
+ * @return: this is void function.
+ */
+static inline void __darray_raw_idx_set(void* idx_p, size_t idx_size, size_t pos, size_t idx);
+
+
+/*
+ * Internal function which sort indexes [@left, @right) of @idx_p by insertion-sort.
+ *
+ * @param[in] barray_p - pointer to array of records.
+ * @param[in] size_of  - size of each array member.
+ * @param[in] idx_p    - pointer to array of indexes.
+ * @param[in] idx_size - size of each index.
+ * @param[in] left     - first position to sort.
+ * @param[in] right    - position after last one to sort.
+ * @param[in] cmp_fp   - comparator function pointer.
+ *
+ * @return: this is void function.
+ */
+static inline void __darray_raw_argsort_insertion(const uint8_t* barray_p, size_t size_of, void* idx_p, size_t idx_size,
+                                                  size_t left, size_t right, compare_fp cmp_fp);
+
+
+/*
+ * Internal function which merge sorted index ranges [@left, @middle) and [@middle, @right) of @src_p into @dst_p.
+ *
+ * @param[in]  barray_p - pointer to array of records.
+ * @param[in]  size_of  - size of each array member.
+ * @param[in]  src_p    - pointer to source array of indexes.
+ * @param[out] dst_p    - pointer to destination array of indexes.
+ * @param[in]  idx_size - size of each index.
+ * @param[in]  left     - first position of first range.
+ * @param[in]  middle   - first position of second range.
+ * @param[in]  right    - position after second range.
+ * @param[in]  cmp_fp   - comparator function pointer.
+ *
+ * @return: this is void function.
+ */
+static inline void __darray_raw_argsort_merge(const uint8_t* barray_p, size_t size_of, const void* src_p, void* dst_p, size_t idx_size,
+                                              size_t left, size_t middle, size_t right, compare_fp cmp_fp);
+
+
+/*
+ * Internal function which gather records: @dst_p[i] = @src_p[@idx_p[i]] for each i.
+ *
+ * @param[out] dst_p    - pointer to destination array.
+ * @param[in]  src_p    - pointer to source array.
+ * @param[in]  size_of  - size of each array member.
+ * @param[in]  length   - number of elements in arrays.
+ * @param[in]  idx_p    - pointer to array of indexes.
+ * @param[in]  idx_size - size of each index.
+ *
+ * @return: this is void function.
+ */
+static void __darray_raw_gather(uint8_t* restrict dst_p, const uint8_t* restrict src_p, size_t size_of, size_t length, const void* idx_p, size_t idx_size);
+
+
+static inline size_t __darray_raw_idx_get(const void* const idx_p, const size_t idx_size, const size_t pos)
+{
+    if (idx_size == sizeof(uint32_t))
+    {
+        return ((const uint32_t*)idx_p)[pos];
+    }
+
+    return ((const size_t*)idx_p)[pos];
+}
+
+
+static inline void __darray_raw_idx_set(void* const idx_p, const size_t idx_size, const size_t pos, const size_t idx)
+{
+    if (idx_size == sizeof(uint32_t))
+    {
+        ((uint32_t*)idx_p)[pos] = (uint32_t)idx;
+    }
+    else
+    {
+        ((size_t*)idx_p)[pos] = idx;
+    }
+}
+
+
+static inline void __darray_raw_argsort_insertion(const uint8_t* const barray_p, const size_t size_of, void* const idx_p, const size_t idx_size,
+                                                  const size_t left, const size_t right, const compare_fp cmp_fp)
+{
+    for (size_t i = left + 1; i < right; ++i)
+    {
+        register const size_t tmp = __darray_raw_idx_get(idx_p, idx_size, i);
+        register size_t j = i;
+
+        for (; j > left && cmp_fp(&barray_p[tmp * size_of], &barray_p[__darray_raw_idx_get(idx_p, idx_size, j - 1) * size_of]) < 0; --j)
+        {
+            __darray_raw_idx_set(idx_p, idx_size, j, __darray_raw_idx_get(idx_p, idx_size, j - 1));
+        }
+
+        __darray_raw_idx_set(idx_p, idx_size, j, tmp);
+    }
+}
+
+
+static inline void __darray_raw_argsort_merge(const uint8_t* const barray_p, const size_t size_of, const void* const src_p, void* const dst_p, const size_t idx_size,
+                                              const size_t left, const size_t middle, const size_t right, const compare_fp cmp_fp)
+{
+    register size_t i = left;
+    register size_t j = middle;
+    register size_t k = left;
+
+    /* ranges are already in order, so merge is plain copy */
+    if (middle == right ||
+        cmp_fp(&barray_p[__darray_raw_idx_get(src_p, idx_size, middle - 1) * size_of], &barray_p[__darray_raw_idx_get(src_p, idx_size, middle) * size_of]) <= 0)
+    {
+        memcpy((uint8_t*)dst_p + left * idx_size, (const uint8_t*)src_p + left * idx_size, (right - left) * idx_size);
+        return;
+    }
+
+    while (i < middle && j < right)
+    {
+        register const size_t first = __darray_raw_idx_get(src_p, idx_size, i);
+        register const size_t second = __darray_raw_idx_get(src_p, idx_size, j);
+
+        /* second range wins only when strictly less, so equal elements keep original order */
+        if (cmp_fp(&barray_p[second * size_of], &barray_p[first * size_of]) < 0)
+        {
+            __darray_raw_idx_set(dst_p, idx_size, k++, second);
+            j++;
+        }
+        else
+        {
+            __darray_raw_idx_set(dst_p, idx_size, k++, first);
+            i++;
+        }
+    }
+
+    if (i < middle)
+    {
+        memcpy((uint8_t*)dst_p + k * idx_size, (const uint8_t*)src_p + i * idx_size, (middle - i) * idx_size);
+    }
+
+    if (j < right)
+    {
+        memcpy((uint8_t*)dst_p + k * idx_size, (const uint8_t*)src_p + j * idx_size, (right - j) * idx_size);
+    }
+}
+
+
+static void __darray_raw_gather(uint8_t* const restrict dst_p, const uint8_t* const restrict src_p, const size_t size_of, const size_t length,
+                                const void* const idx_p, const size_t idx_size)
+{
+    register const size_t prefetch_end = length > DARRAY_RAW_GATHER_PREFETCH ? length - DARRAY_RAW_GATHER_PREFETCH : 0;
+
+    /* copies of constant size are compiled into single load and store */
+#define DARRAY_RAW_GATHER_LOOP(bytes) \
+    for (size_t i = 0; i < length; ++i) \
+    { \
+        if (i < prefetch_end) \
+        { \
+            __builtin_prefetch(&src_p[__darray_raw_idx_get(idx_p, idx_size, i + DARRAY_RAW_GATHER_PREFETCH) * (bytes)]); \
+        } \
+        \
+        memcpy(&dst_p[i * (bytes)], &src_p[__darray_raw_idx_get(idx_p, idx_size, i) * (bytes)], (bytes)); \
+    }
+
+    switch (size_of)
+    {
+        case 1: DARRAY_RAW_GATHER_LOOP(1) break;
+        case 2: DARRAY_RAW_GATHER_LOOP(2) break;
+        case 4: DARRAY_RAW_GATHER_LOOP(4) break;
+        case 8: DARRAY_RAW_GATHER_LOOP(8) break;
+        case 16: DARRAY_RAW_GATHER_LOOP(16) break;
+        default: DARRAY_RAW_GATHER_LOOP(size_of) break;
+    }
+
+#undef DARRAY_RAW_GATHER_LOOP
+}
+
+
+int darray_raw_argsort(const void* const array_p, const size_t size_of, const size_t length, const compare_fp cmp_fp, void* const idx_p, const size_t idx_size)
+{
+    if (array_p == NULL)
+    {
+        perror("DArrayRaw: argument array_p is NULL\n");
+        return -1;
+    }
+
+    if (size_of == 0)
+    {
+        perror("DArrayRaw: argument size_of has to small value\n");
+        return -1;
+    }
+
+    if (length == 0)
+    {
+        perror("DArrayRaw: argument length has to small value\n");
+        return -1;
+    }
+
+    if (cmp_fp == NULL)
+    {
+        perror("DArrayRaw: argument cmp_fp is NULL\n");
+        return -1;
+    }
+
+    if (idx_p == NULL)
+    {
+        perror("DArrayRaw: argument idx_p is NULL\n");
+        return -1;
+    }
+
+    if (idx_size != sizeof(uint32_t) && idx_size != sizeof(size_t))
+    {
+        perror("DArrayRaw: argument idx_size has to be sizeof(uint32_t) or sizeof(size_t)\n");
+        return -1;
+    }
+
+    if (idx_size == sizeof(uint32_t) && length > (size_t)UINT32_MAX)
+    {
+        perror("DArrayRaw: argument length is too big for 32-bit indexes\n");
+        return -1;
+    }
+
+    register const uint8_t* const barray_p = array_p;
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        __darray_raw_idx_set(idx_p, idx_size, i, i);
+    }
+
+    for (size_t left = 0; left < length; left += DARRAY_RAW_ARGSORT_BLOCK)
+    {
+        register const size_t right = length - left < DARRAY_RAW_ARGSORT_BLOCK ? length : left + DARRAY_RAW_ARGSORT_BLOCK;
+        __darray_raw_argsort_insertion(barray_p, size_of, idx_p, idx_size, left, right, cmp_fp);
+    }
+
+    if (length <= DARRAY_RAW_ARGSORT_BLOCK)
+    {
+        return 0;
+    }
+
+    void* const tmp_p = malloc(length * idx_size);
+
+    if (tmp_p == NULL)
+    {
+        perror("DArrayRaw: malloc error\n");
+        return -1;
+    }
+
+    /* bottom-up merging, indexes go back and forth between caller array and temporary buffer */
+    register const void* src_p = idx_p;
+    register void* dst_p = tmp_p;
+
+    for (size_t width = DARRAY_RAW_ARGSORT_BLOCK; width < length; width *= 2)
+    {
+        for (size_t left = 0; left < length; left += 2 * width)
+        {
+            register const size_t middle = length - left < width ? length : left + width;
+            register const size_t right = length - middle < width ? length : middle + width;
+
+            __darray_raw_argsort_merge(barray_p, size_of, src_p, dst_p, idx_size, left, middle, right, cmp_fp);
+        }
+
+        register void* const swap_p = dst_p;
+        dst_p = (void*)src_p;
+        src_p = swap_p;
+    }
+
+    if (src_p != idx_p)
+    {
+        memcpy(idx_p, src_p, length * idx_size);
+    }
+
+    free(tmp_p);
+
+    return 0;
+}
+
+
+int darray_raw_apply_permutation(void* const array_p, const size_t size_of, const size_t length, const void* const idx_p, const size_t idx_size)
+{
+    if (array_p == NULL)
+    {
+        perror("DArrayRaw: argument array_p is NULL\n");
+        return -1;
+    }
+
+    if (size_of == 0)
+    {
+        perror("DArrayRaw: argument size_of has to small value\n");
+        return -1;
+    }
+
+    if (length == 0)
+    {
+        perror("DArrayRaw: argument length has to small value\n");
+        return -1;
+    }
+
+    if (idx_p == NULL)
+    {
+        perror("DArrayRaw: argument idx_p is NULL\n");
+        return -1;
+    }
+
+    if (idx_size != sizeof(uint32_t) && idx_size != sizeof(size_t))
+    {
+        perror("DArrayRaw: argument idx_size has to be sizeof(uint32_t) or sizeof(size_t)\n");
+        return -1;
+    }
+
+    register const size_t nwords = (length + DARRAY_RAW_PERM_WORD_BITS - 1) / DARRAY_RAW_PERM_WORD_BITS;
+    uint64_t* const visited_p = calloc(nwords, sizeof(*visited_p));
+
+    if (visited_p == NULL)
+    {
+        perror("DArrayRaw: calloc error\n");
+        return -1;
+    }
+
+    /* array is not touched until @idx_p is known to be a permutation */
+    for (size_t i = 0; i < length; ++i)
+    {
+        register const size_t idx = __darray_raw_idx_get(idx_p, idx_size, i);
+        register const uint64_t bit = (uint64_t)1 << (idx % DARRAY_RAW_PERM_WORD_BITS);
+
+        if (idx >= length || (visited_p[idx / DARRAY_RAW_PERM_WORD_BITS] & bit) != 0)
+        {
+            perror("DArrayRaw: argument idx_p is not a permutation\n");
+            free(visited_p);
+            return -1;
+        }
+
+        visited_p[idx / DARRAY_RAW_PERM_WORD_BITS] |= bit;
+    }
+
+    memset(visited_p, 0, nwords * sizeof(*visited_p));
+
+    register uint8_t* const barray_p = array_p;
+    uint8_t tmp[size_of];
+
+    for (size_t start = 0; start < length; ++start)
+    {
+        if ((visited_p[start / DARRAY_RAW_PERM_WORD_BITS] & ((uint64_t)1 << (start % DARRAY_RAW_PERM_WORD_BITS))) != 0)
+        {
+            continue;
+        }
+
+        register size_t pos = start;
+        register size_t next = __darray_raw_idx_get(idx_p, idx_size, pos);
+
+        visited_p[pos / DARRAY_RAW_PERM_WORD_BITS] |= (uint64_t)1 << (pos % DARRAY_RAW_PERM_WORD_BITS);
+
+        /* fixed point, record is already in place */
+        if (next == start)
+        {
+            continue;
+        }
+
+        assign(&tmp[0], &barray_p[start * size_of], size_of);
+
+        while (next != start)
+        {
+            assign(&barray_p[pos * size_of], &barray_p[next * size_of], size_of);
+
+            pos = next;
+            next = __darray_raw_idx_get(idx_p, idx_size, pos);
+
+            visited_p[pos / DARRAY_RAW_PERM_WORD_BITS] |= (uint64_t)1 << (pos % DARRAY_RAW_PERM_WORD_BITS);
+        }
+
+        assign(&barray_p[pos * size_of], &tmp[0], size_of);
+    }
+
+    free(visited_p);
+
+    return 0;
+}
+
+
+int darray_raw_sort_by_key(void* const keys_p, const size_t key_size, const size_t length, const compare_fp cmp_fp,
+                           void* const* const payloads_p, const size_t* const payload_sizes_p, const size_t npayloads)
+{
+    if (keys_p == NULL)
+    {
+        perror("DArrayRaw: argument keys_p is NULL\n");
+        return -1;
+    }
+
+    if (key_size == 0)
+    {
+        perror("DArrayRaw: argument key_size has to small value\n");
+        return -1;
+    }
+
+    if (length == 0)
+    {
+        perror("DArrayRaw: argument length has to small value\n");
+        return -1;
+    }
+
+    if (cmp_fp == NULL)
+    {
+        perror("DArrayRaw: argument cmp_fp is NULL\n");
+        return -1;
+    }
+
+    if (npayloads > 0 && (payloads_p == NULL || payload_sizes_p == NULL))
+    {
+        perror("DArrayRaw: argument payloads_p is NULL\n");
+        return -1;
+    }
+
+    register size_t max_size = key_size;
+
+    for (size_t i = 0; i < npayloads; ++i)
+    {
+        if (payloads_p[i] == NULL || payload_sizes_p[i] == 0)
+        {
+            perror("DArrayRaw: argument payloads_p contains invalid column\n");
+            return -1;
+        }
+
+        max_size = payload_sizes_p[i] > max_size ? payload_sizes_p[i] : max_size;
+    }
+
+    register const size_t idx_size = length <= (size_t)UINT32_MAX ? sizeof(uint32_t) : sizeof(size_t);
+    void* const idx_p = malloc(length * idx_size);
+
+    if (idx_p == NULL)
+    {
+        perror("DArrayRaw: malloc error\n");
+        return -1;
+    }
+
+    if (darray_raw_argsort(keys_p, key_size, length, cmp_fp, idx_p, idx_size) != 0)
+    {
+        free(idx_p);
+        return -1;
+    }
+
+    /* one temporary column is reused for all columns */
+    uint8_t* const column_p = malloc(length * max_size);
+    register int ret = 0;
+
+    for (size_t i = 0; i <= npayloads && ret == 0; ++i)
+    {
+        void* const dst_p = i == 0 ? keys_p : payloads_p[i - 1];
+        register const size_t size_of = i == 0 ? key_size : payload_sizes_p[i - 1];
+
+        if (column_p == NULL)
+        {
+            ret = darray_raw_apply_permutation(dst_p, size_of, length, idx_p, idx_size);
+            continue;
+        }
+
+        __darray_raw_gather(column_p, dst_p, size_of, length, idx_p, idx_size);
+        memcpy(dst_p, column_p, length * size_of);
+    }
+
+    free(column_p);
+    free(idx_p);
+
+    return ret;
+}
@@ -0,0 +1,298 @@
+#include <darray_raw/darray_raw.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/*
+    Scans with batch comparator.
+
+    Comparator is called once per block of DARRAY_RAW_BATCH_LENGTH elements instead of once per element, so cost
+    of indirect call is amortized and comparator can be vectorized by caller. Results of block are scanned by
+    simple loops over int8_t, which are vectorized by compiler. Results are the same as for per-element versions.
+*/
+
+
+/* number of elements compared by one call of batch comparator */
+#define DARRAY_RAW_BATCH_LENGTH ((size_t)128)
+
+/* minima of lanes in darray_raw_find_min_batch are kept on stack up to this size, on heap above it */
+#define DARRAY_RAW_BATCH_STACK_BYTES ((size_t)2048)
+
+
+ssize_t darray_raw_find_min_batch(const void* const array_p, const size_t size_of, const size_t length, const compare_batch_fp cmp_fp, void* const out_p)
+{
+    if (array_p == NULL)
+    {
+        perror("DArrayRaw: argument array_p is NULL\n");
+        return -1;
+    }
+
+    if (size_of == 0)
+    {
+        perror("DArrayRaw: argument size_of has to small value\n");
+        return -1;
+    }
+
+    if (length == 0)
+    {
+        perror("DArrayRaw: argument length has to small value\n");
+        return -1;
+    }
+
+    if (cmp_fp == NULL)
+    {
+        perror("DArrayRaw: argument cmp_fp is NULL\n");
+        return -1;
+    }
+
+    register const uint8_t* const barray_p = array_p;
+    register const size_t lanes = length < DARRAY_RAW_BATCH_LENGTH ? length : DARRAY_RAW_BATCH_LENGTH;
+    uint8_t stack_buffer[DARRAY_RAW_BATCH_STACK_BYTES];
+    uint8_t* lane_p = &stack_buffer[0];
+    size_t lane_idx[DARRAY_RAW_BATCH_LENGTH];
+    int8_t out[DARRAY_RAW_BATCH_LENGTH];
+
+    if (lanes * size_of > sizeof(stack_buffer))
+    {
+        lane_p = malloc(lanes * size_of);
+
+        if (lane_p == NULL)
+        {
+            perror("DArrayRaw: malloc error\n");
+            return -1;
+        }
+    }
+
+    /* first block is initial minimum of each lane */
+    (void)memcpy(&lane_p[0], &barray_p[0], lanes * size_of);
+
+    for (size_t i = 0; i < lanes; ++i)
+    {
+        lane_idx[i] = i;
+    }
+
+    /* each next block is compared lane by lane with minima in one call, strictly smaller elements replace them */
+    for (size_t idx = lanes; idx < length; idx += lanes)
+    {
+        register const size_t n = length - idx < lanes ? length - idx : lanes;
+
+        cmp_fp(&barray_p[idx * size_of], size_of, &lane_p[0], size_of, n, &out[0]);
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            if (out[i] < 0)
+            {
+                assign(&lane_p[i * size_of], &barray_p[(idx + i) * size_of], size_of);
+                lane_idx[i] = idx + i;
+            }
+        }
+    }
+
+    /* pairwise reduction of lanes, from equal minima the one with lower index wins */
+    for (size_t width = lanes; width > 1; )
+    {
+        register const size_t half = width / 2;
+        register const size_t right = width - half;
+
+        cmp_fp(&lane_p[right * size_of], size_of, &lane_p[0], size_of, half, &out[0]);
+
+        for (size_t i = 0; i < half; ++i)
+        {
+            if (out[i] < 0 || (out[i] == 0 && lane_idx[right + i] < lane_idx[i]))
+            {
+                assign(&lane_p[i * size_of], &lane_p[(right + i) * size_of], size_of);
+                lane_idx[i] = lane_idx[right + i];
+            }
+        }
+
+        width = right;
+    }
+
+    register const size_t min_idx = lane_idx[0];
+
+    if (lane_p != &stack_buffer[0])
+    {
+        free(lane_p);
+    }
+
+    if (out_p != NULL)
+    {
+        assign(out_p, &barray_p[min_idx * size_of], size_of);
+    }
+
+    return (ssize_t)min_idx;
+}
+
+
+ssize_t darray_raw_unsorted_find_first_batch(const void* const restrict array_p, const size_t size_of, const size_t length,
+                                             const void* const restrict key_p, const compare_batch_fp cmp_fp, void* const out_p)
+{
+    if (array_p == NULL)
+    {
+        perror("DArrayRaw: argument array_p is NULL\n");
+        return -1;
+    }
+
+    if (size_of == 0)
+    {
+        perror("DArrayRaw: argument size_of has to small value\n");
+        return -1;
+    }
+
+    if (length == 0)
+    {
+        perror("DArrayRaw: argument length has to small value\n");
+        return -1;
+    }
+
+    if (key_p == NULL)
+    {
+        perror("DArrayRaw: argument key_p is NULL\n");
+        return -1;
+    }
+
+    if (cmp_fp == NULL)
+    {
+        perror("DArrayRaw: argument cmp_fp is NULL\n");
+        return -1;
+    }
+
+    register const uint8_t* const restrict barray_p = array_p;
+    int8_t out[DARRAY_RAW_BATCH_LENGTH];
+
+    for (size_t idx = 0; idx < length; idx += array_size(out))
+    {
+        register const size_t n = length - idx < array_size(out) ? length - idx : array_size(out);
+
+        cmp_fp(&barray_p[idx * size_of], size_of, key_p, 0, n, &out[0]);
+
+        register const int8_t* const found_p = memchr(&out[0], 0, n);
+
+        if (found_p != NULL)
+        {
+            register const size_t found_idx = idx + (size_t)(found_p - &out[0]);
+
+            if (out_p != NULL)
+            {
+                assign(out_p, &barray_p[found_idx * size_of], size_of);
+            }
+
+            return (ssize_t)found_idx;
+        }
+    }
+
+    return -1;
+}
+
+
+bool darray_raw_equal_batch(const void* const first_array_p, const void* const second_array_p, const size_t size_of, const size_t length, const compare_batch_fp cmp_fp)
+{
+    if (first_array_p == NULL)
+    {
+        perror("DArrayRaw: argument first_array_p is NULL\n");
+        return false;
+    }
+
+    if (second_array_p == NULL)
+    {
+        perror("DArrayRaw: argument second_array_p is NULL\n");
+        return false;
+    }
+
+    if (size_of == 0)
+    {
+        perror("DArrayRaw: argument size_of has to small value\n");
+        return false;
+    }
+
+    if (length == 0)
+    {
+        perror("DArrayRaw: argument length has to small value\n");
+        return false;
+    }
+
+    if (cmp_fp == NULL)
+    {
+        perror("DArrayRaw: argument cmp_fp is NULL\n");
+        return false;
+    }
+
+    register const uint8_t* const first_barray_p = first_array_p;
+    register const uint8_t* const second_barray_p = second_array_p;
+    int8_t out[DARRAY_RAW_BATCH_LENGTH];
+
+    for (size_t idx = 0; idx < length; idx += array_size(out))
+    {
+        register const size_t n = length - idx < array_size(out) ? length - idx : array_size(out);
+
+        cmp_fp(&first_barray_p[idx * size_of], size_of, &second_barray_p[idx * size_of], size_of, n, &out[0]);
+
+        register int8_t any = 0;
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            any |= out[i];
+        }
+
+        if (any != 0)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+bool darray_raw_is_sorted_batch(const void* const array_p, const size_t size_of, const size_t length, const compare_batch_fp cmp_fp)
+{
+    if (array_p == NULL)
+    {
+        perror("DArrayRaw: argument array_p is NULL\n");
+        return false;
+    }
+
+    if (size_of == 0)
+    {
+        perror("DArrayRaw: argument size_of has to small value\n");
+        return false;
+    }
+
+    if (length == 0)
+    {
+        perror("DArrayRaw: argument length has to small value\n");
+        return false;
+    }
+
+    if (cmp_fp == NULL)
+    {
+        perror("DArrayRaw: argument cmp_fp is NULL\n");
+        return false;
+    }
+
+    register const uint8_t* const barray_p = array_p;
+    int8_t out[DARRAY_RAW_BATCH_LENGTH];
+
+    /* element i is compared with element i + 1 */
+    for (size_t idx = 0; idx < length - 1; idx += array_size(out))
+    {
+        register const size_t n = length - 1 - idx < array_size(out) ? length - 1 - idx : array_size(out);
+
+        cmp_fp(&barray_p[idx * size_of], size_of, &barray_p[(idx + 1) * size_of], size_of, n, &out[0]);
+
+        register int8_t max = 0;
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            max = out[i] > max ? out[i] : max;
+        }
+
+        if (max > 0)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
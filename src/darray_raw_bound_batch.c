@@ -0,0 +1,267 @@
+#include <darray_raw/darray_raw.h>
+#include <stdio.h>
+
+
+/*
+    Batched lower/upper bound and find first of many keys in one sorted array.
+
+    1. Sorted   - when keys are sorted, results are not decreasing, so each key is searched from result of previous key
+                  by exponential search (merge of keys with array, O(log gap) comparisons per key).
+    2. Groups   - otherwise keys are searched in groups of DARRAY_RAW_BOUND_BATCH_GROUP. All searches of group have the
+                  same range length in each step (the same array), so they advance in lockstep: every search makes one
+                  step and prefetches its next probe, then next search of group is stepped. Probe of search is loaded
+                  while other searches of group work, so cache misses of group overlap instead of forming one chain.
+    3. Steps    - each step is the same as in darray_raw_lower_bound: base index moves by comparison result times half.
+*/
+
+
+/* number of searches which advance in lockstep */
+#define DARRAY_RAW_BOUND_BATCH_GROUP    ((size_t)16)
+
+
+/* kind of batched search */
+typedef enum darray_raw_bound_batch_e
+{
+    DARRAY_RAW_BOUND_BATCH_LOWER,
+    DARRAY_RAW_BOUND_BATCH_UPPER,
+    DARRAY_RAW_BOUND_BATCH_FIND_FIRST,
+} darray_raw_bound_batch_e;
+
+
+/*
+ * Internal function which search group of keys in lockstep.
+ *
+ * @param[in]  barray_p - pointer to array.
+ * @param[in]  size_of  - size of each array member.
+ * @param[in]  length   - number of elements in array.
+ * @param[in]  bkeys_p  - pointer to keys of group.
+ * @param[in]  nkeys    - number of keys in group (at most DARRAY_RAW_BOUND_BATCH_GROUP).
+ * @param[in]  cmp_fp   - comparator function pointer, called as cmp_fp(key, array member).
+ * @param[in]  limit    - search goes right when comparator result is not less than @limit.
+ * @param[out] out_p    - bound index of each key.
+ *
+ * @return: this is void function.
+ */
+static void __darray_raw_bound_batch_group(const uint8_t* barray_p, size_t size_of, size_t length, const uint8_t* bkeys_p, size_t nkeys,
+                                           const compare_fp cmp_fp, int limit, ssize_t* out_p);
+
+
+/*
+ * Internal function which search sorted keys, each one by exponential search from result of previous key.
+ *
+ * @param[in]  barray_p - pointer to array.
+ * @param[in]  size_of  - size of each array member.
+ * @param[in]  length   - number of elements in array.
+ * @param[in]  bkeys_p  - pointer to sorted keys.
+ * @param[in]  nkeys    - number of keys.
+ * @param[in]  cmp_fp   - comparator function pointer, called as cmp_fp(key, array member).
+ * @param[in]  limit    - search goes right when comparator result is not less than @limit.
+ * @param[out] out_p    - bound index of each key.
+ *
+ * @return: this is void function.
+ */
+static void __darray_raw_bound_batch_sorted(const uint8_t* barray_p, size_t size_of, size_t length, const uint8_t* bkeys_p, size_t nkeys,
+                                            const compare_fp cmp_fp, int limit, ssize_t* out_p);
+
+
+/*
+ * Internal function which check arguments and run batched search of kind @kind.
+ *
+ * @param[in]  array_p - pointer to sorted array.
+ * @param[in]  size_of - size of each array member (and each key).
+ * @param[in]  length  - number of elements in array.
+ * @param[in]  keys_p  - pointer to keys.
+ * @param[in]  nkeys   - number of keys.
+ * @param[in]  cmp_fp  - comparator function pointer.
+ * @param[in]  kind    - kind of search.
+ * @param[out] out_p   - result of each key.
+ *
+ * @return: 0 on success, -1 on failure.
+ */
+static int __darray_raw_bound_batch(const void* array_p, size_t size_of, size_t length, const void* keys_p, size_t nkeys,
+                                    const compare_fp cmp_fp, darray_raw_bound_batch_e kind, ssize_t* out_p);
+
+
+static void __darray_raw_bound_batch_group(const uint8_t* const barray_p, const size_t size_of, const size_t length, const uint8_t* const bkeys_p,
+                                           const size_t nkeys, const compare_fp cmp_fp, const int limit, ssize_t* const out_p)
+{
+    size_t base[DARRAY_RAW_BOUND_BATCH_GROUP] = { 0 };
+    register size_t len = length;
+
+    while (len > 1)
+    {
+        register const size_t half = len / 2;
+        register const size_t next_half = (len - half) / 2;
+
+        for (size_t i = 0; i < nkeys; ++i)
+        {
+            register const size_t new_base = base[i] + (size_t)(cmp_fp(&bkeys_p[i * size_of], &barray_p[(base[i] + half - 1) * size_of]) >= limit) * half;
+
+            /* probe of next step is known now, it is loaded while other searches of group are stepped */
+            if (next_half > 0)
+            {
+                __builtin_prefetch(&barray_p[(new_base + next_half - 1) * size_of], 0, 3);
+            }
+            else
+            {
+                __builtin_prefetch(&barray_p[new_base * size_of], 0, 3);
+            }
+
+            base[i] = new_base;
+        }
+
+        len -= half;
+    }
+
+    for (size_t i = 0; i < nkeys; ++i)
+    {
+        out_p[i] = (ssize_t)(base[i] + (size_t)(cmp_fp(&bkeys_p[i * size_of], &barray_p[base[i] * size_of]) >= limit));
+    }
+}
+
+
+static void __darray_raw_bound_batch_sorted(const uint8_t* const barray_p, const size_t size_of, const size_t length, const uint8_t* const bkeys_p,
+                                            const size_t nkeys, const compare_fp cmp_fp, const int limit, ssize_t* const out_p)
+{
+    register size_t pos = 0;
+
+    for (size_t i = 0; i < nkeys; ++i)
+    {
+        register const void* const key_p = &bkeys_p[i * size_of];
+
+        /* members before @low go right, member at @probe is next one to check */
+        register size_t low = pos;
+        register size_t probe = pos;
+        register size_t step = 1;
+
+        while (probe < length && cmp_fp(key_p, &barray_p[probe * size_of]) >= limit)
+        {
+            low = probe + 1;
+            probe = low + step;
+            step *= 2;
+        }
+
+        register size_t high = probe < length ? probe : length;
+
+        while (low < high)
+        {
+            register const size_t middle = low + (high - low) / 2;
+
+            if (cmp_fp(key_p, &barray_p[middle * size_of]) >= limit)
+            {
+                low = middle + 1;
+            }
+            else
+            {
+                high = middle;
+            }
+        }
+
+        pos = low;
+        out_p[i] = (ssize_t)pos;
+    }
+}
+
+
+static int __darray_raw_bound_batch(const void* const array_p, const size_t size_of, const size_t length, const void* const keys_p, const size_t nkeys,
+                                    const compare_fp cmp_fp, const darray_raw_bound_batch_e kind, ssize_t* const out_p)
+{
+    if (array_p == NULL)
+    {
+        perror("DArrayRaw: argument array_p is NULL\n");
+        return -1;
+    }
+
+    if (size_of == 0)
+    {
+        perror("DArrayRaw: argument size_of has to small value\n");
+        return -1;
+    }
+
+    if (length == 0)
+    {
+        perror("DArrayRaw: argument length has to small value\n");
+        return -1;
+    }
+
+    if (keys_p == NULL && nkeys > 0)
+    {
+        perror("DArrayRaw: argument keys_p is NULL\n");
+        return -1;
+    }
+
+    if (cmp_fp == NULL)
+    {
+        perror("DArrayRaw: argument cmp_fp is NULL\n");
+        return -1;
+    }
+
+    if (out_p == NULL && nkeys > 0)
+    {
+        perror("DArrayRaw: argument out_p is NULL\n");
+        return -1;
+    }
+
+    register const uint8_t* const barray_p = array_p;
+    register const uint8_t* const bkeys_p = keys_p;
+
+    /* lower bound goes right when key > member, upper bound when key >= member */
+    register const int limit = kind == DARRAY_RAW_BOUND_BATCH_UPPER ? 0 : 1;
+
+    register size_t sorted = 1;
+
+    while (sorted < nkeys && cmp_fp(&bkeys_p[(sorted - 1) * size_of], &bkeys_p[sorted * size_of]) <= 0)
+    {
+        ++sorted;
+    }
+
+    if (sorted >= nkeys)
+    {
+        __darray_raw_bound_batch_sorted(barray_p, size_of, length, bkeys_p, nkeys, cmp_fp, limit, out_p);
+    }
+    else
+    {
+        for (size_t i = 0; i < nkeys; i += DARRAY_RAW_BOUND_BATCH_GROUP)
+        {
+            register const size_t n = nkeys - i < DARRAY_RAW_BOUND_BATCH_GROUP ? nkeys - i : DARRAY_RAW_BOUND_BATCH_GROUP;
+
+            __darray_raw_bound_batch_group(barray_p, size_of, length, &bkeys_p[i * size_of], n, cmp_fp, limit, &out_p[i]);
+        }
+    }
+
+    if (kind == DARRAY_RAW_BOUND_BATCH_FIND_FIRST)
+    {
+        for (size_t i = 0; i < nkeys; ++i)
+        {
+            register const size_t idx = (size_t)out_p[i];
+
+            if (idx == length || cmp_fp(&barray_p[idx * size_of], &bkeys_p[i * size_of]) != 0)
+            {
+                out_p[i] = -1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+
+int darray_raw_lower_bound_batch(const void* const array_p, const size_t size_of, const size_t length, const void* const keys_p, const size_t nkeys,
+                                 const compare_fp cmp_fp, ssize_t* const out_idx_p)
+{
+    return __darray_raw_bound_batch(array_p, size_of, length, keys_p, nkeys, cmp_fp, DARRAY_RAW_BOUND_BATCH_LOWER, out_idx_p);
+}
+
+
+int darray_raw_upper_bound_batch(const void* const array_p, const size_t size_of, const size_t length, const void* const keys_p, const size_t nkeys,
+                                 const compare_fp cmp_fp, ssize_t* const out_idx_p)
+{
+    return __darray_raw_bound_batch(array_p, size_of, length, keys_p, nkeys, cmp_fp, DARRAY_RAW_BOUND_BATCH_UPPER, out_idx_p);
+}
+
+
+int darray_raw_sorted_find_first_batch(const void* const array_p, const size_t size_of, const size_t length, const void* const keys_p, const size_t nkeys,
+                                       const compare_fp cmp_fp, ssize_t* const out_idx_p)
+{
+    return __darray_raw_bound_batch(array_p, size_of, length, keys_p, nkeys, cmp_fp, DARRAY_RAW_BOUND_BATCH_FIND_FIRST, out_idx_p);
+}
@@ -0,0 +1,1018 @@
+#define _FILE_OFFSET_BITS 64
+
+#include <darray_raw/darray_raw.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+/*
+    External-memory sort of file with fixed-size records.
+
+    1. Runs   - input file is read in chunks of half of memory budget, each chunk is sorted by darray_raw_sort
+                and appended as a run to temporary file. Next chunk is read while current one is sorted.
+    2. Merge  - up to fan-in runs are merged with binary heap into one run of second temporary file,
+                until all runs can be merged directly into output file.
+    3. I/O    - every stream (run being read or file being written) has two blocks. One block is consumed or filled
+                by merge while the other one is read or written by I/O thread, so disk and CPU work overlap.
+
+    Temporary files are unlinked right after creation, so nothing is left on disk even if process is killed.
+*/
+
+
+/* minimal size of one I/O block, smaller blocks are used only when memory budget is very small */
+#define DARRAY_RAW_XSORT_MIN_BLOCK      ((size_t)1 << 16)
+
+/* temporary directory used when caller does not pass own */
+#define DARRAY_RAW_XSORT_TMP_DIR        "/tmp"
+
+
+/* one asynchronous read or write request */
+typedef struct DArrayRawXSortIoS
+{
+    int fd;
+    uint8_t* buffer_p;
+    size_t bytes;
+    off_t offset;
+    bool write;
+
+    bool pending;
+    ssize_t result;     /* number of transferred bytes or -1 on error */
+
+    struct DArrayRawXSortIoS* next_p;
+} DArrayRawXSortIoS;
+
+
+/* I/O thread with FIFO of requests */
+typedef struct DArrayRawXSortIoThreadS
+{
+    pthread_t thread;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+
+    DArrayRawXSortIoS* head_p;
+    DArrayRawXSortIoS* tail_p;
+    bool stop;
+} DArrayRawXSortIoThreadS;
+
+
+/* double-buffered sequential reader of one run */
+typedef struct DArrayRawXSortInputS
+{
+    int fd;
+    off_t offset;       /* offset of next block to request */
+    off_t end;          /* end of run */
+    size_t block;
+
+    uint8_t* buffers_p[2];
+    DArrayRawXSortIoS io[2];
+    size_t current;
+    size_t pos;         /* bytes consumed from current block */
+    size_t filled;      /* bytes in current block, 0 when run is exhausted */
+} DArrayRawXSortInputS;
+
+
+/* double-buffered sequential writer */
+typedef struct DArrayRawXSortOutputS
+{
+    int fd;
+    off_t offset;
+    size_t block;
+
+    uint8_t* buffers_p[2];
+    DArrayRawXSortIoS io[2];
+    size_t current;
+    size_t pos;
+    bool error;
+} DArrayRawXSortOutputS;
+
+
+/* state of one external sort call */
+typedef struct DArrayRawXSortS
+{
+    size_t size_of;
+    compare_fp cmp_fp;
+
+    uint8_t* memory_p;  /* memory budget, reused by every phase */
+    size_t memory_size;
+    size_t fan_in;
+
+    off_t* run_offset_p; /* nruns + 1 offsets, run i is [run_offset_p[i], run_offset_p[i + 1]) */
+    size_t nruns;
+
+    DArrayRawXSortInputS* inputs_p;
+    size_t* heap_p;
+
+    DArrayRawXSortIoThreadS io_thread;
+} DArrayRawXSortS;
+
+
+/*
+ * Internal function which read or write all @bytes of request, restarting after interrupted and partial transfers.
+ *
+ * @param[in] io_p - request.
+ *
+ * @return: number of transferred bytes (less than requested only at end of file), -1 on error.
+ */
+static ssize_t __darray_raw_xsort_transfer(const DArrayRawXSortIoS* io_p);
+
+
+/*
+ * Internal function which is main loop of I/O thread.
+ *
+ * @param[in] arg_p - I/O thread state.
+ *
+ * @return: NULL.
+ */
+static void* __darray_raw_xsort_io_main(void* arg_p);
+
+
+/*
+ * Internal function which start I/O thread.
+ *
+ * @param[in] io_thread_p - I/O thread state.
+ *
+ * @return: 0 on success, non-zero value on failure.
+ */
+static int __darray_raw_xsort_io_start(DArrayRawXSortIoThreadS* io_thread_p);
+
+
+/*
+ * Internal function which stop I/O thread after all queued requests are done.
+ *
+ * @param[in] io_thread_p - I/O thread state.
+ *
+ * @return: this is void function.
+ */
+static void __darray_raw_xsort_io_stop(DArrayRawXSortIoThreadS* io_thread_p);
+
+
+/*
+ * Internal function which queue request for I/O thread. Request must not be pending.
+ *
+ * @param[in] io_thread_p - I/O thread state.
+ * @param[in] io_p        - request.
+ * @param[in] fd          - file descriptor.
+ * @param[in] buffer_p    - buffer to read into or write from.
+ * @param[in] bytes       - number of bytes to transfer.
+ * @param[in] offset      - offset in file.
+ * @param[in] write       - true for write, false for read.
+ *
+ * @return: this is void function.
+ */
+static void __darray_raw_xsort_io_submit(DArrayRawXSortIoThreadS* io_thread_p, DArrayRawXSortIoS* io_p, int fd, uint8_t* buffer_p,
+                                         size_t bytes, off_t offset, bool write);
+
+
+/*
+ * Internal function which wait until request is done.
+ *
+ * @param[in] io_thread_p - I/O thread state.
+ * @param[in] io_p        - request.
+ *
+ * @return: number of transferred bytes, -1 on error.
+ */
+static ssize_t __darray_raw_xsort_io_wait(DArrayRawXSortIoThreadS* io_thread_p, DArrayRawXSortIoS* io_p);
+
+
+/*
+ * Internal function which request next block of run into buffer @idx of @input_p. Nothing is requested after end of run.
+ *
+ * @param[in] ctx_p   - external sort state.
+ * @param[in] input_p - run reader.
+ * @param[in] idx     - index of buffer (0 or 1).
+ *
+ * @return: this is void function.
+ */
+static void __darray_raw_xsort_input_request(DArrayRawXSortS* ctx_p, DArrayRawXSortInputS* input_p, size_t idx);
+
+
+/*
+ * Internal function which open run reader and wait for its first block.
+ *
+ * @param[in] ctx_p    - external sort state.
+ * @param[in] input_p  - run reader.
+ * @param[in] fd       - file descriptor of file with runs.
+ * @param[in] begin    - offset of run.
+ * @param[in] end      - offset after run.
+ * @param[in] memory_p - memory for two blocks.
+ * @param[in] block    - size of block in bytes.
+ *
+ * @return: 0 on success, non-zero value on failure.
+ */
+static int __darray_raw_xsort_input_open(DArrayRawXSortS* ctx_p, DArrayRawXSortInputS* input_p, int fd, off_t begin, off_t end, uint8_t* memory_p, size_t block);
+
+
+/*
+ * Internal function which move run reader to next record.
+ *
+ * @param[in] ctx_p   - external sort state.
+ * @param[in] input_p - run reader.
+ *
+ * @return: 0 on success, non-zero value on failure.
+ */
+static int __darray_raw_xsort_input_next(DArrayRawXSortS* ctx_p, DArrayRawXSortInputS* input_p);
+
+
+/*
+ * Internal function which open writer.
+ *
+ * @param[in] output_p - writer.
+ * @param[in] fd       - file descriptor.
+ * @param[in] offset   - offset of first written byte.
+ * @param[in] memory_p - memory for two blocks.
+ * @param[in] block    - size of block in bytes.
+ *
+ * @return: this is void function.
+ */
+static void __darray_raw_xsort_output_open(DArrayRawXSortOutputS* output_p, int fd, off_t offset, uint8_t* memory_p, size_t block);
+
+
+/*
+ * Internal function which write current block and switch to the other one.
+ *
+ * @param[in] ctx_p    - external sort state.
+ * @param[in] output_p - writer.
+ *
+ * @return: this is void function.
+ */
+static void __darray_raw_xsort_output_flush(DArrayRawXSortS* ctx_p, DArrayRawXSortOutputS* output_p);
+
+
+/*
+ * Internal function which write remaining data and wait for all writes.
+ *
+ * @param[in] ctx_p    - external sort state.
+ * @param[in] output_p - writer.
+ *
+ * @return: 0 on success, non-zero value on failure.
+ */
+static int __darray_raw_xsort_output_close(DArrayRawXSortS* ctx_p, DArrayRawXSortOutputS* output_p);
+
+
+/*
+ * Internal function which create unlinked temporary file in @tmp_dir.
+ *
+ * @param[in] tmp_dir - directory for temporary file.
+ *
+ * @return: file descriptor on success, -1 on failure.
+ */
+static int __darray_raw_xsort_tmp_file(const char* tmp_dir);
+
+
+/*
+ * Internal function which read input file, sort chunks and write them as runs into @run_fd.
+ *
+ * @param[in] ctx_p  - external sort state.
+ * @param[in] in_fd  - input file descriptor.
+ * @param[in] length - number of records in input file.
+ * @param[in] run_fd - file descriptor for runs.
+ *
+ * @return: 0 on success, non-zero value on failure.
+ */
+static int __darray_raw_xsort_make_runs(DArrayRawXSortS* ctx_p, int in_fd, size_t length, int run_fd);
+
+
+/*
+ * Internal function which merge runs [@first, @first + @count) from @src_fd into @dst_fd at @dst_offset.
+ *
+ * @param[in] ctx_p      - external sort state.
+ * @param[in] src_fd     - file descriptor with runs.
+ * @param[in] first      - index of first run.
+ * @param[in] count      - number of runs to merge.
+ * @param[in] dst_fd     - destination file descriptor.
+ * @param[in] dst_offset - offset in destination file.
+ *
+ * @return: 0 on success, non-zero value on failure.
+ */
+static int __darray_raw_xsort_merge(DArrayRawXSortS* ctx_p, int src_fd, size_t first, size_t count, int dst_fd, off_t dst_offset);
+
+
+/*
+ * Internal function which move heap entry @root down the heap of run readers until heap property is restored.
+ *
+ * @param[in] ctx_p    - external sort state.
+ * @param[in] length   - number of entries in heap.
+ * @param[in] root     - index of entry to move down.
+ *
+ * @return: this is void function.
+ */
+static inline void __darray_raw_xsort_heap_sift_down(DArrayRawXSortS* ctx_p, size_t length, size_t root);
+
+
+static ssize_t __darray_raw_xsort_transfer(const DArrayRawXSortIoS* const io_p)
+{
+    register size_t done = 0;
+
+    while (done < io_p->bytes)
+    {
+        register const ssize_t ret = io_p->write ? pwrite(io_p->fd, &io_p->buffer_p[done], io_p->bytes - done, io_p->offset + (off_t)done)
+                                                 : pread(io_p->fd, &io_p->buffer_p[done], io_p->bytes - done, io_p->offset + (off_t)done);
+
+        if (ret < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            return -1;
+        }
+
+        if (ret == 0)
+        {
+            break;
+        }
+
+        done += (size_t)ret;
+    }
+
+    return (ssize_t)done;
+}
+
+
+static void* __darray_raw_xsort_io_main(void* const arg_p)
+{
+    DArrayRawXSortIoThreadS* const io_thread_p = arg_p;
+
+    pthread_mutex_lock(&io_thread_p->mutex);
+
+    for (;;)
+    {
+        while (io_thread_p->head_p == NULL && !io_thread_p->stop)
+        {
+            pthread_cond_wait(&io_thread_p->cond, &io_thread_p->mutex);
+        }
+
+        if (io_thread_p->head_p == NULL)
+        {
+            break;
+        }
+
+        DArrayRawXSortIoS* const io_p = io_thread_p->head_p;
+        io_thread_p->head_p = io_p->next_p;
+
+        if (io_thread_p->head_p == NULL)
+        {
+            io_thread_p->tail_p = NULL;
+        }
+
+        pthread_mutex_unlock(&io_thread_p->mutex);
+
+        register const ssize_t result = __darray_raw_xsort_transfer(io_p);
+
+        pthread_mutex_lock(&io_thread_p->mutex);
+
+        io_p->result = result;
+        io_p->pending = false;
+        pthread_cond_broadcast(&io_thread_p->cond);
+    }
+
+    pthread_mutex_unlock(&io_thread_p->mutex);
+
+    return NULL;
+}
+
+
+static int __darray_raw_xsort_io_start(DArrayRawXSortIoThreadS* const io_thread_p)
+{
+    io_thread_p->head_p = NULL;
+    io_thread_p->tail_p = NULL;
+    io_thread_p->stop = false;
+
+    if (pthread_mutex_init(&io_thread_p->mutex, NULL) != 0)
+    {
+        perror("DArrayRaw: pthread_mutex_init error\n");
+        return -1;
+    }
+
+    if (pthread_cond_init(&io_thread_p->cond, NULL) != 0)
+    {
+        perror("DArrayRaw: pthread_cond_init error\n");
+        pthread_mutex_destroy(&io_thread_p->mutex);
+        return -1;
+    }
+
+    if (pthread_create(&io_thread_p->thread, NULL, __darray_raw_xsort_io_main, io_thread_p) != 0)
+    {
+        perror("DArrayRaw: pthread_create error\n");
+        pthread_cond_destroy(&io_thread_p->cond);
+        pthread_mutex_destroy(&io_thread_p->mutex);
+        return -1;
+    }
+
+    return 0;
+}
+
+
+static void __darray_raw_xsort_io_stop(DArrayRawXSortIoThreadS* const io_thread_p)
+{
+    pthread_mutex_lock(&io_thread_p->mutex);
+    io_thread_p->stop = true;
+    pthread_cond_broadcast(&io_thread_p->cond);
+    pthread_mutex_unlock(&io_thread_p->mutex);
+
+    pthread_join(io_thread_p->thread, NULL);
+
+    pthread_cond_destroy(&io_thread_p->cond);
+    pthread_mutex_destroy(&io_thread_p->mutex);
+}
+
+
+static void __darray_raw_xsort_io_submit(DArrayRawXSortIoThreadS* const io_thread_p, DArrayRawXSortIoS* const io_p, const int fd, uint8_t* const buffer_p,
+                                         const size_t bytes, const off_t offset, const bool write)
+{
+    io_p->fd = fd;
+    io_p->buffer_p = buffer_p;
+    io_p->bytes = bytes;
+    io_p->offset = offset;
+    io_p->write = write;
+    io_p->next_p = NULL;
+
+    pthread_mutex_lock(&io_thread_p->mutex);
+
+    io_p->pending = true;
+
+    if (io_thread_p->tail_p == NULL)
+    {
+        io_thread_p->head_p = io_p;
+    }
+    else
+    {
+        io_thread_p->tail_p->next_p = io_p;
+    }
+
+    io_thread_p->tail_p = io_p;
+
+    pthread_cond_broadcast(&io_thread_p->cond);
+    pthread_mutex_unlock(&io_thread_p->mutex);
+}
+
+
+static ssize_t __darray_raw_xsort_io_wait(DArrayRawXSortIoThreadS* const io_thread_p, DArrayRawXSortIoS* const io_p)
+{
+    pthread_mutex_lock(&io_thread_p->mutex);
+
+    while (io_p->pending)
+    {
+        pthread_cond_wait(&io_thread_p->cond, &io_thread_p->mutex);
+    }
+
+    register const ssize_t result = io_p->result;
+
+    pthread_mutex_unlock(&io_thread_p->mutex);
+
+    return result;
+}
+
+
+static void __darray_raw_xsort_input_request(DArrayRawXSortS* const ctx_p, DArrayRawXSortInputS* const input_p, const size_t idx)
+{
+    if (input_p->offset >= input_p->end)
+    {
+        input_p->io[idx].pending = false;
+        input_p->io[idx].result = 0;
+        return;
+    }
+
+    register const size_t rest = (size_t)(input_p->end - input_p->offset);
+    register const size_t bytes = rest < input_p->block ? rest : input_p->block;
+
+    __darray_raw_xsort_io_submit(&ctx_p->io_thread, &input_p->io[idx], input_p->fd, input_p->buffers_p[idx], bytes, input_p->offset, false);
+    input_p->offset += (off_t)bytes;
+}
+
+
+static int __darray_raw_xsort_input_open(DArrayRawXSortS* const ctx_p, DArrayRawXSortInputS* const input_p, const int fd, const off_t begin, const off_t end,
+                                         uint8_t* const memory_p, const size_t block)
+{
+    input_p->fd = fd;
+    input_p->offset = begin;
+    input_p->end = end;
+    input_p->block = block;
+    input_p->buffers_p[0] = memory_p;
+    input_p->buffers_p[1] = &memory_p[block];
+    input_p->current = 0;
+    input_p->pos = 0;
+
+    __darray_raw_xsort_input_request(ctx_p, input_p, 0);
+    __darray_raw_xsort_input_request(ctx_p, input_p, 1);
+
+    register const ssize_t result = __darray_raw_xsort_io_wait(&ctx_p->io_thread, &input_p->io[0]);
+
+    if (result <= 0 || (size_t)result % ctx_p->size_of != 0)
+    {
+        perror("DArrayRaw: read error\n");
+        input_p->filled = 0;
+        return -1;
+    }
+
+    input_p->filled = (size_t)result;
+
+    return 0;
+}
+
+
+static int __darray_raw_xsort_input_next(DArrayRawXSortS* const ctx_p, DArrayRawXSortInputS* const input_p)
+{
+    input_p->pos += ctx_p->size_of;
+
+    if (input_p->pos < input_p->filled)
+    {
+        return 0;
+    }
+
+    /* current block is consumed, it is refilled in background while the other one is used */
+    __darray_raw_xsort_input_request(ctx_p, input_p, input_p->current);
+    input_p->current ^= 1;
+    input_p->pos = 0;
+
+    register const ssize_t result = __darray_raw_xsort_io_wait(&ctx_p->io_thread, &input_p->io[input_p->current]);
+
+    if (result < 0 || (size_t)result % ctx_p->size_of != 0)
+    {
+        perror("DArrayRaw: read error\n");
+        input_p->filled = 0;
+        return -1;
+    }
+
+    input_p->filled = (size_t)result;
+
+    return 0;
+}
+
+
+static void __darray_raw_xsort_output_open(DArrayRawXSortOutputS* const output_p, const int fd, const off_t offset, uint8_t* const memory_p, const size_t block)
+{
+    output_p->fd = fd;
+    output_p->offset = offset;
+    output_p->block = block;
+    output_p->buffers_p[0] = memory_p;
+    output_p->buffers_p[1] = &memory_p[block];
+    output_p->io[0].pending = false;
+    output_p->io[0].result = 0;
+    output_p->io[0].bytes = 0;
+    output_p->io[1].pending = false;
+    output_p->io[1].result = 0;
+    output_p->io[1].bytes = 0;
+    output_p->current = 0;
+    output_p->pos = 0;
+    output_p->error = false;
+}
+
+
+static void __darray_raw_xsort_output_flush(DArrayRawXSortS* const ctx_p, DArrayRawXSortOutputS* const output_p)
+{
+    __darray_raw_xsort_io_submit(&ctx_p->io_thread, &output_p->io[output_p->current], output_p->fd, output_p->buffers_p[output_p->current],
+                                 output_p->pos, output_p->offset, true);
+
+    output_p->offset += (off_t)output_p->pos;
+    output_p->current ^= 1;
+    output_p->pos = 0;
+
+    /* previous write from the other block has to finish before the block is filled again */
+    DArrayRawXSortIoS* const io_p = &output_p->io[output_p->current];
+
+    if (__darray_raw_xsort_io_wait(&ctx_p->io_thread, io_p) != (ssize_t)io_p->bytes)
+    {
+        output_p->error = true;
+    }
+}
+
+
+static int __darray_raw_xsort_output_close(DArrayRawXSortS* const ctx_p, DArrayRawXSortOutputS* const output_p)
+{
+    if (output_p->pos > 0)
+    {
+        __darray_raw_xsort_output_flush(ctx_p, output_p);
+    }
+
+    DArrayRawXSortIoS* const io_p = &output_p->io[output_p->current ^ 1];
+
+    if (__darray_raw_xsort_io_wait(&ctx_p->io_thread, io_p) != (ssize_t)io_p->bytes)
+    {
+        output_p->error = true;
+    }
+
+    if (output_p->error)
+    {
+        perror("DArrayRaw: write error\n");
+        return -1;
+    }
+
+    return 0;
+}
+
+
+static int __darray_raw_xsort_tmp_file(const char* const tmp_dir)
+{
+    char path[strlen(tmp_dir) + sizeof("/darray_raw_XXXXXX")];
+    (void)snprintf(&path[0], sizeof(path), "%s/darray_raw_XXXXXX", tmp_dir);
+
+    register const int fd = mkstemp(&path[0]);
+
+    if (fd == -1)
+    {
+        perror("DArrayRaw: mkstemp error\n");
+        return -1;
+    }
+
+    (void)unlink(&path[0]);
+
+    return fd;
+}
+
+
+static int __darray_raw_xsort_make_runs(DArrayRawXSortS* const ctx_p, const int in_fd, const size_t length, const int run_fd)
+{
+    register const size_t size_of = ctx_p->size_of;
+    register const size_t chunk_length = (ctx_p->memory_size / 2) / size_of;
+
+    uint8_t* const chunks_p[2] = { ctx_p->memory_p, &ctx_p->memory_p[chunk_length * size_of] };
+    DArrayRawXSortIoS reads[2] = { { .pending = false }, { .pending = false } };
+    DArrayRawXSortIoS writes[2] = { { .pending = false, .bytes = 0, .result = 0 }, { .pending = false, .bytes = 0, .result = 0 } };
+
+    register size_t current = 0;
+    register size_t read_length = length < chunk_length ? length : chunk_length;
+    register off_t write_offset = 0;
+    register int ret = 0;
+
+    __darray_raw_xsort_io_submit(&ctx_p->io_thread, &reads[0], in_fd, chunks_p[0], read_length * size_of, 0, false);
+
+    for (size_t run = 0; run < ctx_p->nruns; ++run)
+    {
+        register const size_t run_length = read_length;
+
+        if (__darray_raw_xsort_io_wait(&ctx_p->io_thread, &reads[current]) != (ssize_t)(run_length * size_of))
+        {
+            perror("DArrayRaw: read error\n");
+            ret = -1;
+            break;
+        }
+
+        /* next chunk is read into the other buffer while this one is sorted */
+        if (run + 1 < ctx_p->nruns)
+        {
+            register const size_t next_offset = (run + 1) * chunk_length;
+
+            if (__darray_raw_xsort_io_wait(&ctx_p->io_thread, &writes[current ^ 1]) != (ssize_t)writes[current ^ 1].bytes)
+            {
+                perror("DArrayRaw: write error\n");
+                ret = -1;
+                break;
+            }
+
+            read_length = length - next_offset < chunk_length ? length - next_offset : chunk_length;
+            __darray_raw_xsort_io_submit(&ctx_p->io_thread, &reads[current ^ 1], in_fd, chunks_p[current ^ 1], read_length * size_of,
+                                         (off_t)(next_offset * size_of), false);
+        }
+
+        darray_raw_sort(chunks_p[current], size_of, run_length, ctx_p->cmp_fp);
+
+        ctx_p->run_offset_p[run] = write_offset;
+        __darray_raw_xsort_io_submit(&ctx_p->io_thread, &writes[current], run_fd, chunks_p[current], run_length * size_of, write_offset, true);
+        write_offset += (off_t)(run_length * size_of);
+
+        current ^= 1;
+    }
+
+    ctx_p->run_offset_p[ctx_p->nruns] = write_offset;
+
+    /* requests use stack memory, so all of them have to be finished before return */
+    for (size_t i = 0; i < array_size(reads); ++i)
+    {
+        (void)__darray_raw_xsort_io_wait(&ctx_p->io_thread, &reads[i]);
+
+        if (__darray_raw_xsort_io_wait(&ctx_p->io_thread, &writes[i]) != (ssize_t)writes[i].bytes && ret == 0)
+        {
+            perror("DArrayRaw: write error\n");
+            ret = -1;
+        }
+    }
+
+    return ret;
+}
+
+
+static inline void __darray_raw_xsort_heap_sift_down(DArrayRawXSortS* const ctx_p, const size_t length, size_t root)
+{
+    size_t* const heap_p = ctx_p->heap_p;
+    register const size_t tmp = heap_p[root];
+
+#define DARRAY_RAW_XSORT_HEAD(idx) (&ctx_p->inputs_p[idx].buffers_p[ctx_p->inputs_p[idx].current][ctx_p->inputs_p[idx].pos])
+
+    for (size_t child = 2 * root + 1; child < length; child = 2 * root + 1)
+    {
+        if (child + 1 < length && ctx_p->cmp_fp(DARRAY_RAW_XSORT_HEAD(heap_p[child + 1]), DARRAY_RAW_XSORT_HEAD(heap_p[child])) < 0)
+        {
+            child++;
+        }
+
+        if (ctx_p->cmp_fp(DARRAY_RAW_XSORT_HEAD(tmp), DARRAY_RAW_XSORT_HEAD(heap_p[child])) <= 0)
+        {
+            break;
+        }
+
+        heap_p[root] = heap_p[child];
+        root = child;
+    }
+
+#undef DARRAY_RAW_XSORT_HEAD
+
+    heap_p[root] = tmp;
+}
+
+
+static int __darray_raw_xsort_merge(DArrayRawXSortS* const ctx_p, const int src_fd, const size_t first, const size_t count, const int dst_fd, const off_t dst_offset)
+{
+    register const size_t size_of = ctx_p->size_of;
+
+    /* every input and output has two blocks */
+    register const size_t block = ((ctx_p->memory_size / (2 * (count + 1))) / size_of) * size_of;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (__darray_raw_xsort_input_open(ctx_p, &ctx_p->inputs_p[i], src_fd, ctx_p->run_offset_p[first + i], ctx_p->run_offset_p[first + i + 1],
+                                          &ctx_p->memory_p[2 * i * block], block) != 0)
+        {
+            /* already opened readers may still have reads in flight */
+            for (size_t j = 0; j <= i; ++j)
+            {
+                (void)__darray_raw_xsort_io_wait(&ctx_p->io_thread, &ctx_p->inputs_p[j].io[0]);
+                (void)__darray_raw_xsort_io_wait(&ctx_p->io_thread, &ctx_p->inputs_p[j].io[1]);
+            }
+
+            return -1;
+        }
+
+        ctx_p->heap_p[i] = i;
+    }
+
+    DArrayRawXSortOutputS output;
+    __darray_raw_xsort_output_open(&output, dst_fd, dst_offset, &ctx_p->memory_p[2 * count * block], block);
+
+    register size_t heap_length = count;
+    register int ret = 0;
+
+    for (size_t i = heap_length / 2; i > 0; --i)
+    {
+        __darray_raw_xsort_heap_sift_down(ctx_p, heap_length, i - 1);
+    }
+
+    while (heap_length > 0)
+    {
+        DArrayRawXSortInputS* const input_p = &ctx_p->inputs_p[ctx_p->heap_p[0]];
+
+        assign(&output.buffers_p[output.current][output.pos], &input_p->buffers_p[input_p->current][input_p->pos], size_of);
+        output.pos += size_of;
+
+        if (output.pos == output.block)
+        {
+            __darray_raw_xsort_output_flush(ctx_p, &output);
+        }
+
+        if (__darray_raw_xsort_input_next(ctx_p, input_p) != 0)
+        {
+            ret = -1;
+        }
+
+        if (input_p->filled == 0)
+        {
+            ctx_p->heap_p[0] = ctx_p->heap_p[--heap_length];
+        }
+
+        if (heap_length > 0)
+        {
+            __darray_raw_xsort_heap_sift_down(ctx_p, heap_length, 0);
+        }
+    }
+
+    if (__darray_raw_xsort_output_close(ctx_p, &output) != 0)
+    {
+        ret = -1;
+    }
+
+    return ret;
+}
+
+
+int darray_raw_external_sort(const char* const in_path, const char* const out_path, const size_t size_of, const compare_fp cmp_fp,
+                             const size_t memory_budget, const char* const tmp_dir)
+{
+    if (in_path == NULL)
+    {
+        perror("DArrayRaw: argument in_path is NULL\n");
+        return -1;
+    }
+
+    if (out_path == NULL)
+    {
+        perror("DArrayRaw: argument out_path is NULL\n");
+        return -1;
+    }
+
+    if (size_of == 0)
+    {
+        perror("DArrayRaw: argument size_of has to small value\n");
+        return -1;
+    }
+
+    if (cmp_fp == NULL)
+    {
+        perror("DArrayRaw: argument cmp_fp is NULL\n");
+        return -1;
+    }
+
+    /* merge of two runs needs six blocks with at least one record */
+    if (memory_budget / 6 < size_of)
+    {
+        perror("DArrayRaw: argument memory_budget has to small value\n");
+        return -1;
+    }
+
+    register const int in_fd = open(in_path, O_RDONLY | O_CLOEXEC);
+
+    if (in_fd == -1)
+    {
+        perror("DArrayRaw: open error\n");
+        return -1;
+    }
+
+    struct stat in_stat;
+
+    if (fstat(in_fd, &in_stat) != 0 || in_stat.st_size % (off_t)size_of != 0)
+    {
+        perror("DArrayRaw: input file size is not a multiple of size_of\n");
+        close(in_fd);
+        return -1;
+    }
+
+    (void)posix_fadvise(in_fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    register const size_t length = (size_t)in_stat.st_size / size_of;
+    register const size_t min_block = size_of > DARRAY_RAW_XSORT_MIN_BLOCK ? size_of : DARRAY_RAW_XSORT_MIN_BLOCK;
+    register const size_t chunk_length = (memory_budget / 2) / size_of;
+
+    DArrayRawXSortS ctx = {
+        .size_of = size_of,
+        .cmp_fp = cmp_fp,
+        .memory_p = NULL,
+        .memory_size = memory_budget,
+        .fan_in = memory_budget / (2 * min_block) > 3 ? memory_budget / (2 * min_block) - 1 : 2,
+        .nruns = length == 0 ? 0 : (length + chunk_length - 1) / chunk_length,
+    };
+
+    register int ret = -1;
+    register int out_fd = -1;
+    int tmp_fds[2] = { -1, -1 };
+
+    ctx.memory_p = malloc(memory_budget);
+    ctx.run_offset_p = malloc((ctx.nruns + 1) * sizeof(*ctx.run_offset_p));
+    ctx.inputs_p = malloc(ctx.fan_in * sizeof(*ctx.inputs_p));
+    ctx.heap_p = malloc(ctx.fan_in * sizeof(*ctx.heap_p));
+
+    if (ctx.memory_p == NULL || ctx.run_offset_p == NULL || ctx.inputs_p == NULL || ctx.heap_p == NULL)
+    {
+        perror("DArrayRaw: malloc error\n");
+        goto free_memory;
+    }
+
+    if (__darray_raw_xsort_io_start(&ctx.io_thread) != 0)
+    {
+        goto free_memory;
+    }
+
+    /* whole input fits in memory, no temporary files are needed */
+    if (ctx.nruns <= 1)
+    {
+        DArrayRawXSortIoS io = { .pending = false };
+
+        __darray_raw_xsort_io_submit(&ctx.io_thread, &io, in_fd, ctx.memory_p, length * size_of, 0, false);
+
+        if (__darray_raw_xsort_io_wait(&ctx.io_thread, &io) != (ssize_t)(length * size_of))
+        {
+            perror("DArrayRaw: read error\n");
+            goto stop_io;
+        }
+
+        if (length > 0)
+        {
+            darray_raw_sort(ctx.memory_p, size_of, length, cmp_fp);
+        }
+
+        out_fd = open(out_path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+
+        if (out_fd == -1)
+        {
+            perror("DArrayRaw: open error\n");
+            goto stop_io;
+        }
+
+        __darray_raw_xsort_io_submit(&ctx.io_thread, &io, out_fd, ctx.memory_p, length * size_of, 0, true);
+
+        if (__darray_raw_xsort_io_wait(&ctx.io_thread, &io) != (ssize_t)(length * size_of))
+        {
+            perror("DArrayRaw: write error\n");
+            goto stop_io;
+        }
+
+        ret = 0;
+        goto stop_io;
+    }
+
+    tmp_fds[0] = __darray_raw_xsort_tmp_file(tmp_dir != NULL ? tmp_dir : DARRAY_RAW_XSORT_TMP_DIR);
+
+    if (tmp_fds[0] == -1)
+    {
+        goto stop_io;
+    }
+
+    if (__darray_raw_xsort_make_runs(&ctx, in_fd, length, tmp_fds[0]) != 0)
+    {
+        goto stop_io;
+    }
+
+    /* intermediate passes merge groups of fan-in runs into second temporary file */
+    register size_t src = 0;
+
+    while (ctx.nruns > ctx.fan_in)
+    {
+        if (tmp_fds[src ^ 1] == -1)
+        {
+            tmp_fds[src ^ 1] = __darray_raw_xsort_tmp_file(tmp_dir != NULL ? tmp_dir : DARRAY_RAW_XSORT_TMP_DIR);
+
+            if (tmp_fds[src ^ 1] == -1)
+            {
+                goto stop_io;
+            }
+        }
+
+        register size_t nruns = 0;
+
+        for (size_t first = 0; first < ctx.nruns; first += ctx.fan_in)
+        {
+            register const size_t count = ctx.nruns - first < ctx.fan_in ? ctx.nruns - first : ctx.fan_in;
+
+            if (__darray_raw_xsort_merge(&ctx, tmp_fds[src], first, count, tmp_fds[src ^ 1], ctx.run_offset_p[first]) != 0)
+            {
+                goto stop_io;
+            }
+
+            /* merged run starts where its first source run started */
+            ctx.run_offset_p[nruns++] = ctx.run_offset_p[first];
+        }
+
+        ctx.run_offset_p[nruns] = ctx.run_offset_p[ctx.nruns];
+        ctx.nruns = nruns;
+
+        /* source runs are not needed anymore, so disk space is released */
+        if (ftruncate(tmp_fds[src], 0) != 0)
+        {
+            perror("DArrayRaw: ftruncate error\n");
+        }
+
+        src ^= 1;
+    }
+
+    out_fd = open(out_path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+
+    if (out_fd == -1)
+    {
+        perror("DArrayRaw: open error\n");
+        goto stop_io;
+    }
+
+    ret = __darray_raw_xsort_merge(&ctx, tmp_fds[src], 0, ctx.nruns, out_fd, 0);
+
+stop_io:
+    __darray_raw_xsort_io_stop(&ctx.io_thread);
+
+free_memory:
+    for (size_t i = 0; i < array_size(tmp_fds); ++i)
+    {
+        if (tmp_fds[i] != -1)
+        {
+            close(tmp_fds[i]);
+        }
+    }
+
+    if (out_fd != -1 && close(out_fd) != 0)
+    {
+        perror("DArrayRaw: close error\n");
+        ret = -1;
+    }
+
+    close(in_fd);
+
+    free(ctx.heap_p);
+    free(ctx.inputs_p);
+    free(ctx.run_offset_p);
+    free(ctx.memory_p);
+
+    return ret;
+}
@@ -0,0 +1,267 @@
+#include <darray_raw/darray_raw.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/*
+    Eytzinger (BFS) layout of sorted array for read-mostly lookups.
+
+    1. Layout - element of rank r is stored at node k of implicit complete binary tree (children of k are 2k and 2k + 1,
+                root is 1, slot 0 is unused), tree is in-order equal to sorted array. First levels of tree are in few
+                cache lines, and children of node are next to each other.
+    2. Search - path goes down by k = 2k + (node < key), no branch on comparator result. At the end trailing ones
+                (right turns after last left turn) are removed and last node where path went left is the bound.
+    3. Prefetch - 16 descendants four levels below k are contiguous (16k .. 16k + 15), so they are prefetched every
+                  step and memory latency overlaps with comparisons. Layout is aligned to cache line.
+    4. Rank   - node is mapped to rank in sorted array in O(1): rank in perfect tree of the same height minus missing
+                nodes of last level which are before it in order.
+*/
+
+
+/* cache line size */
+#define DARRAY_RAW_EYTZINGER_LINE           ((size_t)64)
+
+/* number of descendants prefetched, four levels below current node */
+#define DARRAY_RAW_EYTZINGER_PREFETCH       ((size_t)16)
+
+/* maximum number of cache lines prefetched in each step (for big array members) */
+#define DARRAY_RAW_EYTZINGER_PREFETCH_LINES ((size_t)8)
+
+
+/*
+ * Internal function which compute rank in sorted array of node @k in Eytzinger layout of @length elements.
+ *
+ * @param[in] k      - node index in range [1, length].
+ * @param[in] length - number of elements in layout.
+ *
+ * @return: rank of node.
+ */
+static inline size_t __darray_raw_eytzinger_rank(size_t k, size_t length);
+
+
+/*
+ * Internal function which prefetch 16 descendants of node @k four levels below it.
+ *
+ * @param[in] barray_p - pointer to layout.
+ * @param[in] size_of  - size of each array member.
+ * @param[in] k        - node index.
+ *
+ * @return: this is void function.
+ */
+static inline void __darray_raw_eytzinger_prefetch(const uint8_t* barray_p, size_t size_of, size_t k);
+
+
+/*
+ * Internal function which search layout for first node where @data_p is not greater (@upper is false)
+ * or is less (@upper is true) and return rank of this node.
+ *
+ * @param[in] eytzinger_p - pointer to layout.
+ * @param[in] size_of     - size of each array member.
+ * @param[in] length      - number of elements in layout.
+ * @param[in] data_p      - searched value.
+ * @param[in] cmp_fp      - comparator function pointer.
+ * @param[in] upper       - search upper bound instead of lower bound.
+ *
+ * @return: rank of found node, @length when all elements are before @data_p.
+ */
+static size_t __darray_raw_eytzinger_bound(const void* eytzinger_p, size_t size_of, size_t length, const void* data_p, const compare_fp cmp_fp, bool upper);
+
+
+/*
+ * Internal function which check arguments of lower and upper bound.
+ *
+ * @param[in] eytzinger_p - pointer to layout.
+ * @param[in] size_of     - size of each array member.
+ * @param[in] length      - number of elements in layout.
+ * @param[in] data_p      - searched value.
+ * @param[in] cmp_fp      - comparator function pointer.
+ *
+ * @return: 0 on success, -1 on failure.
+ */
+static int __darray_raw_eytzinger_check(const void* eytzinger_p, size_t size_of, size_t length, const void* data_p, const compare_fp cmp_fp);
+
+
+static inline size_t __darray_raw_eytzinger_rank(const size_t k, const size_t length)
+{
+    /* tree has @height levels, last level has @last nodes */
+    register const size_t height = (size_t)(64 - __builtin_clzll((unsigned long long)length));
+    register const size_t last = length - (((size_t)1 << (height - 1)) - 1);
+
+    register const size_t depth = (size_t)(63 - __builtin_clzll((unsigned long long)k));
+    register const size_t offset = k - ((size_t)1 << depth);
+
+    /* last level node j of perfect tree has rank 2j, nodes j >= @last are missing */
+    register const size_t rank = ((2 * offset + 1) << (height - 1 - depth)) - 1;
+    register const size_t half = (rank + 1) / 2;
+
+    return rank - (half > last ? half - last : 0);
+}
+
+
+static inline void __darray_raw_eytzinger_prefetch(const uint8_t* const barray_p, const size_t size_of, const size_t k)
+{
+    register const uintptr_t first = (uintptr_t)barray_p + DARRAY_RAW_EYTZINGER_PREFETCH * k * size_of;
+    register size_t bytes = DARRAY_RAW_EYTZINGER_PREFETCH * size_of;
+
+    if (bytes > DARRAY_RAW_EYTZINGER_PREFETCH_LINES * DARRAY_RAW_EYTZINGER_LINE)
+    {
+        bytes = DARRAY_RAW_EYTZINGER_PREFETCH_LINES * DARRAY_RAW_EYTZINGER_LINE;
+    }
+
+    /* address is not dereferenced, prefetch past the end of layout is harmless */
+    for (size_t offset = 0; offset < bytes; offset += DARRAY_RAW_EYTZINGER_LINE)
+    {
+        __builtin_prefetch((const void*)(first + offset), 0, 3);
+    }
+}
+
+
+static size_t __darray_raw_eytzinger_bound(const void* const eytzinger_p, const size_t size_of, const size_t length, const void* const data_p,
+                                           const compare_fp cmp_fp, const bool upper)
+{
+    register const uint8_t* const barray_p = eytzinger_p;
+    register size_t k = 1;
+
+    /* for lower bound go right when node < data, for upper bound when node <= data */
+    register const int limit = upper ? 1 : 0;
+
+    while (k <= length)
+    {
+        __darray_raw_eytzinger_prefetch(barray_p, size_of, k);
+        k = 2 * k + (size_t)(cmp_fp(&barray_p[k * size_of], data_p) < limit);
+    }
+
+    /* remove right turns after last left turn, k == 0 when path never turned left */
+    k >>= __builtin_ffsll(~(long long)k);
+
+    return k == 0 ? length : __darray_raw_eytzinger_rank(k, length);
+}
+
+
+static int __darray_raw_eytzinger_check(const void* const eytzinger_p, const size_t size_of, const size_t length, const void* const data_p,
+                                        const compare_fp cmp_fp)
+{
+    if (eytzinger_p == NULL)
+    {
+        perror("DArrayRaw: argument eytzinger_p is NULL\n");
+        return -1;
+    }
+
+    if (size_of == 0)
+    {
+        perror("DArrayRaw: argument size_of has to small value\n");
+        return -1;
+    }
+
+    if (length == 0)
+    {
+        perror("DArrayRaw: argument length has to small value\n");
+        return -1;
+    }
+
+    if (data_p == NULL)
+    {
+        perror("DArrayRaw: argument data_p is NULL\n");
+        return -1;
+    }
+
+    if (cmp_fp == NULL)
+    {
+        perror("DArrayRaw: argument cmp_fp is NULL\n");
+        return -1;
+    }
+
+    return 0;
+}
+
+
+void* darray_raw_eytzinger_create(const void* const array_p, const size_t size_of, const size_t length)
+{
+    if (array_p == NULL)
+    {
+        perror("DArrayRaw: argument array_p is NULL\n");
+        return NULL;
+    }
+
+    if (size_of == 0)
+    {
+        perror("DArrayRaw: argument size_of has to small value\n");
+        return NULL;
+    }
+
+    if (length == 0)
+    {
+        perror("DArrayRaw: argument length has to small value\n");
+        return NULL;
+    }
+
+    /* slot 0 is unused, size is rounded up to cache line for aligned_alloc */
+    register const size_t bytes = ((length + 1) * size_of + DARRAY_RAW_EYTZINGER_LINE - 1) / DARRAY_RAW_EYTZINGER_LINE * DARRAY_RAW_EYTZINGER_LINE;
+
+    uint8_t* const eytzinger_p = aligned_alloc(DARRAY_RAW_EYTZINGER_LINE, bytes);
+
+    if (eytzinger_p == NULL)
+    {
+        perror("DArrayRaw: aligned_alloc error\n");
+        return NULL;
+    }
+
+    register const uint8_t* const barray_p = array_p;
+
+    (void)memset(eytzinger_p, 0, size_of);
+
+    /* writes are sequential, reads follow in-order ranks */
+    for (size_t k = 1; k <= length; ++k)
+    {
+        assign(&eytzinger_p[k * size_of], &barray_p[__darray_raw_eytzinger_rank(k, length) * size_of], size_of);
+    }
+
+    return eytzinger_p;
+}
+
+
+ssize_t darray_raw_eytzinger_lower_bound(const void* const restrict eytzinger_p, const size_t size_of, const size_t length, const void* const restrict data_p,
+                                         const compare_fp cmp_fp)
+{
+    if (__darray_raw_eytzinger_check(eytzinger_p, size_of, length, data_p, cmp_fp) != 0)
+    {
+        return -1;
+    }
+
+    return (ssize_t)__darray_raw_eytzinger_bound(eytzinger_p, size_of, length, data_p, cmp_fp, false);
+}
+
+
+ssize_t darray_raw_eytzinger_upper_bound(const void* const restrict eytzinger_p, const size_t size_of, const size_t length, const void* const restrict data_p,
+                                         const compare_fp cmp_fp)
+{
+    if (__darray_raw_eytzinger_check(eytzinger_p, size_of, length, data_p, cmp_fp) != 0)
+    {
+        return -1;
+    }
+
+    return (ssize_t)__darray_raw_eytzinger_bound(eytzinger_p, size_of, length, data_p, cmp_fp, true);
+}
+
+
+ssize_t darray_raw_eytzinger_node(const size_t length, const size_t rank)
+{
+    if (rank >= length)
+    {
+        perror("DArrayRaw: argument rank has to small value\n");
+        return -1;
+    }
+
+    /* inverse of rank: descend from root comparing with ranks of nodes */
+    register size_t k = 1;
+    register size_t node_rank = __darray_raw_eytzinger_rank(k, length);
+
+    while (node_rank != rank)
+    {
+        k = 2 * k + (size_t)(node_rank < rank);
+        node_rank = __darray_raw_eytzinger_rank(k, length);
+    }
+
+    return (ssize_t)k;
+}
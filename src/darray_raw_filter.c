@@ -0,0 +1,495 @@
+#include <darray_raw/darray_raw.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/*
+    Approximate membership filter (blocked Bloom filter) kept alongside unsorted array, so lookups of missing keys
+    are answered without scan.
+
+    1. Blocks  - filter is array of cache-line blocks of 512 bits, key sets k bits in one block chosen by its hash,
+                 so add and lookup touch one cache line. Bits per key and k are computed from false positive rate.
+    2. Keys    - key is hashed by caller function or key bytes at key offset of member are hashed,
+                 hash is mixed again, so weak caller hashes are also spread over blocks and bits.
+    3. Updates - insert wrapper adds key to filter. Bloom filter can not remove keys, so delete wrapper only counts
+                 removed keys, and filter is rebuilt from array when more than half of keys are removed
+                 (or capacity is doubled when more keys than capacity are added). Filter never has false negatives.
+    4. Lookup  - find functions check filter first, key which is not in filter is missing without scan.
+*/
+
+
+/* size of block in bytes (cache line) */
+#define DARRAY_RAW_FILTER_BLOCK         ((size_t)64)
+
+/* number of bits in block */
+#define DARRAY_RAW_FILTER_BLOCK_BITS    ((size_t)512)
+
+/* number of 64-bit words in block */
+#define DARRAY_RAW_FILTER_BLOCK_WORDS   ((size_t)8)
+
+/* maximal number of bits set by key */
+#define DARRAY_RAW_FILTER_MAX_HASHES    ((size_t)16)
+
+/* keys in one block collide more than in flat Bloom filter, bits per key are increased by this factor */
+#define DARRAY_RAW_FILTER_BLOCK_PENALTY 1.2
+
+/* ln(2) */
+#define DARRAY_RAW_FILTER_LN2           0.6931471805599453
+
+
+/* membership filter */
+typedef struct DArrayRawFilterS
+{
+    uint64_t* blocks_p;
+    size_t nblocks;
+    size_t nhashes;
+    size_t capacity;
+    size_t nkeys;       /* keys added since last build */
+    size_t nremoved;    /* keys removed since last build */
+    double fpr;
+    hasher_fp hash_fp;
+    size_t size_of;
+    size_t key_offset;
+    size_t key_size;
+} DArrayRawFilterS;
+
+
+/*
+ * Internal function which mix bits of 64-bit value (finalizer of MurmurHash3).
+ *
+ * @param[in] h - value.
+ *
+ * @return: mixed value.
+ */
+static inline uint64_t __darray_raw_filter_mix(uint64_t h);
+
+
+/*
+ * Internal function which compute binary logarithm bit by bit (library does not link libm).
+ *
+ * @param[in] x - value, at least 1.
+ *
+ * @return: log2(@x) with error below 1e-6.
+ */
+static double __darray_raw_filter_log2(double x);
+
+
+/*
+ * Internal function which hash key of member @data_p.
+ *
+ * @param[in] filter_p - pointer to filter.
+ * @param[in] data_p   - member (or searched value).
+ *
+ * @return: hash of key.
+ */
+static inline uint64_t __darray_raw_filter_hash(const DArrayRawFilterS* filter_p, const void* data_p);
+
+
+/*
+ * Internal function which compute block and bit mask of key with hash @h.
+ *
+ * @param[in]  filter_p - pointer to filter.
+ * @param[in]  h        - hash of key.
+ * @param[out] mask_p   - bits of key in block (DARRAY_RAW_FILTER_BLOCK_WORDS words).
+ *
+ * @return: pointer to block of key.
+ */
+static inline uint64_t* __darray_raw_filter_mask(const DArrayRawFilterS* filter_p, uint64_t h, uint64_t* mask_p);
+
+
+/*
+ * Internal function which add key of member @data_p to filter.
+ *
+ * @param[in] filter_p - pointer to filter.
+ * @param[in] data_p   - member.
+ *
+ * @return: this is void function.
+ */
+static void __darray_raw_filter_add(DArrayRawFilterS* filter_p, const void* data_p);
+
+
+/*
+ * Internal function which check if key of @data_p may be in filter.
+ *
+ * @param[in] filter_p - pointer to filter.
+ * @param[in] data_p   - searched value.
+ *
+ * @return: true when key may be in filter, false when it is not.
+ */
+static bool __darray_raw_filter_maybe(const DArrayRawFilterS* filter_p, const void* data_p);
+
+
+/*
+ * Internal function which allocate blocks for @capacity keys and add keys of all members of @array_p.
+ * Old blocks are kept when allocation fails.
+ *
+ * @param[in] filter_p - pointer to filter.
+ * @param[in] array_p  - pointer to array (can be NULL when @length is 0).
+ * @param[in] length   - number of elements in array.
+ * @param[in] capacity - expected number of keys.
+ *
+ * @return: 0 on success, -1 on failure.
+ */
+static int __darray_raw_filter_build(DArrayRawFilterS* filter_p, const void* array_p, size_t length, size_t capacity);
+
+
+static inline uint64_t __darray_raw_filter_mix(uint64_t h)
+{
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ULL;
+    h ^= h >> 33;
+
+    return h;
+}
+
+
+static double __darray_raw_filter_log2(double x)
+{
+    register double result = 0.0;
+
+    while (x >= 2.0)
+    {
+        x /= 2.0;
+        result += 1.0;
+    }
+
+    /* x is in [1, 2), squaring doubles logarithm, so each step gives next bit of fraction */
+    register double bit = 0.5;
+
+    for (size_t i = 0; i < 20; ++i)
+    {
+        x *= x;
+
+        if (x >= 2.0)
+        {
+            x /= 2.0;
+            result += bit;
+        }
+
+        bit /= 2.0;
+    }
+
+    return result;
+}
+
+
+static inline uint64_t __darray_raw_filter_hash(const DArrayRawFilterS* const filter_p, const void* const data_p)
+{
+    if (filter_p->hash_fp != NULL)
+    {
+        return __darray_raw_filter_mix(filter_p->hash_fp(data_p));
+    }
+
+    register const uint8_t* bdata_p = (const uint8_t*)data_p + filter_p->key_offset;
+    register size_t bytes = filter_p->key_size;
+    register uint64_t h = 0x9E3779B97F4A7C15ULL ^ bytes;
+
+    for (; bytes >= sizeof(uint64_t); bytes -= sizeof(uint64_t), bdata_p += sizeof(uint64_t))
+    {
+        uint64_t word;
+        (void)memcpy(&word, bdata_p, sizeof(word));
+
+        h = (h ^ word) * 0xBF58476D1CE4E5B9ULL;
+        h ^= h >> 31;
+    }
+
+    if (bytes > 0)
+    {
+        uint64_t word = 0;
+        (void)memcpy(&word, bdata_p, bytes);
+
+        h = (h ^ word) * 0xBF58476D1CE4E5B9ULL;
+    }
+
+    return __darray_raw_filter_mix(h);
+}
+
+
+static inline uint64_t* __darray_raw_filter_mask(const DArrayRawFilterS* const filter_p, const uint64_t h, uint64_t* const mask_p)
+{
+    /* high half of hash selects block, bits are taken from remixed hash, 9 bits per position */
+    register const size_t block = (size_t)(((h >> 32) * (uint64_t)filter_p->nblocks) >> 32);
+    register uint64_t g = h;
+
+    for (size_t i = 0; i < DARRAY_RAW_FILTER_BLOCK_WORDS; ++i)
+    {
+        mask_p[i] = 0;
+    }
+
+    for (size_t i = 0; i < filter_p->nhashes; ++i)
+    {
+        if (i % 7 == 0)
+        {
+            g = __darray_raw_filter_mix(g + 0x9E3779B97F4A7C15ULL);
+        }
+
+        register const size_t bit = (size_t)(g & (DARRAY_RAW_FILTER_BLOCK_BITS - 1));
+        mask_p[bit / 64] |= (uint64_t)1 << (bit % 64);
+        g >>= 9;
+    }
+
+    return &filter_p->blocks_p[block * DARRAY_RAW_FILTER_BLOCK_WORDS];
+}
+
+
+static void __darray_raw_filter_add(DArrayRawFilterS* const filter_p, const void* const data_p)
+{
+    uint64_t mask[DARRAY_RAW_FILTER_BLOCK_WORDS];
+    uint64_t* const block_p = __darray_raw_filter_mask(filter_p, __darray_raw_filter_hash(filter_p, data_p), mask);
+
+    for (size_t i = 0; i < DARRAY_RAW_FILTER_BLOCK_WORDS; ++i)
+    {
+        block_p[i] |= mask[i];
+    }
+
+    ++filter_p->nkeys;
+}
+
+
+static bool __darray_raw_filter_maybe(const DArrayRawFilterS* const filter_p, const void* const data_p)
+{
+    uint64_t mask[DARRAY_RAW_FILTER_BLOCK_WORDS];
+    register const uint64_t* const block_p = __darray_raw_filter_mask(filter_p, __darray_raw_filter_hash(filter_p, data_p), mask);
+    register uint64_t missing = 0;
+
+    for (size_t i = 0; i < DARRAY_RAW_FILTER_BLOCK_WORDS; ++i)
+    {
+        missing |= mask[i] & ~block_p[i];
+    }
+
+    return missing == 0;
+}
+
+
+static int __darray_raw_filter_build(DArrayRawFilterS* const filter_p, const void* const array_p, const size_t length, const size_t capacity)
+{
+    /* flat Bloom filter needs log2(1 / fpr) / ln(2) bits per key and ln(2) * bits per key hashes */
+    register const double bits_per_key = __darray_raw_filter_log2(1.0 / filter_p->fpr) / DARRAY_RAW_FILTER_LN2 * DARRAY_RAW_FILTER_BLOCK_PENALTY;
+    register const double bits = bits_per_key * (double)(capacity > 0 ? capacity : 1);
+    register const size_t nblocks = (size_t)(bits / (double)DARRAY_RAW_FILTER_BLOCK_BITS) + 1;
+    register const size_t nhashes = (size_t)(bits_per_key / DARRAY_RAW_FILTER_BLOCK_PENALTY * DARRAY_RAW_FILTER_LN2 + 0.5);
+
+    uint64_t* const blocks_p = aligned_alloc(DARRAY_RAW_FILTER_BLOCK, nblocks * DARRAY_RAW_FILTER_BLOCK);
+
+    if (blocks_p == NULL)
+    {
+        perror("DArrayRaw: aligned_alloc error\n");
+        return -1;
+    }
+
+    (void)memset(blocks_p, 0, nblocks * DARRAY_RAW_FILTER_BLOCK);
+
+    free(filter_p->blocks_p);
+
+    filter_p->blocks_p = blocks_p;
+    filter_p->nblocks = nblocks;
+    filter_p->nhashes = nhashes < 1 ? 1 : nhashes > DARRAY_RAW_FILTER_MAX_HASHES ? DARRAY_RAW_FILTER_MAX_HASHES : nhashes;
+    filter_p->capacity = capacity;
+    filter_p->nkeys = 0;
+    filter_p->nremoved = 0;
+
+    register const uint8_t* const barray_p = array_p;
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        __darray_raw_filter_add(filter_p, &barray_p[i * filter_p->size_of]);
+    }
+
+    return 0;
+}
+
+
+void* darray_raw_filter_create(const void* const array_p, const size_t size_of, const size_t length, const size_t capacity, const double fpr,
+                               const hasher_fp hash_fp, const size_t key_offset, const size_t key_size)
+{
+    if (array_p == NULL && length > 0)
+    {
+        perror("DArrayRaw: argument array_p is NULL\n");
+        return NULL;
+    }
+
+    if (size_of == 0)
+    {
+        perror("DArrayRaw: argument size_of has to small value\n");
+        return NULL;
+    }
+
+    if (!(fpr > 0.0 && fpr < 1.0))
+    {
+        perror("DArrayRaw: argument fpr has to be in range (0, 1)\n");
+        return NULL;
+    }
+
+    if (hash_fp == NULL && (key_size == 0 || key_offset > size_of || size_of - key_offset < key_size))
+    {
+        perror("DArrayRaw: argument key_offset + key_size is greater than size_of\n");
+        return NULL;
+    }
+
+    DArrayRawFilterS* const filter_p = calloc(1, sizeof(*filter_p));
+
+    if (filter_p == NULL)
+    {
+        perror("DArrayRaw: calloc error\n");
+        return NULL;
+    }
+
+    filter_p->fpr = fpr;
+    filter_p->hash_fp = hash_fp;
+    filter_p->size_of = size_of;
+    filter_p->key_offset = key_offset;
+    filter_p->key_size = key_size;
+
+    if (__darray_raw_filter_build(filter_p, array_p, length, capacity > length ? capacity : length) != 0)
+    {
+        free(filter_p);
+        return NULL;
+    }
+
+    return filter_p;
+}
+
+
+void darray_raw_filter_destroy(void* const filter_p)
+{
+    if (filter_p == NULL)
+    {
+        perror("DArrayRaw: argument filter_p is NULL\n");
+        return;
+    }
+
+    free(((DArrayRawFilterS*)filter_p)->blocks_p);
+    free(filter_p);
+}
+
+
+size_t darray_raw_filter_size(const void* const filter_p)
+{
+    if (filter_p == NULL)
+    {
+        perror("DArrayRaw: argument filter_p is NULL\n");
+        return 0;
+    }
+
+    return sizeof(DArrayRawFilterS) + ((const DArrayRawFilterS*)filter_p)->nblocks * DARRAY_RAW_FILTER_BLOCK;
+}
+
+
+int darray_raw_filter_rebuild(void* const filter_p, const void* const array_p, const size_t length)
+{
+    if (filter_p == NULL)
+    {
+        perror("DArrayRaw: argument filter_p is NULL\n");
+        return -1;
+    }
+
+    if (array_p == NULL && length > 0)
+    {
+        perror("DArrayRaw: argument array_p is NULL\n");
+        return -1;
+    }
+
+    DArrayRawFilterS* const f_p = filter_p;
+
+    return __darray_raw_filter_build(f_p, array_p, length, f_p->capacity > length ? f_p->capacity : length);
+}
+
+
+int darray_raw_filter_contains(const void* const restrict filter_p, const void* const restrict key_p)
+{
+    if (filter_p == NULL)
+    {
+        perror("DArrayRaw: argument filter_p is NULL\n");
+        return -1;
+    }
+
+    if (key_p == NULL)
+    {
+        perror("DArrayRaw: argument key_p is NULL\n");
+        return -1;
+    }
+
+    return __darray_raw_filter_maybe(filter_p, key_p) ? 1 : 0;
+}
+
+
+ssize_t darray_raw_filter_find_first(const void* const restrict filter_p, const void* const restrict array_p, const size_t length,
+                                     const void* const restrict key_p, const compare_fp cmp_fp, void* const out_p)
+{
+    if (darray_raw_filter_contains(filter_p, key_p) != 1)
+    {
+        return -1;
+    }
+
+    return darray_raw_unsorted_find_first(array_p, ((const DArrayRawFilterS*)filter_p)->size_of, length, key_p, cmp_fp, out_p);
+}
+
+
+ssize_t darray_raw_filter_find_last(const void* const restrict filter_p, const void* const restrict array_p, const size_t length,
+                                    const void* const restrict key_p, const compare_fp cmp_fp, void* const out_p)
+{
+    if (darray_raw_filter_contains(filter_p, key_p) != 1)
+    {
+        return -1;
+    }
+
+    return darray_raw_unsorted_find_last(array_p, ((const DArrayRawFilterS*)filter_p)->size_of, length, key_p, cmp_fp, out_p);
+}
+
+
+int darray_raw_filter_unsorted_insert_pos(void* const restrict filter_p, void* const restrict array_p, const size_t length, const size_t pos,
+                                          const void* const restrict data_p)
+{
+    if (filter_p == NULL)
+    {
+        perror("DArrayRaw: argument filter_p is NULL\n");
+        return -1;
+    }
+
+    DArrayRawFilterS* const f_p = filter_p;
+
+    if (darray_raw_unsorted_insert_pos(array_p, f_p->size_of, length, pos, data_p) != 0)
+    {
+        return -1;
+    }
+
+    __darray_raw_filter_add(f_p, data_p);
+
+    /* more keys than capacity raise false positive rate, filter is rebuilt with doubled capacity */
+    if (f_p->nkeys > f_p->capacity)
+    {
+        (void)__darray_raw_filter_build(f_p, array_p, length, 2 * f_p->capacity > length ? 2 * f_p->capacity : length);
+    }
+
+    return 0;
+}
+
+
+int darray_raw_filter_delete_pos(void* const restrict filter_p, void* const restrict array_p, const size_t length, const size_t pos)
+{
+    if (filter_p == NULL)
+    {
+        perror("DArrayRaw: argument filter_p is NULL\n");
+        return -1;
+    }
+
+    DArrayRawFilterS* const f_p = filter_p;
+
+    if (darray_raw_delete_pos(array_p, f_p->size_of, length, pos) != 0)
+    {
+        return -1;
+    }
+
+    /* bits of removed key stay set, filter is rebuilt when they are more than half of keys */
+    ++f_p->nremoved;
+
+    if (2 * f_p->nremoved > f_p->nkeys)
+    {
+        (void)__darray_raw_filter_build(f_p, array_p, length - 1, f_p->capacity);
+    }
+
+    return 0;
+}
@@ -0,0 +1,553 @@
+#include <darray_raw/darray_raw.h>
+#include <stdio.h>
+#include <string.h>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#define DARRAY_RAW_FIND_BITWISE_X86 1
+#endif
+
+
+/*
+    Find first/last occurrence in unsorted array where equality is bytewise equality of 1-, 2-, 4- or 8-byte key
+    placed at key offset of each member (no comparator calls).
+
+    1. Lanes   - array is scanned as stream of bytes split into lanes of key size, starting at key offset modulo key size.
+                 When member size is power of two not bigger than vector, every vector holds whole members and keys
+                 are in the same lanes of each vector, so constant pattern of lanes selects keys (other lanes are ignored).
+    2. Vectors - lanes are compared with broadcast key (16 bytes with SSE2, 32 with AVX2, 64 with AVX-512BW),
+                 four vectors are checked at once by OR of results, exact lane is found only in vectors with match.
+                 find_last scans from the end backward. Instruction set is chosen at run time.
+    3. Scalar  - members which are not fully covered by vectors, bigger members and other platforms use typed loop
+                 (fixed-size load of key, no comparator).
+*/
+
+
+/* number of vectors checked at once */
+#define DARRAY_RAW_FIND_BITWISE_UNROLL  ((size_t)4)
+
+/* no match in vectors */
+#define DARRAY_RAW_FIND_BITWISE_NONE    SIZE_MAX
+
+
+#ifdef DARRAY_RAW_FIND_BITWISE_X86
+
+/*
+ * Scan of @nvec vectors of @vbytes bytes for lane equal to key, for instruction sets with byte masks (SSE2, AVX2).
+ * @cmp(x) compares lanes of vector x with key, @fix(m) corrects byte mask (SSE2 8-byte lanes from 4-byte compares),
+ * @pattern selects first byte of lanes with keys. Result is byte offset of first byte of matching lane.
+ */
+#define DARRAY_RAW_FIND_BITWISE_BYTE_SCAN(vec_t, vbytes, loadu, or, movemask, cmp, fix)                                         \
+    do                                                                                                                          \
+    {                                                                                                                           \
+        if (!backward)                                                                                                          \
+        {                                                                                                                       \
+            size_t v = 0;                                                                                                       \
+                                                                                                                                \
+            for (; v + DARRAY_RAW_FIND_BITWISE_UNROLL <= nvec; v += DARRAY_RAW_FIND_BITWISE_UNROLL)                             \
+            {                                                                                                                   \
+                const vec_t e0 = cmp(loadu((const vec_t*)(const void*)&bytes_p[(v + 0) * (vbytes)]));                          \
+                const vec_t e1 = cmp(loadu((const vec_t*)(const void*)&bytes_p[(v + 1) * (vbytes)]));                          \
+                const vec_t e2 = cmp(loadu((const vec_t*)(const void*)&bytes_p[(v + 2) * (vbytes)]));                          \
+                const vec_t e3 = cmp(loadu((const vec_t*)(const void*)&bytes_p[(v + 3) * (vbytes)]));                          \
+                                                                                                                                \
+                if ((fix((uint64_t)(uint32_t)movemask(or(or(e0, e1), or(e2, e3)))) & pattern) == 0)                            \
+                {                                                                                                               \
+                    continue;                                                                                                   \
+                }                                                                                                               \
+                                                                                                                                \
+                for (size_t j = v; j < v + DARRAY_RAW_FIND_BITWISE_UNROLL; ++j)                                                 \
+                {                                                                                                               \
+                    const uint64_t m = fix((uint64_t)(uint32_t)movemask(cmp(loadu((const vec_t*)(const void*)&bytes_p[j * (vbytes)])))) & pattern; \
+                                                                                                                                \
+                    if (m != 0)                                                                                                 \
+                    {                                                                                                           \
+                        return j * (vbytes) + (size_t)__builtin_ctzll(m);                                                       \
+                    }                                                                                                           \
+                }                                                                                                               \
+            }                                                                                                                   \
+                                                                                                                                \
+            for (; v < nvec; ++v)                                                                                               \
+            {                                                                                                                   \
+                const uint64_t m = fix((uint64_t)(uint32_t)movemask(cmp(loadu((const vec_t*)(const void*)&bytes_p[v * (vbytes)])))) & pattern; \
+                                                                                                                                \
+                if (m != 0)                                                                                                     \
+                {                                                                                                               \
+                    return v * (vbytes) + (size_t)__builtin_ctzll(m);                                                           \
+                }                                                                                                               \
+            }                                                                                                                   \
+        }                                                                                                                       \
+        else                                                                                                                    \
+        {                                                                                                                       \
+            size_t v = nvec;                                                                                                    \
+                                                                                                                                \
+            for (; v >= DARRAY_RAW_FIND_BITWISE_UNROLL; v -= DARRAY_RAW_FIND_BITWISE_UNROLL)                                    \
+            {                                                                                                                   \
+                const size_t base = v - DARRAY_RAW_FIND_BITWISE_UNROLL;                                                         \
+                const vec_t e0 = cmp(loadu((const vec_t*)(const void*)&bytes_p[(base + 0) * (vbytes)]));                       \
+                const vec_t e1 = cmp(loadu((const vec_t*)(const void*)&bytes_p[(base + 1) * (vbytes)]));                       \
+                const vec_t e2 = cmp(loadu((const vec_t*)(const void*)&bytes_p[(base + 2) * (vbytes)]));                       \
+                const vec_t e3 = cmp(loadu((const vec_t*)(const void*)&bytes_p[(base + 3) * (vbytes)]));                       \
+                                                                                                                                \
+                if ((fix((uint64_t)(uint32_t)movemask(or(or(e0, e1), or(e2, e3)))) & pattern) == 0)                            \
+                {                                                                                                               \
+                    continue;                                                                                                   \
+                }                                                                                                               \
+                                                                                                                                \
+                for (size_t j = v; j > base; --j)                                                                               \
+                {                                                                                                               \
+                    const uint64_t m = fix((uint64_t)(uint32_t)movemask(cmp(loadu((const vec_t*)(const void*)&bytes_p[(j - 1) * (vbytes)])))) & pattern; \
+                                                                                                                                \
+                    if (m != 0)                                                                                                 \
+                    {                                                                                                           \
+                        return (j - 1) * (vbytes) + (size_t)(63 - __builtin_clzll(m));                                          \
+                    }                                                                                                           \
+                }                                                                                                               \
+            }                                                                                                                   \
+                                                                                                                                \
+            for (; v > 0; --v)                                                                                                  \
+            {                                                                                                                   \
+                const uint64_t m = fix((uint64_t)(uint32_t)movemask(cmp(loadu((const vec_t*)(const void*)&bytes_p[(v - 1) * (vbytes)])))) & pattern; \
+                                                                                                                                \
+                if (m != 0)                                                                                                     \
+                {                                                                                                               \
+                    return (v - 1) * (vbytes) + (size_t)(63 - __builtin_clzll(m));                                              \
+                }                                                                                                               \
+            }                                                                                                                   \
+        }                                                                                                                       \
+                                                                                                                                \
+        return DARRAY_RAW_FIND_BITWISE_NONE;                                                                                    \
+    } while (0)
+
+
+/*
+ * Scan of @nvec 64-byte vectors for lane equal to key with AVX-512 lane masks.
+ * @cmp(x) returns mask of lanes of vector x equal to key, @pattern selects lanes with keys.
+ * Result is byte offset of matching lane.
+ */
+#define DARRAY_RAW_FIND_BITWISE_LANE_SCAN(cmp)                                                                                  \
+    do                                                                                                                          \
+    {                                                                                                                           \
+        if (!backward)                                                                                                          \
+        {                                                                                                                       \
+            size_t v = 0;                                                                                                       \
+                                                                                                                                \
+            for (; v + DARRAY_RAW_FIND_BITWISE_UNROLL <= nvec; v += DARRAY_RAW_FIND_BITWISE_UNROLL)                             \
+            {                                                                                                                   \
+                const uint64_t m0 = (uint64_t)cmp(_mm512_loadu_si512(&bytes_p[(v + 0) * 64])) & pattern;                        \
+                const uint64_t m1 = (uint64_t)cmp(_mm512_loadu_si512(&bytes_p[(v + 1) * 64])) & pattern;                        \
+                const uint64_t m2 = (uint64_t)cmp(_mm512_loadu_si512(&bytes_p[(v + 2) * 64])) & pattern;                        \
+                const uint64_t m3 = (uint64_t)cmp(_mm512_loadu_si512(&bytes_p[(v + 3) * 64])) & pattern;                        \
+                                                                                                                                \
+                if ((m0 | m1 | m2 | m3) != 0)                                                                                   \
+                {                                                                                                               \
+                    const size_t j = m0 != 0 ? 0 : m1 != 0 ? 1 : m2 != 0 ? 2 : 3;                                               \
+                    const uint64_t m = m0 != 0 ? m0 : m1 != 0 ? m1 : m2 != 0 ? m2 : m3;                                         \
+                                                                                                                                \
+                    return (v + j) * 64 + (size_t)__builtin_ctzll(m) * key_size;                                                \
+                }                                                                                                               \
+            }                                                                                                                   \
+                                                                                                                                \
+            for (; v < nvec; ++v)                                                                                               \
+            {                                                                                                                   \
+                const uint64_t m = (uint64_t)cmp(_mm512_loadu_si512(&bytes_p[v * 64])) & pattern;                               \
+                                                                                                                                \
+                if (m != 0)                                                                                                     \
+                {                                                                                                               \
+                    return v * 64 + (size_t)__builtin_ctzll(m) * key_size;                                                      \
+                }                                                                                                               \
+            }                                                                                                                   \
+        }                                                                                                                       \
+        else                                                                                                                    \
+        {                                                                                                                       \
+            size_t v = nvec;                                                                                                    \
+                                                                                                                                \
+            for (; v >= DARRAY_RAW_FIND_BITWISE_UNROLL; v -= DARRAY_RAW_FIND_BITWISE_UNROLL)                                    \
+            {                                                                                                                   \
+                const uint64_t m0 = (uint64_t)cmp(_mm512_loadu_si512(&bytes_p[(v - 4) * 64])) & pattern;                        \
+                const uint64_t m1 = (uint64_t)cmp(_mm512_loadu_si512(&bytes_p[(v - 3) * 64])) & pattern;                        \
+                const uint64_t m2 = (uint64_t)cmp(_mm512_loadu_si512(&bytes_p[(v - 2) * 64])) & pattern;                        \
+                const uint64_t m3 = (uint64_t)cmp(_mm512_loadu_si512(&bytes_p[(v - 1) * 64])) & pattern;                        \
+                                                                                                                                \
+                if ((m0 | m1 | m2 | m3) != 0)                                                                                   \
+                {                                                                                                               \
+                    const size_t j = m3 != 0 ? 1 : m2 != 0 ? 2 : m1 != 0 ? 3 : 4;                                               \
+                    const uint64_t m = m3 != 0 ? m3 : m2 != 0 ? m2 : m1 != 0 ? m1 : m0;                                         \
+                                                                                                                                \
+                    return (v - j) * 64 + (size_t)(63 - __builtin_clzll(m)) * key_size;                                         \
+                }                                                                                                               \
+            }                                                                                                                   \
+                                                                                                                                \
+            for (; v > 0; --v)                                                                                                  \
+            {                                                                                                                   \
+                const uint64_t m = (uint64_t)cmp(_mm512_loadu_si512(&bytes_p[(v - 1) * 64])) & pattern;                         \
+                                                                                                                                \
+                if (m != 0)                                                                                                     \
+                {                                                                                                               \
+                    return (v - 1) * 64 + (size_t)(63 - __builtin_clzll(m)) * key_size;                                         \
+                }                                                                                                               \
+            }                                                                                                                   \
+        }                                                                                                                       \
+                                                                                                                                \
+        return DARRAY_RAW_FIND_BITWISE_NONE;                                                                                    \
+    } while (0)
+
+
+/*
+ * Internal function which scan vectors with SSE2.
+ *
+ * @param[in] bytes_p  - pointer to first lane.
+ * @param[in] nvec     - number of 16-byte vectors.
+ * @param[in] key      - key value (low @key_size bytes).
+ * @param[in] key_size - size of key (1, 2, 4 or 8).
+ * @param[in] pattern  - byte mask of first bytes of lanes with keys.
+ * @param[in] backward - scan from the end.
+ *
+ * @return: byte offset of matching lane, DARRAY_RAW_FIND_BITWISE_NONE when there is no match.
+ */
+static size_t __darray_raw_find_bitwise_sse2(const uint8_t* bytes_p, size_t nvec, uint64_t key, size_t key_size, uint64_t pattern, bool backward);
+
+
+/*
+ * Internal function which scan vectors with AVX2.
+ *
+ * @param[in] bytes_p  - pointer to first lane.
+ * @param[in] nvec     - number of 32-byte vectors.
+ * @param[in] key      - key value (low @key_size bytes).
+ * @param[in] key_size - size of key (1, 2, 4 or 8).
+ * @param[in] pattern  - byte mask of first bytes of lanes with keys.
+ * @param[in] backward - scan from the end.
+ *
+ * @return: byte offset of matching lane, DARRAY_RAW_FIND_BITWISE_NONE when there is no match.
+ */
+static size_t __darray_raw_find_bitwise_avx2(const uint8_t* bytes_p, size_t nvec, uint64_t key, size_t key_size, uint64_t pattern, bool backward)
+    __attribute__((target("avx2")));
+
+
+/*
+ * Internal function which scan vectors with AVX-512 (BW for 1- and 2-byte keys).
+ *
+ * @param[in] bytes_p  - pointer to first lane.
+ * @param[in] nvec     - number of 64-byte vectors.
+ * @param[in] key      - key value (low @key_size bytes).
+ * @param[in] key_size - size of key (1, 2, 4 or 8).
+ * @param[in] pattern  - lane mask of lanes with keys.
+ * @param[in] backward - scan from the end.
+ *
+ * @return: byte offset of matching lane, DARRAY_RAW_FIND_BITWISE_NONE when there is no match.
+ */
+static size_t __darray_raw_find_bitwise_avx512(const uint8_t* bytes_p, size_t nvec, uint64_t key, size_t key_size, uint64_t pattern, bool backward)
+    __attribute__((target("avx512f,avx512bw")));
+
+#endif /* DARRAY_RAW_FIND_BITWISE_X86 */
+
+
+/*
+ * Internal function which find first or last member in range [@first, @last) with key equal to @key_p by scalar loop.
+ *
+ * @param[in] barray_p   - pointer to array.
+ * @param[in] size_of    - size of each array member.
+ * @param[in] key_offset - offset of key inside member.
+ * @param[in] key_size   - size of key (1, 2, 4 or 8).
+ * @param[in] key_p      - key bytes.
+ * @param[in] first      - first member of range.
+ * @param[in] last       - member after last one of range.
+ * @param[in] backward   - find last instead of first.
+ *
+ * @return: index of member, -1 when there is no match.
+ */
+static ssize_t __darray_raw_find_bitwise_scalar(const uint8_t* barray_p, size_t size_of, size_t key_offset, size_t key_size, const void* key_p,
+                                                size_t first, size_t last, bool backward);
+
+
+/*
+ * Internal function which check arguments and find first or last member with key equal to @key_p.
+ *
+ * @param[in]  array_p    - pointer to array.
+ * @param[in]  size_of    - size of each array member.
+ * @param[in]  length     - number of elements in array.
+ * @param[in]  key_offset - offset of key inside member.
+ * @param[in]  key_size   - size of key (1, 2, 4 or 8).
+ * @param[in]  key_p      - key bytes.
+ * @param[in]  backward   - find last instead of first.
+ * @param[out] out_p      - copy found member if not NULL.
+ *
+ * @return: index of member on success, -1 value on failure.
+ */
+static ssize_t __darray_raw_find_bitwise(const void* array_p, size_t size_of, size_t length, size_t key_offset, size_t key_size, const void* key_p,
+                                         bool backward, void* out_p);
+
+
+#ifdef DARRAY_RAW_FIND_BITWISE_X86
+
+/* SSE2 has no 64-bit compare: 8-byte lane is equal when both its 4-byte halves are equal */
+#define DARRAY_RAW_FIND_BITWISE_FIX_NONE(m) (m)
+#define DARRAY_RAW_FIND_BITWISE_FIX_HALVES(m) ((m) & ((m) >> 4))
+
+#define DARRAY_RAW_FIND_BITWISE_SSE2_CMP8(x) _mm_cmpeq_epi8((x), k)
+#define DARRAY_RAW_FIND_BITWISE_SSE2_CMP16(x) _mm_cmpeq_epi16((x), k)
+#define DARRAY_RAW_FIND_BITWISE_SSE2_CMP32(x) _mm_cmpeq_epi32((x), k)
+
+#define DARRAY_RAW_FIND_BITWISE_AVX2_CMP8(x) _mm256_cmpeq_epi8((x), k)
+#define DARRAY_RAW_FIND_BITWISE_AVX2_CMP16(x) _mm256_cmpeq_epi16((x), k)
+#define DARRAY_RAW_FIND_BITWISE_AVX2_CMP32(x) _mm256_cmpeq_epi32((x), k)
+#define DARRAY_RAW_FIND_BITWISE_AVX2_CMP64(x) _mm256_cmpeq_epi64((x), k)
+
+#define DARRAY_RAW_FIND_BITWISE_AVX512_CMP8(x) _mm512_cmpeq_epi8_mask((x), k)
+#define DARRAY_RAW_FIND_BITWISE_AVX512_CMP16(x) _mm512_cmpeq_epi16_mask((x), k)
+#define DARRAY_RAW_FIND_BITWISE_AVX512_CMP32(x) _mm512_cmpeq_epi32_mask((x), k)
+#define DARRAY_RAW_FIND_BITWISE_AVX512_CMP64(x) _mm512_cmpeq_epi64_mask((x), k)
+
+
+static size_t __darray_raw_find_bitwise_sse2(const uint8_t* const bytes_p, const size_t nvec, const uint64_t key, const size_t key_size,
+                                             const uint64_t pattern, const bool backward)
+{
+    switch (key_size)
+    {
+        case sizeof(uint8_t):
+        {
+            const __m128i k = _mm_set1_epi8((char)key);
+            DARRAY_RAW_FIND_BITWISE_BYTE_SCAN(__m128i, 16, _mm_loadu_si128, _mm_or_si128, _mm_movemask_epi8,
+                                              DARRAY_RAW_FIND_BITWISE_SSE2_CMP8, DARRAY_RAW_FIND_BITWISE_FIX_NONE);
+        }
+        case sizeof(uint16_t):
+        {
+            const __m128i k = _mm_set1_epi16((short)key);
+            DARRAY_RAW_FIND_BITWISE_BYTE_SCAN(__m128i, 16, _mm_loadu_si128, _mm_or_si128, _mm_movemask_epi8,
+                                              DARRAY_RAW_FIND_BITWISE_SSE2_CMP16, DARRAY_RAW_FIND_BITWISE_FIX_NONE);
+        }
+        case sizeof(uint32_t):
+        {
+            const __m128i k = _mm_set1_epi32((int)key);
+            DARRAY_RAW_FIND_BITWISE_BYTE_SCAN(__m128i, 16, _mm_loadu_si128, _mm_or_si128, _mm_movemask_epi8,
+                                              DARRAY_RAW_FIND_BITWISE_SSE2_CMP32, DARRAY_RAW_FIND_BITWISE_FIX_NONE);
+        }
+        default:
+        {
+            const __m128i k = _mm_set1_epi64x((long long)key);
+            DARRAY_RAW_FIND_BITWISE_BYTE_SCAN(__m128i, 16, _mm_loadu_si128, _mm_or_si128, _mm_movemask_epi8,
+                                              DARRAY_RAW_FIND_BITWISE_SSE2_CMP32, DARRAY_RAW_FIND_BITWISE_FIX_HALVES);
+        }
+    }
+}
+
+
+static size_t __darray_raw_find_bitwise_avx2(const uint8_t* const bytes_p, const size_t nvec, const uint64_t key, const size_t key_size,
+                                             const uint64_t pattern, const bool backward)
+{
+    switch (key_size)
+    {
+        case sizeof(uint8_t):
+        {
+            const __m256i k = _mm256_set1_epi8((char)key);
+            DARRAY_RAW_FIND_BITWISE_BYTE_SCAN(__m256i, 32, _mm256_loadu_si256, _mm256_or_si256, _mm256_movemask_epi8,
+                                              DARRAY_RAW_FIND_BITWISE_AVX2_CMP8, DARRAY_RAW_FIND_BITWISE_FIX_NONE);
+        }
+        case sizeof(uint16_t):
+        {
+            const __m256i k = _mm256_set1_epi16((short)key);
+            DARRAY_RAW_FIND_BITWISE_BYTE_SCAN(__m256i, 32, _mm256_loadu_si256, _mm256_or_si256, _mm256_movemask_epi8,
+                                              DARRAY_RAW_FIND_BITWISE_AVX2_CMP16, DARRAY_RAW_FIND_BITWISE_FIX_NONE);
+        }
+        case sizeof(uint32_t):
+        {
+            const __m256i k = _mm256_set1_epi32((int)key);
+            DARRAY_RAW_FIND_BITWISE_BYTE_SCAN(__m256i, 32, _mm256_loadu_si256, _mm256_or_si256, _mm256_movemask_epi8,
+                                              DARRAY_RAW_FIND_BITWISE_AVX2_CMP32, DARRAY_RAW_FIND_BITWISE_FIX_NONE);
+        }
+        default:
+        {
+            const __m256i k = _mm256_set1_epi64x((long long)key);
+            DARRAY_RAW_FIND_BITWISE_BYTE_SCAN(__m256i, 32, _mm256_loadu_si256, _mm256_or_si256, _mm256_movemask_epi8,
+                                              DARRAY_RAW_FIND_BITWISE_AVX2_CMP64, DARRAY_RAW_FIND_BITWISE_FIX_NONE);
+        }
+    }
+}
+
+
+static size_t __darray_raw_find_bitwise_avx512(const uint8_t* const bytes_p, const size_t nvec, const uint64_t key, const size_t key_size,
+                                               const uint64_t pattern, const bool backward)
+{
+    switch (key_size)
+    {
+        case sizeof(uint8_t):
+        {
+            const __m512i k = _mm512_set1_epi8((char)key);
+            DARRAY_RAW_FIND_BITWISE_LANE_SCAN(DARRAY_RAW_FIND_BITWISE_AVX512_CMP8);
+        }
+        case sizeof(uint16_t):
+        {
+            const __m512i k = _mm512_set1_epi16((short)key);
+            DARRAY_RAW_FIND_BITWISE_LANE_SCAN(DARRAY_RAW_FIND_BITWISE_AVX512_CMP16);
+        }
+        case sizeof(uint32_t):
+        {
+            const __m512i k = _mm512_set1_epi32((int)key);
+            DARRAY_RAW_FIND_BITWISE_LANE_SCAN(DARRAY_RAW_FIND_BITWISE_AVX512_CMP32);
+        }
+        default:
+        {
+            const __m512i k = _mm512_set1_epi64((long long)key);
+            DARRAY_RAW_FIND_BITWISE_LANE_SCAN(DARRAY_RAW_FIND_BITWISE_AVX512_CMP64);
+        }
+    }
+}
+
+#endif /* DARRAY_RAW_FIND_BITWISE_X86 */
+
+
+/* scalar loop for key of type @type */
+#define DARRAY_RAW_FIND_BITWISE_SCALAR_LOOP(type)                                                                               \
+    do                                                                                                                          \
+    {                                                                                                                           \
+        type k;                                                                                                                 \
+        (void)memcpy(&k, key_p, sizeof(k));                                                                                     \
+                                                                                                                                \
+        for (size_t i = 0; i < last - first; ++i)                                                                               \
+        {                                                                                                                       \
+            const size_t idx = backward ? last - 1 - i : first + i;                                                             \
+            type v;                                                                                                             \
+            (void)memcpy(&v, &barray_p[idx * size_of + key_offset], sizeof(v));                                                 \
+                                                                                                                                \
+            if (v == k)                                                                                                         \
+            {                                                                                                                   \
+                return (ssize_t)idx;                                                                                            \
+            }                                                                                                                   \
+        }                                                                                                                       \
+                                                                                                                                \
+        return -1;                                                                                                              \
+    } while (0)
+
+
+static ssize_t __darray_raw_find_bitwise_scalar(const uint8_t* const barray_p, const size_t size_of, const size_t key_offset, const size_t key_size,
+                                                const void* const key_p, const size_t first, const size_t last, const bool backward)
+{
+    switch (key_size)
+    {
+        case sizeof(uint8_t): DARRAY_RAW_FIND_BITWISE_SCALAR_LOOP(uint8_t);
+        case sizeof(uint16_t): DARRAY_RAW_FIND_BITWISE_SCALAR_LOOP(uint16_t);
+        case sizeof(uint32_t): DARRAY_RAW_FIND_BITWISE_SCALAR_LOOP(uint32_t);
+        default: DARRAY_RAW_FIND_BITWISE_SCALAR_LOOP(uint64_t);
+    }
+}
+
+
+static ssize_t __darray_raw_find_bitwise(const void* const array_p, const size_t size_of, const size_t length, const size_t key_offset,
+                                         const size_t key_size, const void* const key_p, const bool backward, void* const out_p)
+{
+    if (array_p == NULL)
+    {
+        perror("DArrayRaw: argument array_p is NULL\n");
+        return -1;
+    }
+
+    if (size_of == 0)
+    {
+        perror("DArrayRaw: argument size_of has to small value\n");
+        return -1;
+    }
+
+    if (length == 0)
+    {
+        perror("DArrayRaw: argument length has to small value\n");
+        return -1;
+    }
+
+    if (key_size != sizeof(uint8_t) && key_size != sizeof(uint16_t) && key_size != sizeof(uint32_t) && key_size != sizeof(uint64_t))
+    {
+        perror("DArrayRaw: argument key_size has to be 1, 2, 4 or 8\n");
+        return -1;
+    }
+
+    if (key_offset > size_of || size_of - key_offset < key_size)
+    {
+        perror("DArrayRaw: argument key_offset + key_size is greater than size_of\n");
+        return -1;
+    }
+
+    if (key_p == NULL)
+    {
+        perror("DArrayRaw: argument key_p is NULL\n");
+        return -1;
+    }
+
+    register const uint8_t* const barray_p = array_p;
+
+    /* members [0, @covered) are scanned by vectors, the rest by scalar loop */
+    register size_t covered = 0;
+    register ssize_t idx = -1;
+
+#ifdef DARRAY_RAW_FIND_BITWISE_X86
+    register const bool avx512 = __builtin_cpu_supports("avx512bw") != 0;
+    register const bool avx2 = !avx512 && __builtin_cpu_supports("avx2") != 0;
+    register const size_t vbytes = avx512 ? 64 : avx2 ? 32 : 16;
+
+    /* every vector holds whole members when member size is power of two not bigger than vector */
+    register const bool vectors = (size_of & (size_of - 1)) == 0 && size_of <= vbytes;
+
+    /* lanes start at key offset modulo key size, so key lanes are aligned to lanes */
+    register const size_t shift = key_offset % key_size;
+    register const size_t nvec = vectors ? (length * size_of - shift) / vbytes : 0;
+    register const size_t end = shift + nvec * vbytes;
+
+    covered = end >= key_offset + key_size ? (end - key_offset - key_size) / size_of + 1 : 0;
+    covered = covered < length ? covered : length;
+
+    uint64_t key = 0;
+    (void)memcpy(&key, key_p, key_size);
+
+    /* byte mask (lane mask for AVX-512) of lanes which hold keys */
+    uint64_t pattern = 0;
+
+    for (size_t lane = 0; nvec > 0 && lane < vbytes / key_size; ++lane)
+    {
+        if ((shift + lane * key_size) % size_of == key_offset)
+        {
+            pattern |= (uint64_t)1 << (avx512 ? lane : lane * key_size);
+        }
+    }
+
+    if (backward && covered < length)
+    {
+        idx = __darray_raw_find_bitwise_scalar(barray_p, size_of, key_offset, key_size, key_p, covered, length, true);
+    }
+
+    if (idx == -1 && nvec > 0)
+    {
+        register const size_t offset = avx512 ? __darray_raw_find_bitwise_avx512(&barray_p[shift], nvec, key, key_size, pattern, backward)
+                                     : avx2   ? __darray_raw_find_bitwise_avx2(&barray_p[shift], nvec, key, key_size, pattern, backward)
+                                              : __darray_raw_find_bitwise_sse2(&barray_p[shift], nvec, key, key_size, pattern, backward);
+
+        if (offset != DARRAY_RAW_FIND_BITWISE_NONE)
+        {
+            idx = (ssize_t)((shift + offset) / size_of);
+        }
+    }
+
+    if (idx == -1 && !backward && covered < length)
+#endif
+    {
+        idx = __darray_raw_find_bitwise_scalar(barray_p, size_of, key_offset, key_size, key_p, covered, length, backward);
+    }
+
+    if (idx != -1 && out_p != NULL)
+    {
+        assign(out_p, &barray_p[(size_t)idx * size_of], size_of);
+    }
+
+    return idx;
+}
+
+
+ssize_t darray_raw_unsorted_find_first_bitwise(const void* const restrict array_p, const size_t size_of, const size_t length, const size_t key_offset,
+                                               const size_t key_size, const void* const restrict key_p, void* const out_p)
+{
+    return __darray_raw_find_bitwise(array_p, size_of, length, key_offset, key_size, key_p, false, out_p);
+}
+
+
+ssize_t darray_raw_unsorted_find_last_bitwise(const void* const restrict array_p, const size_t size_of, const size_t length, const size_t key_offset,
+                                              const size_t key_size, const void* const restrict key_p, void* const out_p)
+{
+    return __darray_raw_find_bitwise(array_p, size_of, length, key_offset, key_size, key_p, true, out_p);
+}
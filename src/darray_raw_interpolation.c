@@ -0,0 +1,249 @@
+#include <darray_raw/darray_raw.h>
+#include <stdio.h>
+
+
+/*
+    Interpolation search for sorted arrays of numeric keys (timestamps, hashed IDs), safeguarded by bisection.
+
+    1. Probe     - position of key is estimated by linear interpolation between numbers of first and last member
+                   of remaining range (@num_fp maps member to number), so uniform keys are found in few probes.
+    2. Guard     - uniform keys need O(log log n) interpolation steps, after twice that many steps (keys are skewed)
+                   search continues by bisection, so worst case is O(log n) probes like binary search.
+    3. Scan      - ranges up to DARRAY_RAW_INTERPOLATION_LINEAR members are scanned sequentially
+                   (probe error is usually few members, so scan is cheaper than more probes).
+
+    All decisions are made by @cmp_fp, numbers are used only for estimates.
+*/
+
+
+/* ranges with at most this number of members are scanned sequentially */
+#define DARRAY_RAW_INTERPOLATION_LINEAR     ((size_t)8)
+
+/*
+ * Internal function which estimate position of key with number @key in range [@low, @high) by interpolation.
+ *
+ * @param[in] barray_p - pointer to array.
+ * @param[in] size_of  - size of each array member.
+ * @param[in] low      - first index of range.
+ * @param[in] high     - index after last one of range (@high > @low).
+ * @param[in] key      - number of searched key.
+ * @param[in] num_fp   - number function pointer.
+ *
+ * @return: estimated index in range [@low, @high).
+ */
+static inline size_t __darray_raw_interpolation_probe(const uint8_t* barray_p, size_t size_of, size_t low, size_t high, double key, const number_fp num_fp);
+
+
+/*
+ * Internal function which get index of first member for which key does not go right (lower bound when @limit is 1,
+ * upper bound when @limit is 0).
+ *
+ * @param[in] barray_p - pointer to array.
+ * @param[in] size_of  - size of each array member.
+ * @param[in] length   - number of elements in array.
+ * @param[in] data_p   - searched value.
+ * @param[in] cmp_fp   - comparator function pointer, called as cmp_fp(data_p, array member).
+ * @param[in] num_fp   - number function pointer.
+ * @param[in] limit    - search goes right when comparator result is not less than @limit.
+ *
+ * @return: bound index.
+ */
+static size_t __darray_raw_interpolation_bound(const uint8_t* barray_p, size_t size_of, size_t length, const void* data_p,
+                                               const compare_fp cmp_fp, const number_fp num_fp, int limit);
+
+
+/*
+ * Internal function which check arguments of interpolation search.
+ *
+ * @param[in] array_p - pointer to array.
+ * @param[in] size_of - size of each array member.
+ * @param[in] length  - number of elements in array.
+ * @param[in] data_p  - searched value.
+ * @param[in] cmp_fp  - comparator function pointer.
+ * @param[in] num_fp  - number function pointer.
+ *
+ * @return: 0 on success, -1 on failure.
+ */
+static int __darray_raw_interpolation_check(const void* array_p, size_t size_of, size_t length, const void* data_p,
+                                            const compare_fp cmp_fp, const number_fp num_fp);
+
+
+static inline size_t __darray_raw_interpolation_probe(const uint8_t* const barray_p, const size_t size_of, const size_t low, const size_t high,
+                                                      const double key, const number_fp num_fp)
+{
+    register const double first = num_fp(&barray_p[low * size_of]);
+    register const double last = num_fp(&barray_p[(high - 1) * size_of]);
+
+    /* negated comparisons are also true for NaN */
+    if (!(last > first) || !(key > first))
+    {
+        return low;
+    }
+
+    if (!(key < last))
+    {
+        return high - 1;
+    }
+
+    return low + (size_t)((key - first) / (last - first) * (double)(high - 1 - low));
+}
+
+
+static size_t __darray_raw_interpolation_bound(const uint8_t* const barray_p, const size_t size_of, const size_t length, const void* const data_p,
+                                               const compare_fp cmp_fp, const number_fp num_fp, const int limit)
+{
+    register const double key = num_fp(data_p);
+
+    /* uniform keys need O(log log n) interpolation steps, budget is twice that */
+    register size_t budget = 2;
+
+    for (size_t bits = (size_t)(64 - __builtin_clzll((unsigned long long)length)); bits > 1; bits >>= 1)
+    {
+        budget += 2;
+    }
+
+    /* members before @low go right, members from @high do not */
+    register size_t low = 0;
+    register size_t high = length;
+
+    while (high - low > DARRAY_RAW_INTERPOLATION_LINEAR)
+    {
+        register const size_t range = high - low;
+        register const size_t pos = budget > 0 ? __darray_raw_interpolation_probe(barray_p, size_of, low, high, key, num_fp) : low + range / 2;
+
+        budget -= budget > 0 ? 1 : 0;
+
+        if (cmp_fp(data_p, &barray_p[pos * size_of]) >= limit)
+        {
+            low = pos + 1;
+        }
+        else
+        {
+            high = pos;
+        }
+    }
+
+    while (low < high && cmp_fp(data_p, &barray_p[low * size_of]) >= limit)
+    {
+        ++low;
+    }
+
+    return low;
+}
+
+
+static int __darray_raw_interpolation_check(const void* const array_p, const size_t size_of, const size_t length, const void* const data_p,
+                                            const compare_fp cmp_fp, const number_fp num_fp)
+{
+    if (array_p == NULL)
+    {
+        perror("DArrayRaw: argument array_p is NULL\n");
+        return -1;
+    }
+
+    if (size_of == 0)
+    {
+        perror("DArrayRaw: argument size_of has to small value\n");
+        return -1;
+    }
+
+    if (length == 0)
+    {
+        perror("DArrayRaw: argument length has to small value\n");
+        return -1;
+    }
+
+    if (data_p == NULL)
+    {
+        perror("DArrayRaw: argument data_p is NULL\n");
+        return -1;
+    }
+
+    if (cmp_fp == NULL)
+    {
+        perror("DArrayRaw: argument cmp_fp is NULL\n");
+        return -1;
+    }
+
+    if (num_fp == NULL)
+    {
+        perror("DArrayRaw: argument num_fp is NULL\n");
+        return -1;
+    }
+
+    return 0;
+}
+
+
+ssize_t darray_raw_interpolation_lower_bound(const void* const restrict array_p, const size_t size_of, const size_t length, const void* const restrict data_p,
+                                             const compare_fp cmp_fp, const number_fp num_fp)
+{
+    if (__darray_raw_interpolation_check(array_p, size_of, length, data_p, cmp_fp, num_fp) != 0)
+    {
+        return -1;
+    }
+
+    return (ssize_t)__darray_raw_interpolation_bound(array_p, size_of, length, data_p, cmp_fp, num_fp, 1);
+}
+
+
+ssize_t darray_raw_interpolation_upper_bound(const void* const restrict array_p, const size_t size_of, const size_t length, const void* const restrict data_p,
+                                             const compare_fp cmp_fp, const number_fp num_fp)
+{
+    if (__darray_raw_interpolation_check(array_p, size_of, length, data_p, cmp_fp, num_fp) != 0)
+    {
+        return -1;
+    }
+
+    return (ssize_t)__darray_raw_interpolation_bound(array_p, size_of, length, data_p, cmp_fp, num_fp, 0);
+}
+
+
+ssize_t darray_raw_interpolation_find_first(const void* const restrict array_p, const size_t size_of, const size_t length, const void* const restrict key_p,
+                                            const compare_fp cmp_fp, const number_fp num_fp, void* const out_p)
+{
+    if (__darray_raw_interpolation_check(array_p, size_of, length, key_p, cmp_fp, num_fp) != 0)
+    {
+        return -1;
+    }
+
+    register const uint8_t* const barray_p = array_p;
+    register const size_t idx = __darray_raw_interpolation_bound(barray_p, size_of, length, key_p, cmp_fp, num_fp, 1);
+
+    if (idx < length && cmp_fp(&barray_p[idx * size_of], key_p) == 0)
+    {
+        if (out_p != NULL)
+        {
+            assign(out_p, &barray_p[idx * size_of], size_of);
+        }
+
+        return (ssize_t)idx;
+    }
+
+    return -1;
+}
+
+
+ssize_t darray_raw_interpolation_find_last(const void* const restrict array_p, const size_t size_of, const size_t length, const void* const restrict key_p,
+                                           const compare_fp cmp_fp, const number_fp num_fp, void* const out_p)
+{
+    if (__darray_raw_interpolation_check(array_p, size_of, length, key_p, cmp_fp, num_fp) != 0)
+    {
+        return -1;
+    }
+
+    register const uint8_t* const barray_p = array_p;
+    register const size_t bound = __darray_raw_interpolation_bound(barray_p, size_of, length, key_p, cmp_fp, num_fp, 0);
+
+    if (bound > 0 && cmp_fp(&barray_p[(bound - 1) * size_of], key_p) == 0)
+    {
+        if (out_p != NULL)
+        {
+            assign(out_p, &barray_p[(bound - 1) * size_of], size_of);
+        }
+
+        return (ssize_t)(bound - 1);
+    }
+
+    return -1;
+}
@@ -0,0 +1,489 @@
+#include <darray_raw/darray_raw.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+
+/*
+    Learned index (piecewise linear model) for sorted arrays of numeric keys (timestamps, monotone IDs).
+
+    1. Model   - keys are mapped to numbers by @num_fp and first index of each distinct number is a point (number, rank).
+                 Points are covered by linear segments, so rank predicted by segment differs from rank of its points
+                 by at most epsilon.
+    2. Build   - one pass over sorted array: segment starts at its first point and keeps cone of slopes which keep
+                 all its points within epsilon (shrinking cone), segment ends when cone becomes empty.
+    3. Radix   - segment of key is found by table of buckets of equal width over range of numbers (bucket stores first
+                 segment of bucket), so only few segments are checked instead of binary search over all of them.
+    4. Search  - only window of 2 * epsilon + 1 members around predicted rank is searched by @cmp_fp. When bound is out
+                 of window (many equal keys, @num_fp loses precision), window is extended by exponential search,
+                 so result is always the same as from darray_raw_lower_bound / darray_raw_upper_bound.
+
+    Model stores 24 bytes per segment and 8 bytes per bucket, smooth keys need few segments for millions of members.
+*/
+
+
+/* initial capacity of segments during build */
+#define DARRAY_RAW_LEARNED_INIT_SEGMENTS ((size_t)64)
+
+
+/* header of model, segments and buckets follow it */
+typedef struct DArrayRawLearnedS
+{
+    size_t size_of;
+    size_t length;
+    size_t epsilon;
+    size_t nsegments;
+    size_t nbuckets;
+    double min;         /* number of first key */
+    double scale;       /* number of buckets per unit of number */
+} DArrayRawLearnedS;
+
+
+/* linear segment, predicted rank of number x is rank + (x - key) * slope */
+typedef struct DArrayRawLearnedSegmentS
+{
+    double key;
+    double slope;
+    size_t rank;
+} DArrayRawLearnedSegmentS;
+
+
+/*
+ * Internal function which get segments of model.
+ *
+ * @param[in] model_p - pointer to model.
+ *
+ * @return: pointer to first segment.
+ */
+static inline DArrayRawLearnedSegmentS* __darray_raw_learned_segments(const DArrayRawLearnedS* model_p);
+
+
+/*
+ * Internal function which get buckets of model (nbuckets + 1 entries, first segment of each bucket).
+ *
+ * @param[in] model_p - pointer to model.
+ *
+ * @return: pointer to first bucket.
+ */
+static inline size_t* __darray_raw_learned_buckets(const DArrayRawLearnedS* model_p);
+
+
+/*
+ * Internal function which compute bucket of number @x, the same function is used for segments and searched keys.
+ *
+ * @param[in] model_p - pointer to model.
+ * @param[in] x       - number.
+ *
+ * @return: bucket in range [0, nbuckets).
+ */
+static inline size_t __darray_raw_learned_bucket(const DArrayRawLearnedS* model_p, double x);
+
+
+/*
+ * Internal function which predict rank of number @x.
+ *
+ * @param[in] model_p - pointer to model.
+ * @param[in] x       - number.
+ *
+ * @return: predicted rank in range [0, length].
+ */
+static size_t __darray_raw_learned_predict(const DArrayRawLearnedS* model_p, double x);
+
+
+/*
+ * Internal function which get index of first member for which key does not go right (lower bound when @limit is 1,
+ * upper bound when @limit is 0), searching window around predicted rank.
+ *
+ * @param[in] model_p - pointer to model.
+ * @param[in] array_p - pointer to sorted array.
+ * @param[in] data_p  - searched value.
+ * @param[in] cmp_fp  - comparator function pointer, called as cmp_fp(data_p, array member).
+ * @param[in] num_fp  - number function pointer.
+ * @param[in] limit   - search goes right when comparator result is not less than @limit.
+ *
+ * @return: bound index.
+ */
+static size_t __darray_raw_learned_bound(const DArrayRawLearnedS* model_p, const void* array_p, const void* data_p,
+                                         const compare_fp cmp_fp, const number_fp num_fp, int limit);
+
+
+/*
+ * Internal function which check arguments of lower and upper bound.
+ *
+ * @param[in] learned_p - pointer to model.
+ * @param[in] array_p   - pointer to sorted array.
+ * @param[in] data_p    - searched value.
+ * @param[in] cmp_fp    - comparator function pointer.
+ * @param[in] num_fp    - number function pointer.
+ *
+ * @return: 0 on success, -1 on failure.
+ */
+static int __darray_raw_learned_check(const void* learned_p, const void* array_p, const void* data_p, const compare_fp cmp_fp, const number_fp num_fp);
+
+
+static inline DArrayRawLearnedSegmentS* __darray_raw_learned_segments(const DArrayRawLearnedS* const model_p)
+{
+    return (DArrayRawLearnedSegmentS*)(uintptr_t)&model_p[1];
+}
+
+
+static inline size_t* __darray_raw_learned_buckets(const DArrayRawLearnedS* const model_p)
+{
+    return (size_t*)(uintptr_t)&__darray_raw_learned_segments(model_p)[model_p->nsegments];
+}
+
+
+static inline size_t __darray_raw_learned_bucket(const DArrayRawLearnedS* const model_p, const double x)
+{
+    register const double b = (x - model_p->min) * model_p->scale;
+
+    /* negated comparisons are also true for NaN */
+    if (!(b > 0.0))
+    {
+        return 0;
+    }
+
+    if (!(b < (double)model_p->nbuckets))
+    {
+        return model_p->nbuckets - 1;
+    }
+
+    return (size_t)b;
+}
+
+
+static size_t __darray_raw_learned_predict(const DArrayRawLearnedS* const model_p, const double x)
+{
+    register const DArrayRawLearnedSegmentS* const segments_p = __darray_raw_learned_segments(model_p);
+    register const size_t* const buckets_p = __darray_raw_learned_buckets(model_p);
+    register const size_t bucket = __darray_raw_learned_bucket(model_p, x);
+
+    /* segments of lower buckets start before @x, segments of higher buckets after it */
+    register size_t low = buckets_p[bucket] > 0 ? buckets_p[bucket] - 1 : 0;
+    register size_t high = buckets_p[bucket + 1] > 0 ? buckets_p[bucket + 1] - 1 : 0;
+
+    /* last segment which starts at or before @x */
+    while (low < high)
+    {
+        register const size_t middle = low + (high - low + 1) / 2;
+
+        if (segments_p[middle].key <= x)
+        {
+            low = middle;
+        }
+        else
+        {
+            high = middle - 1;
+        }
+    }
+
+    register const DArrayRawLearnedSegmentS* const segment_p = &segments_p[low];
+    register const size_t first = segment_p->rank;
+    register const size_t last = low + 1 < model_p->nsegments ? segments_p[low + 1].rank : model_p->length;
+    register const double pos = (double)first + (x - segment_p->key) * segment_p->slope;
+
+    if (!(pos > (double)first))
+    {
+        return first;
+    }
+
+    if (!(pos < (double)last))
+    {
+        return last;
+    }
+
+    return (size_t)pos;
+}
+
+
+static size_t __darray_raw_learned_bound(const DArrayRawLearnedS* const model_p, const void* const array_p, const void* const data_p,
+                                         const compare_fp cmp_fp, const number_fp num_fp, const int limit)
+{
+    register const uint8_t* const barray_p = array_p;
+    register const size_t size_of = model_p->size_of;
+    register const size_t length = model_p->length;
+    register const size_t epsilon = model_p->epsilon;
+    register const size_t pos = __darray_raw_learned_predict(model_p, num_fp(data_p));
+
+    /* bound is in [@low, @high] when member before @low goes right and member at @high does not */
+    register size_t low = pos > epsilon ? pos - epsilon : 0;
+    register size_t high = length - pos > epsilon + 1 ? pos + epsilon + 1 : length;
+
+    if (low > 0 && cmp_fp(data_p, &barray_p[(low - 1) * size_of]) < limit)
+    {
+        register size_t step = 1;
+
+        do
+        {
+            high = low - 1;
+            low = high > step ? high - step : 0;
+            step *= 2;
+        } while (low > 0 && cmp_fp(data_p, &barray_p[(low - 1) * size_of]) < limit);
+    }
+    else if (high < length && cmp_fp(data_p, &barray_p[high * size_of]) >= limit)
+    {
+        register size_t step = 1;
+
+        do
+        {
+            low = high + 1;
+            high = length - low > step ? low + step : length;
+            step *= 2;
+        } while (high < length && cmp_fp(data_p, &barray_p[high * size_of]) >= limit);
+    }
+
+    while (low < high)
+    {
+        register const size_t middle = low + (high - low) / 2;
+
+        if (cmp_fp(data_p, &barray_p[middle * size_of]) >= limit)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    return low;
+}
+
+
+static int __darray_raw_learned_check(const void* const learned_p, const void* const array_p, const void* const data_p,
+                                      const compare_fp cmp_fp, const number_fp num_fp)
+{
+    if (learned_p == NULL)
+    {
+        perror("DArrayRaw: argument learned_p is NULL\n");
+        return -1;
+    }
+
+    if (array_p == NULL)
+    {
+        perror("DArrayRaw: argument array_p is NULL\n");
+        return -1;
+    }
+
+    if (data_p == NULL)
+    {
+        perror("DArrayRaw: argument data_p is NULL\n");
+        return -1;
+    }
+
+    if (cmp_fp == NULL)
+    {
+        perror("DArrayRaw: argument cmp_fp is NULL\n");
+        return -1;
+    }
+
+    if (num_fp == NULL)
+    {
+        perror("DArrayRaw: argument num_fp is NULL\n");
+        return -1;
+    }
+
+    return 0;
+}
+
+
+void* darray_raw_learned_create(const void* const array_p, const size_t size_of, const size_t length, const number_fp num_fp, const size_t epsilon)
+{
+    if (array_p == NULL)
+    {
+        perror("DArrayRaw: argument array_p is NULL\n");
+        return NULL;
+    }
+
+    if (size_of == 0)
+    {
+        perror("DArrayRaw: argument size_of has to small value\n");
+        return NULL;
+    }
+
+    if (length == 0)
+    {
+        perror("DArrayRaw: argument length has to small value\n");
+        return NULL;
+    }
+
+    if (num_fp == NULL)
+    {
+        perror("DArrayRaw: argument num_fp is NULL\n");
+        return NULL;
+    }
+
+    if (epsilon == 0)
+    {
+        perror("DArrayRaw: argument epsilon has to small value\n");
+        return NULL;
+    }
+
+    register const uint8_t* const barray_p = array_p;
+    register size_t capacity = DARRAY_RAW_LEARNED_INIT_SEGMENTS;
+
+    DArrayRawLearnedS* model_p = malloc(sizeof(*model_p) + capacity * sizeof(DArrayRawLearnedSegmentS));
+
+    if (model_p == NULL)
+    {
+        perror("DArrayRaw: malloc error\n");
+        return NULL;
+    }
+
+    model_p->size_of = size_of;
+    model_p->length = length;
+    model_p->epsilon = epsilon;
+    model_p->nsegments = 0;
+
+    /* open segment and its cone of slopes, @count is 0 when no segment is open */
+    double key = 0.0;
+    double slope_low = 0.0;
+    double slope_high = INFINITY;
+    double last = 0.0;
+    size_t rank = 0;
+    size_t count = 0;
+
+    register const double eps = (double)epsilon;
+
+    for (size_t i = 0; i <= length; ++i)
+    {
+        register const double x = i < length ? num_fp(&barray_p[i * size_of]) : 0.0;
+
+        /* equal numbers keep rank of first one, numbers which are not finite or not increasing are left to search */
+        if (i < length && (!isfinite(x) || (count > 0 && !(x > last))))
+        {
+            continue;
+        }
+
+        if (count > 0 && i < length)
+        {
+            register const double dx = x - key;
+            register const double low = ((double)(i - rank) - eps) / dx;
+            register const double high = ((double)(i - rank) + eps) / dx;
+
+            if ((low > slope_low ? low : slope_low) <= (high < slope_high ? high : slope_high))
+            {
+                slope_low = low > slope_low ? low : slope_low;
+                slope_high = high < slope_high ? high : slope_high;
+                last = x;
+                ++count;
+                continue;
+            }
+        }
+
+        if (count > 0)
+        {
+            if (model_p->nsegments == capacity)
+            {
+                capacity *= 2;
+
+                DArrayRawLearnedS* const new_model_p = realloc(model_p, sizeof(*model_p) + capacity * sizeof(DArrayRawLearnedSegmentS));
+
+                if (new_model_p == NULL)
+                {
+                    perror("DArrayRaw: realloc error\n");
+                    free(model_p);
+                    return NULL;
+                }
+
+                model_p = new_model_p;
+            }
+
+            /* middle of cone keeps all points within epsilon, segment with one point is flat */
+            __darray_raw_learned_segments(model_p)[model_p->nsegments++] = (DArrayRawLearnedSegmentS){
+                .key = key,
+                .slope = count > 1 ? (slope_low + slope_high) / 2.0 : 0.0,
+                .rank = rank,
+            };
+        }
+
+        if (i < length)
+        {
+            key = x;
+            last = x;
+            rank = i;
+            count = 1;
+            slope_low = 0.0;
+            slope_high = INFINITY;
+        }
+    }
+
+    /* all numbers are not finite, one flat segment sends every search to exponential search */
+    if (model_p->nsegments == 0)
+    {
+        __darray_raw_learned_segments(model_p)[model_p->nsegments++] = (DArrayRawLearnedSegmentS){ .key = 0.0, .slope = 0.0, .rank = 0 };
+        last = 0.0;
+    }
+
+    register const size_t nsegments = model_p->nsegments;
+
+    model_p->nbuckets = nsegments;
+    model_p->min = __darray_raw_learned_segments(model_p)[0].key;
+    model_p->scale = last > model_p->min ? (double)nsegments / (last - model_p->min) : 0.0;
+
+    DArrayRawLearnedS* const new_model_p = realloc(model_p, sizeof(*model_p) + nsegments * sizeof(DArrayRawLearnedSegmentS) + (nsegments + 1) * sizeof(size_t));
+
+    if (new_model_p == NULL)
+    {
+        perror("DArrayRaw: realloc error\n");
+        free(model_p);
+        return NULL;
+    }
+
+    model_p = new_model_p;
+
+    register const DArrayRawLearnedSegmentS* const segments_p = __darray_raw_learned_segments(model_p);
+    register size_t* const buckets_p = __darray_raw_learned_buckets(model_p);
+    register size_t segment = 0;
+
+    /* bucket stores number of segments in lower buckets */
+    for (size_t b = 0; b <= model_p->nbuckets; ++b)
+    {
+        while (segment < nsegments && __darray_raw_learned_bucket(model_p, segments_p[segment].key) < b)
+        {
+            ++segment;
+        }
+
+        buckets_p[b] = segment;
+    }
+
+    return model_p;
+}
+
+
+size_t darray_raw_learned_size(const void* const learned_p)
+{
+    if (learned_p == NULL)
+    {
+        perror("DArrayRaw: argument learned_p is NULL\n");
+        return 0;
+    }
+
+    register const DArrayRawLearnedS* const model_p = learned_p;
+
+    return sizeof(*model_p) + model_p->nsegments * sizeof(DArrayRawLearnedSegmentS) + (model_p->nbuckets + 1) * sizeof(size_t);
+}
+
+
+ssize_t darray_raw_learned_lower_bound(const void* const restrict learned_p, const void* const restrict array_p, const void* const restrict data_p,
+                                       const compare_fp cmp_fp, const number_fp num_fp)
+{
+    if (__darray_raw_learned_check(learned_p, array_p, data_p, cmp_fp, num_fp) != 0)
+    {
+        return -1;
+    }
+
+    return (ssize_t)__darray_raw_learned_bound(learned_p, array_p, data_p, cmp_fp, num_fp, 1);
+}
+
+
+ssize_t darray_raw_learned_upper_bound(const void* const restrict learned_p, const void* const restrict array_p, const void* const restrict data_p,
+                                       const compare_fp cmp_fp, const number_fp num_fp)
+{
+    if (__darray_raw_learned_check(learned_p, array_p, data_p, cmp_fp, num_fp) != 0)
+    {
+        return -1;
+    }
+
+    return (ssize_t)__darray_raw_learned_bound(learned_p, array_p, data_p, cmp_fp, num_fp, 0);
+}
@@ -0,0 +1,686 @@
+#include <darray_raw/darray_raw.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+
+/*
+    K-way merge of sorted arrays.
+
+    1. Two-way  - when only two inputs are not empty, they are merged directly. After DARRAY_RAW_MERGE_MIN_GALLOP
+                  elements in a row are taken from one input, its next elements are found by exponential search
+                  and copied as one block, so very unequal inputs cost O(log n) comparisons per block.
+    2. K-way    - loser (tournament) tree over not empty inputs. Tree node keeps loser of its match, so after
+                  winner is taken only path from its leaf to root is replayed: log2(k) comparisons per element.
+    3. Unique   - element equal to last written element is dropped, so each value is written once.
+    4. Parallel - output is split into equal slices. Start of slice is co-ranked: for each input number of its
+                  elements placed before output rank is found by binary search, so threads merge disjoint inputs
+                  into disjoint slices of output without synchronization.
+
+    Merge is stable: equal elements are written in order of inputs, and in order of positions inside input.
+*/
+
+
+/* number of elements taken in a row from one input after which two-way merge starts galloping */
+#define DARRAY_RAW_MERGE_MIN_GALLOP         ((size_t)7)
+
+/* minimal number of output elements per thread in parallel merge */
+#define DARRAY_RAW_MERGE_MIN_PER_THREAD     ((size_t)1 << 15)
+
+
+/* state of loser tree merge */
+typedef struct DArrayRawMergeS
+{
+    const uint8_t* const* srcs_p;
+    const size_t* lengths_p;
+    size_t size_of;
+    compare_fp cmp_fp;
+
+    size_t* map_p;      /* leaf -> index of input */
+    size_t* pos_p;      /* leaf -> position of head in input */
+} DArrayRawMergeS;
+
+
+/* state shared by threads of parallel merge */
+typedef struct DArrayRawPMergeS
+{
+    uint8_t* dst_p;
+    const uint8_t* const* srcs_p;
+    const size_t* lengths_p;
+    size_t k;
+    size_t size_of;
+    compare_fp cmp_fp;
+
+    size_t total;
+    size_t nthreads;
+} DArrayRawPMergeS;
+
+
+/* argument of one thread of parallel merge */
+typedef struct DArrayRawPMergeThreadS
+{
+    const DArrayRawPMergeS* ctx_p;
+    size_t tid;
+    int ret;
+} DArrayRawPMergeThreadS;
+
+
+/*
+ * Internal function which validate arguments of merge functions.
+ *
+ * @param[in] dst_p     - output array.
+ * @param[in] srcs_p    - sorted input arrays.
+ * @param[in] lengths_p - lengths of input arrays.
+ * @param[in] k         - number of input arrays.
+ * @param[in] size_of   - size of each array member.
+ * @param[in] cmp_fp    - comparator function pointer.
+ *
+ * @return: 0 if arguments are valid, -1 if not.
+ */
+static int __darray_raw_merge_check(const void* dst_p, const void* const* srcs_p, const size_t* lengths_p, size_t k, size_t size_of, const compare_fp cmp_fp);
+
+
+/*
+ * Internal function which copy @n elements from @src_p to the end of output, dropping duplicates if @unique.
+ *
+ * @param[in] dst_p   - output array.
+ * @param[in] out     - number of elements already written to output.
+ * @param[in] src_p   - elements to copy.
+ * @param[in] n       - number of elements to copy.
+ * @param[in] size_of - size of each array member.
+ * @param[in] cmp_fp  - comparator function pointer.
+ * @param[in] unique  - drop elements equal to last written one.
+ *
+ * @return: number of elements written to output after copy.
+ */
+static inline size_t __darray_raw_merge_emit(uint8_t* restrict dst_p, size_t out, const uint8_t* restrict src_p, size_t n,
+                                             size_t size_of, const compare_fp cmp_fp, bool unique);
+
+
+/*
+ * Internal function which count leading elements of sorted @array_p which are less (or less or equal if @upper) than @key_p.
+ * Exponential search is used, so cost is O(log result).
+ *
+ * @param[in] array_p - pointer to array.
+ * @param[in] size_of - size of each array member.
+ * @param[in] length  - number of elements in array.
+ * @param[in] key_p   - key.
+ * @param[in] cmp_fp  - comparator function pointer.
+ * @param[in] upper   - count also elements equal to @key_p.
+ *
+ * @return: number of counted elements.
+ */
+static size_t __darray_raw_merge_gallop(const uint8_t* array_p, size_t size_of, size_t length, const void* key_p, const compare_fp cmp_fp, bool upper);
+
+
+/*
+ * Internal function which count elements of sorted @array_p which are less (or less or equal if @upper) than @key_p.
+ *
+ * @param[in] array_p - pointer to array.
+ * @param[in] size_of - size of each array member.
+ * @param[in] length  - number of elements in array.
+ * @param[in] key_p   - key.
+ * @param[in] cmp_fp  - comparator function pointer.
+ * @param[in] upper   - count also elements equal to @key_p.
+ *
+ * @return: number of counted elements.
+ */
+static size_t __darray_raw_merge_bound(const uint8_t* array_p, size_t size_of, size_t length, const void* key_p, const compare_fp cmp_fp, bool upper);
+
+
+/*
+ * Internal function which merge two sorted arrays with galloping.
+ *
+ * @param[in] dst_p    - output array.
+ * @param[in] first_p  - first array, its elements go first when equal.
+ * @param[in] first_n  - number of elements in first array.
+ * @param[in] second_p - second array.
+ * @param[in] second_n - number of elements in second array.
+ * @param[in] size_of  - size of each array member.
+ * @param[in] cmp_fp   - comparator function pointer.
+ * @param[in] unique   - drop duplicates.
+ *
+ * @return: number of elements written to output.
+ */
+static size_t __darray_raw_merge_two(uint8_t* restrict dst_p, const uint8_t* first_p, size_t first_n, const uint8_t* second_p, size_t second_n,
+                                     size_t size_of, const compare_fp cmp_fp, bool unique);
+
+
+/*
+ * Internal function which check if head of leaf @first goes before head of leaf @second. Exhausted leaf goes last.
+ *
+ * @param[in] ctx_p  - loser tree state.
+ * @param[in] first  - first leaf.
+ * @param[in] second - second leaf.
+ *
+ * @return: true if @first goes before @second.
+ */
+static inline bool __darray_raw_merge_less(const DArrayRawMergeS* ctx_p, size_t first, size_t second);
+
+
+/*
+ * Internal function which merge sorted arrays. Empty arrays are allowed.
+ *
+ * @param[in] dst_p     - output array.
+ * @param[in] srcs_p    - sorted input arrays.
+ * @param[in] lengths_p - lengths of input arrays.
+ * @param[in] k         - number of input arrays.
+ * @param[in] size_of   - size of each array member.
+ * @param[in] cmp_fp    - comparator function pointer.
+ * @param[in] unique    - drop duplicates.
+ *
+ * @return: number of elements written to output, -1 on failure.
+ */
+static ssize_t __darray_raw_merge_k(uint8_t* restrict dst_p, const uint8_t* const* srcs_p, const size_t* lengths_p, size_t k,
+                                    size_t size_of, const compare_fp cmp_fp, bool unique);
+
+
+/*
+ * Internal function which find for each input number of its elements placed before output @rank.
+ *
+ * @param[in]  ctx_p  - parallel merge state.
+ * @param[in]  rank   - rank in output.
+ * @param[out] cuts_p - for each input number of elements placed before @rank.
+ *
+ * @return: this is void function.
+ */
+static void __darray_raw_merge_co_rank(const DArrayRawPMergeS* ctx_p, size_t rank, size_t* cuts_p);
+
+
+/*
+ * Internal function which is entry point of parallel merge thread. It merge one slice of output.
+ *
+ * @param[in] arg_p - pointer to DArrayRawPMergeThreadS.
+ *
+ * @return: always NULL.
+ */
+static void* __darray_raw_merge_thread(void* arg_p);
+
+
+static inline size_t __darray_raw_merge_emit(uint8_t* const restrict dst_p, size_t out, const uint8_t* const restrict src_p, const size_t n,
+                                             const size_t size_of, const compare_fp cmp_fp, const bool unique)
+{
+    if (!unique)
+    {
+        memcpy(&dst_p[out * size_of], src_p, n * size_of);
+        return out + n;
+    }
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        if (out == 0 || cmp_fp(&dst_p[(out - 1) * size_of], &src_p[i * size_of]) != 0)
+        {
+            assign(&dst_p[out * size_of], &src_p[i * size_of], size_of);
+            ++out;
+        }
+    }
+
+    return out;
+}
+
+
+static size_t __darray_raw_merge_gallop(const uint8_t* const array_p, const size_t size_of, const size_t length, const void* const key_p,
+                                        const compare_fp cmp_fp, const bool upper)
+{
+    register const int limit = upper ? 0 : -1;
+    register size_t low = 0;
+    register size_t idx = 0;
+
+    /* elements before @low are counted, element at @idx is the next probe */
+    while (idx < length && cmp_fp(&array_p[idx * size_of], key_p) <= limit)
+    {
+        low = idx + 1;
+        idx = 2 * idx + 1;
+    }
+
+    return low + __darray_raw_merge_bound(&array_p[low * size_of], size_of, (idx < length ? idx : length) - low, key_p, cmp_fp, upper);
+}
+
+
+static size_t __darray_raw_merge_bound(const uint8_t* const array_p, const size_t size_of, const size_t length, const void* const key_p,
+                                       const compare_fp cmp_fp, const bool upper)
+{
+    register const int limit = upper ? 0 : -1;
+    register size_t low = 0;
+    register size_t high = length;
+
+    while (low < high)
+    {
+        register const size_t middle = low + (high - low) / 2;
+
+        if (cmp_fp(&array_p[middle * size_of], key_p) <= limit)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    return low;
+}
+
+
+static size_t __darray_raw_merge_two(uint8_t* const restrict dst_p, const uint8_t* const first_p, const size_t first_n,
+                                     const uint8_t* const second_p, const size_t second_n, const size_t size_of, const compare_fp cmp_fp, const bool unique)
+{
+    register size_t i = 0;
+    register size_t j = 0;
+    register size_t out = 0;
+    register size_t first_wins = 0;
+    register size_t second_wins = 0;
+
+    while (i < first_n && j < second_n)
+    {
+        if (cmp_fp(&second_p[j * size_of], &first_p[i * size_of]) < 0)
+        {
+            out = __darray_raw_merge_emit(dst_p, out, &second_p[j * size_of], 1, size_of, cmp_fp, unique);
+            ++j;
+            ++second_wins;
+            first_wins = 0;
+
+            /* elements of second array less than head of first array are copied as one block */
+            if (second_wins >= DARRAY_RAW_MERGE_MIN_GALLOP && j < second_n)
+            {
+                register const size_t n = __darray_raw_merge_gallop(&second_p[j * size_of], size_of, second_n - j, &first_p[i * size_of], cmp_fp, false);
+
+                out = __darray_raw_merge_emit(dst_p, out, &second_p[j * size_of], n, size_of, cmp_fp, unique);
+                j += n;
+                second_wins = 0;
+            }
+        }
+        else
+        {
+            out = __darray_raw_merge_emit(dst_p, out, &first_p[i * size_of], 1, size_of, cmp_fp, unique);
+            ++i;
+            ++first_wins;
+            second_wins = 0;
+
+            /* elements of first array less or equal to head of second array are copied as one block */
+            if (first_wins >= DARRAY_RAW_MERGE_MIN_GALLOP && i < first_n)
+            {
+                register const size_t n = __darray_raw_merge_gallop(&first_p[i * size_of], size_of, first_n - i, &second_p[j * size_of], cmp_fp, true);
+
+                out = __darray_raw_merge_emit(dst_p, out, &first_p[i * size_of], n, size_of, cmp_fp, unique);
+                i += n;
+                first_wins = 0;
+            }
+        }
+    }
+
+    out = __darray_raw_merge_emit(dst_p, out, &first_p[i * size_of], first_n - i, size_of, cmp_fp, unique);
+    out = __darray_raw_merge_emit(dst_p, out, &second_p[j * size_of], second_n - j, size_of, cmp_fp, unique);
+
+    return out;
+}
+
+
+static inline bool __darray_raw_merge_less(const DArrayRawMergeS* const ctx_p, const size_t first, const size_t second)
+{
+    register const size_t first_src = ctx_p->map_p[first];
+    register const size_t second_src = ctx_p->map_p[second];
+
+    if (ctx_p->pos_p[first] == ctx_p->lengths_p[first_src])
+    {
+        return false;
+    }
+
+    if (ctx_p->pos_p[second] == ctx_p->lengths_p[second_src])
+    {
+        return true;
+    }
+
+    register const int ret = ctx_p->cmp_fp(&ctx_p->srcs_p[first_src][ctx_p->pos_p[first] * ctx_p->size_of],
+                                           &ctx_p->srcs_p[second_src][ctx_p->pos_p[second] * ctx_p->size_of]);
+
+    return ret < 0 || (ret == 0 && first < second);
+}
+
+
+static ssize_t __darray_raw_merge_k(uint8_t* const restrict dst_p, const uint8_t* const* const srcs_p, const size_t* const lengths_p, const size_t k,
+                                    const size_t size_of, const compare_fp cmp_fp, const bool unique)
+{
+    register size_t m = 0;
+    register size_t total = 0;
+    register size_t last = 0;
+
+    for (size_t i = 0; i < k; ++i)
+    {
+        if (lengths_p[i] > 0)
+        {
+            total += lengths_p[i];
+            last = i;
+            ++m;
+        }
+    }
+
+    if (m == 0)
+    {
+        return 0;
+    }
+
+    if (m == 1)
+    {
+        return (ssize_t)__darray_raw_merge_emit(dst_p, 0, srcs_p[last], lengths_p[last], size_of, cmp_fp, unique);
+    }
+
+    /* map, positions, loser tree and winners used to build the tree */
+    size_t* const scratch_p = malloc(5 * m * sizeof(*scratch_p));
+
+    if (scratch_p == NULL)
+    {
+        perror("DArrayRaw: malloc error\n");
+        return -1;
+    }
+
+    DArrayRawMergeS ctx = {
+        .srcs_p = srcs_p,
+        .lengths_p = lengths_p,
+        .size_of = size_of,
+        .cmp_fp = cmp_fp,
+        .map_p = &scratch_p[0],
+        .pos_p = &scratch_p[m],
+    };
+
+    size_t* const tree_p = &scratch_p[2 * m];
+    size_t* const winners_p = &scratch_p[3 * m];
+
+    for (size_t i = 0, leaf = 0; i < k; ++i)
+    {
+        if (lengths_p[i] > 0)
+        {
+            ctx.map_p[leaf] = i;
+            ctx.pos_p[leaf] = 0;
+            ++leaf;
+        }
+    }
+
+    if (m == 2)
+    {
+        register const size_t first = ctx.map_p[0];
+        register const size_t second = ctx.map_p[1];
+
+        free(scratch_p);
+
+        return (ssize_t)__darray_raw_merge_two(dst_p, srcs_p[first], lengths_p[first], srcs_p[second], lengths_p[second], size_of, cmp_fp, unique);
+    }
+
+    /* leaves are nodes [m, 2m), node n plays winners of nodes 2n and 2n + 1 */
+    for (size_t leaf = 0; leaf < m; ++leaf)
+    {
+        winners_p[m + leaf] = leaf;
+    }
+
+    for (size_t node = m - 1; node > 0; --node)
+    {
+        register const size_t left = winners_p[2 * node];
+        register const size_t right = winners_p[2 * node + 1];
+
+        if (__darray_raw_merge_less(&ctx, right, left))
+        {
+            tree_p[node] = left;
+            winners_p[node] = right;
+        }
+        else
+        {
+            tree_p[node] = right;
+            winners_p[node] = left;
+        }
+    }
+
+    tree_p[0] = winners_p[1];
+
+    register size_t out = 0;
+
+    for (size_t t = 0; t < total; ++t)
+    {
+        register size_t winner = tree_p[0];
+
+        out = __darray_raw_merge_emit(dst_p, out, &srcs_p[ctx.map_p[winner]][ctx.pos_p[winner] * size_of], 1, size_of, cmp_fp, unique);
+        ctx.pos_p[winner]++;
+
+        for (size_t node = (winner + m) / 2; node > 0; node /= 2)
+        {
+            if (__darray_raw_merge_less(&ctx, tree_p[node], winner))
+            {
+                register const size_t tmp = tree_p[node];
+                tree_p[node] = winner;
+                winner = tmp;
+            }
+        }
+
+        tree_p[0] = winner;
+    }
+
+    free(scratch_p);
+
+    return (ssize_t)out;
+}
+
+
+static void __darray_raw_merge_co_rank(const DArrayRawPMergeS* const ctx_p, const size_t rank, size_t* const cuts_p)
+{
+    register const size_t size_of = ctx_p->size_of;
+
+    for (size_t s = 0; s < ctx_p->k; ++s)
+    {
+        register size_t low = 0;
+        register size_t high = ctx_p->lengths_p[s] < rank ? ctx_p->lengths_p[s] : rank;
+
+        /* number of elements placed before element p of input s is monotonic in p */
+        while (low < high)
+        {
+            register const size_t middle = low + (high - low) / 2;
+            register const void* const key_p = &ctx_p->srcs_p[s][middle * size_of];
+            register size_t before = middle;
+
+            for (size_t i = 0; i < ctx_p->k && before < rank; ++i)
+            {
+                if (i != s && ctx_p->lengths_p[i] > 0)
+                {
+                    /* equal elements of earlier inputs go first */
+                    before += __darray_raw_merge_bound(ctx_p->srcs_p[i], size_of, ctx_p->lengths_p[i], key_p, ctx_p->cmp_fp, i < s);
+                }
+            }
+
+            if (before < rank)
+            {
+                low = middle + 1;
+            }
+            else
+            {
+                high = middle;
+            }
+        }
+
+        cuts_p[s] = low;
+    }
+}
+
+
+static void* __darray_raw_merge_thread(void* const arg_p)
+{
+    DArrayRawPMergeThreadS* const thread_p = arg_p;
+    const DArrayRawPMergeS* const ctx_p = thread_p->ctx_p;
+
+    register const size_t k = ctx_p->k;
+    register const size_t begin = ctx_p->total * thread_p->tid / ctx_p->nthreads;
+    register const size_t end = ctx_p->total * (thread_p->tid + 1) / ctx_p->nthreads;
+
+    size_t* const cuts_p = malloc(3 * k * sizeof(*cuts_p));
+    const uint8_t** const srcs_p = malloc(k * sizeof(*srcs_p));
+
+    if (cuts_p == NULL || srcs_p == NULL)
+    {
+        perror("DArrayRaw: malloc error\n");
+        free(cuts_p);
+        free(srcs_p);
+        thread_p->ret = -1;
+        return NULL;
+    }
+
+    size_t* const begin_cuts_p = &cuts_p[0];
+    size_t* const end_cuts_p = &cuts_p[k];
+    size_t* const lengths_p = &cuts_p[2 * k];
+
+    __darray_raw_merge_co_rank(ctx_p, begin, begin_cuts_p);
+    __darray_raw_merge_co_rank(ctx_p, end, end_cuts_p);
+
+    for (size_t i = 0; i < k; ++i)
+    {
+        srcs_p[i] = &ctx_p->srcs_p[i][begin_cuts_p[i] * ctx_p->size_of];
+        lengths_p[i] = end_cuts_p[i] - begin_cuts_p[i];
+    }
+
+    thread_p->ret = __darray_raw_merge_k(&ctx_p->dst_p[begin * ctx_p->size_of], srcs_p, lengths_p, k, ctx_p->size_of, ctx_p->cmp_fp, false) < 0 ? -1 : 0;
+
+    free(srcs_p);
+    free(cuts_p);
+
+    return NULL;
+}
+
+
+static int __darray_raw_merge_check(const void* const dst_p, const void* const* const srcs_p, const size_t* const lengths_p, const size_t k,
+                                    const size_t size_of, const compare_fp cmp_fp)
+{
+    if (dst_p == NULL)
+    {
+        perror("DArrayRaw: argument dst_p is NULL\n");
+        return -1;
+    }
+
+    if (srcs_p == NULL)
+    {
+        perror("DArrayRaw: argument srcs_p is NULL\n");
+        return -1;
+    }
+
+    if (lengths_p == NULL)
+    {
+        perror("DArrayRaw: argument lengths_p is NULL\n");
+        return -1;
+    }
+
+    if (k == 0)
+    {
+        perror("DArrayRaw: argument k has to small value\n");
+        return -1;
+    }
+
+    if (size_of == 0)
+    {
+        perror("DArrayRaw: argument size_of has to small value\n");
+        return -1;
+    }
+
+    if (cmp_fp == NULL)
+    {
+        perror("DArrayRaw: argument cmp_fp is NULL\n");
+        return -1;
+    }
+
+    for (size_t i = 0; i < k; ++i)
+    {
+        if (srcs_p[i] == NULL && lengths_p[i] > 0)
+        {
+            perror("DArrayRaw: argument srcs_p contains NULL\n");
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+
+ssize_t darray_raw_merge_k(void* const restrict dst_p, const void* const* const srcs_p, const size_t* const lengths_p, const size_t k,
+                           const size_t size_of, const compare_fp cmp_fp, const bool unique)
+{
+    if (__darray_raw_merge_check(dst_p, srcs_p, lengths_p, k, size_of, cmp_fp) != 0)
+    {
+        return -1;
+    }
+
+    return __darray_raw_merge_k(dst_p, (const uint8_t* const*)srcs_p, lengths_p, k, size_of, cmp_fp, unique);
+}
+
+
+ssize_t darray_raw_parallel_merge_k(void* const restrict dst_p, const void* const* const srcs_p, const size_t* const lengths_p, const size_t k,
+                                    const size_t size_of, const compare_fp cmp_fp, size_t nthreads)
+{
+    if (__darray_raw_merge_check(dst_p, srcs_p, lengths_p, k, size_of, cmp_fp) != 0)
+    {
+        return -1;
+    }
+
+    register size_t total = 0;
+
+    for (size_t i = 0; i < k; ++i)
+    {
+        total += lengths_p[i];
+    }
+
+    if (nthreads == 0)
+    {
+        register const long online = sysconf(_SC_NPROCESSORS_ONLN);
+        nthreads = online > 0 ? (size_t)online : 1;
+    }
+
+    if (nthreads > total / DARRAY_RAW_MERGE_MIN_PER_THREAD)
+    {
+        nthreads = total / DARRAY_RAW_MERGE_MIN_PER_THREAD;
+    }
+
+    if (nthreads <= 1)
+    {
+        return __darray_raw_merge_k(dst_p, (const uint8_t* const*)srcs_p, lengths_p, k, size_of, cmp_fp, false);
+    }
+
+    const DArrayRawPMergeS ctx = {
+        .dst_p = dst_p,
+        .srcs_p = (const uint8_t* const*)srcs_p,
+        .lengths_p = lengths_p,
+        .k = k,
+        .size_of = size_of,
+        .cmp_fp = cmp_fp,
+        .total = total,
+        .nthreads = nthreads,
+    };
+
+    pthread_t threads[nthreads];
+    bool created[nthreads];
+    DArrayRawPMergeThreadS args[nthreads];
+
+    for (size_t tid = 0; tid < nthreads; ++tid)
+    {
+        args[tid] = (DArrayRawPMergeThreadS){ .ctx_p = &ctx, .tid = tid, .ret = 0 };
+    }
+
+    for (size_t tid = 1; tid < nthreads; ++tid)
+    {
+        created[tid] = pthread_create(&threads[tid], NULL, __darray_raw_merge_thread, &args[tid]) == 0;
+    }
+
+    (void)__darray_raw_merge_thread(&args[0]);
+
+    register int ret = args[0].ret;
+
+    for (size_t tid = 1; tid < nthreads; ++tid)
+    {
+        if (created[tid])
+        {
+            pthread_join(threads[tid], NULL);
+        }
+        else
+        {
+            (void)__darray_raw_merge_thread(&args[tid]);
+        }
+
+        ret |= args[tid].ret;
+    }
+
+    return ret == 0 ? (ssize_t)total : -1;
+}
@@ -0,0 +1,762 @@
+#include <darray_raw/darray_raw.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+
+/*
+    Parallel in-place samplesort in the style of IPS4o.
+
+    1. Sampling      - random sample is sorted and every oversample-th element becomes splitter.
+                       Duplicated splitters are removed and every splitter gets own equality bucket.
+    2. Classification - each thread scans own stripe, moves elements into per-bucket buffer blocks
+                       and flushes full blocks to the beginning of the stripe.
+    3. Permutation   - full blocks are moved in place to the block range of their bucket.
+    4. Cleanup       - partially filled buffers and blocks crossing bucket borders are moved into buckets.
+    5. Recursion     - big buckets are sorted by recursive parallel call, remaining buckets by darray_raw_sort in parallel.
+
+    Additional memory is O(threads * buckets * block) and does not depend on array length.
+*/
+
+
+/* minimal length of array (and minimal length per thread) for which parallel sort is used */
+#define DARRAY_RAW_PSORT_MIN_LENGTH     ((size_t)1 << 16)
+#define DARRAY_RAW_PSORT_MIN_PER_THREAD ((size_t)1 << 14)
+
+/* number of bytes in one block moved during permutation */
+#define DARRAY_RAW_PSORT_BLOCK_BYTES    ((size_t)2048)
+
+/* maximal number of splitters and sample elements per splitter */
+#define DARRAY_RAW_PSORT_MAX_SPLITTERS  ((size_t)255)
+#define DARRAY_RAW_PSORT_OVERSAMPLING   ((size_t)16)
+
+
+/* bucket state used during block permutation */
+typedef struct DArrayRawPSortBucketS
+{
+    pthread_mutex_t mutex;
+    size_t write_block;     /* blocks [begin, write_block) are already in correct bucket */
+    size_t read_block;      /* blocks [write_block, read_block) are full and not processed yet */
+} DArrayRawPSortBucketS;
+
+
+/* shared state of one parallel sort call */
+typedef struct DArrayRawPSortS
+{
+    uint8_t* barray_p;
+    size_t size_of;
+    size_t length;
+    compare_fp cmp_fp;
+
+    size_t nthreads;
+    size_t block_size;
+    size_t nsplitters;
+    size_t nbuckets;
+
+    uint8_t* splitters_p;   /* nsplitters elements */
+    uint8_t* buffers_p;     /* nthreads * nbuckets * block_size elements */
+    uint8_t* swap_p;        /* nthreads * 2 * block_size elements */
+    uint8_t* overflow_p;    /* block_size elements */
+    size_t overflow_bucket;
+
+    size_t* fill_p;         /* nthreads * nbuckets, number of elements in buffers */
+    size_t* counts_p;       /* nthreads * nbuckets, number of elements classified by thread */
+    size_t* stripe_end_p;   /* nthreads, end of full blocks in stripe */
+    size_t* bucket_start_p; /* nbuckets + 1, first element of each bucket */
+    DArrayRawPSortBucketS* buckets_p;
+
+    size_t* order_p;        /* buckets to sort in last phase */
+    size_t order_length;
+    atomic_size_t order_next;
+} DArrayRawPSortS;
+
+
+/* typedef for worker function of each phase */
+typedef void (*psort_worker_fp)(DArrayRawPSortS*, size_t);
+
+
+/* argument passed into each worker thread */
+typedef struct DArrayRawPSortThreadS
+{
+    DArrayRawPSortS* ctx_p;
+    size_t tid;
+    psort_worker_fp worker_fp;
+} DArrayRawPSortThreadS;
+
+
+/*
+ * Internal function which sort @array_p in parallel. Array is sorted sequentially if it is too small.
+ *
+ * @param[in] array_p  - pointer to array.
+ * @param[in] size_of  - size of each array member.
+ * @param[in] length   - number of elements in array.
+ * @param[in] cmp_fp   - comparator function pointer.
+ * @param[in] nthreads - number of threads.
+ *
+ * @return: this is void function.
+ */
+static void __darray_raw_psort(void* array_p, size_t size_of, size_t length, compare_fp cmp_fp, size_t nthreads);
+
+
+/*
+ * Internal function which partition array described by @ctx_p into buckets and sort each of them.
+ *
+ * @param[in] ctx_p     - parallel sort state with allocated buffers.
+ * @param[in] samples_p - buffer for @nsamples elements.
+ * @param[in] nsamples  - number of sampled elements.
+ *
+ * @return: this is void function.
+ */
+static void __darray_raw_psort_partition(DArrayRawPSortS* ctx_p, uint8_t* samples_p, size_t nsamples);
+
+
+/*
+ * Internal function which find bucket index of @data_p.
+ * Even buckets keep elements between splitters, odd buckets keep elements equal to splitter.
+ *
+ * @param[in] ctx_p  - parallel sort state.
+ * @param[in] data_p - element to classify.
+ *
+ * @return: bucket index.
+ */
+static inline size_t __darray_raw_psort_classify(const DArrayRawPSortS* ctx_p, const void* data_p);
+
+
+/*
+ * Internal function which run @worker_fp on @ctx_p->nthreads threads and wait for all of them.
+ * If thread cannot be created, its work is done by calling thread.
+ *
+ * @param[in] ctx_p     - parallel sort state.
+ * @param[in] worker_fp - function called with thread index.
+ *
+ * @return: this is void function.
+ */
+static void __darray_raw_psort_run(DArrayRawPSortS* ctx_p, psort_worker_fp worker_fp);
+
+
+/*
+ * Internal function which is entry point for pthread_create.
+ *
+ * @param[in] arg_p - pointer to DArrayRawPSortThreadS.
+ *
+ * @return: always NULL.
+ */
+static void* __darray_raw_psort_thread(void* arg_p);
+
+
+/*
+ * Internal worker which classify stripe of thread @tid into buffer blocks.
+ *
+ * @param[in] ctx_p - parallel sort state.
+ * @param[in] tid   - thread index.
+ *
+ * @return: this is void function.
+ */
+static void __darray_raw_psort_classify_worker(DArrayRawPSortS* ctx_p, size_t tid);
+
+
+/*
+ * Internal worker which move full blocks into their buckets.
+ *
+ * @param[in] ctx_p - parallel sort state.
+ * @param[in] tid   - thread index.
+ *
+ * @return: this is void function.
+ */
+static void __darray_raw_psort_permute_worker(DArrayRawPSortS* ctx_p, size_t tid);
+
+
+/*
+ * Internal worker which sort buckets taken from shared queue.
+ *
+ * @param[in] ctx_p - parallel sort state.
+ * @param[in] tid   - thread index.
+ *
+ * @return: this is void function.
+ */
+static void __darray_raw_psort_sort_worker(DArrayRawPSortS* ctx_p, size_t tid);
+
+
+/*
+ * Internal function which move full blocks to the beginning of each bucket block range.
+ *
+ * @param[in] ctx_p - parallel sort state.
+ *
+ * @return: this is void function.
+ */
+static void __darray_raw_psort_move_empty_blocks(DArrayRawPSortS* ctx_p);
+
+
+/*
+ * Internal function which move buffered elements and elements crossing bucket borders into their buckets.
+ *
+ * @param[in] ctx_p - parallel sort state.
+ *
+ * @return: this is void function.
+ */
+static void __darray_raw_psort_cleanup(DArrayRawPSortS* ctx_p);
+
+
+/*
+ * Internal function which check if block @block contains elements classified during first phase.
+ *
+ * @param[in] ctx_p - parallel sort state.
+ * @param[in] block - block index.
+ *
+ * @return: true if block is full, false if it is empty.
+ */
+static inline bool __darray_raw_psort_is_full_block(const DArrayRawPSortS* ctx_p, size_t block);
+
+
+/*
+ * Internal function which return first block of stripe owned by thread @tid.
+ *
+ * @param[in] ctx_p - parallel sort state.
+ * @param[in] tid   - thread index.
+ *
+ * @return: index of first block.
+ */
+static inline size_t __darray_raw_psort_stripe_block(const DArrayRawPSortS* ctx_p, size_t tid);
+
+
+static inline size_t __darray_raw_psort_stripe_block(const DArrayRawPSortS* const ctx_p, const size_t tid)
+{
+    return (ctx_p->length / ctx_p->block_size) * tid / ctx_p->nthreads;
+}
+
+
+static inline size_t __darray_raw_psort_classify(const DArrayRawPSortS* const ctx_p, const void* const data_p)
+{
+    register size_t left = 0;
+    register size_t right = ctx_p->nsplitters;
+
+    while (left < right)
+    {
+        register const size_t middle = (left + right) / 2;
+
+        if (ctx_p->cmp_fp(&ctx_p->splitters_p[middle * ctx_p->size_of], data_p) < 0)
+        {
+            left = middle + 1;
+        }
+        else
+        {
+            right = middle;
+        }
+    }
+
+    if (left < ctx_p->nsplitters && ctx_p->cmp_fp(data_p, &ctx_p->splitters_p[left * ctx_p->size_of]) == 0)
+    {
+        return 2 * left + 1;
+    }
+
+    return 2 * left;
+}
+
+
+static void* __darray_raw_psort_thread(void* const arg_p)
+{
+    const DArrayRawPSortThreadS* const thread_p = arg_p;
+
+    thread_p->worker_fp(thread_p->ctx_p, thread_p->tid);
+
+    return NULL;
+}
+
+
+static void __darray_raw_psort_run(DArrayRawPSortS* const ctx_p, const psort_worker_fp worker_fp)
+{
+    register const size_t nthreads = ctx_p->nthreads;
+
+    pthread_t threads[nthreads];
+    bool created[nthreads];
+    DArrayRawPSortThreadS args[nthreads];
+
+    for (size_t tid = 1; tid < nthreads; ++tid)
+    {
+        args[tid] = (DArrayRawPSortThreadS){ .ctx_p = ctx_p, .tid = tid, .worker_fp = worker_fp };
+        created[tid] = pthread_create(&threads[tid], NULL, __darray_raw_psort_thread, &args[tid]) == 0;
+    }
+
+    worker_fp(ctx_p, 0);
+
+    for (size_t tid = 1; tid < nthreads; ++tid)
+    {
+        if (created[tid])
+        {
+            pthread_join(threads[tid], NULL);
+        }
+        else
+        {
+            worker_fp(ctx_p, tid);
+        }
+    }
+}
+
+
+static void __darray_raw_psort_classify_worker(DArrayRawPSortS* const ctx_p, const size_t tid)
+{
+    register const size_t size_of = ctx_p->size_of;
+    register const size_t block_size = ctx_p->block_size;
+    register const size_t nbuckets = ctx_p->nbuckets;
+
+    register uint8_t* const barray_p = ctx_p->barray_p;
+    register uint8_t* const buffers_p = &ctx_p->buffers_p[tid * nbuckets * block_size * size_of];
+    register size_t* const fill_p = &ctx_p->fill_p[tid * nbuckets];
+    register size_t* const counts_p = &ctx_p->counts_p[tid * nbuckets];
+
+    register const size_t begin = __darray_raw_psort_stripe_block(ctx_p, tid) * block_size;
+    register const size_t end = (tid + 1 == ctx_p->nthreads) ? ctx_p->length : __darray_raw_psort_stripe_block(ctx_p, tid + 1) * block_size;
+
+    register size_t write = begin;
+
+    for (size_t i = begin; i < end; ++i)
+    {
+        register const size_t bucket = __darray_raw_psort_classify(ctx_p, &barray_p[i * size_of]);
+        register uint8_t* const buffer_p = &buffers_p[bucket * block_size * size_of];
+
+        assign(&buffer_p[fill_p[bucket] * size_of], &barray_p[i * size_of], size_of);
+        fill_p[bucket]++;
+        counts_p[bucket]++;
+
+        /* write pointer never passes read pointer, because all flushed elements are already read */
+        if (fill_p[bucket] == block_size)
+        {
+            memcpy(&barray_p[write * size_of], buffer_p, block_size * size_of);
+            write += block_size;
+            fill_p[bucket] = 0;
+        }
+    }
+
+    ctx_p->stripe_end_p[tid] = write;
+}
+
+
+static inline bool __darray_raw_psort_is_full_block(const DArrayRawPSortS* const ctx_p, const size_t block)
+{
+    register size_t tid = ctx_p->nthreads - 1;
+
+    while (__darray_raw_psort_stripe_block(ctx_p, tid) > block)
+    {
+        --tid;
+    }
+
+    return block * ctx_p->block_size < ctx_p->stripe_end_p[tid];
+}
+
+
+static void __darray_raw_psort_move_empty_blocks(DArrayRawPSortS* const ctx_p)
+{
+    register const size_t size_of = ctx_p->size_of;
+    register const size_t block_bytes = ctx_p->block_size * size_of;
+    register uint8_t* const barray_p = ctx_p->barray_p;
+
+    for (size_t bucket = 0; bucket < ctx_p->nbuckets; ++bucket)
+    {
+        register const size_t begin = (ctx_p->bucket_start_p[bucket] + ctx_p->block_size - 1) / ctx_p->block_size;
+        register const size_t end = (ctx_p->bucket_start_p[bucket + 1] + ctx_p->block_size - 1) / ctx_p->block_size;
+
+        register size_t full_end = begin;
+        register size_t last = end;
+
+        while (full_end < last)
+        {
+            if (__darray_raw_psort_is_full_block(ctx_p, full_end))
+            {
+                ++full_end;
+            }
+            else if (!__darray_raw_psort_is_full_block(ctx_p, last - 1))
+            {
+                --last;
+            }
+            else
+            {
+                memcpy(&barray_p[full_end * block_bytes], &barray_p[(last - 1) * block_bytes], block_bytes);
+                ++full_end;
+                --last;
+            }
+        }
+
+        ctx_p->buckets_p[bucket].write_block = begin;
+        ctx_p->buckets_p[bucket].read_block = full_end;
+    }
+}
+
+
+static void __darray_raw_psort_permute_worker(DArrayRawPSortS* const ctx_p, const size_t tid)
+{
+    register const size_t size_of = ctx_p->size_of;
+    register const size_t block_size = ctx_p->block_size;
+    register const size_t block_bytes = block_size * size_of;
+    register const size_t nbuckets = ctx_p->nbuckets;
+
+    register uint8_t* const barray_p = ctx_p->barray_p;
+    register uint8_t* hand_p = &ctx_p->swap_p[tid * 2 * block_bytes];
+    register uint8_t* spare_p = &hand_p[block_bytes];
+
+    register const size_t first_bucket = tid * nbuckets / ctx_p->nthreads;
+
+    for (size_t i = 0; i < nbuckets; ++i)
+    {
+        register const size_t src_bucket = (first_bucket + i) % nbuckets;
+        DArrayRawPSortBucketS* const src_p = &ctx_p->buckets_p[src_bucket];
+
+        for (;;)
+        {
+            /* take last unprocessed block of source bucket */
+            pthread_mutex_lock(&src_p->mutex);
+
+            if (src_p->write_block >= src_p->read_block)
+            {
+                pthread_mutex_unlock(&src_p->mutex);
+                break;
+            }
+
+            src_p->read_block--;
+            memcpy(hand_p, &barray_p[src_p->read_block * block_bytes], block_bytes);
+
+            pthread_mutex_unlock(&src_p->mutex);
+
+            /* follow the cycle until block lands on empty slot */
+            for (;;)
+            {
+                register const size_t dst_bucket = __darray_raw_psort_classify(ctx_p, hand_p);
+                DArrayRawPSortBucketS* const dst_p = &ctx_p->buckets_p[dst_bucket];
+
+                pthread_mutex_lock(&dst_p->mutex);
+
+                register const size_t slot = dst_p->write_block++;
+                register const bool occupied = slot < dst_p->read_block;
+
+                if (occupied)
+                {
+                    memcpy(spare_p, &barray_p[slot * block_bytes], block_bytes);
+                    memcpy(&barray_p[slot * block_bytes], hand_p, block_bytes);
+                }
+                else if (slot * block_size + block_size > ctx_p->length)
+                {
+                    /* last block of array is partial, so full block is kept aside until cleanup */
+                    memcpy(ctx_p->overflow_p, hand_p, block_bytes);
+                    ctx_p->overflow_bucket = dst_bucket;
+                }
+                else
+                {
+                    memcpy(&barray_p[slot * block_bytes], hand_p, block_bytes);
+                }
+
+                pthread_mutex_unlock(&dst_p->mutex);
+
+                if (!occupied)
+                {
+                    break;
+                }
+
+                register uint8_t* const tmp_p = hand_p;
+                hand_p = spare_p;
+                spare_p = tmp_p;
+            }
+        }
+    }
+}
+
+
+static void __darray_raw_psort_cleanup(DArrayRawPSortS* const ctx_p)
+{
+    register const size_t size_of = ctx_p->size_of;
+    register const size_t block_size = ctx_p->block_size;
+    register const size_t nbuckets = ctx_p->nbuckets;
+    register uint8_t* const barray_p = ctx_p->barray_p;
+
+    for (size_t bucket = 0; bucket < nbuckets; ++bucket)
+    {
+        register const size_t begin = ctx_p->bucket_start_p[bucket];
+        register const size_t end = ctx_p->bucket_start_p[bucket + 1];
+
+        register const size_t blocks_begin = ((begin + block_size - 1) / block_size) * block_size;
+        register size_t blocks_end = ctx_p->buckets_p[bucket].write_block * block_size;
+
+        register const bool has_overflow = ctx_p->overflow_bucket == bucket;
+
+        if (has_overflow)
+        {
+            blocks_end -= block_size;
+        }
+
+        /* elements of written blocks inside [begin, end) stay in place, others fill free slots */
+        register const size_t keep_begin = blocks_begin < end ? blocks_begin : end;
+        register const size_t keep_end = blocks_end < end ? blocks_end : end;
+
+        const uint8_t* sources_p[3 + ctx_p->nthreads];
+        size_t sources_length[3 + ctx_p->nthreads];
+        register size_t nsources = 0;
+
+        if (blocks_end > end)
+        {
+            register const size_t spill_begin = blocks_begin > end ? blocks_begin : end;
+
+            sources_p[nsources] = &barray_p[spill_begin * size_of];
+            sources_length[nsources++] = blocks_end - spill_begin;
+        }
+
+        if (has_overflow)
+        {
+            sources_p[nsources] = ctx_p->overflow_p;
+            sources_length[nsources++] = block_size;
+        }
+
+        for (size_t tid = 0; tid < ctx_p->nthreads; ++tid)
+        {
+            sources_p[nsources] = &ctx_p->buffers_p[(tid * nbuckets + bucket) * block_size * size_of];
+            sources_length[nsources++] = ctx_p->fill_p[tid * nbuckets + bucket];
+        }
+
+        register size_t slot = begin;
+
+        for (size_t i = 0; i < nsources; ++i)
+        {
+            register size_t copied = 0;
+
+            while (copied < sources_length[i])
+            {
+                if (slot == keep_begin && keep_begin < keep_end)
+                {
+                    slot = keep_end;
+                }
+
+                register const size_t slot_end = slot < keep_begin ? keep_begin : end;
+                register const size_t left = sources_length[i] - copied;
+                register const size_t count = left < slot_end - slot ? left : slot_end - slot;
+
+                memcpy(&barray_p[slot * size_of], &sources_p[i][copied * size_of], count * size_of);
+
+                slot += count;
+                copied += count;
+            }
+        }
+    }
+}
+
+
+static void __darray_raw_psort_sort_worker(DArrayRawPSortS* const ctx_p, const size_t tid)
+{
+    (void)tid;
+
+    for (;;)
+    {
+        register const size_t next = atomic_fetch_add(&ctx_p->order_next, 1);
+
+        if (next >= ctx_p->order_length)
+        {
+            return;
+        }
+
+        register const size_t bucket = ctx_p->order_p[next];
+        register const size_t begin = ctx_p->bucket_start_p[bucket];
+        register const size_t end = ctx_p->bucket_start_p[bucket + 1];
+
+        darray_raw_sort(&ctx_p->barray_p[begin * ctx_p->size_of], ctx_p->size_of, end - begin, ctx_p->cmp_fp);
+    }
+}
+
+
+static void __darray_raw_psort_partition(DArrayRawPSortS* const ctx_p, uint8_t* const samples_p, const size_t nsamples)
+{
+    register const size_t size_of = ctx_p->size_of;
+    register const size_t length = ctx_p->length;
+    register const size_t nthreads = ctx_p->nthreads;
+    register const compare_fp cmp_fp = ctx_p->cmp_fp;
+
+    /* sampling with local xorshift, so rand() state of user is not changed */
+    register uint64_t seed = 0x9E3779B97F4A7C15ULL ^ length;
+
+    for (size_t i = 0; i < nsamples; ++i)
+    {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+
+        assign(&samples_p[i * size_of], &ctx_p->barray_p[(seed % length) * size_of], size_of);
+    }
+
+    darray_raw_sort(samples_p, size_of, nsamples, cmp_fp);
+
+    for (size_t i = DARRAY_RAW_PSORT_OVERSAMPLING - 1; i < nsamples; i += DARRAY_RAW_PSORT_OVERSAMPLING)
+    {
+        if (ctx_p->nsplitters > 0 && cmp_fp(&ctx_p->splitters_p[(ctx_p->nsplitters - 1) * size_of], &samples_p[i * size_of]) == 0)
+        {
+            continue;
+        }
+
+        assign(&ctx_p->splitters_p[ctx_p->nsplitters * size_of], &samples_p[i * size_of], size_of);
+        ctx_p->nsplitters++;
+    }
+
+    ctx_p->nbuckets = 2 * ctx_p->nsplitters + 1;
+
+    /* phase 1: local classification */
+    __darray_raw_psort_run(ctx_p, __darray_raw_psort_classify_worker);
+
+    for (size_t bucket = 0; bucket < ctx_p->nbuckets; ++bucket)
+    {
+        register size_t count = 0;
+
+        for (size_t tid = 0; tid < nthreads; ++tid)
+        {
+            count += ctx_p->counts_p[tid * ctx_p->nbuckets + bucket];
+        }
+
+        ctx_p->bucket_start_p[bucket + 1] = ctx_p->bucket_start_p[bucket] + count;
+    }
+
+    /* phase 2: block permutation */
+    __darray_raw_psort_move_empty_blocks(ctx_p);
+
+    for (size_t bucket = 0; bucket < ctx_p->nbuckets; ++bucket)
+    {
+        pthread_mutex_init(&ctx_p->buckets_p[bucket].mutex, NULL);
+    }
+
+    __darray_raw_psort_run(ctx_p, __darray_raw_psort_permute_worker);
+
+    for (size_t bucket = 0; bucket < ctx_p->nbuckets; ++bucket)
+    {
+        pthread_mutex_destroy(&ctx_p->buckets_p[bucket].mutex);
+    }
+
+    /* phase 3: cleanup of buffers and bucket borders */
+    __darray_raw_psort_cleanup(ctx_p);
+
+    /* phase 4: big buckets are sorted by all threads, others in parallel by single threads */
+    for (size_t bucket = 0; bucket < ctx_p->nbuckets; bucket += 2)
+    {
+        register const size_t bucket_length = ctx_p->bucket_start_p[bucket + 1] - ctx_p->bucket_start_p[bucket];
+
+        if (bucket_length < 2)
+        {
+            continue;
+        }
+
+        if (bucket_length > length / nthreads)
+        {
+            __darray_raw_psort(&ctx_p->barray_p[ctx_p->bucket_start_p[bucket] * size_of], size_of, bucket_length, cmp_fp, nthreads);
+        }
+        else
+        {
+            ctx_p->order_p[ctx_p->order_length++] = bucket;
+        }
+    }
+
+    atomic_init(&ctx_p->order_next, 0);
+    __darray_raw_psort_run(ctx_p, __darray_raw_psort_sort_worker);
+}
+
+
+static void __darray_raw_psort(void* const array_p, const size_t size_of, const size_t length, const compare_fp cmp_fp, size_t nthreads)
+{
+    if (nthreads > length / DARRAY_RAW_PSORT_MIN_PER_THREAD)
+    {
+        nthreads = length / DARRAY_RAW_PSORT_MIN_PER_THREAD;
+    }
+
+    if (length < DARRAY_RAW_PSORT_MIN_LENGTH || nthreads < 2)
+    {
+        darray_raw_sort(array_p, size_of, length, cmp_fp);
+        return;
+    }
+
+    DArrayRawPSortS ctx = {
+        .barray_p = array_p,
+        .size_of = size_of,
+        .length = length,
+        .cmp_fp = cmp_fp,
+        .nthreads = nthreads,
+        .block_size = size_of < DARRAY_RAW_PSORT_BLOCK_BYTES ? DARRAY_RAW_PSORT_BLOCK_BYTES / size_of : 1,
+        .overflow_bucket = SIZE_MAX,
+    };
+
+    register size_t nsplitters = nthreads * 16;
+
+    if (nsplitters > DARRAY_RAW_PSORT_MAX_SPLITTERS)
+    {
+        nsplitters = DARRAY_RAW_PSORT_MAX_SPLITTERS;
+    }
+
+    register const size_t nsamples = nsplitters * DARRAY_RAW_PSORT_OVERSAMPLING;
+    register const size_t max_buckets = 2 * nsplitters + 1;
+
+    uint8_t* const samples_p = malloc(nsamples * size_of);
+    ctx.splitters_p = malloc(nsplitters * size_of);
+    ctx.buffers_p = malloc(nthreads * max_buckets * ctx.block_size * size_of);
+    ctx.swap_p = malloc(nthreads * 2 * ctx.block_size * size_of);
+    ctx.overflow_p = malloc(ctx.block_size * size_of);
+    ctx.fill_p = calloc(nthreads * max_buckets, sizeof(*ctx.fill_p));
+    ctx.counts_p = calloc(nthreads * max_buckets, sizeof(*ctx.counts_p));
+    ctx.stripe_end_p = calloc(nthreads, sizeof(*ctx.stripe_end_p));
+    ctx.bucket_start_p = calloc(max_buckets + 1, sizeof(*ctx.bucket_start_p));
+    ctx.buckets_p = calloc(max_buckets, sizeof(*ctx.buckets_p));
+    ctx.order_p = calloc(max_buckets, sizeof(*ctx.order_p));
+
+    if (samples_p == NULL || ctx.splitters_p == NULL || ctx.buffers_p == NULL || ctx.swap_p == NULL || ctx.overflow_p == NULL ||
+        ctx.fill_p == NULL || ctx.counts_p == NULL || ctx.stripe_end_p == NULL || ctx.bucket_start_p == NULL ||
+        ctx.buckets_p == NULL || ctx.order_p == NULL)
+    {
+        perror("DArrayRaw: malloc error, array will be sorted sequentially\n");
+        darray_raw_sort(array_p, size_of, length, cmp_fp);
+    }
+    else
+    {
+        __darray_raw_psort_partition(&ctx, samples_p, nsamples);
+    }
+
+    free(samples_p);
+    free(ctx.splitters_p);
+    free(ctx.buffers_p);
+    free(ctx.swap_p);
+    free(ctx.overflow_p);
+    free(ctx.fill_p);
+    free(ctx.counts_p);
+    free(ctx.stripe_end_p);
+    free(ctx.bucket_start_p);
+    free(ctx.buckets_p);
+    free(ctx.order_p);
+}
+
+
+int darray_raw_parallel_sort(void* const array_p, const size_t size_of, const size_t length, const compare_fp cmp_fp, size_t nthreads)
+{
+    if (array_p == NULL)
+    {
+        perror("DArrayRaw: argument array_p is NULL\n");
+        return -1;
+    }
+
+    if (size_of == 0)
+    {
+        perror("DArrayRaw: argument size_of has to small value\n");
+        return -1;
+    }
+
+    if (length == 0)
+    {
+        perror("DArrayRaw: argument length has to small value\n");
+        return -1;
+    }
+
+    if (cmp_fp == NULL)
+    {
+        perror("DArrayRaw: argument cmp_fp is NULL\n");
+        return -1;
+    }
+
+    if (nthreads == 0)
+    {
+        register const long online = sysconf(_SC_NPROCESSORS_ONLN);
+        nthreads = online > 0 ? (size_t)online : 1;
+    }
+
+    __darray_raw_psort(array_p, size_of, length, cmp_fp, nthreads);
+
+    return 0;
+}
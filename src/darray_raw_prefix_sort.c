@@ -0,0 +1,268 @@
+#include <darray_raw/darray_raw.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/*
+    Sort with normalized key prefixes for expensive comparators.
+
+    1. Prefixes - caller callback writes 8- or 16-byte order-preserving prefix of each element (memcmp order),
+                  prefix is loaded as big-endian integers and stored with index of element.
+    2. Pairs    - (prefix, index) pairs are sorted by type-specialized sort, so comparison is inlined integer compare.
+    3. Gather   - array is permuted by sorted indexes, runs of equal prefixes are marked in bitmap on the way.
+    4. Ties     - only runs of equal prefixes are sorted by darray_raw_sort with @cmp_fp.
+*/
+
+
+/* (prefix, index) pair for 8-byte prefixes */
+typedef struct DArrayRawPrefix8S
+{
+    uint64_t key;
+    size_t idx;
+} DArrayRawPrefix8S;
+
+
+/* (prefix, index) pair for 16-byte prefixes */
+typedef struct DArrayRawPrefix16S
+{
+    uint64_t hi;
+    uint64_t lo;
+    size_t idx;
+} DArrayRawPrefix16S;
+
+
+static DARRAY_RAW_DECLARE_SORT(__darray_raw_prefix8_sort, DArrayRawPrefix8S);
+DARRAY_RAW_DEFINE_SORT(__darray_raw_prefix8_sort, DArrayRawPrefix8S, a.key < b.key)
+
+static DARRAY_RAW_DECLARE_SORT(__darray_raw_prefix16_sort, DArrayRawPrefix16S);
+DARRAY_RAW_DEFINE_SORT(__darray_raw_prefix16_sort, DArrayRawPrefix16S, (a.hi < b.hi || (a.hi == b.hi && a.lo < b.lo)))
+
+
+/*
+ * Internal function which load 8 bytes as big-endian integer, so integer order is the same as memcmp order.
+ *
+ * @param[in] bytes_p - pointer to 8 bytes.
+ *
+ * @return: loaded integer.
+ */
+static inline uint64_t __darray_raw_load_be64(const uint8_t* bytes_p);
+
+
+/*
+ * Internal function which build and sort pairs for 8-byte prefixes, then replace pairs by sorted indexes in place.
+ * Element is marked in @ties_p when its prefix is equal to prefix of previous element in sorted order.
+ *
+ * @param[in]  array_p - pointer to array.
+ * @param[in]  size_of - size of each array member.
+ * @param[in]  length  - number of elements in array.
+ * @param[in]  norm_fp - prefix function pointer.
+ * @param[in]  pairs_p - memory for @length pairs, on return it contains @length indexes.
+ * @param[out] ties_p  - bitmap of elements with prefix equal to previous one.
+ *
+ * @return: this is void function.
+ */
+static void __darray_raw_prefix8_indexes(const void* array_p, size_t size_of, size_t length, const normalize_fp norm_fp,
+                                         DArrayRawPrefix8S* pairs_p, uint64_t* ties_p);
+
+
+/*
+ * Internal function which build and sort pairs for 16-byte prefixes, then replace pairs by sorted indexes in place.
+ * Element is marked in @ties_p when its prefix is equal to prefix of previous element in sorted order.
+ *
+ * @param[in]  array_p - pointer to array.
+ * @param[in]  size_of - size of each array member.
+ * @param[in]  length  - number of elements in array.
+ * @param[in]  norm_fp - prefix function pointer.
+ * @param[in]  pairs_p - memory for @length pairs, on return it contains @length indexes.
+ * @param[out] ties_p  - bitmap of elements with prefix equal to previous one.
+ *
+ * @return: this is void function.
+ */
+static void __darray_raw_prefix16_indexes(const void* array_p, size_t size_of, size_t length, const normalize_fp norm_fp,
+                                          DArrayRawPrefix16S* pairs_p, uint64_t* ties_p);
+
+
+static inline uint64_t __darray_raw_load_be64(const uint8_t* const bytes_p)
+{
+    uint64_t val;
+    memcpy(&val, bytes_p, sizeof(val));
+
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    val = __builtin_bswap64(val);
+#endif
+
+    return val;
+}
+
+
+static void __darray_raw_prefix8_indexes(const void* const array_p, const size_t size_of, const size_t length, const normalize_fp norm_fp,
+                                         DArrayRawPrefix8S* const pairs_p, uint64_t* const ties_p)
+{
+    register const uint8_t* const barray_p = array_p;
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        uint8_t prefix[8];
+        norm_fp(&barray_p[i * size_of], &prefix[0]);
+
+        pairs_p[i] = (DArrayRawPrefix8S){ .key = __darray_raw_load_be64(&prefix[0]), .idx = i };
+    }
+
+    __darray_raw_prefix8_sort(pairs_p, length);
+
+    /* index i is written over pair i / 2, which was already read */
+    size_t* const idx_p = (size_t*)pairs_p;
+    register uint64_t prev = pairs_p[0].key;
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        register const uint64_t key = pairs_p[i].key;
+        register const size_t idx = pairs_p[i].idx;
+
+        if (i > 0 && key == prev)
+        {
+            ties_p[i / 64] |= (uint64_t)1 << (i % 64);
+        }
+
+        prev = key;
+        idx_p[i] = idx;
+    }
+}
+
+
+static void __darray_raw_prefix16_indexes(const void* const array_p, const size_t size_of, const size_t length, const normalize_fp norm_fp,
+                                          DArrayRawPrefix16S* const pairs_p, uint64_t* const ties_p)
+{
+    register const uint8_t* const barray_p = array_p;
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        uint8_t prefix[16];
+        norm_fp(&barray_p[i * size_of], &prefix[0]);
+
+        pairs_p[i] = (DArrayRawPrefix16S){ .hi = __darray_raw_load_be64(&prefix[0]), .lo = __darray_raw_load_be64(&prefix[8]), .idx = i };
+    }
+
+    __darray_raw_prefix16_sort(pairs_p, length);
+
+    /* index i is written over pair i / 3, which was already read */
+    size_t* const idx_p = (size_t*)pairs_p;
+    register uint64_t prev_hi = pairs_p[0].hi;
+    register uint64_t prev_lo = pairs_p[0].lo;
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        register const uint64_t hi = pairs_p[i].hi;
+        register const uint64_t lo = pairs_p[i].lo;
+        register const size_t idx = pairs_p[i].idx;
+
+        if (i > 0 && hi == prev_hi && lo == prev_lo)
+        {
+            ties_p[i / 64] |= (uint64_t)1 << (i % 64);
+        }
+
+        prev_hi = hi;
+        prev_lo = lo;
+        idx_p[i] = idx;
+    }
+}
+
+
+int darray_raw_prefix_sort(void* const array_p, const size_t size_of, const size_t length, const size_t prefix_size,
+                           const normalize_fp norm_fp, const compare_fp cmp_fp)
+{
+    if (array_p == NULL)
+    {
+        perror("DArrayRaw: argument array_p is NULL\n");
+        return -1;
+    }
+
+    if (size_of == 0)
+    {
+        perror("DArrayRaw: argument size_of has to small value\n");
+        return -1;
+    }
+
+    if (length == 0)
+    {
+        perror("DArrayRaw: argument length has to small value\n");
+        return -1;
+    }
+
+    if (prefix_size != 8 && prefix_size != 16)
+    {
+        perror("DArrayRaw: argument prefix_size has to be 8 or 16\n");
+        return -1;
+    }
+
+    if (norm_fp == NULL)
+    {
+        perror("DArrayRaw: argument norm_fp is NULL\n");
+        return -1;
+    }
+
+    if (cmp_fp == NULL)
+    {
+        perror("DArrayRaw: argument cmp_fp is NULL\n");
+        return -1;
+    }
+
+    register const size_t pair_size = prefix_size == 8 ? sizeof(DArrayRawPrefix8S) : sizeof(DArrayRawPrefix16S);
+    register const size_t nwords = (length + 63) / 64;
+
+    void* const pairs_p = malloc(length * pair_size);
+    uint64_t* const ties_p = calloc(nwords, sizeof(*ties_p));
+
+    if (pairs_p == NULL || ties_p == NULL)
+    {
+        perror("DArrayRaw: malloc error\n");
+        free(pairs_p);
+        free(ties_p);
+        return -1;
+    }
+
+    if (prefix_size == 8)
+    {
+        __darray_raw_prefix8_indexes(array_p, size_of, length, norm_fp, pairs_p, ties_p);
+    }
+    else
+    {
+        __darray_raw_prefix16_indexes(array_p, size_of, length, norm_fp, pairs_p, ties_p);
+    }
+
+    register int ret = darray_raw_apply_permutation(array_p, size_of, length, pairs_p, sizeof(size_t));
+
+    /* element with tie bit set belongs to run started by closest previous element without it */
+    register uint8_t* const barray_p = array_p;
+    register size_t i = 0;
+
+    while (ret == 0 && i < length)
+    {
+        if (ties_p[i / 64] == 0 && i % 64 == 0)
+        {
+            i += 64;
+            continue;
+        }
+
+        if ((ties_p[i / 64] >> (i % 64) & 1) == 0)
+        {
+            ++i;
+            continue;
+        }
+
+        register const size_t first = i - 1;
+
+        while (i < length && (ties_p[i / 64] >> (i % 64) & 1) != 0)
+        {
+            ++i;
+        }
+
+        darray_raw_sort(&barray_p[first * size_of], size_of, i - first, cmp_fp);
+    }
+
+    free(ties_p);
+    free(pairs_p);
+
+    return ret;
+}
@@ -0,0 +1,507 @@
+#include <darray_raw/darray_raw.h>
+#include <stdio.h>
+#include <string.h>
+
+
+/*
+    Set algebra on two sorted arrays: intersection, union, difference and symmetric difference.
+
+    1. Merge     - both arrays are walked like in merge. Equal elements advance both arrays, so duplicates are
+                   handled like in multisets (intersection keeps minimum, union maximum of occurrences).
+    2. Galloping - after DARRAY_RAW_SET_MIN_GALLOP elements in a row are taken from one array, run of its elements
+                   before head of the other array is found by exponential search and copied (or skipped) as one block.
+                   When one array is much shorter, cost is O(short * log(long / short)) comparisons.
+    3. Count     - when output is NULL nothing is written, only number of elements of result is returned.
+    4. Keys      - intersection of strictly increasing arrays of 4- and 8-byte integers compares whole blocks:
+                   each element of block of first array is compared with every element of block of second array
+                   by plain loops vectorized by compiler (SSE4.1/AVX2/AVX-512 clones), block with smaller last element
+                   is advanced. Very different lengths are intersected by exponential search instead.
+*/
+
+
+/* number of elements taken in a row from one array after which galloping starts */
+#define DARRAY_RAW_SET_MIN_GALLOP       ((size_t)7)
+
+/* length ratio from which key intersection searches elements of shorter array in longer one */
+#define DARRAY_RAW_SET_SKEW_RATIO       ((size_t)32)
+
+
+/* functionlike macro which mark function to be compiled for few instruction sets and dispatched at load time */
+#if defined(__x86_64__) && defined(__GNUC__) && !defined(__clang__)
+#define DARRAY_RAW_SET_CLONES __attribute__((target_clones("avx512f", "avx2", "sse4.1", "default")))
+#else
+#define DARRAY_RAW_SET_CLONES
+#endif
+
+
+/* elements of result of set operation */
+typedef enum darray_raw_set_op_e
+{
+    DARRAY_RAW_SET_FIRST_ONLY = 1,      /* elements only in first array */
+    DARRAY_RAW_SET_SECOND_ONLY = 2,     /* elements only in second array */
+    DARRAY_RAW_SET_COMMON = 4,          /* elements in both arrays */
+} darray_raw_set_op_e;
+
+
+/*
+ * Internal function which count leading elements of sorted @array_p which are less than @key_p.
+ * Exponential search is used, so cost is O(log result).
+ *
+ * @param[in] array_p - pointer to array.
+ * @param[in] size_of - size of each array member.
+ * @param[in] length  - number of elements in array.
+ * @param[in] key_p   - key.
+ * @param[in] cmp_fp  - comparator function pointer.
+ *
+ * @return: number of counted elements.
+ */
+static size_t __darray_raw_set_gallop(const uint8_t* array_p, size_t size_of, size_t length, const void* key_p, const compare_fp cmp_fp);
+
+
+/*
+ * Internal function which append @n elements to output (or only count them if @out_p is NULL).
+ *
+ * @param[in] out_p   - output array or NULL.
+ * @param[in] out     - number of elements in output.
+ * @param[in] src_p   - elements to append.
+ * @param[in] n       - number of elements to append.
+ * @param[in] size_of - size of each array member.
+ *
+ * @return: number of elements in output after append.
+ */
+static inline size_t __darray_raw_set_emit(uint8_t* out_p, size_t out, const uint8_t* src_p, size_t n, size_t size_of);
+
+
+/*
+ * Internal function which compute set operation @ops of two sorted arrays.
+ *
+ * @param[in]  first_p       - pointer to first sorted array.
+ * @param[in]  first_length  - number of elements in first array.
+ * @param[in]  second_p      - pointer to second sorted array.
+ * @param[in]  second_length - number of elements in second array.
+ * @param[in]  size_of       - size of each array member.
+ * @param[in]  cmp_fp        - comparator function pointer.
+ * @param[in]  ops           - elements of result, mask of darray_raw_set_op_e.
+ * @param[out] out_p         - output array or NULL.
+ *
+ * @return: number of elements of result.
+ */
+static size_t __darray_raw_set_op(const uint8_t* first_p, size_t first_length, const uint8_t* second_p, size_t second_length,
+                                  size_t size_of, const compare_fp cmp_fp, unsigned ops, uint8_t* out_p);
+
+
+/*
+ * Internal function which check arguments and compute set operation @ops.
+ *
+ * @param[in]  first_p       - pointer to first sorted array.
+ * @param[in]  first_length  - number of elements in first array.
+ * @param[in]  second_p      - pointer to second sorted array.
+ * @param[in]  second_length - number of elements in second array.
+ * @param[in]  size_of       - size of each array member.
+ * @param[in]  cmp_fp        - comparator function pointer.
+ * @param[in]  ops           - elements of result, mask of darray_raw_set_op_e.
+ * @param[out] out_p         - output array or NULL.
+ *
+ * @return: number of elements of result on success, -1 on failure.
+ */
+static ssize_t __darray_raw_set(const void* first_p, size_t first_length, const void* second_p, size_t second_length,
+                                size_t size_of, const compare_fp cmp_fp, unsigned ops, void* out_p);
+
+
+/*
+ * Functionlike macro which define intersection of strictly increasing arrays of integer keys:
+ * size_t name(const type* first_p, size_t first_length, const type* second_p, size_t second_length, type* out_p).
+ *
+ * @param[in] name  - name of generated function.
+ * @param[in] type  - type of key.
+ * @param[in] block - number of elements in block (elements of block of first array are compared with all elements
+ *                    of block of second array).
+ *
+ * @return nothing.
+ */
+#define DARRAY_RAW_DEFINE_SET_INTERSECT_KEYS(name, type, block) \
+    static size_t name##_gallop(const type* const small_p, const size_t small_length, const type* const large_p, const size_t large_length, \
+                                type* const out_p) \
+    { \
+        register size_t out = 0; \
+        register size_t pos = 0; \
+        \
+        for (size_t i = 0; i < small_length && pos < large_length; ++i) \
+        { \
+            register const type key = small_p[i]; \
+            register size_t low = pos; \
+            register size_t step = 1; \
+            \
+            while (low + step < large_length && large_p[low + step] < key) \
+            { \
+                low += step; \
+                step *= 2; \
+            } \
+            \
+            register size_t high = low + step < large_length ? low + step + 1 : large_length; \
+            \
+            while (low < high) \
+            { \
+                register const size_t middle = low + (high - low) / 2; \
+                \
+                if (large_p[middle] < key) \
+                { \
+                    low = middle + 1; \
+                } \
+                else \
+                { \
+                    high = middle; \
+                } \
+            } \
+            \
+            pos = low; \
+            \
+            if (pos < large_length && large_p[pos] == key) \
+            { \
+                if (out_p != NULL) \
+                { \
+                    out_p[out] = key; \
+                } \
+                \
+                ++out; \
+                ++pos; \
+            } \
+        } \
+        \
+        return out; \
+    } \
+    \
+    DARRAY_RAW_SET_CLONES \
+    static size_t name(const type* const first_p, const size_t first_length, const type* const second_p, const size_t second_length, \
+                       type* const out_p) \
+    { \
+        if (first_length > DARRAY_RAW_SET_SKEW_RATIO * second_length) \
+        { \
+            return name##_gallop(second_p, second_length, first_p, first_length, out_p); \
+        } \
+        \
+        if (second_length > DARRAY_RAW_SET_SKEW_RATIO * first_length) \
+        { \
+            return name##_gallop(first_p, first_length, second_p, second_length, out_p); \
+        } \
+        \
+        register size_t out = 0; \
+        register size_t i = 0; \
+        register size_t j = 0; \
+        \
+        while (i + (block) <= first_length && j + (block) <= second_length) \
+        { \
+            const type* const restrict a_p = &first_p[i]; \
+            const type* const restrict b_p = &second_p[j]; \
+            type hit[(block)] = { 0 }; \
+            \
+            /* all pairs, every element of b is broadcast and compared with whole block of a */ \
+            for (size_t k = 0; k < (block); ++k) \
+            { \
+                for (size_t lane = 0; lane < (block); ++lane) \
+                { \
+                    hit[lane] |= (type)(a_p[lane] == b_p[k]); \
+                } \
+            } \
+            \
+            if (out_p == NULL) \
+            { \
+                for (size_t lane = 0; lane < (block); ++lane) \
+                { \
+                    out += (size_t)hit[lane]; \
+                } \
+            } \
+            else \
+            { \
+                /* every lane is written into local block, position moves only for hits, \
+                   so only elements of result are copied into @out_p */ \
+                type packed[(block)]; \
+                register size_t hits = 0; \
+                \
+                for (size_t lane = 0; lane < (block); ++lane) \
+                { \
+                    packed[hits] = a_p[lane]; \
+                    hits += (size_t)hit[lane]; \
+                } \
+                \
+                memcpy(&out_p[out], &packed[0], hits * sizeof(type)); \
+                out += hits; \
+            } \
+            \
+            register const type a_last = a_p[(block) - 1]; \
+            register const type b_last = b_p[(block) - 1]; \
+            \
+            i += a_last <= b_last ? (block) : 0; \
+            j += b_last <= a_last ? (block) : 0; \
+        } \
+        \
+        while (i < first_length && j < second_length) \
+        { \
+            if (first_p[i] < second_p[j]) \
+            { \
+                ++i; \
+            } \
+            else if (second_p[j] < first_p[i]) \
+            { \
+                ++j; \
+            } \
+            else \
+            { \
+                if (out_p != NULL) \
+                { \
+                    out_p[out] = first_p[i]; \
+                } \
+                \
+                ++out; \
+                ++i; \
+                ++j; \
+            } \
+        } \
+        \
+        return out; \
+    }
+
+
+DARRAY_RAW_DEFINE_SET_INTERSECT_KEYS(__darray_raw_set_intersect_u32, uint32_t, 16)
+DARRAY_RAW_DEFINE_SET_INTERSECT_KEYS(__darray_raw_set_intersect_i32, int32_t, 16)
+DARRAY_RAW_DEFINE_SET_INTERSECT_KEYS(__darray_raw_set_intersect_u64, uint64_t, 8)
+DARRAY_RAW_DEFINE_SET_INTERSECT_KEYS(__darray_raw_set_intersect_i64, int64_t, 8)
+
+
+static size_t __darray_raw_set_gallop(const uint8_t* const array_p, const size_t size_of, const size_t length, const void* const key_p,
+                                      const compare_fp cmp_fp)
+{
+    register size_t low = 0;
+    register size_t idx = 0;
+
+    /* elements before @low are less than key, element at @idx is the next probe */
+    while (idx < length && cmp_fp(&array_p[idx * size_of], key_p) < 0)
+    {
+        low = idx + 1;
+        idx = 2 * idx + 1;
+    }
+
+    register size_t high = idx < length ? idx : length;
+
+    while (low < high)
+    {
+        register const size_t middle = low + (high - low) / 2;
+
+        if (cmp_fp(&array_p[middle * size_of], key_p) < 0)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    return low;
+}
+
+
+static inline size_t __darray_raw_set_emit(uint8_t* const out_p, const size_t out, const uint8_t* const src_p, const size_t n, const size_t size_of)
+{
+    if (out_p != NULL && n > 0)
+    {
+        memcpy(&out_p[out * size_of], src_p, n * size_of);
+    }
+
+    return out + n;
+}
+
+
+static size_t __darray_raw_set_op(const uint8_t* const first_p, const size_t first_length, const uint8_t* const second_p, const size_t second_length,
+                                  const size_t size_of, const compare_fp cmp_fp, const unsigned ops, uint8_t* const out_p)
+{
+    register size_t i = 0;
+    register size_t j = 0;
+    register size_t out = 0;
+    register size_t first_wins = 0;
+    register size_t second_wins = 0;
+
+    while (i < first_length && j < second_length)
+    {
+        register const int ret = cmp_fp(&first_p[i * size_of], &second_p[j * size_of]);
+
+        if (ret < 0)
+        {
+            register size_t n = 1;
+
+            /* run of first array before head of second array */
+            if (++first_wins >= DARRAY_RAW_SET_MIN_GALLOP)
+            {
+                n += __darray_raw_set_gallop(&first_p[(i + 1) * size_of], size_of, first_length - i - 1, &second_p[j * size_of], cmp_fp);
+                first_wins = 0;
+            }
+
+            if (ops & DARRAY_RAW_SET_FIRST_ONLY)
+            {
+                out = __darray_raw_set_emit(out_p, out, &first_p[i * size_of], n, size_of);
+            }
+
+            i += n;
+            second_wins = 0;
+        }
+        else if (ret > 0)
+        {
+            register size_t n = 1;
+
+            if (++second_wins >= DARRAY_RAW_SET_MIN_GALLOP)
+            {
+                n += __darray_raw_set_gallop(&second_p[(j + 1) * size_of], size_of, second_length - j - 1, &first_p[i * size_of], cmp_fp);
+                second_wins = 0;
+            }
+
+            if (ops & DARRAY_RAW_SET_SECOND_ONLY)
+            {
+                out = __darray_raw_set_emit(out_p, out, &second_p[j * size_of], n, size_of);
+            }
+
+            j += n;
+            first_wins = 0;
+        }
+        else
+        {
+            if (ops & DARRAY_RAW_SET_COMMON)
+            {
+                out = __darray_raw_set_emit(out_p, out, &first_p[i * size_of], 1, size_of);
+            }
+
+            ++i;
+            ++j;
+            first_wins = 0;
+            second_wins = 0;
+        }
+    }
+
+    if (ops & DARRAY_RAW_SET_FIRST_ONLY)
+    {
+        out = __darray_raw_set_emit(out_p, out, &first_p[i * size_of], first_length - i, size_of);
+    }
+
+    if (ops & DARRAY_RAW_SET_SECOND_ONLY)
+    {
+        out = __darray_raw_set_emit(out_p, out, &second_p[j * size_of], second_length - j, size_of);
+    }
+
+    return out;
+}
+
+
+static ssize_t __darray_raw_set(const void* const first_p, const size_t first_length, const void* const second_p, const size_t second_length,
+                                const size_t size_of, const compare_fp cmp_fp, const unsigned ops, void* const out_p)
+{
+    if (first_p == NULL && first_length > 0)
+    {
+        perror("DArrayRaw: argument first_p is NULL\n");
+        return -1;
+    }
+
+    if (second_p == NULL && second_length > 0)
+    {
+        perror("DArrayRaw: argument second_p is NULL\n");
+        return -1;
+    }
+
+    if (size_of == 0)
+    {
+        perror("DArrayRaw: argument size_of has to small value\n");
+        return -1;
+    }
+
+    if (cmp_fp == NULL)
+    {
+        perror("DArrayRaw: argument cmp_fp is NULL\n");
+        return -1;
+    }
+
+    return (ssize_t)__darray_raw_set_op(first_p, first_length, second_p, second_length, size_of, cmp_fp, ops, out_p);
+}
+
+
+ssize_t darray_raw_set_intersect(const void* const first_p, const size_t first_length, const void* const second_p, const size_t second_length,
+                                 const size_t size_of, const compare_fp cmp_fp, void* const out_p)
+{
+    return __darray_raw_set(first_p, first_length, second_p, second_length, size_of, cmp_fp, DARRAY_RAW_SET_COMMON, out_p);
+}
+
+
+ssize_t darray_raw_set_union(const void* const first_p, const size_t first_length, const void* const second_p, const size_t second_length,
+                             const size_t size_of, const compare_fp cmp_fp, void* const out_p)
+{
+    return __darray_raw_set(first_p, first_length, second_p, second_length, size_of, cmp_fp,
+                            DARRAY_RAW_SET_FIRST_ONLY | DARRAY_RAW_SET_SECOND_ONLY | DARRAY_RAW_SET_COMMON, out_p);
+}
+
+
+ssize_t darray_raw_set_difference(const void* const first_p, const size_t first_length, const void* const second_p, const size_t second_length,
+                                  const size_t size_of, const compare_fp cmp_fp, void* const out_p)
+{
+    return __darray_raw_set(first_p, first_length, second_p, second_length, size_of, cmp_fp, DARRAY_RAW_SET_FIRST_ONLY, out_p);
+}
+
+
+ssize_t darray_raw_set_symmetric_difference(const void* const first_p, const size_t first_length, const void* const second_p, const size_t second_length,
+                                            const size_t size_of, const compare_fp cmp_fp, void* const out_p)
+{
+    return __darray_raw_set(first_p, first_length, second_p, second_length, size_of, cmp_fp,
+                            DARRAY_RAW_SET_FIRST_ONLY | DARRAY_RAW_SET_SECOND_ONLY, out_p);
+}
+
+
+ssize_t darray_raw_set_intersect_keys(const void* const first_p, const size_t first_length, const void* const second_p, const size_t second_length,
+                                      const size_t size_of, const darray_raw_key_type_e key_type, void* const out_p)
+{
+    if (first_p == NULL && first_length > 0)
+    {
+        perror("DArrayRaw: argument first_p is NULL\n");
+        return -1;
+    }
+
+    if (second_p == NULL && second_length > 0)
+    {
+        perror("DArrayRaw: argument second_p is NULL\n");
+        return -1;
+    }
+
+    if (first_length == 0 || second_length == 0)
+    {
+        return 0;
+    }
+
+    switch (size_of)
+    {
+        case sizeof(uint32_t):
+        {
+            switch (key_type)
+            {
+                case DARRAY_RAW_KEY_UNSIGNED: return (ssize_t)__darray_raw_set_intersect_u32(first_p, first_length, second_p, second_length, out_p);
+                case DARRAY_RAW_KEY_SIGNED: return (ssize_t)__darray_raw_set_intersect_i32(first_p, first_length, second_p, second_length, out_p);
+                default: break;
+            }
+
+            break;
+        }
+        case sizeof(uint64_t):
+        {
+            switch (key_type)
+            {
+                case DARRAY_RAW_KEY_UNSIGNED: return (ssize_t)__darray_raw_set_intersect_u64(first_p, first_length, second_p, second_length, out_p);
+                case DARRAY_RAW_KEY_SIGNED: return (ssize_t)__darray_raw_set_intersect_i64(first_p, first_length, second_p, second_length, out_p);
+                default: break;
+            }
+
+            break;
+        }
+        default:
+        {
+            perror("DArrayRaw: argument size_of has to be 4 or 8\n");
+            return -1;
+        }
+    }
+
+    perror("DArrayRaw: argument key_type is invalid\n");
+    return -1;
+}
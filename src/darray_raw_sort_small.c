@@ -0,0 +1,212 @@
+#include <darray_raw/darray_raw.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+
+/*
+    Sorting networks for small arrays of 4- and 8-byte numeric keys.
+
+    1. Padding  - array is copied into buffer of 8, 16, 32 or 64 elements, rest of buffer is filled by maximal value.
+    2. Network  - bitonic sorting network where every comparator sorts ascending: first stage of each merge
+                  compares element with its mirror in block, next stages compare elements distant by half of block.
+                  Each stage is branchless min/max over contiguous slices, so it is vectorized by compiler.
+    3. Dispatch - network is compiled for AVX-512, AVX2, SSE4.1 and baseline x86-64 (target_clones),
+                  best version is chosen once at program load time.
+*/
+
+
+/* functionlike macro which mark function to be compiled for few instruction sets and dispatched at load time */
+#if defined(__x86_64__) && defined(__GNUC__) && !defined(__clang__)
+#define DARRAY_RAW_NETWORK_CLONES __attribute__((target_clones("avx512f", "avx2", "sse4.1", "default")))
+#else
+#define DARRAY_RAW_NETWORK_CLONES
+#endif
+
+
+/*
+ * Functionlike macro which define sorting network for one type: void name(type* array_p, size_t length).
+ * @length has to be in range [0, DARRAY_RAW_SORT_SMALL_MAX], arguments are not checked (see darray_raw_priv_common.h).
+ *
+ * @param[in] name    - name of generated function.
+ * @param[in] type    - type of each array member.
+ * @param[in] max_val - maximal value of type used for padding.
+ *
+ * @return nothing.
+ */
+#define DARRAY_RAW_DEFINE_NETWORK(name, type, max_val) \
+    static inline __attribute__((always_inline)) void name##_stages(type* const buf_p, const size_t n) \
+    { \
+        for (size_t k = 2; k <= n; k *= 2) \
+        { \
+            for (size_t base = 0; base < n; base += k) \
+            { \
+                type* const restrict lo_p = &buf_p[base]; \
+                type* const restrict hi_p = &buf_p[base + k / 2]; \
+                \
+                for (size_t t = 0; t < k / 2; ++t) \
+                { \
+                    const type x = lo_p[t]; \
+                    const type y = hi_p[k / 2 - 1 - t]; \
+                    \
+                    lo_p[t] = x < y ? x : y; \
+                    hi_p[k / 2 - 1 - t] = x < y ? y : x; \
+                } \
+            } \
+            \
+            for (size_t j = k / 4; j > 0; j /= 2) \
+            { \
+                for (size_t base = 0; base < n; base += 2 * j) \
+                { \
+                    type* const restrict lo_p = &buf_p[base]; \
+                    type* const restrict hi_p = &buf_p[base + j]; \
+                    \
+                    for (size_t t = 0; t < j; ++t) \
+                    { \
+                        const type x = lo_p[t]; \
+                        const type y = hi_p[t]; \
+                        \
+                        lo_p[t] = x < y ? x : y; \
+                        hi_p[t] = x < y ? y : x; \
+                    } \
+                } \
+            } \
+        } \
+    } \
+    \
+    DARRAY_RAW_NETWORK_CLONES \
+    void name(type* const array_p, const size_t length) \
+    { \
+        type buf[DARRAY_RAW_SORT_SMALL_MAX]; \
+        \
+        memcpy(&buf[0], array_p, length * sizeof(type)); \
+        \
+        for (size_t i = length; i < array_size(buf); ++i) \
+        { \
+            buf[i] = (max_val); \
+        } \
+        \
+        /* constant network size lets compiler unroll and vectorize every stage */ \
+        if (length <= 8) \
+        { \
+            name##_stages(&buf[0], 8); \
+        } \
+        else if (length <= 16) \
+        { \
+            name##_stages(&buf[0], 16); \
+        } \
+        else if (length <= 32) \
+        { \
+            name##_stages(&buf[0], 32); \
+        } \
+        else \
+        { \
+            name##_stages(&buf[0], 64); \
+        } \
+        \
+        memcpy(array_p, &buf[0], length * sizeof(type)); \
+    }
+
+
+/*
+ * Functionlike macro which define public small sort function for one type.
+ * Arrays longer than DARRAY_RAW_SORT_SMALL_MAX are sorted by @fallback.
+ *
+ * @param[in] name     - name of generated function.
+ * @param[in] type     - type of each array member.
+ * @param[in] network  - sorting network function.
+ * @param[in] fallback - type-specialized sort for longer arrays.
+ *
+ * @return nothing.
+ */
+#define DARRAY_RAW_DEFINE_SORT_SMALL(name, type, network, fallback) \
+    void name(type* const array_p, const size_t length) \
+    { \
+        if (array_p == NULL) \
+        { \
+            perror("DArrayRaw: argument array_p is NULL\n"); \
+            return; \
+        } \
+        \
+        if (length == 0) \
+        { \
+            perror("DArrayRaw: argument length has to small value\n"); \
+            return; \
+        } \
+        \
+        if (length > DARRAY_RAW_SORT_SMALL_MAX) \
+        { \
+            fallback(array_p, length); \
+            return; \
+        } \
+        \
+        network(array_p, length); \
+    }
+
+
+DARRAY_RAW_DEFINE_NETWORK(__darray_raw_network_i32, int32_t, INT32_MAX)
+DARRAY_RAW_DEFINE_NETWORK(__darray_raw_network_u32, uint32_t, UINT32_MAX)
+DARRAY_RAW_DEFINE_NETWORK(__darray_raw_network_float, float, INFINITY)
+DARRAY_RAW_DEFINE_NETWORK(__darray_raw_network_i64, int64_t, INT64_MAX)
+DARRAY_RAW_DEFINE_NETWORK(__darray_raw_network_u64, uint64_t, UINT64_MAX)
+DARRAY_RAW_DEFINE_NETWORK(__darray_raw_network_double, double, (double)INFINITY)
+
+
+DARRAY_RAW_DEFINE_SORT_SMALL(darray_raw_sort_small_i32, int32_t, __darray_raw_network_i32, darray_raw_sort_i32)
+DARRAY_RAW_DEFINE_SORT_SMALL(darray_raw_sort_small_u32, uint32_t, __darray_raw_network_u32, darray_raw_sort_u32)
+DARRAY_RAW_DEFINE_SORT_SMALL(darray_raw_sort_small_float, float, __darray_raw_network_float, darray_raw_sort_float)
+DARRAY_RAW_DEFINE_SORT_SMALL(darray_raw_sort_small_i64, int64_t, __darray_raw_network_i64, darray_raw_sort_i64)
+DARRAY_RAW_DEFINE_SORT_SMALL(darray_raw_sort_small_u64, uint64_t, __darray_raw_network_u64, darray_raw_sort_u64)
+DARRAY_RAW_DEFINE_SORT_SMALL(darray_raw_sort_small_double, double, __darray_raw_network_double, darray_raw_sort_double)
+
+
+int darray_raw_sort_small(void* const array_p, const size_t size_of, const size_t length, const darray_raw_key_type_e key_type)
+{
+    if (array_p == NULL)
+    {
+        perror("DArrayRaw: argument array_p is NULL\n");
+        return -1;
+    }
+
+    if (length == 0)
+    {
+        perror("DArrayRaw: argument length has to small value\n");
+        return -1;
+    }
+
+    switch (size_of)
+    {
+        case sizeof(uint32_t):
+        {
+            switch (key_type)
+            {
+                case DARRAY_RAW_KEY_UNSIGNED: darray_raw_sort_small_u32(array_p, length); return 0;
+                case DARRAY_RAW_KEY_SIGNED: darray_raw_sort_small_i32(array_p, length); return 0;
+                case DARRAY_RAW_KEY_FLOAT: darray_raw_sort_small_float(array_p, length); return 0;
+                default: break;
+            }
+
+            break;
+        }
+        case sizeof(uint64_t):
+        {
+            switch (key_type)
+            {
+                case DARRAY_RAW_KEY_UNSIGNED: darray_raw_sort_small_u64(array_p, length); return 0;
+                case DARRAY_RAW_KEY_SIGNED: darray_raw_sort_small_i64(array_p, length); return 0;
+                case DARRAY_RAW_KEY_FLOAT: darray_raw_sort_small_double(array_p, length); return 0;
+                default: break;
+            }
+
+            break;
+        }
+        default:
+        {
+            perror("DArrayRaw: argument size_of has to be 4 or 8\n");
+            return -1;
+        }
+    }
+
+    perror("DArrayRaw: argument key_type is invalid\n");
+    return -1;
+}
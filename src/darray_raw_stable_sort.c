@@ -0,0 +1,850 @@
+#include <darray_raw/darray_raw.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/*
+    Stable sort in the style of TimSort.
+
+    1. Runs      - array is scanned for ascending and strictly descending runs (descending runs are reversed).
+                   Short runs are extended to minimal run length by binary insertion-sort.
+    2. Stack     - runs are pushed on stack and merged while lengths do not grow like Fibonacci numbers,
+                   so stack depth is O(log n) and merges are balanced.
+    3. Merge     - smaller run is copied into scratch buffer and merged from the side of that run.
+                   When one run wins many times in a row, merge switches to galloping (exponential search).
+    4. In place  - if smaller run does not fit in scratch buffer, both runs are split by binary search,
+                   middle blocks are rotated and both halves are merged recursively (O(1) additional memory).
+*/
+
+
+/* arrays shorter than this are sorted by binary insertion-sort only */
+#define DARRAY_RAW_SSORT_MIN_MERGE      ((size_t)64)
+
+/* number of consecutive wins which switch merge into galloping mode */
+#define DARRAY_RAW_SSORT_MIN_GALLOP     ((size_t)7)
+
+/* maximal number of pending runs, enough for any length of array */
+#define DARRAY_RAW_SSORT_MAX_RUNS       ((size_t)128)
+
+/* size of internal buffer used when caller does not pass scratch buffer */
+#define DARRAY_RAW_SSORT_STACK_BYTES    ((size_t)1024)
+
+
+/* state of one stable sort call */
+typedef struct DArrayRawSSortS
+{
+    uint8_t* barray_p;
+    size_t size_of;
+    compare_fp cmp_fp;
+
+    uint8_t* scratch_p;
+    size_t scratch_length;  /* number of elements which fit in scratch buffer */
+    size_t min_gallop;
+
+    size_t run_base[DARRAY_RAW_SSORT_MAX_RUNS];
+    size_t run_length[DARRAY_RAW_SSORT_MAX_RUNS];
+    size_t nruns;
+} DArrayRawSSortS;
+
+
+/*
+ * Internal function which compute minimal run length for array of @length elements.
+ * Result is in range [32, 64] and @length / result is equal or a bit less than power of two.
+ *
+ * @param[in] length - number of elements in array.
+ *
+ * @return: minimal run length.
+ */
+static inline size_t __darray_raw_ssort_min_run(size_t length);
+
+
+/*
+ * Internal function which find length of run starting at @array_p. Strictly descending run is reversed.
+ *
+ * @param[in] array_p - pointer to array.
+ * @param[in] size_of - size of each array member.
+ * @param[in] length  - number of elements in array (at least 1).
+ * @param[in] cmp_fp  - comparator function pointer.
+ *
+ * @return: length of ascending run.
+ */
+static inline size_t __darray_raw_ssort_count_run(uint8_t* array_p, size_t size_of, size_t length, compare_fp cmp_fp);
+
+
+/*
+ * Internal function which sort @array_p by binary insertion-sort. Elements [0, @start) have to be sorted.
+ *
+ * @param[in] array_p - pointer to array.
+ * @param[in] size_of - size of each array member.
+ * @param[in] length  - number of elements in array.
+ * @param[in] start   - number of already sorted elements at the beginning of array.
+ * @param[in] cmp_fp  - comparator function pointer.
+ *
+ * @return: this is void function.
+ */
+static inline void __darray_raw_ssort_binary_insertion(uint8_t* array_p, size_t size_of, size_t length, size_t start, compare_fp cmp_fp);
+
+
+/*
+ * Internal function which find position of @key_p in sorted @array_p by exponential search started at @hint.
+ * Equal elements are placed after @key_p.
+ *
+ * @param[in] key_p   - pointer to key.
+ * @param[in] array_p - pointer to sorted array.
+ * @param[in] size_of - size of each array member.
+ * @param[in] length  - number of elements in array (at least 1).
+ * @param[in] hint    - index where search starts.
+ * @param[in] cmp_fp  - comparator function pointer.
+ *
+ * @return: number of elements less than @key_p.
+ */
+static inline size_t __darray_raw_ssort_gallop_left(const void* key_p, const uint8_t* array_p, size_t size_of, size_t length, size_t hint, compare_fp cmp_fp);
+
+
+/*
+ * Internal function which find position of @key_p in sorted @array_p by exponential search started at @hint.
+ * Equal elements are placed before @key_p.
+ *
+ * @param[in] key_p   - pointer to key.
+ * @param[in] array_p - pointer to sorted array.
+ * @param[in] size_of - size of each array member.
+ * @param[in] length  - number of elements in array (at least 1).
+ * @param[in] hint    - index where search starts.
+ * @param[in] cmp_fp  - comparator function pointer.
+ *
+ * @return: number of elements less or equal to @key_p.
+ */
+static inline size_t __darray_raw_ssort_gallop_right(const void* key_p, const uint8_t* array_p, size_t size_of, size_t length, size_t hint, compare_fp cmp_fp);
+
+
+/*
+ * Internal function which merge neighbouring runs. First run is copied into scratch buffer, so @len1 has to fit in it.
+ * First element of second run has to be less than first element of first run.
+ *
+ * @param[in] ctx_p - stable sort state.
+ * @param[in] base  - index of first run.
+ * @param[in] len1  - length of first run.
+ * @param[in] len2  - length of second run.
+ *
+ * @return: this is void function.
+ */
+static void __darray_raw_ssort_merge_lo(DArrayRawSSortS* ctx_p, size_t base, size_t len1, size_t len2);
+
+
+/*
+ * Internal function which merge neighbouring runs. Second run is copied into scratch buffer, so @len2 has to fit in it.
+ * Last element of first run has to be greater than last element of second run.
+ *
+ * @param[in] ctx_p - stable sort state.
+ * @param[in] base  - index of first run.
+ * @param[in] len1  - length of first run.
+ * @param[in] len2  - length of second run.
+ *
+ * @return: this is void function.
+ */
+static void __darray_raw_ssort_merge_hi(DArrayRawSSortS* ctx_p, size_t base, size_t len1, size_t len2);
+
+
+/*
+ * Internal function which swap neighbouring blocks of @array_p (rotate left by @len1 elements).
+ *
+ * @param[in] ctx_p   - stable sort state.
+ * @param[in] array_p - pointer to first block.
+ * @param[in] len1    - length of first block.
+ * @param[in] len2    - length of second block.
+ *
+ * @return: this is void function.
+ */
+static inline void __darray_raw_ssort_rotate(DArrayRawSSortS* ctx_p, uint8_t* array_p, size_t len1, size_t len2);
+
+
+/*
+ * Internal function which merge neighbouring runs with scratch buffer if smaller run fits in it
+ * or in place by rotations otherwise.
+ *
+ * @param[in] ctx_p - stable sort state.
+ * @param[in] base  - index of first run.
+ * @param[in] len1  - length of first run.
+ * @param[in] len2  - length of second run.
+ *
+ * @return: this is void function.
+ */
+static void __darray_raw_ssort_merge(DArrayRawSSortS* ctx_p, size_t base, size_t len1, size_t len2);
+
+
+/*
+ * Internal function which merge runs @idx and @idx + 1 from stack of pending runs.
+ *
+ * @param[in] ctx_p - stable sort state.
+ * @param[in] idx   - index of run in stack.
+ *
+ * @return: this is void function.
+ */
+static void __darray_raw_ssort_merge_at(DArrayRawSSortS* ctx_p, size_t idx);
+
+
+/*
+ * Internal function which merge runs from top of stack until stack invariants hold.
+ *
+ * @param[in] ctx_p - stable sort state.
+ * @param[in] force - merge all runs.
+ *
+ * @return: this is void function.
+ */
+static void __darray_raw_ssort_merge_collapse(DArrayRawSSortS* ctx_p, bool force);
+
+
+static inline size_t __darray_raw_ssort_min_run(size_t length)
+{
+    register size_t rest = 0;
+
+    while (length >= DARRAY_RAW_SSORT_MIN_MERGE)
+    {
+        rest |= length & 1;
+        length >>= 1;
+    }
+
+    return length + rest;
+}
+
+
+static inline size_t __darray_raw_ssort_count_run(uint8_t* const array_p, const size_t size_of, const size_t length, const compare_fp cmp_fp)
+{
+    if (length == 1)
+    {
+        return 1;
+    }
+
+    register size_t run_length = 2;
+
+    if (cmp_fp(&array_p[size_of], &array_p[0]) < 0)
+    {
+        while (run_length < length && cmp_fp(&array_p[run_length * size_of], &array_p[(run_length - 1) * size_of]) < 0)
+        {
+            run_length++;
+        }
+
+        darray_raw_reverse(array_p, size_of, run_length);
+    }
+    else
+    {
+        while (run_length < length && cmp_fp(&array_p[run_length * size_of], &array_p[(run_length - 1) * size_of]) >= 0)
+        {
+            run_length++;
+        }
+    }
+
+    return run_length;
+}
+
+
+static inline void __darray_raw_ssort_binary_insertion(uint8_t* const array_p, const size_t size_of, const size_t length, const size_t start, const compare_fp cmp_fp)
+{
+    uint8_t tmp[size_of];
+
+    for (size_t i = start; i < length; ++i)
+    {
+        register size_t left = 0;
+        register size_t right = i;
+
+        while (left < right)
+        {
+            register const size_t middle = left + (right - left) / 2;
+
+            if (cmp_fp(&array_p[i * size_of], &array_p[middle * size_of]) < 0)
+            {
+                right = middle;
+            }
+            else
+            {
+                left = middle + 1;
+            }
+        }
+
+        if (left == i)
+        {
+            continue;
+        }
+
+        assign(&tmp[0], &array_p[i * size_of], size_of);
+        (void)memmove(&array_p[(left + 1) * size_of], &array_p[left * size_of], (i - left) * size_of);
+        assign(&array_p[left * size_of], &tmp[0], size_of);
+    }
+}
+
+
+static inline size_t __darray_raw_ssort_gallop_left(const void* const key_p, const uint8_t* const array_p, const size_t size_of, const size_t length,
+                                                    const size_t hint, const compare_fp cmp_fp)
+{
+    register size_t last_offset = 0;
+    register size_t offset = 1;
+    register size_t left;
+    register size_t right;
+
+    if (cmp_fp(key_p, &array_p[hint * size_of]) > 0)
+    {
+        /* array[hint + last_offset] < key <= array[hint + offset] */
+        register const size_t max_offset = length - hint;
+
+        while (offset < max_offset && cmp_fp(key_p, &array_p[(hint + offset) * size_of]) > 0)
+        {
+            last_offset = offset;
+            offset = 2 * offset + 1;
+        }
+
+        if (offset > max_offset)
+        {
+            offset = max_offset;
+        }
+
+        left = hint + last_offset + 1;
+        right = hint + offset;
+    }
+    else
+    {
+        /* array[hint - offset] < key <= array[hint - last_offset] */
+        register const size_t max_offset = hint + 1;
+
+        while (offset < max_offset && cmp_fp(key_p, &array_p[(hint - offset) * size_of]) <= 0)
+        {
+            last_offset = offset;
+            offset = 2 * offset + 1;
+        }
+
+        if (offset > max_offset)
+        {
+            offset = max_offset;
+        }
+
+        left = hint + 1 - offset;
+        right = hint - last_offset;
+    }
+
+    while (left < right)
+    {
+        register const size_t middle = left + (right - left) / 2;
+
+        if (cmp_fp(key_p, &array_p[middle * size_of]) > 0)
+        {
+            left = middle + 1;
+        }
+        else
+        {
+            right = middle;
+        }
+    }
+
+    return right;
+}
+
+
+static inline size_t __darray_raw_ssort_gallop_right(const void* const key_p, const uint8_t* const array_p, const size_t size_of, const size_t length,
+                                                     const size_t hint, const compare_fp cmp_fp)
+{
+    register size_t last_offset = 0;
+    register size_t offset = 1;
+    register size_t left;
+    register size_t right;
+
+    if (cmp_fp(key_p, &array_p[hint * size_of]) < 0)
+    {
+        /* array[hint - offset] <= key < array[hint - last_offset] */
+        register const size_t max_offset = hint + 1;
+
+        while (offset < max_offset && cmp_fp(key_p, &array_p[(hint - offset) * size_of]) < 0)
+        {
+            last_offset = offset;
+            offset = 2 * offset + 1;
+        }
+
+        if (offset > max_offset)
+        {
+            offset = max_offset;
+        }
+
+        left = hint + 1 - offset;
+        right = hint - last_offset;
+    }
+    else
+    {
+        /* array[hint + last_offset] <= key < array[hint + offset] */
+        register const size_t max_offset = length - hint;
+
+        while (offset < max_offset && cmp_fp(key_p, &array_p[(hint + offset) * size_of]) >= 0)
+        {
+            last_offset = offset;
+            offset = 2 * offset + 1;
+        }
+
+        if (offset > max_offset)
+        {
+            offset = max_offset;
+        }
+
+        left = hint + last_offset + 1;
+        right = hint + offset;
+    }
+
+    while (left < right)
+    {
+        register const size_t middle = left + (right - left) / 2;
+
+        if (cmp_fp(key_p, &array_p[middle * size_of]) < 0)
+        {
+            right = middle;
+        }
+        else
+        {
+            left = middle + 1;
+        }
+    }
+
+    return right;
+}
+
+
+static void __darray_raw_ssort_merge_lo(DArrayRawSSortS* const ctx_p, const size_t base, size_t len1, size_t len2)
+{
+    register const size_t size_of = ctx_p->size_of;
+    register const compare_fp cmp_fp = ctx_p->cmp_fp;
+    uint8_t* const barray_p = ctx_p->barray_p;
+    uint8_t* const tmp_p = ctx_p->scratch_p;
+
+    (void)memcpy(&tmp_p[0], &barray_p[base * size_of], len1 * size_of);
+
+    register size_t cursor1 = 0;            /* in scratch buffer */
+    register size_t cursor2 = base + len1;  /* in array */
+    register size_t dest = base;
+
+    register size_t min_gallop = ctx_p->min_gallop;
+    register size_t count1 = 0;
+    register size_t count2 = 0;
+    register bool galloping = false;
+
+    /* second run is never overwritten before it is read, because dest < cursor2 while first run is not empty */
+    while (len1 != 0 && len2 != 0)
+    {
+        if (!galloping)
+        {
+            if (cmp_fp(&barray_p[cursor2 * size_of], &tmp_p[cursor1 * size_of]) < 0)
+            {
+                assign(&barray_p[dest * size_of], &barray_p[cursor2 * size_of], size_of);
+                dest++;
+                cursor2++;
+                len2--;
+                count2++;
+                count1 = 0;
+            }
+            else
+            {
+                assign(&barray_p[dest * size_of], &tmp_p[cursor1 * size_of], size_of);
+                dest++;
+                cursor1++;
+                len1--;
+                count1++;
+                count2 = 0;
+            }
+
+            galloping = count1 >= min_gallop || count2 >= min_gallop;
+            continue;
+        }
+
+        count1 = __darray_raw_ssort_gallop_right(&barray_p[cursor2 * size_of], &tmp_p[cursor1 * size_of], size_of, len1, 0, cmp_fp);
+        (void)memcpy(&barray_p[dest * size_of], &tmp_p[cursor1 * size_of], count1 * size_of);
+        dest += count1;
+        cursor1 += count1;
+        len1 -= count1;
+
+        if (len1 == 0)
+        {
+            break;
+        }
+
+        count2 = __darray_raw_ssort_gallop_left(&tmp_p[cursor1 * size_of], &barray_p[cursor2 * size_of], size_of, len2, 0, cmp_fp);
+        (void)memmove(&barray_p[dest * size_of], &barray_p[cursor2 * size_of], count2 * size_of);
+        dest += count2;
+        cursor2 += count2;
+        len2 -= count2;
+
+        if (count1 < DARRAY_RAW_SSORT_MIN_GALLOP && count2 < DARRAY_RAW_SSORT_MIN_GALLOP)
+        {
+            /* galloping does not pay off, make it harder to enter again */
+            galloping = false;
+            min_gallop += 2;
+            count1 = 0;
+            count2 = 0;
+        }
+        else if (min_gallop > 1)
+        {
+            min_gallop--;
+        }
+    }
+
+    ctx_p->min_gallop = min_gallop;
+
+    /* rest of second run is already in place */
+    (void)memcpy(&barray_p[dest * size_of], &tmp_p[cursor1 * size_of], len1 * size_of);
+}
+
+
+static void __darray_raw_ssort_merge_hi(DArrayRawSSortS* const ctx_p, const size_t base, size_t len1, size_t len2)
+{
+    register const size_t size_of = ctx_p->size_of;
+    register const compare_fp cmp_fp = ctx_p->cmp_fp;
+    uint8_t* const barray_p = ctx_p->barray_p;
+    uint8_t* const tmp_p = ctx_p->scratch_p;
+
+    (void)memcpy(&tmp_p[0], &barray_p[(base + len1) * size_of], len2 * size_of);
+
+    /* all cursors point one element after the last not merged element */
+    register size_t end1 = base + len1;         /* in array */
+    register size_t end2 = len2;                /* in scratch buffer */
+    register size_t dest_end = base + len1 + len2;
+
+    register size_t min_gallop = ctx_p->min_gallop;
+    register size_t count1 = 0;
+    register size_t count2 = 0;
+    register bool galloping = false;
+
+    while (len1 != 0 && len2 != 0)
+    {
+        if (!galloping)
+        {
+            if (cmp_fp(&tmp_p[(end2 - 1) * size_of], &barray_p[(end1 - 1) * size_of]) < 0)
+            {
+                end1--;
+                dest_end--;
+                assign(&barray_p[dest_end * size_of], &barray_p[end1 * size_of], size_of);
+                len1--;
+                count1++;
+                count2 = 0;
+            }
+            else
+            {
+                end2--;
+                dest_end--;
+                assign(&barray_p[dest_end * size_of], &tmp_p[end2 * size_of], size_of);
+                len2--;
+                count2++;
+                count1 = 0;
+            }
+
+            galloping = count1 >= min_gallop || count2 >= min_gallop;
+            continue;
+        }
+
+        count1 = len1 - __darray_raw_ssort_gallop_right(&tmp_p[(end2 - 1) * size_of], &barray_p[base * size_of], size_of, len1, len1 - 1, cmp_fp);
+        end1 -= count1;
+        dest_end -= count1;
+        (void)memmove(&barray_p[dest_end * size_of], &barray_p[end1 * size_of], count1 * size_of);
+        len1 -= count1;
+
+        if (len1 == 0)
+        {
+            break;
+        }
+
+        count2 = len2 - __darray_raw_ssort_gallop_left(&barray_p[(end1 - 1) * size_of], &tmp_p[0], size_of, len2, len2 - 1, cmp_fp);
+        end2 -= count2;
+        dest_end -= count2;
+        (void)memcpy(&barray_p[dest_end * size_of], &tmp_p[end2 * size_of], count2 * size_of);
+        len2 -= count2;
+
+        if (count1 < DARRAY_RAW_SSORT_MIN_GALLOP && count2 < DARRAY_RAW_SSORT_MIN_GALLOP)
+        {
+            galloping = false;
+            min_gallop += 2;
+            count1 = 0;
+            count2 = 0;
+        }
+        else if (min_gallop > 1)
+        {
+            min_gallop--;
+        }
+    }
+
+    ctx_p->min_gallop = min_gallop;
+
+    /* rest of first run is already in place */
+    (void)memcpy(&barray_p[base * size_of], &tmp_p[0], len2 * size_of);
+}
+
+
+static inline void __darray_raw_ssort_rotate(DArrayRawSSortS* const ctx_p, uint8_t* const array_p, const size_t len1, const size_t len2)
+{
+    register const size_t size_of = ctx_p->size_of;
+
+    if (len1 == 0 || len2 == 0)
+    {
+        return;
+    }
+
+    if (len1 <= len2 && len1 <= ctx_p->scratch_length)
+    {
+        (void)memcpy(&ctx_p->scratch_p[0], &array_p[0], len1 * size_of);
+        (void)memmove(&array_p[0], &array_p[len1 * size_of], len2 * size_of);
+        (void)memcpy(&array_p[len2 * size_of], &ctx_p->scratch_p[0], len1 * size_of);
+    }
+    else if (len2 <= ctx_p->scratch_length)
+    {
+        (void)memcpy(&ctx_p->scratch_p[0], &array_p[len1 * size_of], len2 * size_of);
+        (void)memmove(&array_p[len2 * size_of], &array_p[0], len1 * size_of);
+        (void)memcpy(&array_p[0], &ctx_p->scratch_p[0], len2 * size_of);
+    }
+    else
+    {
+        darray_raw_reverse(&array_p[0], size_of, len1);
+        darray_raw_reverse(&array_p[len1 * size_of], size_of, len2);
+        darray_raw_reverse(&array_p[0], size_of, len1 + len2);
+    }
+}
+
+
+static void __darray_raw_ssort_merge(DArrayRawSSortS* const ctx_p, size_t base, size_t len1, size_t len2)
+{
+    register const size_t size_of = ctx_p->size_of;
+    uint8_t* const barray_p = ctx_p->barray_p;
+
+    while (len1 != 0 && len2 != 0)
+    {
+        if (len1 <= len2 && len1 <= ctx_p->scratch_length)
+        {
+            __darray_raw_ssort_merge_lo(ctx_p, base, len1, len2);
+            return;
+        }
+
+        if (len2 <= ctx_p->scratch_length)
+        {
+            __darray_raw_ssort_merge_hi(ctx_p, base, len1, len2);
+            return;
+        }
+
+        if (len1 <= ctx_p->scratch_length)
+        {
+            __darray_raw_ssort_merge_lo(ctx_p, base, len1, len2);
+            return;
+        }
+
+        /* single element is moved to its place by one rotation (halving of 1 + 1 merge would make no progress) */
+        if (len1 == 1)
+        {
+            register const size_t pos = __darray_raw_ssort_gallop_left(&barray_p[base * size_of], &barray_p[(base + 1) * size_of], size_of, len2, 0, ctx_p->cmp_fp);
+            __darray_raw_ssort_rotate(ctx_p, &barray_p[base * size_of], 1, pos);
+            return;
+        }
+
+        if (len2 == 1)
+        {
+            register const size_t pos = __darray_raw_ssort_gallop_right(&barray_p[(base + len1) * size_of], &barray_p[base * size_of], size_of, len1, 0, ctx_p->cmp_fp);
+            __darray_raw_ssort_rotate(ctx_p, &barray_p[(base + pos) * size_of], len1 - pos, 1);
+            return;
+        }
+
+        /* split bigger run in half, find place of its middle element in the other run and rotate blocks between,
+           both runs have at least 2 elements, so both parts are smaller than merged range */
+        size_t cut1;
+        size_t cut2;
+
+        if (len1 > len2)
+        {
+            cut1 = len1 / 2;
+            cut2 = __darray_raw_ssort_gallop_left(&barray_p[(base + cut1) * size_of], &barray_p[(base + len1) * size_of], size_of, len2, 0, ctx_p->cmp_fp);
+        }
+        else
+        {
+            cut2 = len2 / 2;
+            cut1 = __darray_raw_ssort_gallop_right(&barray_p[(base + len1 + cut2) * size_of], &barray_p[base * size_of], size_of, len1, 0, ctx_p->cmp_fp);
+        }
+
+        __darray_raw_ssort_rotate(ctx_p, &barray_p[(base + cut1) * size_of], len1 - cut1, cut2);
+
+        register const size_t middle = base + cut1 + cut2;
+
+        /* recursion on smaller part and loop on bigger part keep stack depth O(log n) */
+        if (cut1 + cut2 < len1 + len2 - cut1 - cut2)
+        {
+            __darray_raw_ssort_merge(ctx_p, base, cut1, cut2);
+
+            base = middle;
+            len1 = len1 - cut1;
+            len2 = len2 - cut2;
+        }
+        else
+        {
+            __darray_raw_ssort_merge(ctx_p, middle, len1 - cut1, len2 - cut2);
+
+            len1 = cut1;
+            len2 = cut2;
+        }
+    }
+}
+
+
+static void __darray_raw_ssort_merge_at(DArrayRawSSortS* const ctx_p, const size_t idx)
+{
+    register const size_t size_of = ctx_p->size_of;
+    uint8_t* const barray_p = ctx_p->barray_p;
+
+    register size_t base1 = ctx_p->run_base[idx];
+    register size_t len1 = ctx_p->run_length[idx];
+    register const size_t base2 = ctx_p->run_base[idx + 1];
+    register size_t len2 = ctx_p->run_length[idx + 1];
+
+    ctx_p->run_length[idx] = len1 + len2;
+
+    if (idx + 3 == ctx_p->nruns)
+    {
+        ctx_p->run_base[idx + 1] = ctx_p->run_base[idx + 2];
+        ctx_p->run_length[idx + 1] = ctx_p->run_length[idx + 2];
+    }
+
+    ctx_p->nruns--;
+
+    /* elements of first run not greater than first element of second run are already in place */
+    register const size_t skip = __darray_raw_ssort_gallop_right(&barray_p[base2 * size_of], &barray_p[base1 * size_of], size_of, len1, 0, ctx_p->cmp_fp);
+    base1 += skip;
+    len1 -= skip;
+
+    if (len1 == 0)
+    {
+        return;
+    }
+
+    /* the same for elements of second run not less than last element of first run */
+    len2 = __darray_raw_ssort_gallop_left(&barray_p[(base1 + len1 - 1) * size_of], &barray_p[base2 * size_of], size_of, len2, len2 - 1, ctx_p->cmp_fp);
+
+    if (len2 == 0)
+    {
+        return;
+    }
+
+    __darray_raw_ssort_merge(ctx_p, base1, len1, len2);
+}
+
+
+static void __darray_raw_ssort_merge_collapse(DArrayRawSSortS* const ctx_p, const bool force)
+{
+    const size_t* const run_length = ctx_p->run_length;
+
+    while (ctx_p->nruns > 1)
+    {
+        register size_t idx = ctx_p->nruns - 2;
+
+        if (force)
+        {
+            if (idx > 0 && run_length[idx - 1] < run_length[idx + 1])
+            {
+                idx--;
+            }
+        }
+        else if ((idx > 0 && run_length[idx - 1] <= run_length[idx] + run_length[idx + 1]) ||
+                 (idx > 1 && run_length[idx - 2] <= run_length[idx - 1] + run_length[idx]))
+        {
+            if (run_length[idx - 1] < run_length[idx + 1])
+            {
+                idx--;
+            }
+        }
+        else if (run_length[idx] > run_length[idx + 1])
+        {
+            break;
+        }
+
+        __darray_raw_ssort_merge_at(ctx_p, idx);
+    }
+}
+
+
+int darray_raw_stable_sort(void* const array_p, const size_t size_of, const size_t length, const compare_fp cmp_fp, void* const scratch_p, const size_t scratch_length)
+{
+    if (array_p == NULL)
+    {
+        perror("DArrayRaw: argument array_p is NULL\n");
+        return -1;
+    }
+
+    if (size_of == 0)
+    {
+        perror("DArrayRaw: argument size_of has to small value\n");
+        return -1;
+    }
+
+    if (length == 0)
+    {
+        perror("DArrayRaw: argument length has to small value\n");
+        return -1;
+    }
+
+    if (cmp_fp == NULL)
+    {
+        perror("DArrayRaw: argument cmp_fp is NULL\n");
+        return -1;
+    }
+
+    uint8_t* const barray_p = array_p;
+
+    if (length < DARRAY_RAW_SSORT_MIN_MERGE)
+    {
+        register const size_t run_length = __darray_raw_ssort_count_run(barray_p, size_of, length, cmp_fp);
+        __darray_raw_ssort_binary_insertion(barray_p, size_of, length, run_length, cmp_fp);
+
+        return 0;
+    }
+
+    /* without caller buffer small one from stack is used for short merges and rotations,
+       members bigger than it get buffer for one member from heap */
+    uint8_t stack_buffer[DARRAY_RAW_SSORT_STACK_BYTES];
+    uint8_t* heap_buffer_p = NULL;
+
+    if (scratch_p == NULL && size_of > sizeof(stack_buffer))
+    {
+        heap_buffer_p = malloc(size_of);
+
+        if (heap_buffer_p == NULL)
+        {
+            perror("DArrayRaw: malloc error, merges will use rotations only\n");
+        }
+    }
+
+    DArrayRawSSortS ctx = {
+        .barray_p = barray_p,
+        .size_of = size_of,
+        .cmp_fp = cmp_fp,
+        .scratch_p = scratch_p != NULL ? scratch_p : heap_buffer_p != NULL ? heap_buffer_p : &stack_buffer[0],
+        .scratch_length = scratch_p != NULL ? scratch_length : heap_buffer_p != NULL ? 1 : sizeof(stack_buffer) / size_of,
+        .min_gallop = DARRAY_RAW_SSORT_MIN_GALLOP,
+        .nruns = 0,
+    };
+
+    register const size_t min_run = __darray_raw_ssort_min_run(length);
+    register size_t base = 0;
+
+    while (base < length)
+    {
+        register const size_t rest = length - base;
+        register size_t run_length = __darray_raw_ssort_count_run(&barray_p[base * size_of], size_of, rest, cmp_fp);
+
+        if (run_length < min_run)
+        {
+            register const size_t forced_length = rest < min_run ? rest : min_run;
+
+            __darray_raw_ssort_binary_insertion(&barray_p[base * size_of], size_of, forced_length, run_length, cmp_fp);
+            run_length = forced_length;
+        }
+
+        ctx.run_base[ctx.nruns] = base;
+        ctx.run_length[ctx.nruns] = run_length;
+        ctx.nruns++;
+
+        __darray_raw_ssort_merge_collapse(&ctx, false);
+
+        base += run_length;
+    }
+
+    __darray_raw_ssort_merge_collapse(&ctx, true);
+
+    free(heap_buffer_p);
+
+    return 0;
+}
@@ -0,0 +1,621 @@
+#include <darray_raw/darray_raw.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#define DARRAY_RAW_STREE_X86 1
+#endif
+
+
+/*
+    Static B-tree (S+ tree) index over frozen sorted array of 4- or 8-byte integer keys.
+
+    1. Leaves  - sorted array itself is split into blocks of B keys (16 for 4-byte, 8 for 8-byte keys, one cache line),
+                 index stores only internal nodes, so it takes about 1 / B of array memory.
+    2. Nodes   - internal node is one cache line of B separators and has B + 1 children, separator i is the first key
+                 of child i + 1 (maximal value for missing children). Nodes are stored layer by layer from root, child c
+                 of node j is node j * (B + 1) + c of next layer, so there are no pointers.
+    3. Search  - in each node number of separators less than key (SIMD compare + movemask + popcount) is the child,
+                 in leaf block it is position in block. Leaves are contiguous, so result is lower bound rank in array.
+                 Unsigned keys are stored with flipped sign bit, so signed vector compare is used for all keys.
+                 AVX-512, AVX2 or scalar variant is chosen at run time.
+    4. Persist - index is one position-independent buffer with header, it can be saved to file and loaded back.
+*/
+
+
+/* magic number at the beginning of index: "DARSTREE" */
+#define DARRAY_RAW_STREE_MAGIC          ((uint64_t)0x4545525453524144ULL)
+
+/* version of index format */
+#define DARRAY_RAW_STREE_VERSION        ((uint32_t)1)
+
+/* size of node (cache line) */
+#define DARRAY_RAW_STREE_NODE           ((size_t)64)
+
+/* size of header, nodes start after it */
+#define DARRAY_RAW_STREE_HEADER         ((size_t)256)
+
+/* maximal number of internal layers (9^22 > 2^64 with one spare offset) */
+#define DARRAY_RAW_STREE_MAX_LAYERS     ((size_t)24)
+
+
+/* header of index */
+typedef struct DArrayRawSTreeS
+{
+    uint64_t magic;
+    uint32_t version;
+    uint32_t key_size;
+    uint32_t key_type;
+    uint32_t nlayers;
+    uint64_t length;
+    uint64_t bytes;
+    uint64_t layer_offsets[DARRAY_RAW_STREE_MAX_LAYERS];   /* index of first node of each layer, root layer first */
+} DArrayRawSTreeS;
+
+
+/*
+ * Internal function which compute layout of index (number of layers, offsets of layers and size in bytes).
+ *
+ * @param[in]  key_size - size of key (4 or 8).
+ * @param[in]  length   - number of elements in array.
+ * @param[out] tree_p   - header where nlayers, layer_offsets and bytes are written.
+ *
+ * @return: this is void function.
+ */
+static void __darray_raw_stree_layout(size_t key_size, size_t length, DArrayRawSTreeS* tree_p);
+
+
+/*
+ * Internal function which fill nodes of index from sorted array.
+ *
+ * @param[in] tree_p  - index with layout.
+ * @param[in] array_p - pointer to sorted array.
+ *
+ * @return: this is void function.
+ */
+static void __darray_raw_stree_fill(DArrayRawSTreeS* tree_p, const void* array_p);
+
+
+/*
+ * Internal function which check header of index.
+ *
+ * @param[in] tree_p - index.
+ * @param[in] bytes  - size of buffer with index.
+ *
+ * @return: 0 when header is valid, -1 otherwise.
+ */
+static int __darray_raw_stree_validate(const DArrayRawSTreeS* tree_p, size_t bytes);
+
+
+/*
+ * Functionlike macro which define lower bound search in index:
+ * size_t name(const DArrayRawSTreeS* tree_p, const type* array_p, type key, type flip).
+ * @key has to be already transformed (@flip is sign bit for unsigned keys, 0 for signed keys).
+ *
+ * @param[in] name     - name of generated function.
+ * @param[in] type     - signed type of key.
+ * @param[in] block    - number of keys in node.
+ * @param[in] count_fn - function size_t count_fn(const type* keys_p, type key, type flip) which count keys_p[i] ^ flip < key
+ *                       for @block keys.
+ * @param[in] attr     - function attributes (target instruction set).
+ *
+ * @return nothing.
+ */
+#define DARRAY_RAW_DEFINE_STREE_SEARCH(name, type, block, count_fn, attr) \
+    attr static size_t name(const DArrayRawSTreeS* const tree_p, const type* const array_p, const type key, const type flip) \
+    { \
+        register const type* const nodes_p = (const type*)((const uint8_t*)tree_p + DARRAY_RAW_STREE_HEADER); \
+        register const size_t length = (size_t)tree_p->length; \
+        register const size_t nlayers = tree_p->nlayers; \
+        register size_t j = 0; \
+        \
+        for (size_t layer = 0; layer < nlayers; ++layer) \
+        { \
+            j = j * ((block) + 1) + count_fn(&nodes_p[((size_t)tree_p->layer_offsets[layer] + j) * (block)], key, 0); \
+        } \
+        \
+        register const size_t first = j * (block); \
+        register size_t count = 0; \
+        \
+        if (first + (block) <= length) \
+        { \
+            count = count_fn(&array_p[first], key, flip); \
+        } \
+        else \
+        { \
+            for (size_t i = first; i < length; ++i) \
+            { \
+                count += (size_t)((type)(array_p[i] ^ flip) < key); \
+            } \
+        } \
+        \
+        return first + count; \
+    }
+
+
+/*
+ * Internal function which count keys (with flipped bits @flip) less than @key in block of 16 keys, scalar version.
+ *
+ * @param[in] keys_p - pointer to keys.
+ * @param[in] key    - searched key.
+ * @param[in] flip   - bits flipped in keys before compare.
+ *
+ * @return: number of keys less than @key.
+ */
+static inline size_t __darray_raw_stree_count32_scalar(const int32_t* keys_p, int32_t key, int32_t flip);
+
+
+/*
+ * Internal function which count keys (with flipped bits @flip) less than @key in block of 8 keys, scalar version.
+ *
+ * @param[in] keys_p - pointer to keys.
+ * @param[in] key    - searched key.
+ * @param[in] flip   - bits flipped in keys before compare.
+ *
+ * @return: number of keys less than @key.
+ */
+static inline size_t __darray_raw_stree_count64_scalar(const int64_t* keys_p, int64_t key, int64_t flip);
+
+
+#ifdef DARRAY_RAW_STREE_X86
+
+/*
+ * Internal function which count keys less than @key in block of 16 keys using AVX-512.
+ *
+ * @param[in] keys_p - pointer to keys.
+ * @param[in] key    - searched key.
+ * @param[in] flip   - bits flipped in keys before compare.
+ *
+ * @return: number of keys less than @key.
+ */
+static inline size_t __darray_raw_stree_count32_avx512(const int32_t* keys_p, int32_t key, int32_t flip) __attribute__((target("avx512f,popcnt")));
+
+
+/*
+ * Internal function which count keys less than @key in block of 16 keys using AVX2.
+ *
+ * @param[in] keys_p - pointer to keys.
+ * @param[in] key    - searched key.
+ * @param[in] flip   - bits flipped in keys before compare.
+ *
+ * @return: number of keys less than @key.
+ */
+static inline size_t __darray_raw_stree_count32_avx2(const int32_t* keys_p, int32_t key, int32_t flip) __attribute__((target("avx2,popcnt")));
+
+
+/*
+ * Internal function which count keys less than @key in block of 8 keys using AVX-512.
+ *
+ * @param[in] keys_p - pointer to keys.
+ * @param[in] key    - searched key.
+ * @param[in] flip   - bits flipped in keys before compare.
+ *
+ * @return: number of keys less than @key.
+ */
+static inline size_t __darray_raw_stree_count64_avx512(const int64_t* keys_p, int64_t key, int64_t flip) __attribute__((target("avx512f,popcnt")));
+
+
+/*
+ * Internal function which count keys less than @key in block of 8 keys using AVX2.
+ *
+ * @param[in] keys_p - pointer to keys.
+ * @param[in] key    - searched key.
+ * @param[in] flip   - bits flipped in keys before compare.
+ *
+ * @return: number of keys less than @key.
+ */
+static inline size_t __darray_raw_stree_count64_avx2(const int64_t* keys_p, int64_t key, int64_t flip) __attribute__((target("avx2,popcnt")));
+
+
+static inline size_t __darray_raw_stree_count32_avx512(const int32_t* const keys_p, const int32_t key, const int32_t flip)
+{
+    register const __m512i keys = _mm512_xor_si512(_mm512_loadu_si512(keys_p), _mm512_set1_epi32(flip));
+
+    return (size_t)__builtin_popcount(_mm512_cmplt_epi32_mask(keys, _mm512_set1_epi32(key)));
+}
+
+
+static inline size_t __darray_raw_stree_count32_avx2(const int32_t* const keys_p, const int32_t key, const int32_t flip)
+{
+    register const __m256i vkey = _mm256_set1_epi32(key);
+    register const __m256i vflip = _mm256_set1_epi32(flip);
+    register const __m256i low = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)&keys_p[0]), vflip);
+    register const __m256i high = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)&keys_p[8]), vflip);
+
+    register const unsigned mask = (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(vkey, low))) |
+                                   (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(vkey, high))) << 8;
+
+    return (size_t)__builtin_popcount(mask);
+}
+
+
+static inline size_t __darray_raw_stree_count64_avx512(const int64_t* const keys_p, const int64_t key, const int64_t flip)
+{
+    register const __m512i keys = _mm512_xor_si512(_mm512_loadu_si512(keys_p), _mm512_set1_epi64(flip));
+
+    return (size_t)__builtin_popcount(_mm512_cmplt_epi64_mask(keys, _mm512_set1_epi64(key)));
+}
+
+
+static inline size_t __darray_raw_stree_count64_avx2(const int64_t* const keys_p, const int64_t key, const int64_t flip)
+{
+    register const __m256i vkey = _mm256_set1_epi64x(key);
+    register const __m256i vflip = _mm256_set1_epi64x(flip);
+    register const __m256i low = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)&keys_p[0]), vflip);
+    register const __m256i high = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)&keys_p[4]), vflip);
+
+    register const unsigned mask = (unsigned)_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(vkey, low))) |
+                                   (unsigned)_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(vkey, high))) << 4;
+
+    return (size_t)__builtin_popcount(mask);
+}
+
+
+DARRAY_RAW_DEFINE_STREE_SEARCH(__darray_raw_stree_search32_avx512, int32_t, 16, __darray_raw_stree_count32_avx512, __attribute__((target("avx512f,popcnt"))))
+DARRAY_RAW_DEFINE_STREE_SEARCH(__darray_raw_stree_search32_avx2, int32_t, 16, __darray_raw_stree_count32_avx2, __attribute__((target("avx2,popcnt"))))
+DARRAY_RAW_DEFINE_STREE_SEARCH(__darray_raw_stree_search64_avx512, int64_t, 8, __darray_raw_stree_count64_avx512, __attribute__((target("avx512f,popcnt"))))
+DARRAY_RAW_DEFINE_STREE_SEARCH(__darray_raw_stree_search64_avx2, int64_t, 8, __darray_raw_stree_count64_avx2, __attribute__((target("avx2,popcnt"))))
+
+#endif /* DARRAY_RAW_STREE_X86 */
+
+
+static inline size_t __darray_raw_stree_count32_scalar(const int32_t* const keys_p, const int32_t key, const int32_t flip)
+{
+    register size_t count = 0;
+
+    for (size_t i = 0; i < 16; ++i)
+    {
+        count += (size_t)((int32_t)(keys_p[i] ^ flip) < key);
+    }
+
+    return count;
+}
+
+
+static inline size_t __darray_raw_stree_count64_scalar(const int64_t* const keys_p, const int64_t key, const int64_t flip)
+{
+    register size_t count = 0;
+
+    for (size_t i = 0; i < 8; ++i)
+    {
+        count += (size_t)((int64_t)(keys_p[i] ^ flip) < key);
+    }
+
+    return count;
+}
+
+
+DARRAY_RAW_DEFINE_STREE_SEARCH(__darray_raw_stree_search32_scalar, int32_t, 16, __darray_raw_stree_count32_scalar, )
+DARRAY_RAW_DEFINE_STREE_SEARCH(__darray_raw_stree_search64_scalar, int64_t, 8, __darray_raw_stree_count64_scalar, )
+
+
+static void __darray_raw_stree_layout(const size_t key_size, const size_t length, DArrayRawSTreeS* const tree_p)
+{
+    register const size_t block = DARRAY_RAW_STREE_NODE / key_size;
+    size_t sizes[DARRAY_RAW_STREE_MAX_LAYERS];
+    register size_t nlayers = 0;
+
+    /* layer sizes from bottom, number of leaf blocks is divided by fan-out until one root remains */
+    for (size_t size = (length + block - 1) / block; size > 1; )
+    {
+        size = (size + block) / (block + 1);
+        sizes[nlayers++] = size;
+    }
+
+    register size_t offset = 0;
+
+    for (size_t layer = 0; layer < nlayers; ++layer)
+    {
+        tree_p->layer_offsets[layer] = offset;
+        offset += sizes[nlayers - 1 - layer];
+    }
+
+    for (size_t layer = nlayers; layer < DARRAY_RAW_STREE_MAX_LAYERS; ++layer)
+    {
+        tree_p->layer_offsets[layer] = offset;
+    }
+
+    tree_p->nlayers = (uint32_t)nlayers;
+    tree_p->bytes = DARRAY_RAW_STREE_HEADER + offset * DARRAY_RAW_STREE_NODE;
+}
+
+
+static void __darray_raw_stree_fill(DArrayRawSTreeS* const tree_p, const void* const array_p)
+{
+    register const size_t key_size = tree_p->key_size;
+    register const size_t block = DARRAY_RAW_STREE_NODE / key_size;
+    register const size_t length = (size_t)tree_p->length;
+    register const size_t nlayers = tree_p->nlayers;
+    register const size_t nblocks = (length + block - 1) / block;
+    register uint8_t* const nodes_p = (uint8_t*)tree_p + DARRAY_RAW_STREE_HEADER;
+
+    register const bool is_unsigned = tree_p->key_type == DARRAY_RAW_KEY_UNSIGNED;
+
+    /* leaf blocks under one child of node of layer, from bottom layer (1 block per child) */
+    register size_t span = 1;
+
+    for (size_t height = 1; height <= nlayers; ++height)
+    {
+        register const size_t layer = nlayers - height;
+        register const size_t nnodes = (size_t)(tree_p->layer_offsets[layer + 1] - tree_p->layer_offsets[layer]);
+        register const size_t nchildren = height == 1 ? nblocks : (size_t)(tree_p->layer_offsets[layer + 2] - tree_p->layer_offsets[layer + 1]);
+
+        for (size_t j = 0; j < nnodes; ++j)
+        {
+            register uint8_t* const node_p = &nodes_p[((size_t)tree_p->layer_offsets[layer] + j) * DARRAY_RAW_STREE_NODE];
+
+            for (size_t c = 0; c < block; ++c)
+            {
+                register const size_t child = j * (block + 1) + c + 1;
+
+                /* first key of child is first key of its leftmost leaf block, missing child has maximal key */
+                register const size_t first = child * span * block;
+
+                if (key_size == sizeof(uint32_t))
+                {
+                    register const uint32_t key = child < nchildren ? ((const uint32_t*)array_p)[first] ^ (is_unsigned ? (uint32_t)1 << 31 : 0) : (uint32_t)INT32_MAX;
+                    ((int32_t*)node_p)[c] = (int32_t)key;
+                }
+                else
+                {
+                    register const uint64_t key = child < nchildren ? ((const uint64_t*)array_p)[first] ^ (is_unsigned ? (uint64_t)1 << 63 : 0) : (uint64_t)INT64_MAX;
+                    ((int64_t*)node_p)[c] = (int64_t)key;
+                }
+            }
+        }
+
+        span *= block + 1;
+    }
+}
+
+
+static int __darray_raw_stree_validate(const DArrayRawSTreeS* const tree_p, const size_t bytes)
+{
+    if (bytes < DARRAY_RAW_STREE_HEADER || tree_p->magic != DARRAY_RAW_STREE_MAGIC || tree_p->version != DARRAY_RAW_STREE_VERSION)
+    {
+        return -1;
+    }
+
+    if ((tree_p->key_size != sizeof(uint32_t) && tree_p->key_size != sizeof(uint64_t)) ||
+        (tree_p->key_type != DARRAY_RAW_KEY_UNSIGNED && tree_p->key_type != DARRAY_RAW_KEY_SIGNED) || tree_p->length == 0)
+    {
+        return -1;
+    }
+
+    DArrayRawSTreeS layout;
+    __darray_raw_stree_layout(tree_p->key_size, (size_t)tree_p->length, &layout);
+
+    if (layout.bytes != tree_p->bytes || layout.bytes != bytes || layout.nlayers != tree_p->nlayers ||
+        memcmp(layout.layer_offsets, tree_p->layer_offsets, sizeof(layout.layer_offsets)) != 0)
+    {
+        return -1;
+    }
+
+    return 0;
+}
+
+
+void* darray_raw_stree_create(const void* const array_p, const size_t size_of, const size_t length, const darray_raw_key_type_e key_type)
+{
+    if (array_p == NULL)
+    {
+        perror("DArrayRaw: argument array_p is NULL\n");
+        return NULL;
+    }
+
+    if (size_of != sizeof(uint32_t) && size_of != sizeof(uint64_t))
+    {
+        perror("DArrayRaw: argument size_of has to be 4 or 8\n");
+        return NULL;
+    }
+
+    if (length == 0)
+    {
+        perror("DArrayRaw: argument length has to small value\n");
+        return NULL;
+    }
+
+    if (key_type != DARRAY_RAW_KEY_UNSIGNED && key_type != DARRAY_RAW_KEY_SIGNED)
+    {
+        perror("DArrayRaw: argument key_type has to be unsigned or signed\n");
+        return NULL;
+    }
+
+    DArrayRawSTreeS layout;
+    __darray_raw_stree_layout(size_of, length, &layout);
+
+    DArrayRawSTreeS* const tree_p = aligned_alloc(DARRAY_RAW_STREE_NODE, (size_t)layout.bytes);
+
+    if (tree_p == NULL)
+    {
+        perror("DArrayRaw: aligned_alloc error\n");
+        return NULL;
+    }
+
+    (void)memset(tree_p, 0, DARRAY_RAW_STREE_HEADER);
+
+    tree_p->magic = DARRAY_RAW_STREE_MAGIC;
+    tree_p->version = DARRAY_RAW_STREE_VERSION;
+    tree_p->key_size = (uint32_t)size_of;
+    tree_p->key_type = (uint32_t)key_type;
+    tree_p->length = length;
+    tree_p->nlayers = layout.nlayers;
+    tree_p->bytes = layout.bytes;
+    (void)memcpy(tree_p->layer_offsets, layout.layer_offsets, sizeof(layout.layer_offsets));
+
+    __darray_raw_stree_fill(tree_p, array_p);
+
+    return tree_p;
+}
+
+
+size_t darray_raw_stree_size(const void* const stree_p)
+{
+    if (stree_p == NULL)
+    {
+        perror("DArrayRaw: argument stree_p is NULL\n");
+        return 0;
+    }
+
+    return (size_t)((const DArrayRawSTreeS*)stree_p)->bytes;
+}
+
+
+ssize_t darray_raw_stree_lower_bound(const void* const restrict stree_p, const void* const restrict array_p, const void* const restrict key_p)
+{
+    if (stree_p == NULL)
+    {
+        perror("DArrayRaw: argument stree_p is NULL\n");
+        return -1;
+    }
+
+    if (array_p == NULL)
+    {
+        perror("DArrayRaw: argument array_p is NULL\n");
+        return -1;
+    }
+
+    if (key_p == NULL)
+    {
+        perror("DArrayRaw: argument key_p is NULL\n");
+        return -1;
+    }
+
+    register const DArrayRawSTreeS* const tree_p = stree_p;
+
+    if (tree_p->key_size == sizeof(uint32_t))
+    {
+        int32_t key;
+        (void)memcpy(&key, key_p, sizeof(key));
+        register const int32_t flip = tree_p->key_type == DARRAY_RAW_KEY_UNSIGNED ? INT32_MIN : 0;
+        key ^= flip;
+
+#ifdef DARRAY_RAW_STREE_X86
+        if (__builtin_cpu_supports("avx512f"))
+        {
+            return (ssize_t)__darray_raw_stree_search32_avx512(tree_p, array_p, key, flip);
+        }
+
+        if (__builtin_cpu_supports("avx2"))
+        {
+            return (ssize_t)__darray_raw_stree_search32_avx2(tree_p, array_p, key, flip);
+        }
+#endif
+
+        return (ssize_t)__darray_raw_stree_search32_scalar(tree_p, array_p, key, flip);
+    }
+
+    int64_t key;
+    (void)memcpy(&key, key_p, sizeof(key));
+    register const int64_t flip = tree_p->key_type == DARRAY_RAW_KEY_UNSIGNED ? INT64_MIN : 0;
+    key ^= flip;
+
+#ifdef DARRAY_RAW_STREE_X86
+    if (__builtin_cpu_supports("avx512f"))
+    {
+        return (ssize_t)__darray_raw_stree_search64_avx512(tree_p, array_p, key, flip);
+    }
+
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return (ssize_t)__darray_raw_stree_search64_avx2(tree_p, array_p, key, flip);
+    }
+#endif
+
+    return (ssize_t)__darray_raw_stree_search64_scalar(tree_p, array_p, key, flip);
+}
+
+
+int darray_raw_stree_save(const void* const stree_p, const char* const path)
+{
+    if (stree_p == NULL)
+    {
+        perror("DArrayRaw: argument stree_p is NULL\n");
+        return -1;
+    }
+
+    if (path == NULL)
+    {
+        perror("DArrayRaw: argument path is NULL\n");
+        return -1;
+    }
+
+    register const size_t bytes = darray_raw_stree_size(stree_p);
+
+    FILE* const file_p = fopen(path, "wb");
+
+    if (file_p == NULL)
+    {
+        perror("DArrayRaw: fopen error\n");
+        return -1;
+    }
+
+    register const size_t written = fwrite(stree_p, 1, bytes, file_p);
+
+    if (fclose(file_p) != 0 || written != bytes)
+    {
+        perror("DArrayRaw: fwrite error\n");
+        return -1;
+    }
+
+    return 0;
+}
+
+
+void* darray_raw_stree_load(const char* const path)
+{
+    if (path == NULL)
+    {
+        perror("DArrayRaw: argument path is NULL\n");
+        return NULL;
+    }
+
+    FILE* const file_p = fopen(path, "rb");
+
+    if (file_p == NULL)
+    {
+        perror("DArrayRaw: fopen error\n");
+        return NULL;
+    }
+
+    DArrayRawSTreeS header;
+
+    if (fread(&header, 1, sizeof(header), file_p) != sizeof(header) || fseek(file_p, 0, SEEK_END) != 0)
+    {
+        perror("DArrayRaw: fread error\n");
+        (void)fclose(file_p);
+        return NULL;
+    }
+
+    register const long file_size = ftell(file_p);
+
+    if (file_size < 0 || __darray_raw_stree_validate(&header, (size_t)file_size) != 0)
+    {
+        perror("DArrayRaw: file is not valid index\n");
+        (void)fclose(file_p);
+        return NULL;
+    }
+
+    void* const stree_p = aligned_alloc(DARRAY_RAW_STREE_NODE, (size_t)file_size);
+
+    if (stree_p == NULL)
+    {
+        perror("DArrayRaw: aligned_alloc error\n");
+        (void)fclose(file_p);
+        return NULL;
+    }
+
+    if (fseek(file_p, 0, SEEK_SET) != 0 || fread(stree_p, 1, (size_t)file_size, file_p) != (size_t)file_size)
+    {
+        perror("DArrayRaw: fread error\n");
+        free(stree_p);
+        (void)fclose(file_p);
+        return NULL;
+    }
+
+    (void)fclose(file_p);
+
+    return stree_p;
+}
@@ -0,0 +1,451 @@
+#include <darray_raw/darray_raw.h>
+#include <stdio.h>
+#include <string.h>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#define DARRAY_RAW_UNIQUE_X86 1
+#endif
+
+
+/*
+    Removal of consecutive duplicates (unique) in a single forward pass.
+
+    1. Generic - element is compared with last kept element and copied to the end of kept prefix when different.
+                 Variant with counts adds one to count of last kept element for each dropped duplicate.
+    2. Keys    - for 4- and 8-byte keys compared bitwise, vector of elements is compared with the same vector
+                 shifted by one element (last element of previous vector is carried in register),
+                 so memory overwritten by compaction is never read again.
+                 AVX-512: kept elements are written by compress-store (VPCOMPRESSD/Q).
+                 AVX2:    kept elements are packed by permutation from table indexed by mask and whole vector is stored,
+                          lanes after kept ones land on positions which are already read.
+                 Other:   branchless scalar loop.
+                 Instruction set is chosen at run time.
+
+    Slots after new length are zeroed, like after delete functions.
+*/
+
+
+#ifdef DARRAY_RAW_UNIQUE_X86
+
+/* AVX2 permutation for each 8-bit mask of kept 32-bit lanes: kept lanes first */
+static int32_t darray_raw_unique_perm32[256][8];
+
+/* AVX2 permutation (in 32-bit lanes) for each 4-bit mask of kept 64-bit lanes */
+static int32_t darray_raw_unique_perm64[16][8];
+
+
+/*
+ * Internal function which fill permutation tables. It is called once at program load time.
+ *
+ * @return: this is void function.
+ */
+static void __darray_raw_unique_init_tables(void) __attribute__((constructor));
+
+
+/*
+ * Internal function which remove consecutive duplicates from @array_p using AVX-512.
+ *
+ * @param[in] array_p - pointer to array.
+ * @param[in] length  - number of elements in array (at least 1).
+ *
+ * @return: new length.
+ */
+static size_t __darray_raw_unique_u32_avx512(uint32_t* array_p, size_t length) __attribute__((target("avx512f")));
+
+
+/*
+ * Internal function which remove consecutive duplicates from @array_p using AVX2.
+ *
+ * @param[in] array_p - pointer to array.
+ * @param[in] length  - number of elements in array (at least 1).
+ *
+ * @return: new length.
+ */
+static size_t __darray_raw_unique_u32_avx2(uint32_t* array_p, size_t length) __attribute__((target("avx2")));
+
+
+/*
+ * Internal function which remove consecutive duplicates from @array_p using AVX-512.
+ *
+ * @param[in] array_p - pointer to array.
+ * @param[in] length  - number of elements in array (at least 1).
+ *
+ * @return: new length.
+ */
+static size_t __darray_raw_unique_u64_avx512(uint64_t* array_p, size_t length) __attribute__((target("avx512f")));
+
+
+/*
+ * Internal function which remove consecutive duplicates from @array_p using AVX2.
+ *
+ * @param[in] array_p - pointer to array.
+ * @param[in] length  - number of elements in array (at least 1).
+ *
+ * @return: new length.
+ */
+static size_t __darray_raw_unique_u64_avx2(uint64_t* array_p, size_t length) __attribute__((target("avx2")));
+
+#endif /* DARRAY_RAW_UNIQUE_X86 */
+
+
+/*
+ * Internal function which remove consecutive duplicates from elements [@pos, @length) of @array_p by scalar loop.
+ *
+ * @param[in] array_p - pointer to array.
+ * @param[in] length  - number of elements in array.
+ * @param[in] pos     - first element to check.
+ * @param[in] out     - number of already kept elements.
+ * @param[in] last    - value of element before @pos.
+ *
+ * @return: new length.
+ */
+static inline size_t __darray_raw_unique_u32_scalar(uint32_t* array_p, size_t length, size_t pos, size_t out, uint32_t last);
+
+
+/*
+ * Internal function which remove consecutive duplicates from elements [@pos, @length) of @array_p by scalar loop.
+ *
+ * @param[in] array_p - pointer to array.
+ * @param[in] length  - number of elements in array.
+ * @param[in] pos     - first element to check.
+ * @param[in] out     - number of already kept elements.
+ * @param[in] last    - value of element before @pos.
+ *
+ * @return: new length.
+ */
+static inline size_t __darray_raw_unique_u64_scalar(uint64_t* array_p, size_t length, size_t pos, size_t out, uint64_t last);
+
+
+/*
+ * Internal function which check arguments of unique functions.
+ *
+ * @param[in] array_p - pointer to array.
+ * @param[in] size_of - size of each array member.
+ * @param[in] length  - number of elements in array.
+ *
+ * @return: 0 if arguments are valid, -1 if not.
+ */
+static int __darray_raw_unique_check(const void* array_p, size_t size_of, size_t length);
+
+
+static inline size_t __darray_raw_unique_u32_scalar(uint32_t* const array_p, const size_t length, size_t pos, size_t out, uint32_t last)
+{
+    for (; pos < length; ++pos)
+    {
+        register const uint32_t val = array_p[pos];
+
+        /* always written, kept only when different */
+        array_p[out] = val;
+        out += val != last;
+        last = val;
+    }
+
+    return out;
+}
+
+
+static inline size_t __darray_raw_unique_u64_scalar(uint64_t* const array_p, const size_t length, size_t pos, size_t out, uint64_t last)
+{
+    for (; pos < length; ++pos)
+    {
+        register const uint64_t val = array_p[pos];
+
+        array_p[out] = val;
+        out += val != last;
+        last = val;
+    }
+
+    return out;
+}
+
+
+#ifdef DARRAY_RAW_UNIQUE_X86
+
+static void __darray_raw_unique_init_tables(void)
+{
+    for (size_t mask = 0; mask < array_size(darray_raw_unique_perm32); ++mask)
+    {
+        register size_t n = 0;
+
+        for (size_t lane = 0; lane < 8; ++lane)
+        {
+            if ((mask >> lane) & 1)
+            {
+                darray_raw_unique_perm32[mask][n++] = (int32_t)lane;
+            }
+        }
+
+        for (; n < 8; ++n)
+        {
+            darray_raw_unique_perm32[mask][n] = 7;
+        }
+    }
+
+    for (size_t mask = 0; mask < array_size(darray_raw_unique_perm64); ++mask)
+    {
+        register size_t n = 0;
+
+        for (size_t lane = 0; lane < 4; ++lane)
+        {
+            if ((mask >> lane) & 1)
+            {
+                darray_raw_unique_perm64[mask][n++] = (int32_t)(2 * lane);
+                darray_raw_unique_perm64[mask][n++] = (int32_t)(2 * lane + 1);
+            }
+        }
+
+        for (; n < 8; n += 2)
+        {
+            darray_raw_unique_perm64[mask][n] = 6;
+            darray_raw_unique_perm64[mask][n + 1] = 7;
+        }
+    }
+}
+
+
+static size_t __darray_raw_unique_u32_avx512(uint32_t* const array_p, const size_t length)
+{
+    register size_t out = 1;
+    register size_t pos = 1;
+    __m512i prev = _mm512_set1_epi32((int)array_p[0]);
+
+    for (; pos + 16 <= length; pos += 16)
+    {
+        const __m512i cur = _mm512_loadu_si512(&array_p[pos]);
+
+        /* [prev[15], cur[0], ..., cur[14]] */
+        const __m512i shifted = _mm512_maskz_alignr_epi32(0xFFFF, cur, prev, 15);
+        const __mmask16 keep = _mm512_cmpneq_epi32_mask(cur, shifted);
+
+        _mm512_mask_compressstoreu_epi32(&array_p[out], keep, cur);
+        out += (size_t)__builtin_popcount(keep);
+        prev = cur;
+    }
+
+    /* compress-store writes only kept elements, so element before @pos still has its value */
+    return __darray_raw_unique_u32_scalar(array_p, length, pos, out, array_p[pos - 1]);
+}
+
+
+static size_t __darray_raw_unique_u32_avx2(uint32_t* const array_p, const size_t length)
+{
+    register size_t out = 1;
+    register size_t pos = 1;
+    register uint32_t last = array_p[0];
+
+    const __m256i rotate = _mm256_setr_epi32(7, 0, 1, 2, 3, 4, 5, 6);
+
+    for (; pos + 8 <= length; pos += 8)
+    {
+        const __m256i cur = _mm256_loadu_si256((const __m256i*)&array_p[pos]);
+
+        /* [last, cur[0], ..., cur[6]] */
+        const __m256i shifted = _mm256_blend_epi32(_mm256_permutevar8x32_epi32(cur, rotate), _mm256_set1_epi32((int)last), 0x01);
+        const __m256i equal = _mm256_cmpeq_epi32(cur, shifted);
+        register const unsigned keep = ~(unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(equal)) & 0xFFu;
+
+        const __m256i perm = _mm256_loadu_si256((const __m256i*)&darray_raw_unique_perm32[keep][0]);
+        _mm256_storeu_si256((__m256i*)&array_p[out], _mm256_permutevar8x32_epi32(cur, perm));
+
+        out += (size_t)__builtin_popcount(keep);
+        last = (uint32_t)_mm256_extract_epi32(cur, 7);
+    }
+
+    return __darray_raw_unique_u32_scalar(array_p, length, pos, out, last);
+}
+
+
+static size_t __darray_raw_unique_u64_avx512(uint64_t* const array_p, const size_t length)
+{
+    register size_t out = 1;
+    register size_t pos = 1;
+    __m512i prev = _mm512_set1_epi64((long long)array_p[0]);
+
+    for (; pos + 8 <= length; pos += 8)
+    {
+        const __m512i cur = _mm512_loadu_si512(&array_p[pos]);
+
+        /* [prev[7], cur[0], ..., cur[6]] */
+        const __m512i shifted = _mm512_maskz_alignr_epi64(0xFF, cur, prev, 7);
+        const __mmask8 keep = _mm512_cmpneq_epi64_mask(cur, shifted);
+
+        _mm512_mask_compressstoreu_epi64(&array_p[out], keep, cur);
+        out += (size_t)__builtin_popcount(keep);
+        prev = cur;
+    }
+
+    return __darray_raw_unique_u64_scalar(array_p, length, pos, out, array_p[pos - 1]);
+}
+
+
+static size_t __darray_raw_unique_u64_avx2(uint64_t* const array_p, const size_t length)
+{
+    register size_t out = 1;
+    register size_t pos = 1;
+    register uint64_t last = array_p[0];
+
+    for (; pos + 4 <= length; pos += 4)
+    {
+        const __m256i cur = _mm256_loadu_si256((const __m256i*)&array_p[pos]);
+
+        /* [last, cur[0], cur[1], cur[2]] */
+        const __m256i shifted = _mm256_blend_epi32(_mm256_permute4x64_epi64(cur, 0x90), _mm256_set1_epi64x((long long)last), 0x03);
+        const __m256i equal = _mm256_cmpeq_epi64(cur, shifted);
+        register const unsigned keep = ~(unsigned)_mm256_movemask_pd(_mm256_castsi256_pd(equal)) & 0xFu;
+
+        const __m256i perm = _mm256_loadu_si256((const __m256i*)&darray_raw_unique_perm64[keep][0]);
+        _mm256_storeu_si256((__m256i*)&array_p[out], _mm256_permutevar8x32_epi32(cur, perm));
+
+        out += (size_t)__builtin_popcount(keep);
+        last = (uint64_t)_mm256_extract_epi64(cur, 3);
+    }
+
+    return __darray_raw_unique_u64_scalar(array_p, length, pos, out, last);
+}
+
+#endif /* DARRAY_RAW_UNIQUE_X86 */
+
+
+static int __darray_raw_unique_check(const void* const array_p, const size_t size_of, const size_t length)
+{
+    if (array_p == NULL)
+    {
+        perror("DArrayRaw: argument array_p is NULL\n");
+        return -1;
+    }
+
+    if (size_of == 0)
+    {
+        perror("DArrayRaw: argument size_of has to small value\n");
+        return -1;
+    }
+
+    if (length == 0)
+    {
+        perror("DArrayRaw: argument length has to small value\n");
+        return -1;
+    }
+
+    return 0;
+}
+
+
+ssize_t darray_raw_unique(void* const array_p, const size_t size_of, const size_t length, const compare_fp cmp_fp)
+{
+    return darray_raw_unique_counts(array_p, size_of, length, cmp_fp, NULL);
+}
+
+
+ssize_t darray_raw_unique_counts(void* const array_p, const size_t size_of, const size_t length, const compare_fp cmp_fp, size_t* const counts_p)
+{
+    if (__darray_raw_unique_check(array_p, size_of, length) != 0)
+    {
+        return -1;
+    }
+
+    if (cmp_fp == NULL)
+    {
+        perror("DArrayRaw: argument cmp_fp is NULL\n");
+        return -1;
+    }
+
+    register uint8_t* const barray_p = array_p;
+    register size_t out = 1;
+
+    if (counts_p != NULL)
+    {
+        counts_p[0] = 1;
+    }
+
+    for (size_t pos = 1; pos < length; ++pos)
+    {
+        if (cmp_fp(&barray_p[(out - 1) * size_of], &barray_p[pos * size_of]) == 0)
+        {
+            if (counts_p != NULL)
+            {
+                counts_p[out - 1]++;
+            }
+
+            continue;
+        }
+
+        if (out != pos)
+        {
+            assign(&barray_p[out * size_of], &barray_p[pos * size_of], size_of);
+        }
+
+        if (counts_p != NULL)
+        {
+            counts_p[out] = 1;
+        }
+
+        out++;
+    }
+
+    memset(&barray_p[out * size_of], 0, (length - out) * size_of);
+
+    return (ssize_t)out;
+}
+
+
+ssize_t darray_raw_unique_bitwise(void* const array_p, const size_t size_of, const size_t length)
+{
+    if (__darray_raw_unique_check(array_p, size_of, length) != 0)
+    {
+        return -1;
+    }
+
+    register size_t out = 0;
+
+    switch (size_of)
+    {
+        case sizeof(uint32_t):
+        {
+#ifdef DARRAY_RAW_UNIQUE_X86
+            if (__builtin_cpu_supports("avx512f"))
+            {
+                out = __darray_raw_unique_u32_avx512(array_p, length);
+            }
+            else if (__builtin_cpu_supports("avx2"))
+            {
+                out = __darray_raw_unique_u32_avx2(array_p, length);
+            }
+            else
+#endif
+            {
+                out = __darray_raw_unique_u32_scalar(array_p, length, 1, 1, ((const uint32_t*)array_p)[0]);
+            }
+
+            break;
+        }
+        case sizeof(uint64_t):
+        {
+#ifdef DARRAY_RAW_UNIQUE_X86
+            if (__builtin_cpu_supports("avx512f"))
+            {
+                out = __darray_raw_unique_u64_avx512(array_p, length);
+            }
+            else if (__builtin_cpu_supports("avx2"))
+            {
+                out = __darray_raw_unique_u64_avx2(array_p, length);
+            }
+            else
+#endif
+            {
+                out = __darray_raw_unique_u64_scalar(array_p, length, 1, 1, ((const uint64_t*)array_p)[0]);
+            }
+
+            break;
+        }
+        default:
+        {
+            perror("DArrayRaw: argument size_of has to be 4 or 8\n");
+            return -1;
+        }
+    }
+
+    memset((uint8_t*)array_p + out * size_of, 0, (length - out) * size_of);
+
+    return (ssize_t)out;
+}
@@ -1,5 +1,6 @@
 #include <darray_raw/darray_raw.h>
 #include <assert.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -39,6 +40,42 @@ static int int_compare(const void* first_p, const void* second_p)
 }
 
 
+static size_t int_compare_calls;
+
+
+static int int_compare_counted(const void* first_p, const void* second_p)
+{
+    int_compare_calls++;
+
+    return int_compare(first_p, second_p);
+}
+
+
+static double int_number(const void* key_p)
+{
+    assert(key_p != NULL);
+
+    return (double)*(const int*)key_p;
+}
+
+
+static size_t int_compare_batch_calls;
+
+
+static void int_compare_batch(const void* first_p, const size_t first_stride, const void* second_p, const size_t second_stride, const size_t n, int8_t* out_p)
+{
+    register const uint8_t* const first_bp = first_p;
+    register const uint8_t* const second_bp = second_p;
+
+    int_compare_batch_calls++;
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        out_p[i] = (int8_t)int_compare(&first_bp[i * first_stride], &second_bp[i * second_stride]);
+    }
+}
+
+
 static MyStructS* mystruct_create(const size_t key, const size_t a, const size_t b, const size_t c)
 {
     MyStructS* mystruct_p = malloc(sizeof(*mystruct_p));
@@ -103,6 +140,10 @@ static int mystruct_pointers_compare(const void* first_p, const void* second_p)
 }
 
 
+DARRAY_RAW_DECLARE_SORT(mystruct_sort, MyStructS);
+DARRAY_RAW_DEFINE_SORT(mystruct_sort, MyStructS, a.key < b.key)
+
+
 static void test_darray_raw_create(void)
 {
     register const size_t size_of = sizeof(int);
@@ -1076,6 +1117,86 @@ static void test_darray_raw_delete_all_with_entries(void)
 }
 
 
+static void test_darray_raw_unique(void)
+{
+    register const size_t length = 1000;
+
+    int* array_p = darray_raw_create(sizeof(*array_p), length);
+    assert(array_p != NULL);
+
+    size_t* counts_p = darray_raw_create(sizeof(*counts_p), length);
+    assert(counts_p != NULL);
+
+    /* value i is repeated i % 4 + 1 times */
+    register size_t n = 0;
+
+    for (size_t val = 0; n < length; ++val)
+    {
+        for (size_t rep = 0; rep <= val % 4 && n < length; ++rep)
+        {
+            array_p[n++] = (int)val;
+        }
+    }
+
+    register const int last_val = array_p[length - 1];
+
+    register ssize_t ret = darray_raw_unique_counts(array_p, sizeof(*array_p), length, int_compare, counts_p);
+    assert(ret == last_val + 1);
+
+    for (size_t i = 0; i < (size_t)ret; ++i)
+    {
+        assert(array_p[i] == (int)i);
+    }
+
+    /* last value may be cut by array length */
+    for (size_t i = 0; i + 1 < (size_t)ret; ++i)
+    {
+        assert(counts_p[i] == i % 4 + 1);
+    }
+
+    for (size_t i = (size_t)ret; i < length; ++i)
+    {
+        assert(array_p[i] == 0);
+    }
+
+    ret = darray_raw_unique(array_p, sizeof(*array_p), (size_t)ret, int_compare);
+    assert(ret == last_val + 1);
+
+    /* bitwise version, 4- and 8-byte keys */
+    for (size_t i = 0; i < length; ++i)
+    {
+        array_p[i] = (int)(i / 3);
+    }
+
+    ret = darray_raw_unique_bitwise(array_p, sizeof(*array_p), length);
+    assert(ret == (ssize_t)((length + 2) / 3));
+
+    for (size_t i = 0; i < (size_t)ret; ++i)
+    {
+        assert(array_p[i] == (int)i);
+    }
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        counts_p[i] = i / 7;
+    }
+
+    ret = darray_raw_unique_bitwise(counts_p, sizeof(*counts_p), length);
+    assert(ret == (ssize_t)((length + 6) / 7));
+
+    for (size_t i = 0; i < (size_t)ret; ++i)
+    {
+        assert(counts_p[i] == i);
+    }
+
+    ret = darray_raw_unique_bitwise(array_p, 2, length);
+    assert(ret == -1);
+
+    darray_raw_destroy(counts_p);
+    darray_raw_destroy(array_p);
+}
+
+
 static void test_darray_raw_lower_bound(void)
 {
     const int array[] = {0, 1, 1, 2, 3, 5, 8, 13, 21, 34, 55, 89, 144};
@@ -1166,374 +1287,2401 @@ static void test_darray_raw_upper_bound(void)
 }
 
 
-static void test_darray_raw_find_min(void)
+static void test_darray_raw_bound_hint(void)
 {
-    const int array[] = {5, 4, 3, 2, 1, 0, -1, -1, 0, 1, 2, 3, 4, 5};
+    register const size_t length = 1000;
 
-    int out = -1;
-    register ssize_t min_index = -1;
-    
-    min_index = darray_raw_find_min(&array[0], sizeof(*array), array_size(array), int_compare, &out);
-    assert(min_index == 6);
-    assert(out == -1);
+    int* array_p = darray_raw_create(sizeof(*array_p), length);
+    assert(array_p != NULL);
 
-    min_index = -1;
-    min_index = darray_raw_find_min(&array[0], sizeof(*array), array_size(array), int_compare, NULL);
-    assert(min_index == 6);
-}
+    for (size_t i = 0; i < length; ++i)
+    {
+        array_p[i] = (int)(2 * (i / 3));
+    }
 
+    /* every hint for keys between and at members, also hint past the end */
+    for (size_t shifted = 0; shifted <= (size_t)array_p[length - 1] + 2; shifted += 7)
+    {
+        const int key = (int)shifted - 1;
 
-static void test_darray_raw_find_max(void)
-{
-    const int array[] = {5, 4, 3, 2, 1, 0, -1, -1, 0, 1, 2, 3, 4, 5};
+        for (size_t hint = 0; hint <= length + 1; ++hint)
+        {
+            assert(darray_raw_lower_bound_hint(array_p, sizeof(*array_p), length, &key, int_compare, hint) ==
+                   darray_raw_lower_bound(array_p, sizeof(*array_p), length, &key, int_compare));
+            assert(darray_raw_upper_bound_hint(array_p, sizeof(*array_p), length, &key, int_compare, hint) ==
+                   darray_raw_upper_bound(array_p, sizeof(*array_p), length, &key, int_compare));
+            assert(darray_raw_sorted_find_first_hint(array_p, sizeof(*array_p), length, &key, int_compare, hint, NULL) ==
+                   darray_raw_sorted_find_first(array_p, sizeof(*array_p), length, &key, int_compare, NULL));
+            assert(darray_raw_sorted_find_last_hint(array_p, sizeof(*array_p), length, &key, int_compare, hint, NULL) ==
+                   darray_raw_sorted_find_last(array_p, sizeof(*array_p), length, &key, int_compare, NULL));
+        }
+    }
 
-    int out = -1;
-    register ssize_t max_index = -1;
-    
-    max_index = darray_raw_find_max(&array[0], sizeof(*array), array_size(array), int_compare, &out);
-    assert(max_index == 0);
-    assert(out == 5);
+    /* cursor scan: each key is near previous result */
+    int_compare_calls = 0;
+    size_t hint = 0;
 
-    max_index = -1;
-    max_index = darray_raw_find_max(&array[0], sizeof(*array), array_size(array), int_compare, NULL);
-    assert(max_index == 0);
-}
+    for (size_t i = 0; i < length; ++i)
+    {
+        const int key = (int)i;
+        register const ssize_t idx = darray_raw_lower_bound_hint(array_p, sizeof(*array_p), length, &key, int_compare_counted, hint);
 
+        assert(idx == darray_raw_lower_bound(array_p, sizeof(*array_p), length, &key, int_compare));
+        hint = (size_t)idx;
+    }
 
-static void test_darray_raw_unsorted_find_first(void)
-{
-    const int array[] = {8, 6, 6, 3, 7, 7, 7, 2, 1, 1, 1, 1, 10, 3, 4, 9, 9, 5, 5, 5, 8};
+    /* binary search needs 10 comparisons per lookup */
+    assert(int_compare_calls < length * 5);
 
-    register const bool is_sorted = darray_raw_is_sorted(&array[0], sizeof(*array), array_size(array), int_compare);
-    assert(is_sorted == false);
+    /* near-sorted stream appended by insert with hint */
+    int_compare_calls = 0;
+    hint = 0;
 
-    int out = -1;
-    int search_key = -1;
-    register ssize_t first_index = -1;
+    for (size_t i = 0; i < length; ++i)
+    {
+        const int val = (int)(i + (i % 4 == 0 ? 3 : 0));
+        register const ssize_t pos = darray_raw_sorted_insert_hint(array_p, sizeof(*array_p), i + 1, &val, int_compare_counted, hint);
 
-    search_key = 0;
-    first_index = darray_raw_unsorted_find_first(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
-    assert(first_index == -1);
-    assert(out == -1);
+        assert(pos >= 0 && array_p[pos] == val);
+        hint = i + 1;
+    }
 
-    search_key = 1;
-    first_index = darray_raw_unsorted_find_first(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
-    assert(first_index == 8);
-    assert(out == search_key);
-    assert(out == array[first_index]);
+    assert(int_compare_calls < length * 5);
+    assert(darray_raw_is_sorted(array_p, sizeof(*array_p), length, int_compare));
 
-    search_key = 2;
-    first_index = darray_raw_unsorted_find_first(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
-    assert(first_index == 7);
-    assert(out == search_key);
-    assert(out == array[first_index]);
+    const int key = 5;
+    assert(darray_raw_lower_bound_hint(NULL, sizeof(*array_p), length, &key, int_compare, 0) == -1);
+    assert(darray_raw_sorted_insert_hint(array_p, sizeof(*array_p), 0, &key, int_compare, 0) == -1);
 
-    search_key = 3;
-    first_index = darray_raw_unsorted_find_first(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
-    assert(first_index == 3);
-    assert(out == search_key);
-    assert(out == array[first_index]);
+    darray_raw_destroy(array_p);
+}
 
-    search_key = 4;
-    first_index = darray_raw_unsorted_find_first(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
-    assert(first_index == 14);
-    assert(out == search_key);
-    assert(out == array[first_index]);
 
-    search_key = 5;
-    first_index = darray_raw_unsorted_find_first(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
-    assert(first_index == 17);
-    assert(out == search_key);
-    assert(out == array[first_index]);
+static void test_darray_raw_bound_typed(void)
+{
+    int32_t array[200];
+    double darray[200];
+    uint8_t barray[200];
 
-    search_key = 6;
-    first_index = darray_raw_unsorted_find_first(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
-    assert(first_index == 1);
-    assert(out == search_key);
-    assert(out == array[first_index]);
+    /* every length, values repeat, so bounds of runs and both ends are checked */
+    for (size_t length = 1; length <= array_size(array); ++length)
+    {
+        for (size_t i = 0; i < length; ++i)
+        {
+            array[i] = (int32_t)(2 * (i / 3)) - 10;
+            darray[i] = (double)array[i] / 4.0;
+            barray[i] = (uint8_t)(i / 3);
+        }
 
-    search_key = 7;
-    first_index = darray_raw_unsorted_find_first(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
-    assert(first_index == 4);
-    assert(out == search_key);
-    assert(out == array[first_index]);
+        for (size_t shifted = 0; shifted <= (size_t)(array[length - 1] + 12); ++shifted)
+        {
+            const int32_t key = (int32_t)shifted - 11;
+            const double dkey = (double)key / 4.0;
+
+            register size_t lower = 0;
+            register size_t upper = 0;
+
+            while (lower < length && array[lower] < key)
+            {
+                ++lower;
+            }
+
+            while (upper < length && array[upper] <= key)
+            {
+                ++upper;
+            }
+
+            assert(darray_raw_lower_bound_i32(array, length, key) == (ssize_t)lower);
+            assert(darray_raw_upper_bound_i32(array, length, key) == (ssize_t)upper);
+            assert(darray_raw_lower_bound_double(darray, length, dkey) == (ssize_t)lower);
+            assert(darray_raw_upper_bound_double(darray, length, dkey) == (ssize_t)upper);
+            assert(darray_raw_lower_bound(array, sizeof(*array), length, &key, int_compare) == (ssize_t)lower);
+            assert(darray_raw_upper_bound(array, sizeof(*array), length, &key, int_compare) == (ssize_t)upper);
+
+            int out = 0;
+            register const ssize_t first = darray_raw_sorted_find_first(array, sizeof(*array), length, &key, int_compare, &out);
+            register const ssize_t last = darray_raw_sorted_find_last(array, sizeof(*array), length, &key, int_compare, NULL);
+
+            assert(first == (lower < upper ? (ssize_t)lower : -1));
+            assert(last == (lower < upper ? (ssize_t)upper - 1 : -1));
+            assert(first == -1 || out == key);
+        }
 
-    search_key = 8;
-    first_index = darray_raw_unsorted_find_first(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
-    assert(first_index == 0);
-    assert(out == search_key);
-    assert(out == array[first_index]);
+        const uint8_t bkey = (uint8_t)(length / 6);
+        register size_t lower = 0;
 
-    search_key = 9;
-    first_index = darray_raw_unsorted_find_first(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
-    assert(first_index == 15);
-    assert(out == search_key);
-    assert(out == array[first_index]);
+        while (lower < length && barray[lower] < bkey)
+        {
+            ++lower;
+        }
 
-    search_key = 10;
-    first_index = darray_raw_unsorted_find_first(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, NULL);
-    assert(first_index == 12);
-    assert(array[first_index] == search_key);
+        assert(darray_raw_lower_bound_u8(barray, length, bkey) == (ssize_t)lower);
+    }
+
+    /* records use generic member size */
+    MyStructS records[100];
+
+    for (size_t i = 0; i < array_size(records); ++i)
+    {
+        records[i] = (MyStructS){ .key = 2 * i };
+    }
+
+    for (size_t key = 0; key <= 2 * array_size(records); ++key)
+    {
+        const MyStructS data = { .key = key };
+
+        assert(darray_raw_lower_bound(records, sizeof(*records), array_size(records), &data, mystruct_compare) == (ssize_t)((key + 1) / 2));
+        assert(darray_raw_upper_bound(records, sizeof(*records), array_size(records), &data, mystruct_compare) == (ssize_t)(key / 2 + 1 > array_size(records) ? array_size(records) : key / 2 + 1));
+    }
+
+    assert(darray_raw_lower_bound_i32(NULL, 1, 0) == -1);
+    assert(darray_raw_upper_bound_u64(NULL, 1, 0) == -1);
 }
 
 
-static void test_darray_raw_unsorted_find_last(void)
+static void test_darray_raw_bound_batch(void)
 {
-    const int array[] = {8, 6, 6, 3, 7, 7, 7, 2, 1, 1, 1, 1, 10, 3, 4, 9, 9, 5, 5, 5, 8};
+    register const size_t length = 10000;
+    register const size_t nkeys = 1000;
 
-    register const bool is_sorted = darray_raw_is_sorted(&array[0], sizeof(*array), array_size(array), int_compare);
-    assert(is_sorted == false);
+    int* array_p = darray_raw_create(sizeof(*array_p), length);
+    assert(array_p != NULL);
 
-    int out = -1;
-    int search_key = -1;
-    register ssize_t last_index = -1;
+    int* keys_p = darray_raw_create(sizeof(*keys_p), nkeys);
+    assert(keys_p != NULL);
 
-    search_key = 0;
-    last_index = darray_raw_unsorted_find_last(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
-    assert(last_index == -1);
-    assert(out == -1);
+    ssize_t* out_p = darray_raw_create(sizeof(*out_p), nkeys);
+    assert(out_p != NULL);
 
-    search_key = 1;
-    last_index = darray_raw_unsorted_find_last(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
-    assert(last_index == 11);
-    assert(out == search_key);
-    assert(out == array[last_index]);
+    for (size_t i = 0; i < length; ++i)
+    {
+        array_p[i] = (int)(2 * (i / 2));
+    }
 
-    search_key = 2;
-    last_index = darray_raw_unsorted_find_last(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
-    assert(last_index == 7);
-    assert(out == search_key);
-    assert(out == array[last_index]);
+    /* unsorted keys (one group is not full), then the same keys sorted */
+    for (size_t pass = 0; pass < 2; ++pass)
+    {
+        for (size_t i = 0; i < nkeys; ++i)
+        {
+            keys_p[i] = (int)((i * 7919) % (length + 10)) - 5;
+        }
 
-    search_key = 3;
-    last_index = darray_raw_unsorted_find_last(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
-    assert(last_index == 13);
-    assert(out == search_key);
-    assert(out == array[last_index]);
+        if (pass == 1)
+        {
+            darray_raw_sort(keys_p, sizeof(*keys_p), nkeys, int_compare);
+        }
 
-    search_key = 4;
-    last_index = darray_raw_unsorted_find_last(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
-    assert(last_index == 14);
-    assert(out == search_key);
-    assert(out == array[last_index]);
+        assert(darray_raw_lower_bound_batch(array_p, sizeof(*array_p), length, keys_p, nkeys - 3, int_compare, out_p) == 0);
 
-    search_key = 5;
-    last_index = darray_raw_unsorted_find_last(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
-    assert(last_index == 19);
-    assert(out == search_key);
-    assert(out == array[last_index]);
+        for (size_t i = 0; i < nkeys - 3; ++i)
+        {
+            assert(out_p[i] == darray_raw_lower_bound(array_p, sizeof(*array_p), length, &keys_p[i], int_compare));
+        }
 
-    search_key = 6;
-    last_index = darray_raw_unsorted_find_last(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
-    assert(last_index == 2);
-    assert(out == search_key);
-    assert(out == array[last_index]);
+        assert(darray_raw_upper_bound_batch(array_p, sizeof(*array_p), length, keys_p, nkeys, int_compare, out_p) == 0);
 
-    search_key = 7;
-    last_index = darray_raw_unsorted_find_last(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
-    assert(last_index == 6);
-    assert(out == search_key);
-    assert(out == array[last_index]);
+        for (size_t i = 0; i < nkeys; ++i)
+        {
+            assert(out_p[i] == darray_raw_upper_bound(array_p, sizeof(*array_p), length, &keys_p[i], int_compare));
+        }
 
-    search_key = 8;
-    last_index = darray_raw_unsorted_find_last(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
-    assert(last_index == 20);
-    assert(out == search_key);
-    assert(out == array[last_index]);
+        assert(darray_raw_sorted_find_first_batch(array_p, sizeof(*array_p), length, keys_p, nkeys, int_compare, out_p) == 0);
 
-    search_key = 9;
-    last_index = darray_raw_unsorted_find_last(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
-    assert(last_index == 16);
+        for (size_t i = 0; i < nkeys; ++i)
+        {
+            assert(out_p[i] == darray_raw_sorted_find_first(array_p, sizeof(*array_p), length, &keys_p[i], int_compare, NULL));
+        }
+    }
+
+    /* odd length and records */
+    MyStructS records[37];
+    MyStructS record_keys[5] = { { .key = 74 }, { .key = 0 }, { .key = 75 }, { .key = 3 }, { .key = 40 } };
+    const ssize_t expected[5] = { 37, 0, 37, 2, 20 };
+
+    for (size_t i = 0; i < array_size(records); ++i)
+    {
+        records[i] = (MyStructS){ .key = 2 * i };
+    }
+
+    assert(darray_raw_lower_bound_batch(records, sizeof(*records), array_size(records), record_keys, array_size(record_keys), mystruct_compare, out_p) == 0);
+
+    for (size_t i = 0; i < array_size(record_keys); ++i)
+    {
+        assert(out_p[i] == expected[i]);
+    }
+
+    assert(darray_raw_lower_bound_batch(array_p, sizeof(*array_p), length, keys_p, 0, int_compare, NULL) == 0);
+    assert(darray_raw_lower_bound_batch(array_p, sizeof(*array_p), length, keys_p, nkeys, NULL, out_p) == -1);
+
+    darray_raw_destroy(out_p);
+    darray_raw_destroy(keys_p);
+    darray_raw_destroy(array_p);
+}
+
+
+static void test_darray_raw_interpolation(void)
+{
+    register const size_t length = 100000;
+
+    int* array_p = darray_raw_create(sizeof(*array_p), length);
+    assert(array_p != NULL);
+
+    /* uniform keys with runs of equal keys, then skewed (cubic) keys */
+    for (size_t pass = 0; pass < 2; ++pass)
+    {
+        for (size_t i = 0; i < length; ++i)
+        {
+            array_p[i] = pass == 0 ? (int)(10 * (i / 2)) : (int)((i / 100) * (i / 100) * (i / 100));
+        }
+
+        register const size_t max_key = (size_t)array_p[length - 1];
+        int_compare_calls = 0;
+
+        for (size_t i = 0; i <= 1000; ++i)
+        {
+            const int key = (int)(i * (max_key / 1000) + i % 3) - 1;
+            int out = 0;
+
+            assert(darray_raw_interpolation_lower_bound(array_p, sizeof(*array_p), length, &key, int_compare_counted, int_number) ==
+                   darray_raw_lower_bound(array_p, sizeof(*array_p), length, &key, int_compare));
+            assert(darray_raw_interpolation_upper_bound(array_p, sizeof(*array_p), length, &key, int_compare_counted, int_number) ==
+                   darray_raw_upper_bound(array_p, sizeof(*array_p), length, &key, int_compare));
+            assert(darray_raw_interpolation_find_first(array_p, sizeof(*array_p), length, &key, int_compare_counted, int_number, &out) ==
+                   darray_raw_sorted_find_first(array_p, sizeof(*array_p), length, &key, int_compare, NULL));
+            assert(darray_raw_interpolation_find_last(array_p, sizeof(*array_p), length, &key, int_compare_counted, int_number, NULL) ==
+                   darray_raw_sorted_find_last(array_p, sizeof(*array_p), length, &key, int_compare, NULL));
+        }
+
+        /* binary search needs 17 comparisons per lookup, 4 lookups per key */
+        if (pass == 0)
+        {
+            assert(int_compare_calls < 1001 * 4 * 12);
+        }
+        else
+        {
+            assert(int_compare_calls < 1001 * 4 * 2 * 3 * 17);
+        }
+    }
+
+    const int key = 5;
+    assert(darray_raw_interpolation_lower_bound(array_p, sizeof(*array_p), 1, &key, int_compare, int_number) == 1);
+    assert(darray_raw_interpolation_lower_bound(array_p, sizeof(*array_p), length, &key, int_compare, NULL) == -1);
+
+    darray_raw_destroy(array_p);
+}
+
+
+static void test_darray_raw_eytzinger(void)
+{
+    /* every layout size up to few full levels, values repeat to check bounds of runs */
+    for (size_t length = 1; length <= 300; ++length)
+    {
+        int* array_p = darray_raw_create(sizeof(*array_p), length);
+        assert(array_p != NULL);
+
+        for (size_t i = 0; i < length; ++i)
+        {
+            array_p[i] = (int)(2 * (i / 3));
+        }
+
+        int* eytzinger_p = darray_raw_eytzinger_create(array_p, sizeof(*array_p), length);
+        assert(eytzinger_p != NULL);
+
+        for (size_t i = 0; i < length; ++i)
+        {
+            register const ssize_t node = darray_raw_eytzinger_node(length, i);
+            assert(node >= 1 && (size_t)node <= length);
+            assert(eytzinger_p[node] == array_p[i]);
+        }
+
+        /* values from -1 to maximum + 1 */
+        for (size_t shifted = 0; shifted <= (size_t)array_p[length - 1] + 2; ++shifted)
+        {
+            const int val = (int)shifted - 1;
+
+            assert(darray_raw_eytzinger_lower_bound(eytzinger_p, sizeof(*array_p), length, &val, int_compare) ==
+                   darray_raw_lower_bound(array_p, sizeof(*array_p), length, &val, int_compare));
+
+            assert(darray_raw_eytzinger_upper_bound(eytzinger_p, sizeof(*array_p), length, &val, int_compare) ==
+                   darray_raw_upper_bound(array_p, sizeof(*array_p), length, &val, int_compare));
+        }
+
+        darray_raw_destroy(eytzinger_p);
+        darray_raw_destroy(array_p);
+    }
+
+    /* big records */
+    register const size_t length = 1000;
+
+    MyStructS* array_p = darray_raw_create(sizeof(*array_p), length);
+    assert(array_p != NULL);
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        array_p[i] = (MyStructS){ .key = 3 * i, .a = i, .b = i, .c = i };
+    }
+
+    MyStructS* eytzinger_p = darray_raw_eytzinger_create(array_p, sizeof(*array_p), length);
+    assert(eytzinger_p != NULL);
+    assert(((uintptr_t)eytzinger_p & 63) == 0);
+
+    for (size_t key = 0; key <= 3 * length; ++key)
+    {
+        const MyStructS data = { .key = key };
+
+        assert(darray_raw_eytzinger_lower_bound(eytzinger_p, sizeof(*array_p), length, &data, mystruct_compare) == (ssize_t)((key + 2) / 3));
+    }
+
+    assert(darray_raw_eytzinger_lower_bound(NULL, sizeof(*array_p), length, &array_p[0], mystruct_compare) == -1);
+    assert(darray_raw_eytzinger_node(length, length) == -1);
+
+    darray_raw_destroy(eytzinger_p);
+    darray_raw_destroy(array_p);
+}
+
+
+static void test_darray_raw_stree(void)
+{
+    /* lengths around full blocks and full layers (16, 16 * 17, 16 * 17 * 17) */
+    const size_t lengths[] = { 1, 15, 16, 17, 271, 272, 273, 4624, 4625, 100000 };
+    register const size_t max_length = 100000;
+
+    uint32_t* array_p = darray_raw_create(sizeof(*array_p), max_length);
+    assert(array_p != NULL);
+
+    int64_t* array64_p = darray_raw_create(sizeof(*array64_p), max_length);
+    assert(array64_p != NULL);
+
+    for (size_t i = 0; i < array_size(lengths); ++i)
+    {
+        register const size_t length = lengths[i];
+
+        /* keys with duplicates and highest bit set, so unsigned order is checked */
+        for (size_t j = 0; j < length; ++j)
+        {
+            array_p[j] = (uint32_t)(2 * (j / 2) * 40000);
+            array64_p[j] = 3 * (int64_t)(j / 3) - (int64_t)length;
+        }
+
+        void* stree_p = darray_raw_stree_create(array_p, sizeof(*array_p), length, DARRAY_RAW_KEY_UNSIGNED);
+        assert(stree_p != NULL);
+
+        void* stree64_p = darray_raw_stree_create(array64_p, sizeof(*array64_p), length, DARRAY_RAW_KEY_SIGNED);
+        assert(stree64_p != NULL);
+
+        for (size_t j = 0; j <= length + 1; j += 1 + j / 64)
+        {
+            const uint32_t keys[] = { (uint32_t)(j * 40000), (uint32_t)(j * 40000 + 1), (uint32_t)(j * 40000 - 1) };
+
+            for (size_t k = 0; k < array_size(keys); ++k)
+            {
+                assert(darray_raw_stree_lower_bound(stree_p, array_p, &keys[k]) ==
+                       darray_raw_lower_bound_u32(array_p, length, keys[k]));
+            }
+
+            const int64_t key64 = (int64_t)j - (int64_t)length - 1;
+            assert(darray_raw_stree_lower_bound(stree64_p, array64_p, &key64) == darray_raw_lower_bound_i64(array64_p, length, key64));
+        }
+
+        const uint32_t max_key = UINT32_MAX;
+        assert(darray_raw_stree_lower_bound(stree_p, array_p, &max_key) == (ssize_t)length);
+
+        darray_raw_destroy(stree64_p);
+        darray_raw_destroy(stree_p);
+    }
+
+    /* save and load */
+    const char* const path = "/tmp/darray_raw_test_stree.bin";
+
+    void* stree_p = darray_raw_stree_create(array_p, sizeof(*array_p), max_length, DARRAY_RAW_KEY_UNSIGNED);
+    assert(stree_p != NULL);
+    assert(darray_raw_stree_size(stree_p) < max_length * sizeof(*array_p) / 8);
+    assert(darray_raw_stree_save(stree_p, path) == 0);
+
+    void* loaded_p = darray_raw_stree_load(path);
+    assert(loaded_p != NULL);
+    assert(memcmp(loaded_p, stree_p, darray_raw_stree_size(stree_p)) == 0);
+
+    const uint32_t key = array_p[max_length / 2];
+    assert(darray_raw_stree_lower_bound(loaded_p, array_p, &key) == darray_raw_lower_bound_u32(array_p, max_length, key));
+
+    /* truncated file is rejected */
+    FILE* const file_p = fopen(path, "wb");
+    assert(file_p != NULL);
+    assert(fwrite(stree_p, 1, darray_raw_stree_size(stree_p) - 64, file_p) == darray_raw_stree_size(stree_p) - 64);
+    assert(fclose(file_p) == 0);
+    assert(darray_raw_stree_load(path) == NULL);
+    assert(remove(path) == 0);
+
+    assert(darray_raw_stree_create(array_p, 2, max_length, DARRAY_RAW_KEY_UNSIGNED) == NULL);
+
+    darray_raw_destroy(loaded_p);
+    darray_raw_destroy(stree_p);
+    darray_raw_destroy(array64_p);
+    darray_raw_destroy(array_p);
+}
+
+
+static void test_darray_raw_learned(void)
+{
+    register const size_t length = 100000;
+
+    int* array_p = darray_raw_create(sizeof(*array_p), length);
+    assert(array_p != NULL);
+
+    /* smooth keys with runs of equal keys, then long run of one key, then skewed (cubic) keys */
+    for (size_t pass = 0; pass < 3; ++pass)
+    {
+        for (size_t i = 0; i < length; ++i)
+        {
+            if (pass == 0)
+            {
+                array_p[i] = (int)(7 * (i / 3));
+            }
+            else if (pass == 1)
+            {
+                array_p[i] = i < length / 4 ? (int)i : i < length / 2 ? (int)(length / 4) : (int)(i - length / 4);
+            }
+            else
+            {
+                array_p[i] = (int)((i / 100) * (i / 100) * (i / 100));
+            }
+        }
+
+        void* learned_p = darray_raw_learned_create(array_p, sizeof(*array_p), length, int_number, 16);
+        assert(learned_p != NULL);
+
+        /* model of smooth keys is much smaller than array */
+        if (pass == 0)
+        {
+            assert(darray_raw_learned_size(learned_p) < 1024);
+        }
+
+        register const size_t max_key = (size_t)array_p[length - 1];
+        int_compare_calls = 0;
+
+        for (size_t i = 0; i <= 1000; ++i)
+        {
+            const int key = (int)(i * (max_key / 1000) + i % 3) - 1;
+
+            assert(darray_raw_learned_lower_bound(learned_p, array_p, &key, int_compare_counted, int_number) ==
+                   darray_raw_lower_bound(array_p, sizeof(*array_p), length, &key, int_compare));
+            assert(darray_raw_learned_upper_bound(learned_p, array_p, &key, int_compare_counted, int_number) ==
+                   darray_raw_upper_bound(array_p, sizeof(*array_p), length, &key, int_compare));
+        }
+
+        /* window of 33 members needs at most 6 comparisons and 2 checks of its ends */
+        if (pass == 0)
+        {
+            assert(int_compare_calls <= 1001 * 2 * 8);
+        }
+
+        darray_raw_destroy(learned_p);
+    }
+
+    const int key = 5;
+    void* learned_p = darray_raw_learned_create(array_p, sizeof(*array_p), 1, int_number, 1);
+    assert(learned_p != NULL);
+    assert(darray_raw_learned_lower_bound(learned_p, array_p, &key, int_compare, int_number) == 1);
+    assert(darray_raw_learned_lower_bound(learned_p, array_p, &key, int_compare, NULL) == -1);
+    assert(darray_raw_learned_create(array_p, sizeof(*array_p), length, int_number, 0) == NULL);
+
+    darray_raw_destroy(learned_p);
+    darray_raw_destroy(array_p);
+}
+
+
+static void test_darray_raw_find_min(void)
+{
+    const int array[] = {5, 4, 3, 2, 1, 0, -1, -1, 0, 1, 2, 3, 4, 5};
+
+    int out = -1;
+    register ssize_t min_index = -1;
+    
+    min_index = darray_raw_find_min(&array[0], sizeof(*array), array_size(array), int_compare, &out);
+    assert(min_index == 6);
+    assert(out == -1);
+
+    min_index = -1;
+    min_index = darray_raw_find_min(&array[0], sizeof(*array), array_size(array), int_compare, NULL);
+    assert(min_index == 6);
+}
+
+
+static void test_darray_raw_find_max(void)
+{
+    const int array[] = {5, 4, 3, 2, 1, 0, -1, -1, 0, 1, 2, 3, 4, 5};
+
+    int out = -1;
+    register ssize_t max_index = -1;
+    
+    max_index = darray_raw_find_max(&array[0], sizeof(*array), array_size(array), int_compare, &out);
+    assert(max_index == 0);
+    assert(out == 5);
+
+    max_index = -1;
+    max_index = darray_raw_find_max(&array[0], sizeof(*array), array_size(array), int_compare, NULL);
+    assert(max_index == 0);
+}
+
+
+static void test_darray_raw_unsorted_find_first(void)
+{
+    const int array[] = {8, 6, 6, 3, 7, 7, 7, 2, 1, 1, 1, 1, 10, 3, 4, 9, 9, 5, 5, 5, 8};
+
+    register const bool is_sorted = darray_raw_is_sorted(&array[0], sizeof(*array), array_size(array), int_compare);
+    assert(is_sorted == false);
+
+    int out = -1;
+    int search_key = -1;
+    register ssize_t first_index = -1;
+
+    search_key = 0;
+    first_index = darray_raw_unsorted_find_first(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
+    assert(first_index == -1);
+    assert(out == -1);
+
+    search_key = 1;
+    first_index = darray_raw_unsorted_find_first(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
+    assert(first_index == 8);
     assert(out == search_key);
-    assert(out == array[last_index]);
+    assert(out == array[first_index]);
+
+    search_key = 2;
+    first_index = darray_raw_unsorted_find_first(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
+    assert(first_index == 7);
+    assert(out == search_key);
+    assert(out == array[first_index]);
+
+    search_key = 3;
+    first_index = darray_raw_unsorted_find_first(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
+    assert(first_index == 3);
+    assert(out == search_key);
+    assert(out == array[first_index]);
+
+    search_key = 4;
+    first_index = darray_raw_unsorted_find_first(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
+    assert(first_index == 14);
+    assert(out == search_key);
+    assert(out == array[first_index]);
+
+    search_key = 5;
+    first_index = darray_raw_unsorted_find_first(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
+    assert(first_index == 17);
+    assert(out == search_key);
+    assert(out == array[first_index]);
+
+    search_key = 6;
+    first_index = darray_raw_unsorted_find_first(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
+    assert(first_index == 1);
+    assert(out == search_key);
+    assert(out == array[first_index]);
+
+    search_key = 7;
+    first_index = darray_raw_unsorted_find_first(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
+    assert(first_index == 4);
+    assert(out == search_key);
+    assert(out == array[first_index]);
+
+    search_key = 8;
+    first_index = darray_raw_unsorted_find_first(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
+    assert(first_index == 0);
+    assert(out == search_key);
+    assert(out == array[first_index]);
+
+    search_key = 9;
+    first_index = darray_raw_unsorted_find_first(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
+    assert(first_index == 15);
+    assert(out == search_key);
+    assert(out == array[first_index]);
+
+    search_key = 10;
+    first_index = darray_raw_unsorted_find_first(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, NULL);
+    assert(first_index == 12);
+    assert(array[first_index] == search_key);
+}
+
+
+static void test_darray_raw_unsorted_find_last(void)
+{
+    const int array[] = {8, 6, 6, 3, 7, 7, 7, 2, 1, 1, 1, 1, 10, 3, 4, 9, 9, 5, 5, 5, 8};
+
+    register const bool is_sorted = darray_raw_is_sorted(&array[0], sizeof(*array), array_size(array), int_compare);
+    assert(is_sorted == false);
+
+    int out = -1;
+    int search_key = -1;
+    register ssize_t last_index = -1;
+
+    search_key = 0;
+    last_index = darray_raw_unsorted_find_last(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
+    assert(last_index == -1);
+    assert(out == -1);
+
+    search_key = 1;
+    last_index = darray_raw_unsorted_find_last(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
+    assert(last_index == 11);
+    assert(out == search_key);
+    assert(out == array[last_index]);
+
+    search_key = 2;
+    last_index = darray_raw_unsorted_find_last(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
+    assert(last_index == 7);
+    assert(out == search_key);
+    assert(out == array[last_index]);
+
+    search_key = 3;
+    last_index = darray_raw_unsorted_find_last(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
+    assert(last_index == 13);
+    assert(out == search_key);
+    assert(out == array[last_index]);
+
+    search_key = 4;
+    last_index = darray_raw_unsorted_find_last(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
+    assert(last_index == 14);
+    assert(out == search_key);
+    assert(out == array[last_index]);
+
+    search_key = 5;
+    last_index = darray_raw_unsorted_find_last(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
+    assert(last_index == 19);
+    assert(out == search_key);
+    assert(out == array[last_index]);
+
+    search_key = 6;
+    last_index = darray_raw_unsorted_find_last(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
+    assert(last_index == 2);
+    assert(out == search_key);
+    assert(out == array[last_index]);
+
+    search_key = 7;
+    last_index = darray_raw_unsorted_find_last(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
+    assert(last_index == 6);
+    assert(out == search_key);
+    assert(out == array[last_index]);
+
+    search_key = 8;
+    last_index = darray_raw_unsorted_find_last(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
+    assert(last_index == 20);
+    assert(out == search_key);
+    assert(out == array[last_index]);
+
+    search_key = 9;
+    last_index = darray_raw_unsorted_find_last(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
+    assert(last_index == 16);
+    assert(out == search_key);
+    assert(out == array[last_index]);
+
+    search_key = 10;
+    last_index = darray_raw_unsorted_find_last(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, NULL);
+    assert(last_index == 12);
+    assert(array[last_index] == search_key);
+}
+
+
+static void test_darray_raw_unsorted_find_bitwise(void)
+{
+    const size_t sizes[] = { 1, 2, 3, 4, 8, 12, 16, 32, 64, 128 };
+    const size_t key_sizes[] = { 1, 2, 4, 8 };
+    register const size_t max_length = 300;
+
+    uint8_t* array_p = darray_raw_create(128, max_length);
+    assert(array_p != NULL);
+
+    /* bytes with few values, so keys repeat and also partially match */
+    for (size_t i = 0; i < 128 * max_length; ++i)
+    {
+        array_p[i] = (uint8_t)((i * 7 + i / 5) % 3);
+    }
+
+    for (size_t s = 0; s < array_size(sizes); ++s)
+    {
+        register const size_t size_of = sizes[s];
+
+        for (size_t k = 0; k < array_size(key_sizes) && key_sizes[k] <= size_of; ++k)
+        {
+            register const size_t key_size = key_sizes[k];
+
+            for (size_t key_offset = 0; key_offset + key_size <= size_of; key_offset += 1 + key_offset / 4)
+            {
+                for (size_t length = 1; length <= max_length; length += 1 + length / 8)
+                {
+                    /* keys of some members (also first and last) */
+                    for (size_t m = 0; m < length; m += 1 + length / 3)
+                    {
+                        const uint8_t* const key_p = &array_p[m * size_of + key_offset];
+                        ssize_t first = -1;
+                        ssize_t last = -1;
+
+                        for (size_t i = 0; i < length; ++i)
+                        {
+                            if (memcmp(&array_p[i * size_of + key_offset], key_p, key_size) == 0)
+                            {
+                                first = first == -1 ? (ssize_t)i : first;
+                                last = (ssize_t)i;
+                            }
+                        }
+
+                        assert(darray_raw_unsorted_find_first_bitwise(array_p, size_of, length, key_offset, key_size, key_p, NULL) == first);
+                        assert(darray_raw_unsorted_find_last_bitwise(array_p, size_of, length, key_offset, key_size, key_p, NULL) == last);
+                    }
+
+                    const uint8_t missing[8] = { 9, 9, 9, 9, 9, 9, 9, 9 };
+                    assert(darray_raw_unsorted_find_first_bitwise(array_p, size_of, length, key_offset, key_size, missing, NULL) == -1);
+                    assert(darray_raw_unsorted_find_last_bitwise(array_p, size_of, length, key_offset, key_size, missing, NULL) == -1);
+                }
+            }
+        }
+    }
+
+    darray_raw_destroy(array_p);
+
+    /* records with key inside, the same results as with comparator */
+    register const size_t length = 1000;
+
+    MyStructS* records_p = darray_raw_create(sizeof(*records_p), length);
+    assert(records_p != NULL);
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        records_p[i] = (MyStructS){ .key = i % 97, .a = i, .b = i, .c = i };
+    }
+
+    for (size_t key = 0; key <= 97; ++key)
+    {
+        const MyStructS data = { .key = key };
+        MyStructS out = { 0 };
+
+        assert(darray_raw_unsorted_find_first_bitwise(records_p, sizeof(*records_p), length, offsetof(MyStructS, key), sizeof(data.key), &data.key, &out) ==
+               darray_raw_unsorted_find_first(records_p, sizeof(*records_p), length, &data, mystruct_compare, NULL));
+        assert(darray_raw_unsorted_find_last_bitwise(records_p, sizeof(*records_p), length, offsetof(MyStructS, key), sizeof(data.key), &data.key, NULL) ==
+               darray_raw_unsorted_find_last(records_p, sizeof(*records_p), length, &data, mystruct_compare, NULL));
+        assert(key == 97 || out.key == key);
+    }
+
+    const size_t key = 5;
+    assert(darray_raw_unsorted_find_first_bitwise(records_p, sizeof(*records_p), length, 0, 3, &key, NULL) == -1);
+    assert(darray_raw_unsorted_find_first_bitwise(records_p, sizeof(*records_p), length, sizeof(*records_p) - 4, 8, &key, NULL) == -1);
+    assert(darray_raw_unsorted_find_last_bitwise(NULL, sizeof(*records_p), length, 0, 8, &key, NULL) == -1);
+
+    darray_raw_destroy(records_p);
+}
+
+
+static uint64_t mystruct_hash(const void* data_p)
+{
+    return ((const MyStructS*)data_p)->key;
+}
+
+
+static void test_darray_raw_filter(void)
+{
+    register const size_t length = 20000;
+
+    int* array_p = darray_raw_create(sizeof(*array_p), length);
+    assert(array_p != NULL);
+
+    /* even keys in array, odd keys are missing */
+    for (size_t i = 0; i < length; ++i)
+    {
+        array_p[i] = (int)(2 * ((i * 7919) % length));
+    }
+
+    const double rates[] = { 0.1, 0.01, 0.001 };
+
+    for (size_t r = 0; r < array_size(rates); ++r)
+    {
+        void* filter_p = darray_raw_filter_create(array_p, sizeof(*array_p), length, 0, rates[r], NULL, 0, sizeof(*array_p));
+        assert(filter_p != NULL);
+
+        size_t false_positives = 0;
+
+        for (size_t i = 0; i < length; ++i)
+        {
+            const int key = (int)(2 * i);
+            assert(darray_raw_filter_contains(filter_p, &key) == 1);
+
+            const int missing = (int)(2 * i + 1);
+            false_positives += (size_t)darray_raw_filter_contains(filter_p, &missing);
+        }
+
+        /* measured rate is close to requested one, memory grows with lower rate */
+        assert((double)false_positives < 1.5 * rates[r] * (double)length);
+        assert(darray_raw_filter_size(filter_p) < (size_t)(2.0 * (double)length * (double)(r + 1) * 4.0));
+
+        darray_raw_filter_destroy(filter_p);
+    }
+
+    void* filter_p = darray_raw_filter_create(array_p, sizeof(*array_p), length, 0, 0.01, NULL, 0, sizeof(*array_p));
+    assert(filter_p != NULL);
+
+    /* missing key is answered by filter without scan */
+    for (size_t i = 0; i < 100; ++i)
+    {
+        const int key = (int)(2 * i);
+        const int missing = (int)(2 * i + 1);
+        int out = -1;
+
+        int_compare_calls = 0;
+        register const ssize_t found = darray_raw_filter_find_first(filter_p, array_p, length, &missing, int_compare_counted, NULL);
+
+        assert(found == -1);
+        assert(int_compare_calls == 0 || int_compare_calls == length);
+
+        assert(darray_raw_filter_find_first(filter_p, array_p, length, &key, int_compare, &out) ==
+               darray_raw_unsorted_find_first(array_p, sizeof(*array_p), length, &key, int_compare, NULL));
+        assert(out == key);
+        assert(darray_raw_filter_find_last(filter_p, array_p, length, &key, int_compare, NULL) ==
+               darray_raw_unsorted_find_last(array_p, sizeof(*array_p), length, &key, int_compare, NULL));
+    }
+
+    /* delete half of keys (filter is rebuilt), then insert new keys over capacity (filter grows) */
+    for (size_t i = 0; i < length / 2 + 1; ++i)
+    {
+        assert(darray_raw_filter_delete_pos(filter_p, array_p, length - i, 0) == 0);
+    }
+
+    register const size_t kept = length - (length / 2 + 1);
+
+    for (size_t i = 0; i < kept; ++i)
+    {
+        assert(darray_raw_filter_contains(filter_p, &array_p[i]) == 1);
+    }
+
+    register const size_t size = darray_raw_filter_size(filter_p);
+
+    for (size_t i = kept; i < length; ++i)
+    {
+        const int key = -(int)i;
+        assert(darray_raw_filter_unsorted_insert_pos(filter_p, array_p, i + 1, i / 2, &key) == 0);
+    }
+
+    for (size_t i = kept; i < length; ++i)
+    {
+        const int key = -(int)i;
+        assert(darray_raw_filter_contains(filter_p, &key) == 1);
+        assert(darray_raw_filter_find_first(filter_p, array_p, length, &key, int_compare, NULL) >= 0);
+    }
+
+    assert(darray_raw_filter_size(filter_p) >= size);
+
+    darray_raw_filter_destroy(filter_p);
+    darray_raw_destroy(array_p);
+
+    /* records hashed by caller function */
+    MyStructS records[100];
+
+    for (size_t i = 0; i < array_size(records); ++i)
+    {
+        records[i] = (MyStructS){ .key = 3 * i, .a = i, .b = i, .c = i };
+    }
+
+    filter_p = darray_raw_filter_create(records, sizeof(*records), array_size(records), 1000, 0.01, mystruct_hash, 0, 0);
+    assert(filter_p != NULL);
+
+    for (size_t key = 0; key < 3 * array_size(records); ++key)
+    {
+        const MyStructS data = { .key = key };
+
+        assert(darray_raw_filter_find_first(filter_p, records, array_size(records), &data, mystruct_compare, NULL) ==
+               darray_raw_unsorted_find_first(records, sizeof(*records), array_size(records), &data, mystruct_compare, NULL));
+    }
+
+    darray_raw_filter_destroy(filter_p);
+
+    assert(darray_raw_filter_create(records, sizeof(*records), array_size(records), 0, 1.0, mystruct_hash, 0, 0) == NULL);
+    assert(darray_raw_filter_create(records, sizeof(*records), array_size(records), 0, 0.01, NULL, sizeof(*records) - 4, 8) == NULL);
+    assert(darray_raw_filter_contains(NULL, &records[0]) == -1);
+}
+
+
+static int mystruct_a_key_compare(const void* member_p, const void* key_p)
+{
+    /* array member is MyStructS, key is bare size_t compared with field a */
+    register const MyStructS* const mystruct_p = member_p;
+    register const size_t key = *(const size_t*)key_p;
+
+    return (mystruct_p->a > key) - (mystruct_p->a < key);
+}
+
+
+static void test_darray_raw_sorted_find_first(void)
+{
+    const int array[] = {1, 2, 2, 3, 3, 4, 5, 5, 5, 6, 7, 7, 7, 7, 8, 9, 9, 10};
+
+    register const bool is_sorted = darray_raw_is_sorted(&array[0], sizeof(*array), array_size(array), int_compare);
+    assert(is_sorted == true);
+
+    int out = -1;
+    int search_key = -1;
+    register ssize_t first_index = -1;
+
+    search_key = 0;
+    first_index = darray_raw_sorted_find_first(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
+    assert(first_index == -1);
+    assert(out == -1);
+
+    search_key = 1;
+    first_index = darray_raw_sorted_find_first(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
+    assert(first_index == 0);
+    assert(out == search_key);
+    assert(out == array[first_index]);
+    
+    search_key = 2;
+    first_index = darray_raw_sorted_find_first(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
+    assert(first_index == 1);
+    assert(out == search_key);
+    assert(out == array[first_index]);
+
+    search_key = 3;
+    first_index = darray_raw_sorted_find_first(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
+    assert(first_index == 3);
+    assert(out == search_key);
+    assert(out == array[first_index]);
+
+    search_key = 4;
+    first_index = darray_raw_sorted_find_first(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
+    assert(first_index == 5);
+    assert(out == search_key);
+    assert(out == array[first_index]);
+
+    search_key = 5;
+    first_index = darray_raw_sorted_find_first(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
+    assert(first_index == 6);
+    assert(out == search_key);
+    assert(out == array[first_index]);
+
+    search_key = 6;
+    first_index = darray_raw_sorted_find_first(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
+    assert(first_index == 9);
+    assert(out == search_key);
+    assert(out == array[first_index]);
+
+    search_key = 7;
+    first_index = darray_raw_sorted_find_first(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
+    assert(first_index == 10);
+    assert(out == search_key);
+    assert(out == array[first_index]);
+
+    search_key = 8;
+    first_index = darray_raw_sorted_find_first(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
+    assert(first_index == 14);
+    assert(out == search_key);
+    assert(out == array[first_index]);
+
+    search_key = 9;
+    first_index = darray_raw_sorted_find_first(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
+    assert(first_index == 15);
+    assert(out == search_key);
+    assert(out == array[first_index]);
+
+    search_key = 10;
+    first_index = darray_raw_sorted_find_first(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, NULL);
+    assert(first_index == 17);
+    assert(array[first_index] == search_key);
+
+    /* comparator of record with bare key is called only as cmp_fp(array member, key) */
+    MyStructS records[40];
+
+    for (size_t i = 0; i < array_size(records); ++i)
+    {
+        records[i] = (MyStructS){ .key = 0, .a = i / 2, .b = i, .c = 0 };
+    }
+
+    const size_t a_key = 7;
+    MyStructS record_out = { 0 };
+
+    assert(darray_raw_sorted_find_first(&records[0], sizeof(*records), array_size(records), &a_key, mystruct_a_key_compare, &record_out) == 14);
+    assert(record_out.b == 14);
+    assert(darray_raw_sorted_find_last(&records[0], sizeof(*records), array_size(records), &a_key, mystruct_a_key_compare, &record_out) == 15);
+    assert(record_out.b == 15);
+    assert(darray_raw_sorted_find_first_hint(&records[0], sizeof(*records), array_size(records), &a_key, mystruct_a_key_compare, 30, NULL) == 14);
+    assert(darray_raw_sorted_find_last_hint(&records[0], sizeof(*records), array_size(records), &a_key, mystruct_a_key_compare, 2, NULL) == 15);
+
+    const size_t missing_a_key = 100;
+    assert(darray_raw_sorted_find_first(&records[0], sizeof(*records), array_size(records), &missing_a_key, mystruct_a_key_compare, NULL) == -1);
+}
+
+
+static void test_darray_raw_sorted_find_last(void)
+{
+    const int array[] = {1, 2, 2, 3, 3, 4, 5, 5, 5, 6, 7, 7, 7, 7, 8, 9, 9, 10};
+
+    register const bool is_sorted = darray_raw_is_sorted(&array[0], sizeof(*array), array_size(array), int_compare);
+    assert(is_sorted == true);
+
+    int out = -1;
+    int search_key = -1;
+    register ssize_t last_index = -1;
+
+    search_key = 0;
+    last_index = darray_raw_sorted_find_last(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
+    assert(last_index == -1);
+    assert(out == -1);
+
+    search_key = 1;
+    last_index = darray_raw_sorted_find_last(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
+    assert(last_index == 0);
+    assert(out == search_key);
+    assert(out == array[last_index]);
+    
+    search_key = 2;
+    last_index = darray_raw_sorted_find_last(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
+    assert(last_index == 2);
+    assert(out == search_key);
+    assert(out == array[last_index]);
+
+    search_key = 3;
+    last_index = darray_raw_sorted_find_last(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
+    assert(last_index == 4);
+    assert(out == search_key);
+    assert(out == array[last_index]);
+
+    search_key = 4;
+    last_index = darray_raw_sorted_find_last(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
+    assert(last_index == 5);
+    assert(out == search_key);
+    assert(out == array[last_index]);
+
+    search_key = 5;
+    last_index = darray_raw_sorted_find_last(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
+    assert(last_index == 8);
+    assert(out == search_key);
+    assert(out == array[last_index]);
+
+    search_key = 6;
+    last_index = darray_raw_sorted_find_last(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
+    assert(last_index == 9);
+    assert(out == search_key);
+    assert(out == array[last_index]);
+
+    search_key = 7;
+    last_index = darray_raw_sorted_find_last(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
+    assert(last_index == 13);
+    assert(out == search_key);
+    assert(out == array[last_index]);
+
+    search_key = 8;
+    last_index = darray_raw_sorted_find_last(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
+    assert(last_index == 14);
+    assert(out == search_key);
+    assert(out == array[last_index]);
+
+    search_key = 9;
+    last_index = darray_raw_sorted_find_last(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
+    assert(last_index == 16);
+    assert(out == search_key);
+    assert(out == array[last_index]);
+
+    search_key = 10;
+    last_index = darray_raw_sorted_find_last(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, NULL);
+    assert(last_index == 17);
+    assert(array[last_index] == search_key);
+}
+
+
+static void test_darray_raw_sort(void)
+{
+    register const size_t size_of = sizeof(int);
+    register const size_t length = 1000;
+
+    int* array_p = darray_raw_create(size_of, length);
+    assert(array_p != NULL);
+
+    /* first test with shuffle array */
+    for (size_t i = 0; i < length; ++i)
+    {
+        array_p[i] = (int)(i + 1);
+    }
+
+    darray_raw_shuffle(&array_p[0], size_of, length);
+    darray_raw_sort(&array_p[0], size_of, length, int_compare);
+    assert(darray_raw_is_sorted(&array_p[0], size_of, length, int_compare) == true);
+
+    /* second test with worst-case */
+    for (size_t i = 0; i < length; ++i)
+    {
+        array_p[i] = (int)(length - i);
+    }
+
+    darray_raw_sort(&array_p[0], size_of, length, int_compare);
+    assert(darray_raw_is_sorted(&array_p[0], size_of, length, int_compare) == true);
+
+    /* already sorted array */
+    darray_raw_sort(&array_p[0], size_of, length, int_compare);
+    assert(darray_raw_is_sorted(&array_p[0], size_of, length, int_compare) == true);
+
+    /* organ pipe */
+    for (size_t i = 0; i < length; ++i)
+    {
+        array_p[i] = (int)(i < length / 2 ? i : length - i);
+    }
+
+    darray_raw_sort(&array_p[0], size_of, length, int_compare);
+    assert(darray_raw_is_sorted(&array_p[0], size_of, length, int_compare) == true);
+
+    /* many duplicates */
+    for (size_t i = 0; i < length; ++i)
+    {
+        array_p[i] = (int)((i * 7919) % 3);
+    }
+
+    darray_raw_sort(&array_p[0], size_of, length, int_compare);
+    assert(darray_raw_is_sorted(&array_p[0], size_of, length, int_compare) == true);
+
+    /* sorted and reverse sorted arrays cost n - 1 comparisons */
+    for (size_t i = 0; i < length; ++i)
+    {
+        array_p[i] = (int)(length - i);
+    }
+
+    int_compare_calls = 0;
+    darray_raw_sort(&array_p[0], size_of, length, int_compare_counted);
+    assert(int_compare_calls == length - 1);
+
+    int_compare_calls = 0;
+    darray_raw_sort(&array_p[0], size_of, length, int_compare_counted);
+    assert(int_compare_calls == length - 1);
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        assert(array_p[i] == (int)(i + 1));
+    }
+
+    /* sorted array with short and long unsorted tail (values from the whole range) */
+    const size_t tail_lengths[] = { 1, 10, 200, 400 };
+
+    for (size_t test = 0; test < array_size(tail_lengths); ++test)
+    {
+        register const size_t prefix_length = length - tail_lengths[test];
+
+        for (size_t i = 0; i < prefix_length; ++i)
+        {
+            array_p[i] = (int)(2 * i);
+        }
+
+        for (size_t i = prefix_length; i < length; ++i)
+        {
+            array_p[i] = (int)((i * 7919) % (2 * length));
+        }
+
+        darray_raw_sort(&array_p[0], size_of, length, int_compare);
+        assert(darray_raw_is_sorted(&array_p[0], size_of, length, int_compare) == true);
+    }
+
+    /* reverse sorted array with unsorted tail */
+    for (size_t i = 0; i < length; ++i)
+    {
+        array_p[i] = (int)(i < length - 50 ? length - i : (i * 7919) % length);
+    }
+
+    darray_raw_sort(&array_p[0], size_of, length, int_compare);
+    assert(darray_raw_is_sorted(&array_p[0], size_of, length, int_compare) == true);
+
+    darray_raw_destroy(array_p);
+}
+
+
+static void test_darray_raw_sort_typed(void)
+{
+    register const size_t length = 1000;
+
+    /* int32_t with shuffled, reversed and duplicated values */
+    int32_t* i32_array_p = darray_raw_create(sizeof(*i32_array_p), length);
+    assert(i32_array_p != NULL);
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        i32_array_p[i] = (int32_t)i - 500;
+    }
+
+    darray_raw_shuffle(&i32_array_p[0], sizeof(*i32_array_p), length);
+    darray_raw_sort_i32(&i32_array_p[0], length);
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        assert(i32_array_p[i] == (int32_t)i - 500);
+    }
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        i32_array_p[i] = (int32_t)(length - i);
+    }
+
+    darray_raw_sort_i32(&i32_array_p[0], length);
+    assert(darray_raw_is_sorted(&i32_array_p[0], sizeof(*i32_array_p), length, int_compare) == true);
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        i32_array_p[i] = (int32_t)((i * 7919) % 5);
+    }
+
+    darray_raw_sort_i32(&i32_array_p[0], length);
+    assert(darray_raw_is_sorted(&i32_array_p[0], sizeof(*i32_array_p), length, int_compare) == true);
+
+    darray_raw_destroy(i32_array_p);
+
+    /* uint64_t */
+    uint64_t* u64_array_p = darray_raw_create(sizeof(*u64_array_p), length);
+    assert(u64_array_p != NULL);
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        u64_array_p[i] = ((uint64_t)i * 0x9E3779B97F4A7C15ULL) ^ (UINT64_MAX - (uint64_t)i % 3);
+    }
+
+    darray_raw_sort_u64(&u64_array_p[0], length);
+
+    for (size_t i = 1; i < length; ++i)
+    {
+        assert(u64_array_p[i - 1] <= u64_array_p[i]);
+    }
+
+    darray_raw_destroy(u64_array_p);
+
+    /* double with negative values */
+    double* double_array_p = darray_raw_create(sizeof(*double_array_p), length);
+    assert(double_array_p != NULL);
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        double_array_p[i] = ((double)((i * 7919) % length) - 500.0) / 3.0;
+    }
+
+    darray_raw_sort_double(&double_array_p[0], length);
+
+    for (size_t i = 1; i < length; ++i)
+    {
+        assert(double_array_p[i - 1] <= double_array_p[i]);
+    }
+
+    darray_raw_destroy(double_array_p);
+
+    /* int8_t tiny array sorted by insertion-sort */
+    int8_t i8_array[] = {5, -3, 127, -128, 0, 0, 1};
+    darray_raw_sort_i8(&i8_array[0], array_size(i8_array));
+
+    for (size_t i = 0; i < array_size(i8_array); ++i)
+    {
+        assert(i8_array[i] == ((int8_t[]){-128, -3, 0, 0, 1, 5, 127})[i]);
+    }
+
+    /* user type generated in this file */
+    MyStructS* mystruct_p = darray_raw_create(sizeof(*mystruct_p), length);
+    assert(mystruct_p != NULL);
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        mystruct_p[i] = (MyStructS){ .key = i, .a = i + 1, .b = i + 2, .c = i + 3 };
+    }
+
+    darray_raw_shuffle(&mystruct_p[0], sizeof(*mystruct_p), length);
+    mystruct_sort(&mystruct_p[0], length);
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        assert(mystruct_p[i].key == i);
+        assert(mystruct_p[i].a == i + 1);
+    }
+
+    darray_raw_destroy(mystruct_p);
+}
+
+
+static void test_darray_raw_sort_small(void)
+{
+    register int ret = -1;
+
+    /* every length handled by network and one longer array sorted by fallback */
+    for (size_t length = 1; length <= DARRAY_RAW_SORT_SMALL_MAX + 36; ++length)
+    {
+        int32_t i32_array[DARRAY_RAW_SORT_SMALL_MAX + 36];
+        uint64_t u64_array[DARRAY_RAW_SORT_SMALL_MAX + 36];
+        double double_array[DARRAY_RAW_SORT_SMALL_MAX + 36];
+
+        for (size_t i = 0; i < length; ++i)
+        {
+            i32_array[i] = (int32_t)((i * 7919) % 23) - 11;
+            u64_array[i] = (uint64_t)(length - i) * 0x9E3779B97F4A7C15ULL;
+            double_array[i] = ((double)((i * 7919) % length) - 10.0) / 3.0;
+        }
+
+        darray_raw_sort_small_i32(&i32_array[0], length);
+        ret = darray_raw_sort_small(&u64_array[0], sizeof(*u64_array), length, DARRAY_RAW_KEY_UNSIGNED);
+        assert(ret == 0);
+        ret = darray_raw_sort_small(&double_array[0], sizeof(*double_array), length, DARRAY_RAW_KEY_FLOAT);
+        assert(ret == 0);
+
+        for (size_t i = 1; i < length; ++i)
+        {
+            assert(i32_array[i - 1] <= i32_array[i]);
+            assert(u64_array[i - 1] <= u64_array[i]);
+            assert(double_array[i - 1] <= double_array[i]);
+        }
+
+        /* elements are permuted, not lost: sum of i32 keys is preserved */
+        register int64_t sum = 0;
+        register int64_t expected_sum = 0;
+
+        for (size_t i = 0; i < length; ++i)
+        {
+            sum += i32_array[i];
+            expected_sum += (int64_t)((i * 7919) % 23) - 11;
+        }
+
+        assert(sum == expected_sum);
+    }
+
+    /* maximal values are not confused with padding */
+    uint32_t u32_array[] = {UINT32_MAX, 0, UINT32_MAX, 5, 1};
+    darray_raw_sort_small_u32(&u32_array[0], array_size(u32_array));
+
+    for (size_t i = 0; i < array_size(u32_array); ++i)
+    {
+        assert(u32_array[i] == ((uint32_t[]){0, 1, 5, UINT32_MAX, UINT32_MAX})[i]);
+    }
+
+    /* wrong size of key */
+    int16_t i16_array[] = {3, 2, 1};
+    ret = darray_raw_sort_small(&i16_array[0], sizeof(*i16_array), array_size(i16_array), DARRAY_RAW_KEY_SIGNED);
+    assert(ret != 0);
+}
+
+
+static void test_darray_raw_radix_sort(void)
+{
+    register const size_t length = 1000;
+    register int ret = -1;
+
+    /* signed keys with internal buffer */
+    int* int_array_p = darray_raw_create(sizeof(*int_array_p), length);
+    assert(int_array_p != NULL);
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        int_array_p[i] = (int)i - 500;
+    }
+
+    darray_raw_shuffle(&int_array_p[0], sizeof(*int_array_p), length);
+    ret = darray_raw_radix_sort(&int_array_p[0], sizeof(*int_array_p), length, DARRAY_RAW_KEY_SIGNED, NULL);
+    assert(ret == 0);
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        assert(int_array_p[i] == (int)i - 500);
+    }
+
+    darray_raw_destroy(int_array_p);
+
+    /* unsigned keys with caller buffer */
+    uint64_t* u64_array_p = darray_raw_create(sizeof(*u64_array_p), length);
+    assert(u64_array_p != NULL);
+
+    uint64_t* scratch_p = darray_raw_create(sizeof(*scratch_p), length);
+    assert(scratch_p != NULL);
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        u64_array_p[i] = (uint64_t)i * 0x9E3779B97F4A7C15ULL;
+    }
+
+    ret = darray_raw_radix_sort(&u64_array_p[0], sizeof(*u64_array_p), length, DARRAY_RAW_KEY_UNSIGNED, scratch_p);
+    assert(ret == 0);
+
+    for (size_t i = 1; i < length; ++i)
+    {
+        assert(u64_array_p[i - 1] <= u64_array_p[i]);
+    }
+
+    darray_raw_destroy(scratch_p);
+    darray_raw_destroy(u64_array_p);
+
+    /* floating point keys */
+    float* float_array_p = darray_raw_create(sizeof(*float_array_p), length);
+    assert(float_array_p != NULL);
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        float_array_p[i] = ((float)((i * 7919) % length) - 500.0f) / 7.0f;
+    }
+
+    ret = darray_raw_radix_sort(&float_array_p[0], sizeof(*float_array_p), length, DARRAY_RAW_KEY_FLOAT, NULL);
+    assert(ret == 0);
+
+    for (size_t i = 1; i < length; ++i)
+    {
+        assert(float_array_p[i - 1] <= float_array_p[i]);
+    }
+
+    darray_raw_destroy(float_array_p);
+
+    /* small array sorted without buffer */
+    double double_array[] = {2.5, -0.5, -100.0, 3.0, 0.0, -2.5};
+    ret = darray_raw_radix_sort(&double_array[0], sizeof(*double_array), array_size(double_array), DARRAY_RAW_KEY_FLOAT, NULL);
+    assert(ret == 0);
+
+    for (size_t i = 0; i < array_size(double_array); ++i)
+    {
+        assert(double_array[i] == ((double[]){-100.0, -2.5, -0.5, 0.0, 2.5, 3.0})[i]);
+    }
+}
+
+
+static void test_darray_raw_radix_sort_by_key(void)
+{
+    register const size_t length = 1000;
+
+    MyStructS* mystruct_p = darray_raw_create(sizeof(*mystruct_p), length);
+    assert(mystruct_p != NULL);
+
+    /* a is original position, so stability can be checked */
+    for (size_t i = 0; i < length; ++i)
+    {
+        mystruct_p[i] = (MyStructS){ .key = (i * 7919) % 100, .a = i, .b = 0, .c = 0 };
+    }
+
+    register const int ret = darray_raw_radix_sort_by_key(&mystruct_p[0], sizeof(*mystruct_p), length, offsetof(MyStructS, key), 
+                                                          sizeof(mystruct_p->key), DARRAY_RAW_KEY_UNSIGNED, NULL);
+    assert(ret == 0);
+
+    for (size_t i = 1; i < length; ++i)
+    {
+        assert(mystruct_p[i - 1].key <= mystruct_p[i].key);
+
+        if (mystruct_p[i - 1].key == mystruct_p[i].key)
+        {
+            assert(mystruct_p[i - 1].a < mystruct_p[i].a);
+        }
+    }
+
+    darray_raw_destroy(mystruct_p);
+}
+
+
+static int record24_compare(const void* first_p, const void* second_p)
+{
+    /* records of test_darray_raw_parallel_sort: key and position */
+    register const size_t* const first_sp = first_p;
+    register const size_t* const second_sp = second_p;
+
+    if (first_sp[0] != second_sp[0])
+    {
+        return first_sp[0] > second_sp[0] ? 1 : -1;
+    }
+
+    return (first_sp[1] > second_sp[1]) - (first_sp[1] < second_sp[1]);
+}
+
+
+static void test_darray_raw_parallel_sort(void)
+{
+    register const size_t size_of = sizeof(int);
+    register const size_t length = (size_t)1 << 18;
+    register int ret = -1;
+
+    int* array_p = darray_raw_create(size_of, length);
+    assert(array_p != NULL);
+
+    /* first test with shuffle array */
+    for (size_t i = 0; i < length; ++i)
+    {
+        array_p[i] = (int)(i + 1);
+    }
+
+    darray_raw_shuffle(&array_p[0], size_of, length);
+    ret = darray_raw_parallel_sort(&array_p[0], size_of, length, int_compare, 4);
+    assert(ret == 0);
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        assert(array_p[i] == (int)(i + 1));
+    }
+
+    /* second test with many duplicates */
+    for (size_t i = 0; i < length; ++i)
+    {
+        array_p[i] = (int)((i * 7919) % 7);
+    }
+
+    ret = darray_raw_parallel_sort(&array_p[0], size_of, length, int_compare, 3);
+    assert(ret == 0);
+    assert(darray_raw_is_sorted(&array_p[0], size_of, length, int_compare) == true);
+
+    /* third test with small array sorted sequentially */
+    ret = darray_raw_parallel_sort(&array_p[0], size_of, 1000, int_compare, 0);
+    assert(ret == 0);
+    assert(darray_raw_is_sorted(&array_p[0], size_of, 1000, int_compare) == true);
+
+    darray_raw_destroy(array_p);
+
+    /* fourth test with odd length (partial last block), result has to be equal to sequential sort */
+    register const size_t odd_length = ((size_t)1 << 18) + 12345;
+
+    array_p = darray_raw_create(size_of, odd_length);
+    assert(array_p != NULL);
+
+    for (size_t i = 0; i < odd_length; ++i)
+    {
+        array_p[i] = (int)((i * 2654435761U) % 100003);
+    }
+
+    int* baseline_p = darray_raw_clone(&array_p[0], size_of, odd_length);
+    assert(baseline_p != NULL);
+
+    ret = darray_raw_parallel_sort(&array_p[0], size_of, odd_length, int_compare, 4);
+    assert(ret == 0);
+
+    darray_raw_sort(&baseline_p[0], size_of, odd_length, int_compare);
+
+    assert(darray_raw_equal(&array_p[0], &baseline_p[0], size_of, odd_length, int_compare) == true);
+
+    darray_raw_destroy(baseline_p);
+    darray_raw_destroy(array_p);
+
+    /* fifth test with 24-byte records (size not power of two) and few keys, so some buckets overflow */
+    typedef struct Record24S
+    {
+        size_t key;
+        size_t pos;
+        size_t check;
+    } Record24S;
+
+    register const size_t rec_length = ((size_t)1 << 17) + 777;
+
+    Record24S* rec_p = darray_raw_create(sizeof(*rec_p), rec_length);
+    assert(rec_p != NULL);
+
+    for (size_t i = 0; i < rec_length; ++i)
+    {
+        rec_p[i] = (Record24S){ .key = (i * 7919) % 13 == 0 ? 5 : (i * 7919) % 31, .pos = i, .check = ~i };
+    }
+
+    Record24S* rec_baseline_p = darray_raw_clone(&rec_p[0], sizeof(*rec_p), rec_length);
+    assert(rec_baseline_p != NULL);
+
+    /* key is first member, as in MyStructS */
+    ret = darray_raw_parallel_sort(&rec_p[0], sizeof(*rec_p), rec_length, mystruct_compare, 3);
+    assert(ret == 0);
+    assert(darray_raw_is_sorted(&rec_p[0], sizeof(*rec_p), rec_length, mystruct_compare) == true);
+
+    /* parallel sort is not stable, so both arrays are ordered by (key, pos) before multiset compare */
+    darray_raw_sort(&rec_p[0], sizeof(*rec_p), rec_length, record24_compare);
+    darray_raw_sort(&rec_baseline_p[0], sizeof(*rec_baseline_p), rec_length, record24_compare);
+
+    assert(memcmp(&rec_p[0], &rec_baseline_p[0], rec_length * sizeof(*rec_p)) == 0);
+
+    darray_raw_destroy(rec_baseline_p);
+    darray_raw_destroy(rec_p);
+}
+
+
+static void test_darray_raw_stable_sort(void)
+{
+    register const size_t length = 10000;
+    register int ret = -1;
+
+    MyStructS* mystruct_p = darray_raw_create(sizeof(*mystruct_p), length);
+    assert(mystruct_p != NULL);
+
+    MyStructS* scratch_p = darray_raw_create(sizeof(*scratch_p), length / 2);
+    assert(scratch_p != NULL);
+
+    /* scratch buffer big enough, small scratch buffer and no buffer (merge in place) */
+    const size_t scratch_lengths[] = { length / 2, 100, 0 };
+
+    for (size_t test = 0; test < array_size(scratch_lengths); ++test)
+    {
+        /* b is original position, so stability can be checked. Runs of a are partly ascending and descending */
+        for (size_t i = 0; i < length; ++i)
+        {
+            mystruct_p[i] = (MyStructS){ .key = (i * 7919) % 100, .a = (i / 500) % 2 == 0 ? i % 300 : 300 - i % 300, .b = i, .c = 0 };
+        }
+
+        ret = darray_raw_stable_sort(&mystruct_p[0], sizeof(*mystruct_p), length, mystruct_compare, 
+                                     scratch_lengths[test] != 0 ? scratch_p : NULL, scratch_lengths[test]);
+        assert(ret == 0);
+
+        for (size_t i = 1; i < length; ++i)
+        {
+            assert(mystruct_p[i - 1].key <= mystruct_p[i].key);
+
+            if (mystruct_p[i - 1].key == mystruct_p[i].key)
+            {
+                assert(mystruct_p[i - 1].b < mystruct_p[i].b);
+            }
+        }
+    }
+
+    darray_raw_destroy(scratch_p);
+    darray_raw_destroy(mystruct_p);
+
+    /* reverse sorted and small arrays */
+    register const size_t size_of = sizeof(int);
+
+    int* array_p = darray_raw_create(size_of, length);
+    assert(array_p != NULL);
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        array_p[i] = (int)(length - i);
+    }
+
+    ret = darray_raw_stable_sort(&array_p[0], size_of, length, int_compare, NULL, 0);
+    assert(ret == 0);
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        assert(array_p[i] == (int)(i + 1));
+    }
+
+    darray_raw_shuffle(&array_p[0], size_of, 50);
+    ret = darray_raw_stable_sort(&array_p[0], size_of, 50, int_compare, NULL, 0);
+    assert(ret == 0);
+    assert(darray_raw_is_sorted(&array_p[0], size_of, 50, int_compare) == true);
+
+    darray_raw_destroy(array_p);
+
+    /* members bigger than stack buffer, without scratch buffer and with buffer of zero length (key first, as in MyStructS) */
+    typedef struct BigStructS
+    {
+        size_t key;
+        size_t pos;
+        uint8_t pad[2048 - 2 * sizeof(size_t)];
+    } BigStructS;
+
+    register const size_t big_length = 300;
+
+    BigStructS* big_p = darray_raw_create(sizeof(*big_p), big_length);
+    assert(big_p != NULL);
+
+    BigStructS* big_scratch_p = darray_raw_create(sizeof(*big_scratch_p), 1);
+    assert(big_scratch_p != NULL);
+
+    for (size_t test = 0; test < 2; ++test)
+    {
+        for (size_t i = 0; i < big_length; ++i)
+        {
+            big_p[i].key = (i * 7919) % 17;
+            big_p[i].pos = i;
+        }
+
+        ret = darray_raw_stable_sort(&big_p[0], sizeof(*big_p), big_length, mystruct_compare, test == 0 ? NULL : big_scratch_p, 0);
+        assert(ret == 0);
+
+        for (size_t i = 1; i < big_length; ++i)
+        {
+            assert(big_p[i - 1].key <= big_p[i].key);
+
+            if (big_p[i - 1].key == big_p[i].key)
+            {
+                assert(big_p[i - 1].pos < big_p[i].pos);
+            }
+        }
+    }
+
+    darray_raw_destroy(big_scratch_p);
+    darray_raw_destroy(big_p);
+}
+
+
+static void test_darray_raw_argsort(void)
+{
+    register const size_t length = 1000;
+    register int ret = -1;
+
+    MyStructS* mystruct_p = darray_raw_create(sizeof(*mystruct_p), length);
+    assert(mystruct_p != NULL);
+
+    size_t* idx_p = darray_raw_create(sizeof(*idx_p), length);
+    assert(idx_p != NULL);
+
+    /* a is original position, so stability can be checked */
+    for (size_t i = 0; i < length; ++i)
+    {
+        mystruct_p[i] = (MyStructS){ .key = (i * 7919) % 100, .a = i, .b = 0, .c = 0 };
+    }
+
+    ret = darray_raw_argsort(&mystruct_p[0], sizeof(*mystruct_p), length, mystruct_compare, &idx_p[0], sizeof(*idx_p));
+    assert(ret == 0);
+
+    /* array is not modified by argsort */
+    for (size_t i = 0; i < length; ++i)
+    {
+        assert(mystruct_p[i].a == i);
+    }
+
+    for (size_t i = 1; i < length; ++i)
+    {
+        assert(mystruct_p[idx_p[i - 1]].key <= mystruct_p[idx_p[i]].key);
+
+        if (mystruct_p[idx_p[i - 1]].key == mystruct_p[idx_p[i]].key)
+        {
+            assert(idx_p[i - 1] < idx_p[i]);
+        }
+    }
+
+    ret = darray_raw_apply_permutation(&mystruct_p[0], sizeof(*mystruct_p), length, &idx_p[0], sizeof(*idx_p));
+    assert(ret == 0);
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        assert(mystruct_p[i].a == idx_p[i]);
+    }
+
+    /* not a permutation, array has to stay untouched */
+    idx_p[0] = idx_p[1];
+    ret = darray_raw_apply_permutation(&mystruct_p[0], sizeof(*mystruct_p), length, &idx_p[0], sizeof(*idx_p));
+    assert(ret != 0);
+    assert(darray_raw_is_sorted(&mystruct_p[0], sizeof(*mystruct_p), length, mystruct_compare) == true);
+
+    darray_raw_destroy(idx_p);
+    darray_raw_destroy(mystruct_p);
+
+    /* 32-bit indexes */
+    register const size_t size_of = sizeof(int);
+
+    int* array_p = darray_raw_create(size_of, length);
+    assert(array_p != NULL);
+
+    uint32_t* idx32_p = darray_raw_create(sizeof(*idx32_p), length);
+    assert(idx32_p != NULL);
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        array_p[i] = (int)(length - i);
+    }
+
+    ret = darray_raw_argsort(&array_p[0], size_of, length, int_compare, &idx32_p[0], sizeof(*idx32_p));
+    assert(ret == 0);
+
+    ret = darray_raw_apply_permutation(&array_p[0], size_of, length, &idx32_p[0], sizeof(*idx32_p));
+    assert(ret == 0);
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        assert(array_p[i] == (int)(i + 1));
+    }
+
+    darray_raw_destroy(idx32_p);
+    darray_raw_destroy(array_p);
+}
+
+
+static void test_darray_raw_sort_by_key(void)
+{
+    register const size_t length = 10000;
+
+    int* keys_p = darray_raw_create(sizeof(*keys_p), length);
+    assert(keys_p != NULL);
+
+    size_t* positions_p = darray_raw_create(sizeof(*positions_p), length);
+    assert(positions_p != NULL);
+
+    MyStructS* mystruct_p = darray_raw_create(sizeof(*mystruct_p), length);
+    assert(mystruct_p != NULL);
+
+    uint8_t* bytes_p = darray_raw_create(sizeof(*bytes_p), length);
+    assert(bytes_p != NULL);
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        keys_p[i] = (int)((i * 7919) % 1000);
+        positions_p[i] = i;
+        mystruct_p[i] = (MyStructS){ .key = (size_t)keys_p[i], .a = i, .b = 0, .c = 0 };
+        bytes_p[i] = (uint8_t)keys_p[i];
+    }
+
+    void* const payloads[] = { positions_p, mystruct_p, bytes_p };
+    const size_t payload_sizes[] = { sizeof(*positions_p), sizeof(*mystruct_p), sizeof(*bytes_p) };
+
+    register int ret = darray_raw_sort_by_key(keys_p, sizeof(*keys_p), length, int_compare, payloads, payload_sizes, 3);
+    assert(ret == 0);
+    assert(darray_raw_is_sorted(keys_p, sizeof(*keys_p), length, int_compare));
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        assert((size_t)keys_p[i] == (positions_p[i] * 7919) % 1000);
+        assert(mystruct_p[i].key == (size_t)keys_p[i]);
+        assert(mystruct_p[i].a == positions_p[i]);
+        assert(bytes_p[i] == (uint8_t)keys_p[i]);
+
+        /* stable */
+        if (i > 0 && keys_p[i - 1] == keys_p[i])
+        {
+            assert(positions_p[i - 1] < positions_p[i]);
+        }
+    }
+
+    /* keys only */
+    darray_raw_shuffle(keys_p, sizeof(*keys_p), length);
+    ret = darray_raw_sort_by_key(keys_p, sizeof(*keys_p), length, int_compare, NULL, NULL, 0);
+    assert(ret == 0);
+    assert(darray_raw_is_sorted(keys_p, sizeof(*keys_p), length, int_compare));
+
+    ret = darray_raw_sort_by_key(keys_p, sizeof(*keys_p), length, int_compare, NULL, NULL, 1);
+    assert(ret != 0);
+
+    darray_raw_destroy(bytes_p);
+    darray_raw_destroy(mystruct_p);
+    darray_raw_destroy(positions_p);
+    darray_raw_destroy(keys_p);
+}
+
+
+static void test_darray_raw_nth_element(void)
+{
+    register const size_t size_of = sizeof(int);
+    register const size_t length = 1000;
+    register int ret = -1;
+
+    int* array_p = darray_raw_create(size_of, length);
+    assert(array_p != NULL);
+
+    const size_t nths[] = { 0, 1, 16, 499, 500, 998, 999 };
+
+    for (size_t test = 0; test < array_size(nths); ++test)
+    {
+        register const size_t nth = nths[test];
+
+        /* shuffled distinct values */
+        for (size_t i = 0; i < length; ++i)
+        {
+            array_p[i] = (int)(i + 1);
+        }
+
+        darray_raw_shuffle(&array_p[0], size_of, length);
+        ret = darray_raw_nth_element(&array_p[0], size_of, length, nth, int_compare);
+        assert(ret == 0);
+        assert(array_p[nth] == (int)(nth + 1));
+
+        for (size_t i = 0; i < length; ++i)
+        {
+            assert(i < nth ? array_p[i] <= array_p[nth] : array_p[i] >= array_p[nth]);
+        }
+
+        /* organ pipe with many duplicates */
+        for (size_t i = 0; i < length; ++i)
+        {
+            array_p[i] = (int)((i < length / 2 ? i : length - i) % 37);
+        }
+
+        ret = darray_raw_nth_element(&array_p[0], size_of, length, nth, int_compare);
+        assert(ret == 0);
+
+        for (size_t i = 0; i < length; ++i)
+        {
+            assert(i < nth ? array_p[i] <= array_p[nth] : array_p[i] >= array_p[nth]);
+        }
+    }
+
+    ret = darray_raw_nth_element(&array_p[0], size_of, length, length, int_compare);
+    assert(ret != 0);
+
+    darray_raw_destroy(array_p);
+}
+
+
+static void test_darray_raw_partial_sort(void)
+{
+    register const size_t size_of = sizeof(int);
+    register const size_t length = 1000;
+    register const size_t middle = 100;
+
+    int* array_p = darray_raw_create(size_of, length);
+    assert(array_p != NULL);
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        array_p[i] = (int)(length - i);
+    }
+
+    darray_raw_shuffle(&array_p[0], size_of, length);
+    register const int ret = darray_raw_partial_sort(&array_p[0], size_of, length, middle, int_compare);
+    assert(ret == 0);
+
+    for (size_t i = 0; i < middle; ++i)
+    {
+        assert(array_p[i] == (int)(i + 1));
+    }
+
+    for (size_t i = middle; i < length; ++i)
+    {
+        assert(array_p[i] > (int)middle);
+    }
+
+    assert(darray_raw_partial_sort(&array_p[0], size_of, length, length + 1, int_compare) == -1);
+
+    darray_raw_destroy(array_p);
+}
+
+
+static void test_darray_raw_top_k(void)
+{
+    register const size_t length = 1000;
+    enum { k = 10 };
+
+    MyStructS* mystruct_p = darray_raw_create(sizeof(*mystruct_p), length);
+    assert(mystruct_p != NULL);
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        mystruct_p[i] = (MyStructS){ .key = (i * 7919) % length, .a = i, .b = 0, .c = 0 };
+    }
+
+    MyStructS top[k];
+    register int ret = darray_raw_top_k(&mystruct_p[0], sizeof(*mystruct_p), length, k, mystruct_compare, &top[0]);
+    assert(ret == 0);
+
+    for (size_t i = 0; i < k; ++i)
+    {
+        assert(top[i].key == length - 1 - i);
+    }
+
+    /* array is not modified */
+    for (size_t i = 0; i < length; ++i)
+    {
+        assert(mystruct_p[i].a == i);
+    }
+
+    ret = darray_raw_top_k(&mystruct_p[0], sizeof(*mystruct_p), length, 0, mystruct_compare, &top[0]);
+    assert(ret != 0);
+
+    darray_raw_destroy(mystruct_p);
+}
+
+
+static size_t mystruct_compare_key_a_calls;
+
+
+static int mystruct_compare_key_a(const void* first_p, const void* second_p)
+{
+    register const MyStructS* const mystruct_first_p = first_p;
+    register const MyStructS* const mystruct_second_p = second_p;
+
+    mystruct_compare_key_a_calls++;
+
+    if (mystruct_first_p->key != mystruct_second_p->key)
+    {
+        return mystruct_first_p->key > mystruct_second_p->key ? 1 : -1;
+    }
+
+    return (mystruct_first_p->a > mystruct_second_p->a) - (mystruct_first_p->a < mystruct_second_p->a);
+}
+
+
+static void mystruct_prefix_key(const void* mystruct_p, void* prefix_p)
+{
+    register const uint64_t key = ((const MyStructS*)mystruct_p)->key;
+    register uint8_t* const bprefix_p = prefix_p;
+
+    for (size_t i = 0; i < 8; ++i)
+    {
+        bprefix_p[i] = (uint8_t)(key >> (56 - 8 * i));
+    }
+}
+
+
+static void mystruct_prefix_key_a(const void* mystruct_p, void* prefix_p)
+{
+    register const uint64_t a = ((const MyStructS*)mystruct_p)->a;
+    register uint8_t* const bprefix_p = prefix_p;
+
+    mystruct_prefix_key(mystruct_p, prefix_p);
+
+    for (size_t i = 0; i < 8; ++i)
+    {
+        bprefix_p[8 + i] = (uint8_t)(a >> (56 - 8 * i));
+    }
+}
+
+
+static void test_darray_raw_merge_k(void)
+{
+    enum { k = 5 };
+    const size_t lengths[k] = { 1000, 0, 3, 100000, 777 };
+    int* srcs[k];
+    size_t total = 0;
+
+    for (size_t i = 0; i < k; ++i)
+    {
+        srcs[i] = malloc(lengths[i] * sizeof(int) + 1);
+        assert(srcs[i] != NULL);
+
+        for (size_t j = 0; j < lengths[i]; ++j)
+        {
+            srcs[i][j] = (int)((j * 7919 + i) % 5000);
+        }
+
+        darray_raw_sort(srcs[i], sizeof(int), lengths[i] > 0 ? lengths[i] : 1, int_compare);
+        total += lengths[i];
+    }
+
+    int* expected_p = darray_raw_create(sizeof(*expected_p), total);
+    assert(expected_p != NULL);
+
+    int* dst_p = darray_raw_create(sizeof(*dst_p), total);
+    assert(dst_p != NULL);
+
+    for (size_t i = 0, n = 0; i < k; ++i)
+    {
+        memcpy(&expected_p[n], srcs[i], lengths[i] * sizeof(int));
+        n += lengths[i];
+    }
+
+    darray_raw_sort(expected_p, sizeof(*expected_p), total, int_compare);
+
+    /* loser tree */
+    register ssize_t ret = darray_raw_merge_k(dst_p, (const void* const*)srcs, lengths, k, sizeof(int), int_compare, false);
+    assert(ret == (ssize_t)total);
+    assert(darray_raw_equal(dst_p, expected_p, sizeof(*dst_p), total, int_compare));
+
+    /* drop duplicates */
+    ret = darray_raw_merge_k(dst_p, (const void* const*)srcs, lengths, k, sizeof(int), int_compare, true);
+    assert(ret == 5000);
+
+    for (size_t i = 0; i < (size_t)ret; ++i)
+    {
+        assert(dst_p[i] == (int)i);
+    }
+
+    /* parallel, output is split between 3 threads */
+    memset(dst_p, 0, total * sizeof(*dst_p));
+    ret = darray_raw_parallel_merge_k(dst_p, (const void* const*)srcs, lengths, k, sizeof(int), int_compare, 4);
+    assert(ret == (ssize_t)total);
+    assert(darray_raw_equal(dst_p, expected_p, sizeof(*dst_p), total, int_compare));
+
+    /* two-way galloping with very unequal inputs */
+    const void* const two_srcs[2] = { srcs[0], srcs[3] };
+    const size_t two_lengths[2] = { lengths[0], lengths[3] };
+
+    int_compare_calls = 0;
+    ret = darray_raw_merge_k(dst_p, two_srcs, two_lengths, 2, sizeof(int), int_compare_counted, false);
+    assert(ret == (ssize_t)(lengths[0] + lengths[3]));
+    assert(darray_raw_is_sorted(dst_p, sizeof(*dst_p), (size_t)ret, int_compare));
+    assert(int_compare_calls < lengths[3]);
+
+    /* stability: equal elements keep order of inputs */
+    const MyStructS first[] = { { .key = 1, .a = 0 }, { .key = 2, .a = 0 } };
+    const MyStructS second[] = { { .key = 1, .a = 1 }, { .key = 2, .a = 1 } };
+    const MyStructS third[] = { { .key = 0, .a = 2 }, { .key = 2, .a = 2 } };
+    const void* const mystruct_srcs[3] = { first, second, third };
+    const size_t mystruct_lengths[3] = { 2, 2, 2 };
+    MyStructS merged[6];
+
+    ret = darray_raw_merge_k(&merged[0], mystruct_srcs, mystruct_lengths, 3, sizeof(MyStructS), mystruct_compare, false);
+    assert(ret == 6);
+
+    const size_t expected_a[6] = { 2, 0, 1, 0, 1, 2 };
+
+    for (size_t i = 0; i < 6; ++i)
+    {
+        assert(merged[i].a == expected_a[i]);
+    }
 
-    search_key = 10;
-    last_index = darray_raw_unsorted_find_last(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, NULL);
-    assert(last_index == 12);
-    assert(array[last_index] == search_key);
+    ret = darray_raw_merge_k(dst_p, (const void* const*)srcs, lengths, 0, sizeof(int), int_compare, false);
+    assert(ret == -1);
+
+    for (size_t i = 0; i < k; ++i)
+    {
+        free(srcs[i]);
+    }
+
+    darray_raw_destroy(dst_p);
+    darray_raw_destroy(expected_p);
 }
 
 
-static void test_darray_raw_sorted_find_first(void)
+static void test_darray_raw_set(void)
 {
-    const int array[] = {1, 2, 2, 3, 3, 4, 5, 5, 5, 6, 7, 7, 7, 7, 8, 9, 9, 10};
+    enum { max_val = 4000 };
+    register const size_t first_length = 2000;
+    register const size_t second_length = 1400;
 
-    register const bool is_sorted = darray_raw_is_sorted(&array[0], sizeof(*array), array_size(array), int_compare);
-    assert(is_sorted == true);
+    int* first_p = darray_raw_create(sizeof(*first_p), first_length);
+    assert(first_p != NULL);
 
-    int out = -1;
-    int search_key = -1;
-    register ssize_t first_index = -1;
+    int* second_p = darray_raw_create(sizeof(*second_p), second_length);
+    assert(second_p != NULL);
 
-    search_key = 0;
-    first_index = darray_raw_sorted_find_first(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
-    assert(first_index == -1);
-    assert(out == -1);
+    int* out_p = darray_raw_create(sizeof(*out_p), first_length + second_length);
+    assert(out_p != NULL);
 
-    search_key = 1;
-    first_index = darray_raw_sorted_find_first(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
-    assert(first_index == 0);
-    assert(out == search_key);
-    assert(out == array[first_index]);
-    
-    search_key = 2;
-    first_index = darray_raw_sorted_find_first(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
-    assert(first_index == 1);
-    assert(out == search_key);
-    assert(out == array[first_index]);
+    /* multisets: first has even values, some twice, second has multiples of 3, some three times */
+    size_t first_counts[max_val] = { 0 };
+    size_t second_counts[max_val] = { 0 };
 
-    search_key = 3;
-    first_index = darray_raw_sorted_find_first(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
-    assert(first_index == 3);
-    assert(out == search_key);
-    assert(out == array[first_index]);
+    for (size_t i = 0, val = 0; i < first_length; val += 2)
+    {
+        for (size_t rep = 0; rep <= (val % 10 == 0) && i < first_length; ++rep)
+        {
+            first_p[i++] = (int)val;
+            ++first_counts[val];
+        }
+    }
 
-    search_key = 4;
-    first_index = darray_raw_sorted_find_first(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
-    assert(first_index == 5);
-    assert(out == search_key);
-    assert(out == array[first_index]);
+    for (size_t i = 0, val = 0; i < second_length; val += 3)
+    {
+        for (size_t rep = 0; rep <= 2 * (val % 7 == 0) && i < second_length; ++rep)
+        {
+            second_p[i++] = (int)val;
+            ++second_counts[val];
+        }
+    }
 
-    search_key = 5;
-    first_index = darray_raw_sorted_find_first(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
-    assert(first_index == 6);
-    assert(out == search_key);
-    assert(out == array[first_index]);
+    /* sizes of results from counts of each value */
+    size_t intersect = 0;
+    size_t sum = 0;
+    size_t difference = 0;
+    size_t symmetric = 0;
 
-    search_key = 6;
-    first_index = darray_raw_sorted_find_first(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
-    assert(first_index == 9);
-    assert(out == search_key);
-    assert(out == array[first_index]);
+    for (size_t val = 0; val < max_val; ++val)
+    {
+        register const size_t a = first_counts[val];
+        register const size_t b = second_counts[val];
 
-    search_key = 7;
-    first_index = darray_raw_sorted_find_first(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
-    assert(first_index == 10);
-    assert(out == search_key);
-    assert(out == array[first_index]);
+        intersect += a < b ? a : b;
+        sum += a > b ? a : b;
+        difference += a > b ? a - b : 0;
+        symmetric += a > b ? a - b : b - a;
+    }
 
-    search_key = 8;
-    first_index = darray_raw_sorted_find_first(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
-    assert(first_index == 14);
-    assert(out == search_key);
-    assert(out == array[first_index]);
+    register ssize_t ret = darray_raw_set_intersect(first_p, first_length, second_p, second_length, sizeof(int), int_compare, NULL);
+    assert(ret == (ssize_t)intersect);
 
-    search_key = 9;
-    first_index = darray_raw_sorted_find_first(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
-    assert(first_index == 15);
-    assert(out == search_key);
-    assert(out == array[first_index]);
+    ret = darray_raw_set_intersect(first_p, first_length, second_p, second_length, sizeof(int), int_compare, out_p);
+    assert(ret == (ssize_t)intersect);
+    assert(darray_raw_is_sorted(out_p, sizeof(int), (size_t)ret, int_compare));
 
-    search_key = 10;
-    first_index = darray_raw_sorted_find_first(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, NULL);
-    assert(first_index == 17);
-    assert(array[first_index] == search_key);
-}
+    for (size_t i = 0; i < (size_t)ret; ++i)
+    {
+        assert(out_p[i] % 6 == 0);
+    }
 
+    ret = darray_raw_set_union(first_p, first_length, second_p, second_length, sizeof(int), int_compare, out_p);
+    assert(ret == (ssize_t)sum);
+    assert(darray_raw_is_sorted(out_p, sizeof(int), (size_t)ret, int_compare));
+    assert(darray_raw_set_union(first_p, first_length, second_p, second_length, sizeof(int), int_compare, NULL) == ret);
 
-static void test_darray_raw_sorted_find_last(void)
-{
-    const int array[] = {1, 2, 2, 3, 3, 4, 5, 5, 5, 6, 7, 7, 7, 7, 8, 9, 9, 10};
+    ret = darray_raw_set_difference(first_p, first_length, second_p, second_length, sizeof(int), int_compare, out_p);
+    assert(ret == (ssize_t)difference);
+    assert(darray_raw_is_sorted(out_p, sizeof(int), (size_t)ret, int_compare));
 
-    register const bool is_sorted = darray_raw_is_sorted(&array[0], sizeof(*array), array_size(array), int_compare);
-    assert(is_sorted == true);
+    for (size_t i = 0; i < (size_t)ret; ++i)
+    {
+        assert(first_counts[out_p[i]] > second_counts[out_p[i]]);
+    }
 
-    int out = -1;
-    int search_key = -1;
-    register ssize_t last_index = -1;
+    ret = darray_raw_set_symmetric_difference(first_p, first_length, second_p, second_length, sizeof(int), int_compare, out_p);
+    assert(ret == (ssize_t)symmetric);
+    assert(darray_raw_is_sorted(out_p, sizeof(int), (size_t)ret, int_compare));
 
-    search_key = 0;
-    last_index = darray_raw_sorted_find_last(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
-    assert(last_index == -1);
-    assert(out == -1);
+    /* skewed sizes are galloped, so comparator is called much less than once per element */
+    const int few[] = { 6, 1000, 1998, 3001 };
+    int_compare_calls = 0;
 
-    search_key = 1;
-    last_index = darray_raw_sorted_find_last(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
-    assert(last_index == 0);
-    assert(out == search_key);
-    assert(out == array[last_index]);
-    
-    search_key = 2;
-    last_index = darray_raw_sorted_find_last(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
-    assert(last_index == 2);
-    assert(out == search_key);
-    assert(out == array[last_index]);
+    ret = darray_raw_set_intersect(few, array_size(few), first_p, first_length, sizeof(int), int_compare_counted, out_p);
+    assert(ret == 3);
+    assert(out_p[0] == 6 && out_p[1] == 1000 && out_p[2] == 1998);
+    assert(int_compare_calls < first_length / 4);
 
-    search_key = 3;
-    last_index = darray_raw_sorted_find_last(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
-    assert(last_index == 4);
-    assert(out == search_key);
-    assert(out == array[last_index]);
+    ret = darray_raw_set_difference(first_p, first_length, few, array_size(few), sizeof(int), int_compare, out_p);
+    assert(ret == (ssize_t)first_length - 3);
 
-    search_key = 4;
-    last_index = darray_raw_sorted_find_last(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
-    assert(last_index == 5);
-    assert(out == search_key);
-    assert(out == array[last_index]);
+    assert(darray_raw_set_union(NULL, 0, few, array_size(few), sizeof(int), int_compare, out_p) == (ssize_t)array_size(few));
+    assert(darray_raw_set_intersect(first_p, first_length, second_p, second_length, sizeof(int), NULL, out_p) == -1);
 
-    search_key = 5;
-    last_index = darray_raw_sorted_find_last(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
-    assert(last_index == 8);
-    assert(out == search_key);
-    assert(out == array[last_index]);
+    /* integer keys: strictly increasing sets */
+    register const size_t keys_length = 10000;
 
-    search_key = 6;
-    last_index = darray_raw_sorted_find_last(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
-    assert(last_index == 9);
-    assert(out == search_key);
-    assert(out == array[last_index]);
+    uint32_t* first_keys_p = darray_raw_create(sizeof(*first_keys_p), keys_length);
+    assert(first_keys_p != NULL);
 
-    search_key = 7;
-    last_index = darray_raw_sorted_find_last(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
-    assert(last_index == 13);
-    assert(out == search_key);
-    assert(out == array[last_index]);
+    uint32_t* second_keys_p = darray_raw_create(sizeof(*second_keys_p), keys_length);
+    assert(second_keys_p != NULL);
 
-    search_key = 8;
-    last_index = darray_raw_sorted_find_last(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
-    assert(last_index == 14);
-    assert(out == search_key);
-    assert(out == array[last_index]);
+    uint32_t* out_keys_p = darray_raw_create(sizeof(*out_keys_p), keys_length);
+    assert(out_keys_p != NULL);
 
-    search_key = 9;
-    last_index = darray_raw_sorted_find_last(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, &out);
-    assert(last_index == 16);
-    assert(out == search_key);
-    assert(out == array[last_index]);
+    for (size_t i = 0; i < keys_length; ++i)
+    {
+        first_keys_p[i] = (uint32_t)(2 * i + 3000000000u);
+        second_keys_p[i] = (uint32_t)(3 * i + 3000000000u);
+    }
 
-    search_key = 10;
-    last_index = darray_raw_sorted_find_last(&array[0], sizeof(*array), array_size(array), &search_key, int_compare, NULL);
-    assert(last_index == 17);
-    assert(array[last_index] == search_key);
+    /* multiples of 6 below 2 * keys_length */
+    register const size_t keys_expected = (2 * keys_length - 1) / 6 + 1;
+
+    ret = darray_raw_set_intersect_keys(first_keys_p, keys_length, second_keys_p, keys_length, sizeof(uint32_t), DARRAY_RAW_KEY_UNSIGNED, out_keys_p);
+    assert(ret == (ssize_t)keys_expected);
+
+    for (size_t i = 0; i < (size_t)ret; ++i)
+    {
+        assert(out_keys_p[i] == (uint32_t)(6 * i + 3000000000u));
+    }
+
+    assert(darray_raw_set_intersect_keys(first_keys_p, keys_length, second_keys_p, keys_length, sizeof(uint32_t), DARRAY_RAW_KEY_UNSIGNED, NULL) == ret);
+
+    /* skewed: few keys of second array */
+    ret = darray_raw_set_intersect_keys(first_keys_p, keys_length, &second_keys_p[100], 50, sizeof(uint32_t), DARRAY_RAW_KEY_UNSIGNED, out_keys_p);
+    assert(ret == 25);
+    assert(out_keys_p[0] == second_keys_p[100]);
+
+    /* signed 8-byte keys with negatives */
+    int64_t* first_keys64_p = (int64_t*)first_keys_p;
+    int64_t* second_keys64_p = (int64_t*)second_keys_p;
+    int64_t* out_keys64_p = (int64_t*)out_keys_p;
+
+    for (size_t i = 0; i < keys_length / 2; ++i)
+    {
+        first_keys64_p[i] = 4 * (int64_t)i - 5000;
+        second_keys64_p[i] = 5 * (int64_t)i - 5000;
+    }
+
+    ret = darray_raw_set_intersect_keys(first_keys64_p, keys_length / 2, second_keys64_p, keys_length / 2, sizeof(int64_t), DARRAY_RAW_KEY_SIGNED, out_keys64_p);
+    assert(ret == (ssize_t)((4 * (keys_length / 2) - 1) / 20 + 1));
+
+    for (size_t i = 0; i < (size_t)ret; ++i)
+    {
+        assert(out_keys64_p[i] == 20 * (int64_t)i - 5000);
+    }
+
+    assert(darray_raw_set_intersect_keys(first_keys_p, keys_length, second_keys_p, keys_length, 2, DARRAY_RAW_KEY_UNSIGNED, NULL) == -1);
+
+    /* output sized by counting call, sentinel after it cannot be overwritten even if result is much smaller than inputs */
+    register const size_t sparse_length = 256;
+
+    for (size_t i = 0; i < sparse_length; ++i)
+    {
+        first_keys_p[i] = (uint32_t)(2 * i);
+        second_keys_p[i] = (uint32_t)(2 * i + 1);
+    }
+
+    second_keys_p[0] = 0;
+
+    ret = darray_raw_set_intersect_keys(first_keys_p, sparse_length, second_keys_p, sparse_length, sizeof(uint32_t), DARRAY_RAW_KEY_UNSIGNED, NULL);
+    assert(ret == 1);
+
+    uint32_t* sized_keys_p = darray_raw_create(sizeof(*sized_keys_p), (size_t)ret + 1);
+    assert(sized_keys_p != NULL);
+
+    sized_keys_p[ret] = UINT32_MAX;
+
+    assert(darray_raw_set_intersect_keys(first_keys_p, sparse_length, second_keys_p, sparse_length, sizeof(uint32_t), DARRAY_RAW_KEY_UNSIGNED, sized_keys_p) == ret);
+    assert(sized_keys_p[0] == 0);
+    assert(sized_keys_p[ret] == UINT32_MAX);
+
+    darray_raw_destroy(sized_keys_p);
+
+    darray_raw_destroy(out_keys_p);
+    darray_raw_destroy(second_keys_p);
+    darray_raw_destroy(first_keys_p);
+    darray_raw_destroy(out_p);
+    darray_raw_destroy(second_p);
+    darray_raw_destroy(first_p);
 }
 
 
-static void test_darray_raw_sort(void)
+static void test_darray_raw_prefix_sort(void)
 {
-    register const size_t size_of = sizeof(int);
-    register const size_t length = 1000;
+    register const size_t length = 10000;
 
-    int* array_p = darray_raw_create(size_of, length);
-    assert(array_p != NULL);
+    MyStructS* mystruct_p = darray_raw_create(sizeof(*mystruct_p), length);
+    assert(mystruct_p != NULL);
 
-    /* first test with shuffle array */
+    /* 8-byte prefix: only elements with equal key are compared */
     for (size_t i = 0; i < length; ++i)
     {
-        array_p[i] = (int)(i + 1);
+        mystruct_p[i] = (MyStructS){ .key = (i * 7919) % 1000, .a = (i * 104729) % length, .b = i, .c = 0 };
     }
 
-    darray_raw_shuffle(&array_p[0], size_of, length);
-    darray_raw_sort(&array_p[0], size_of, length, int_compare);
-    assert(darray_raw_is_sorted(&array_p[0], size_of, length, int_compare) == true);
+    mystruct_compare_key_a_calls = 0;
+    register int ret = darray_raw_prefix_sort(&mystruct_p[0], sizeof(*mystruct_p), length, 8, mystruct_prefix_key, mystruct_compare_key_a);
+    assert(ret == 0);
+    assert(mystruct_compare_key_a_calls < length * 5);
 
-    /* second test with worst-case */
-    for (size_t i = 0; i < length; ++i)
+    for (size_t i = 1; i < length; ++i)
     {
-        array_p[i] = (int)(length - i);
+        assert(mystruct_compare_key_a(&mystruct_p[i - 1], &mystruct_p[i]) < 0);
     }
 
-    darray_raw_sort(&array_p[0], size_of, length, int_compare);
-    assert(darray_raw_is_sorted(&array_p[0], size_of, length, int_compare) == true);
+    /* 16-byte prefix: all prefixes are different, comparator is never called */
+    darray_raw_shuffle(&mystruct_p[0], sizeof(*mystruct_p), length);
+
+    mystruct_compare_key_a_calls = 0;
+    ret = darray_raw_prefix_sort(&mystruct_p[0], sizeof(*mystruct_p), length, 16, mystruct_prefix_key_a, mystruct_compare_key_a);
+    assert(ret == 0);
+    assert(mystruct_compare_key_a_calls == 0);
+
+    for (size_t i = 1; i < length; ++i)
+    {
+        assert(mystruct_p[i - 1].key < mystruct_p[i].key || (mystruct_p[i - 1].key == mystruct_p[i].key && mystruct_p[i - 1].a < mystruct_p[i].a));
+    }
+
+    ret = darray_raw_prefix_sort(&mystruct_p[0], sizeof(*mystruct_p), length, 4, mystruct_prefix_key, mystruct_compare_key_a);
+    assert(ret != 0);
+
+    darray_raw_destroy(mystruct_p);
+}
+
+
+static void test_darray_raw_external_sort(void)
+{
+    register const size_t length = 100000;
+    const char* const in_path = "/tmp/darray_raw_test_external_sort_in";
+    const char* const out_path = "/tmp/darray_raw_test_external_sort_out";
+
+    int* array_p = darray_raw_create(sizeof(*array_p), length);
+    assert(array_p != NULL);
+
+    /* single run, one merge pass and many merge passes (fan-in 2) */
+    const size_t budgets[] = { 1 << 20, 1 << 19, 1 << 16 };
+
+    for (size_t b = 0; b < sizeof(budgets) / sizeof(budgets[0]); ++b)
+    {
+        for (size_t i = 0; i < length; ++i)
+        {
+            array_p[i] = (int)((i * 7919) % (length / 2));
+        }
+
+        FILE* file_p = fopen(in_path, "wb");
+        assert(file_p != NULL);
+        assert(fwrite(array_p, sizeof(*array_p), length, file_p) == length);
+        assert(fclose(file_p) == 0);
+
+        register int ret = darray_raw_external_sort(in_path, out_path, sizeof(*array_p), int_compare, budgets[b], NULL);
+        assert(ret == 0);
+
+        file_p = fopen(out_path, "rb");
+        assert(file_p != NULL);
+        assert(fread(array_p, sizeof(*array_p), length, file_p) == length);
+        assert(fgetc(file_p) == EOF);
+        assert(fclose(file_p) == 0);
+
+        /* every value is present exactly twice */
+        for (size_t i = 0; i < length; ++i)
+        {
+            assert(array_p[i] == (int)(i / 2));
+        }
+    }
+
+    /* in place */
+    register int ret = darray_raw_external_sort(out_path, out_path, sizeof(*array_p), int_compare, 1 << 16, ".");
+    assert(ret == 0);
+
+    FILE* file_p = fopen(out_path, "rb");
+    assert(file_p != NULL);
+    assert(fread(array_p, sizeof(*array_p), length, file_p) == length);
+    assert(fclose(file_p) == 0);
+    assert(darray_raw_is_sorted(array_p, sizeof(*array_p), length, int_compare));
+
+    ret = darray_raw_external_sort(in_path, out_path, sizeof(*array_p), int_compare, sizeof(*array_p), NULL);
+    assert(ret != 0);
+
+    ret = darray_raw_external_sort(in_path, out_path, 3, int_compare, 1 << 16, NULL);
+    assert(ret != 0);
+
+    assert(remove(in_path) == 0);
+    assert(remove(out_path) == 0);
 
     darray_raw_destroy(array_p);
 }
@@ -1639,6 +3787,73 @@ static void test_darray_raw_is_reverse_sorted(void)
 }
 
 
+static void test_darray_raw_batch(void)
+{
+    register const size_t length = 1000;
+
+    int* array_p = darray_raw_create(sizeof(*array_p), length);
+    assert(array_p != NULL);
+
+    int* copy_p = darray_raw_create(sizeof(*copy_p), length);
+    assert(copy_p != NULL);
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        array_p[i] = (int)((i * 7919) % 997);
+    }
+
+    int val = 0;
+    int_compare_batch_calls = 0;
+    register ssize_t idx = darray_raw_find_min_batch(array_p, sizeof(*array_p), length, int_compare_batch, &val);
+    assert(idx == darray_raw_find_min(array_p, sizeof(*array_p), length, int_compare, NULL));
+    assert(val == 0);
+    assert(int_compare_batch_calls < length / 8);
+
+    /* descending input gives new minimum in every element, still one call per block and 7 calls of reduction */
+    for (size_t i = 0; i < length; ++i)
+    {
+        copy_p[i] = (int)(length - i);
+    }
+
+    int_compare_batch_calls = 0;
+    idx = darray_raw_find_min_batch(copy_p, sizeof(*copy_p), length, int_compare_batch, &val);
+    assert(idx == (ssize_t)(length - 1));
+    assert(val == 1);
+    assert(int_compare_batch_calls <= (length + 127) / 128 + 7);
+
+    const int key = array_p[700];
+    idx = darray_raw_unsorted_find_first_batch(array_p, sizeof(*array_p), length, &key, int_compare_batch, &val);
+    assert(idx == darray_raw_unsorted_find_first(array_p, sizeof(*array_p), length, &key, int_compare, NULL));
+    assert(val == key);
+
+    const int missing = 1000;
+    idx = darray_raw_unsorted_find_first_batch(array_p, sizeof(*array_p), length, &missing, int_compare_batch, NULL);
+    assert(idx == -1);
+
+    memcpy(copy_p, array_p, length * sizeof(*array_p));
+    assert(darray_raw_equal_batch(array_p, copy_p, sizeof(*array_p), length, int_compare_batch));
+
+    copy_p[length - 1]++;
+    assert(!darray_raw_equal_batch(array_p, copy_p, sizeof(*array_p), length, int_compare_batch));
+
+    assert(!darray_raw_is_sorted_batch(array_p, sizeof(*array_p), length, int_compare_batch));
+
+    darray_raw_sort(array_p, sizeof(*array_p), length, int_compare);
+    assert(darray_raw_is_sorted_batch(array_p, sizeof(*array_p), length, int_compare_batch));
+
+    /* last pair is checked too */
+    array_p[length - 1] = -1;
+    assert(!darray_raw_is_sorted_batch(array_p, sizeof(*array_p), length, int_compare_batch));
+    assert(darray_raw_is_sorted_batch(array_p, sizeof(*array_p), 1, int_compare_batch));
+
+    idx = darray_raw_find_min_batch(array_p, sizeof(*array_p), length, NULL, NULL);
+    assert(idx == -1);
+
+    darray_raw_destroy(copy_p);
+    darray_raw_destroy(array_p);
+}
+
+
 int main(void)
 {
     test_darray_raw_create();
@@ -1666,20 +3881,46 @@ int main(void)
     test_darray_raw_delete_last_with_entry();
     test_darray_raw_delete_pos_with_entry();
     test_darray_raw_delete_all_with_entries();
+    test_darray_raw_unique();
     test_darray_raw_lower_bound();
     test_darray_raw_upper_bound();
+    test_darray_raw_bound_hint();
+    test_darray_raw_bound_typed();
+    test_darray_raw_bound_batch();
+    test_darray_raw_interpolation();
+    test_darray_raw_eytzinger();
+    test_darray_raw_stree();
+    test_darray_raw_learned();
     test_darray_raw_find_min();
     test_darray_raw_find_max();
     test_darray_raw_unsorted_find_first();
     test_darray_raw_unsorted_find_last();
+    test_darray_raw_unsorted_find_bitwise();
+    test_darray_raw_filter();
     test_darray_raw_sorted_find_first();
     test_darray_raw_sorted_find_last();
     test_darray_raw_sort();
+    test_darray_raw_sort_typed();
+    test_darray_raw_sort_small();
+    test_darray_raw_radix_sort();
+    test_darray_raw_radix_sort_by_key();
+    test_darray_raw_parallel_sort();
+    test_darray_raw_stable_sort();
+    test_darray_raw_argsort();
+    test_darray_raw_sort_by_key();
+    test_darray_raw_nth_element();
+    test_darray_raw_partial_sort();
+    test_darray_raw_top_k();
+    test_darray_raw_merge_k();
+    test_darray_raw_set();
+    test_darray_raw_prefix_sort();
+    test_darray_raw_external_sort();
     test_darray_raw_shuffle();
     test_darray_raw_reverse();
     test_darray_raw_equal();
     test_darray_raw_is_sorted();
     test_darray_raw_is_reverse_sorted();
+    test_darray_raw_batch();
 
     return EXIT_SUCCESS;
 }